@@ -0,0 +1,213 @@
+#include "BenchHarness.h"
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> g_allocationCount(0);
+static std::atomic<uint64_t> g_allocatedBytes(0);
+
+// 替换全局分配函数以统计分配次数；数组和 nothrow 版本默认转发到这里（对齐分配不计入）
+void* operator new(size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+uint64_t BenchHarness::allocationCount() {
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+uint64_t BenchHarness::allocatedBytes() {
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+static std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            escaped += buffer;
+        } else {
+            escaped += static_cast<char>(c);
+        }
+    }
+    return escaped;
+}
+
+BenchHarness::BenchHarness() : m_iterations(5) {}
+
+bool BenchHarness::shouldRun(const std::string& name) const {
+    return m_filter.empty() || name.find(m_filter) != std::string::npos;
+}
+
+void BenchHarness::run(const std::string& group, const std::string& name, const Workload& workload,
+                       Body body, Setup setup) {
+    if (!shouldRun(name)) {
+        return;
+    }
+
+    Result result;
+    result.name = name;
+    result.group = group;
+    result.workload = workload;
+
+    // 预热：填充缓存、解析区和内存池，不计入结果
+    if (setup) {
+        setup();
+    }
+    if (!body(result.errorMessage)) {
+        result.success = false;
+        m_results.push_back(result);
+        return;
+    }
+
+    std::vector<double> samples;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    for (int i = 0; i < m_iterations; ++i) {
+        if (setup) {
+            setup();
+        }
+        uint64_t allocationsBefore = allocationCount();
+        uint64_t bytesBefore = allocatedBytes();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool ok = body(result.errorMessage);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        allocations += allocationCount() - allocationsBefore;
+        bytes += allocatedBytes() - bytesBefore;
+
+        if (!ok) {
+            result.success = false;
+            break;
+        }
+        samples.push_back(elapsed);
+    }
+
+    if (!samples.empty()) {
+        std::vector<double> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            total += sorted[i];
+        }
+
+        result.iterations = static_cast<int>(sorted.size());
+        result.minMs = sorted.front();
+        result.maxMs = sorted.back();
+        result.meanMs = total / sorted.size();
+        result.medianMs = sorted.size() % 2 == 1
+            ? sorted[sorted.size() / 2]
+            : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+        result.allocationsPerRun = static_cast<double>(allocations) / sorted.size();
+        result.bytesAllocatedPerRun = static_cast<double>(bytes) / sorted.size();
+
+        double seconds = result.medianMs / 1000.0;
+        if (seconds > 0.0) {
+            result.mbPerSecond = static_cast<double>(workload.bytes) / (1024.0 * 1024.0) / seconds;
+            result.rowsPerSecond = static_cast<double>(workload.rows) / seconds;
+        }
+    }
+
+    m_results.push_back(result);
+}
+
+size_t BenchHarness::failureCount() const {
+    size_t failures = 0;
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        if (!m_results[i].success) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+void BenchHarness::printTable(std::ostream& out) const {
+    out << std::left << std::setw(36) << "benchmark"
+        << std::right << std::setw(12) << "median ms"
+        << std::setw(12) << "MB/s"
+        << std::setw(14) << "rows/s"
+        << std::setw(14) << "allocs/run" << "\n";
+
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const Result& result = m_results[i];
+        out << std::left << std::setw(36) << result.name << std::right;
+        if (!result.success) {
+            out << "  失败: " << result.errorMessage << "\n";
+            continue;
+        }
+        out << std::fixed << std::setprecision(3) << std::setw(12) << result.medianMs
+            << std::setprecision(1) << std::setw(12) << result.mbPerSecond
+            << std::setprecision(0) << std::setw(14) << result.rowsPerSecond
+            << std::setprecision(1) << std::setw(14) << result.allocationsPerRun << "\n";
+    }
+}
+
+void BenchHarness::writeJson(std::ostream& out) const {
+    out << std::fixed << std::setprecision(4);
+    out << "{\n  \"context\": {";
+    bool first = true;
+    for (std::map<std::string, std::string>::const_iterator it = m_context.begin(); it != m_context.end(); ++it) {
+        out << (first ? "\n" : ",\n") << "    \"" << jsonEscape(it->first) << "\": \"" << jsonEscape(it->second) << "\"";
+        first = false;
+    }
+    out << (first ? "},\n" : "\n  },\n");
+
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const Result& result = m_results[i];
+        out << (i > 0 ? "," : "") << "\n    {";
+        out << "\"name\": \"" << jsonEscape(result.name) << "\", ";
+        out << "\"group\": \"" << jsonEscape(result.group) << "\", ";
+        out << "\"success\": " << (result.success ? "true" : "false") << ", ";
+        out << "\"error\": \"" << jsonEscape(result.errorMessage) << "\", ";
+        out << "\"iterations\": " << result.iterations << ", ";
+        out << "\"bytes\": " << result.workload.bytes << ", ";
+        out << "\"rows\": " << result.workload.rows << ", ";
+        out << "\"min_ms\": " << result.minMs << ", ";
+        out << "\"median_ms\": " << result.medianMs << ", ";
+        out << "\"mean_ms\": " << result.meanMs << ", ";
+        out << "\"max_ms\": " << result.maxMs << ", ";
+        out << "\"mb_per_second\": " << result.mbPerSecond << ", ";
+        out << "\"rows_per_second\": " << result.rowsPerSecond << ", ";
+        out << "\"allocations_per_run\": " << result.allocationsPerRun << ", ";
+        out << "\"allocated_bytes_per_run\": " << result.bytesAllocatedPerRun << "}";
+    }
+    out << (m_results.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+}
+
+bool BenchHarness::writeJson(const std::string& filename, std::string& errorMessage) const {
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        errorMessage = "无法创建结果文件: " + filename;
+        return false;
+    }
+    writeJson(file);
+    if (!file.good()) {
+        errorMessage = "写入结果文件失败: " + filename;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <ostream>
+#include <cstdint>
+
+/**
+ * @brief 基准测试运行器
+ *
+ * 每个基准先预热一次，再计时运行若干次，取中位数计算吞吐量；
+ * 同时统计每次运行的堆分配次数和字节数（BenchHarness.cpp 替换了全局 operator new）。
+ */
+class BenchHarness {
+public:
+    // 一次运行处理的数据量，用于换算 MB/s 和 行/s
+    struct Workload {
+        uint64_t bytes = 0;
+        uint64_t rows = 0;
+    };
+
+    struct Result {
+        std::string name;
+        std::string group;              // micro / e2e
+        int iterations = 0;
+        Workload workload;
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double meanMs = 0.0;
+        double maxMs = 0.0;
+        double mbPerSecond = 0.0;       // 按中位数计算
+        double rowsPerSecond = 0.0;
+        double allocationsPerRun = 0.0;
+        double bytesAllocatedPerRun = 0.0;
+        bool success = true;
+        std::string errorMessage;
+    };
+
+    // 计时部分：返回 false 表示基准失败，setup 在每次计时前调用且不计时
+    typedef std::function<bool(std::string& errorMessage)> Body;
+    typedef std::function<void()> Setup;
+
+    BenchHarness();
+
+    void setIterations(int iterations) { m_iterations = iterations; }
+    // 只运行名称包含该子串的基准，为空时全部运行
+    void setFilter(const std::string& filter) { m_filter = filter; }
+    void setContext(const std::string& key, const std::string& value) { m_context[key] = value; }
+
+    bool shouldRun(const std::string& name) const;
+    void run(const std::string& group, const std::string& name, const Workload& workload,
+             Body body, Setup setup = Setup());
+
+    const std::vector<Result>& getResults() const { return m_results; }
+    size_t failureCount() const;
+
+    void printTable(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+    bool writeJson(const std::string& filename, std::string& errorMessage) const;
+
+    // 进程启动以来的累计分配（所有线程）
+    static uint64_t allocationCount();
+    static uint64_t allocatedBytes();
+
+private:
+    int m_iterations;
+    std::string m_filter;
+    std::map<std::string, std::string> m_context;
+    std::vector<Result> m_results;
+};
+
+#endif // BENCHHARNESS_H
@@ -0,0 +1,144 @@
+#include "LoopbackSender.h"
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+LoopbackSender::LoopbackSender() : m_fd(-1), m_datagram(false) {}
+
+LoopbackSender::~LoopbackSender() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool LoopbackSender::connect(SocketDataSource::Transport, const std::string&, int, std::string& errorMessage) {
+    errorMessage = "当前平台不支持回环发送";
+    return false;
+}
+
+bool LoopbackSender::send(const std::vector<std::string>&, size_t, size_t, std::string& errorMessage) {
+    errorMessage = "当前平台不支持回环发送";
+    return false;
+}
+
+void LoopbackSender::close() {
+}
+
+#else
+
+bool LoopbackSender::connect(SocketDataSource::Transport transport, const std::string& address, int port,
+                             std::string& errorMessage) {
+    close();
+    bool isUnix = transport == SocketDataSource::Transport::Unix ||
+                  transport == SocketDataSource::Transport::UnixDatagram;
+    m_datagram = transport == SocketDataSource::Transport::Udp ||
+                 transport == SocketDataSource::Transport::UnixDatagram;
+    int socketType = m_datagram ? SOCK_DGRAM : SOCK_STREAM;
+
+    int result = -1;
+    if (isUnix) {
+        sockaddr_un target;
+        std::memset(&target, 0, sizeof(target));
+        target.sun_family = AF_UNIX;
+        std::strncpy(target.sun_path, address.c_str(), sizeof(target.sun_path) - 1);
+        m_fd = socket(AF_UNIX, socketType, 0);
+        if (m_fd >= 0) {
+            result = ::connect(m_fd, reinterpret_cast<sockaddr*>(&target), sizeof(target));
+        }
+    } else {
+        sockaddr_in target;
+        std::memset(&target, 0, sizeof(target));
+        target.sin_family = AF_INET;
+        target.sin_port = htons(static_cast<uint16_t>(port));
+        inet_pton(AF_INET, "127.0.0.1", &target.sin_addr);
+        m_fd = socket(AF_INET, socketType, 0);
+        if (m_fd >= 0) {
+            result = ::connect(m_fd, reinterpret_cast<sockaddr*>(&target), sizeof(target));
+        }
+    }
+    if (result != 0) {
+        errorMessage = std::string("无法连接回环地址: ") + std::strerror(errno);
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool LoopbackSender::send(const std::vector<std::string>& frames, size_t first, size_t last,
+                          std::string& errorMessage) {
+    if (m_fd < 0) {
+        errorMessage = "发送端未连接";
+        return false;
+    }
+
+    if (m_datagram) {
+#ifdef __linux__
+        const size_t batchSize = 64;
+        mmsghdr messages[batchSize];
+        iovec vectors[batchSize];
+        while (first < last) {
+            size_t count = std::min(batchSize, last - first);
+            for (size_t i = 0; i < count; ++i) {
+                vectors[i].iov_base = const_cast<char*>(frames[first + i].data());
+                vectors[i].iov_len = frames[first + i].size();
+                std::memset(&messages[i], 0, sizeof(messages[i]));
+                messages[i].msg_hdr.msg_iov = &vectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+            }
+            int sent = sendmmsg(m_fd, messages, static_cast<unsigned int>(count), 0);
+            if (sent < 0) {
+                if (errno == ENOBUFS || errno == EINTR) {
+                    continue;
+                }
+                errorMessage = std::string("发送失败: ") + std::strerror(errno);
+                return false;
+            }
+            first += static_cast<size_t>(sent);
+        }
+#else
+        for (; first < last; ++first) {
+            if (::send(m_fd, frames[first].data(), frames[first].size(), 0) < 0) {
+                errorMessage = std::string("发送失败: ") + std::strerror(errno);
+                return false;
+            }
+        }
+#endif
+        return true;
+    }
+
+    m_streamBuffer.clear();
+    for (size_t i = first; i < last; ++i) {
+        m_streamBuffer += frames[i];
+    }
+    size_t offset = 0;
+    while (offset < m_streamBuffer.size()) {
+        ssize_t sent = ::send(m_fd, m_streamBuffer.data() + offset, m_streamBuffer.size() - offset, 0);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            errorMessage = std::string("发送失败: ") + std::strerror(errno);
+            return false;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+void LoopbackSender::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+#endif // _WIN32
@@ -0,0 +1,36 @@
+#ifndef LOOPBACKSENDER_H
+#define LOOPBACKSENDER_H
+
+#include "data/SocketDataSource.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief 本机回环发送端，向 SocketDataSource 发送预先编码的帧
+ *
+ * 数据报一帧一个，Linux 上用 sendmmsg 成批发送；流式连接把多帧拼接后一次写出。
+ */
+class LoopbackSender {
+public:
+    LoopbackSender();
+    ~LoopbackSender();
+
+    // UDP/TCP 连接 127.0.0.1:port，Unix 域套接字连接 address 路径
+    bool connect(SocketDataSource::Transport transport, const std::string& address, int port,
+                 std::string& errorMessage);
+    // 发送 frames 中 [first, last) 的帧
+    bool send(const std::vector<std::string>& frames, size_t first, size_t last, std::string& errorMessage);
+    void close();
+
+    bool isDatagram() const { return m_datagram; }
+
+private:
+    LoopbackSender(const LoopbackSender&);
+    LoopbackSender& operator=(const LoopbackSender&);
+
+    int m_fd;
+    bool m_datagram;
+    std::string m_streamBuffer;
+};
+
+#endif // LOOPBACKSENDER_H
@@ -0,0 +1,158 @@
+#include "SyntheticData.h"
+#include <random>
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+
+SyntheticData::SyntheticData(const Config& config) : m_config(config) {}
+
+std::vector<std::string> SyntheticData::fieldNames() const {
+    std::vector<std::string> names;
+    names.push_back("time");
+    for (size_t i = 0; i < m_config.columns; ++i) {
+        names.push_back("ch" + std::to_string(i + 1));
+    }
+    return names;
+}
+
+void SyntheticData::appendNumber(std::string& out, double value, NumberFormat format) const {
+    char buffer[64];
+    int length = 0;
+    switch (format) {
+    case NumberFormat::Scientific:
+        length = std::snprintf(buffer, sizeof(buffer), "%.*e", m_config.precision, value);
+        break;
+    case NumberFormat::Integer:
+        length = std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(std::llround(value * 1000.0)));
+        break;
+    default:
+        length = std::snprintf(buffer, sizeof(buffer), "%.*f", m_config.precision, value);
+        break;
+    }
+    out.append(buffer, static_cast<size_t>(length));
+}
+
+std::vector<std::string> SyntheticData::generateLines() const {
+    // 显式实现分布，std::uniform_real_distribution 的结果随标准库实现而不同
+    std::mt19937_64 rng(m_config.seed);
+    auto uniform = [&rng]() { return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0); };
+
+    std::vector<std::string> lines;
+    lines.reserve(m_config.rows);
+    std::string line;
+    const NumberFormat formats[] = {NumberFormat::Fixed, NumberFormat::Scientific, NumberFormat::Integer};
+
+    for (size_t row = 0; row < m_config.rows; ++row) {
+        line.clear();
+        bool malformed = m_config.malformedRatio > 0.0 && uniform() < m_config.malformedRatio;
+        size_t badColumn = malformed ? static_cast<size_t>(uniform() * (m_config.columns + 1)) : 0;
+        // 一半的异常行在 badColumn 处截断（字段数不足），另一半在该列写入无法解析的文本
+        bool truncated = malformed && (rng() & 1) != 0;
+
+        for (size_t col = 0; col <= m_config.columns; ++col) {
+            if (truncated && col == badColumn) {
+                break;
+            }
+            if (col > 0) {
+                line += m_config.delimiter;
+            }
+            if (malformed && col == badColumn) {
+                line += "n/a";
+                continue;
+            }
+
+            double value = 0.0;
+            if (col == 0) {
+                value = static_cast<double>(row) * 0.001;
+            } else {
+                double phase = static_cast<double>(row) * 0.01 * static_cast<double>(col);
+                value = 100.0 * std::sin(phase) + 100.0 * m_config.noise * (uniform() * 2.0 - 1.0);
+            }
+
+            NumberFormat format = m_config.format;
+            if (format == NumberFormat::Mixed) {
+                format = formats[(row + col) % 3];
+            }
+            appendNumber(line, value, col == 0 && format == NumberFormat::Integer ? NumberFormat::Fixed : format);
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::vector<std::string> SyntheticData::generateFields(size_t count) const {
+    std::mt19937_64 rng(m_config.seed);
+    const NumberFormat formats[] = {NumberFormat::Fixed, NumberFormat::Scientific, NumberFormat::Integer};
+
+    std::vector<std::string> fields;
+    fields.reserve(count);
+    std::string text;
+    for (size_t i = 0; i < count; ++i) {
+        double value = (static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0) - 0.5) * 2000.0;
+        NumberFormat format = m_config.format == NumberFormat::Mixed ? formats[i % 3] : m_config.format;
+        text.clear();
+        appendNumber(text, value, format);
+        fields.push_back(text);
+    }
+    return fields;
+}
+
+std::string SyntheticData::generateCsv() const {
+    std::string csv;
+    if (m_config.header) {
+        std::vector<std::string> names = fieldNames();
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (i > 0) {
+                csv += m_config.delimiter;
+            }
+            csv += names[i];
+        }
+        csv += '\n';
+    }
+
+    std::vector<std::string> lines = generateLines();
+    for (size_t i = 0; i < lines.size(); ++i) {
+        csv += lines[i];
+        csv += '\n';
+    }
+    return csv;
+}
+
+bool SyntheticData::writeCsv(const std::string& filename, std::string& errorMessage) const {
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        errorMessage = "无法创建文件: " + filename;
+        return false;
+    }
+    std::string csv = generateCsv();
+    file.write(csv.data(), static_cast<std::streamsize>(csv.size()));
+    if (!file.good()) {
+        errorMessage = "写入文件失败: " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool SyntheticData::parseFormat(const std::string& text, NumberFormat& format) {
+    if (text == "fixed") {
+        format = NumberFormat::Fixed;
+    } else if (text == "scientific") {
+        format = NumberFormat::Scientific;
+    } else if (text == "integer") {
+        format = NumberFormat::Integer;
+    } else if (text == "mixed") {
+        format = NumberFormat::Mixed;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string SyntheticData::formatName(NumberFormat format) {
+    switch (format) {
+    case NumberFormat::Scientific: return "scientific";
+    case NumberFormat::Integer:    return "integer";
+    case NumberFormat::Mixed:      return "mixed";
+    default:                       return "fixed";
+    }
+}
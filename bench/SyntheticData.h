@@ -0,0 +1,58 @@
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief 确定性的合成 CSV 数据生成器
+ *
+ * 相同的配置（含种子）总是生成逐字节相同的内容，不同机器、不同次运行的结果可以直接比较。
+ * 第一列为单调递增的 time，其余列为正弦信号叠加均匀噪声。
+ */
+class SyntheticData {
+public:
+    enum class NumberFormat {
+        Fixed,          // 123.456789
+        Scientific,     // 1.234568e+02
+        Integer,        // 123
+        Mixed           // 逐字段轮换以上三种
+    };
+
+    struct Config {
+        size_t rows = 100000;
+        size_t columns = 8;             // 不含 time 列
+        NumberFormat format = NumberFormat::Fixed;
+        int precision = 6;
+        double noise = 0.1;             // 噪声幅度（相对信号幅度）
+        double malformedRatio = 0.0;    // 含无法解析字段或字段数错误的行所占比例
+        uint64_t seed = 42;
+        char delimiter = ',';
+        bool header = true;
+    };
+
+    explicit SyntheticData(const Config& config);
+
+    // 生成完整的 CSV 文本
+    std::string generateCsv() const;
+    bool writeCsv(const std::string& filename, std::string& errorMessage) const;
+
+    // 只生成数据行（不含表头），每个元素为一行，不带换行符
+    std::vector<std::string> generateLines() const;
+    // 逐个数值字段的文本，用于数值解析基准
+    std::vector<std::string> generateFields(size_t count) const;
+
+    std::vector<std::string> fieldNames() const;
+    const Config& getConfig() const { return m_config; }
+
+    static bool parseFormat(const std::string& text, NumberFormat& format);
+    static std::string formatName(NumberFormat format);
+
+private:
+    void appendNumber(std::string& out, double value, NumberFormat format) const;
+
+    Config m_config;
+};
+
+#endif // SYNTHETICDATA_H
@@ -0,0 +1,600 @@
+#include "BenchHarness.h"
+#include "SyntheticData.h"
+#include "LoopbackSender.h"
+#include "data/DataModel.h"
+#include "data/DataParser.h"
+#include "data/CSVDataSource.h"
+#include "data/ParseArena.h"
+#include "data/RecordingLog.h"
+#include "data/ReplayDataSource.h"
+#include "plugins/PluginManager.h"
+#include "plugins/ExportPlugin.h"
+#include "utils/FileUtils.h"
+#include <QVariant>
+#include <iostream>
+#include <fstream>
+#include <streambuf>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <ctime>
+#include <cstdlib>
+
+// 数据源和插件把日志写到 std::cout，计时期间丢弃，避免终端输出计入耗时
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+static void printUsage(const char* program) {
+    std::cerr << "用法: " << program << " [选项]\n"
+              << "\n"
+              << "合成数据:\n"
+              << "  --rows <N>          行数（默认 100000）\n"
+              << "  --columns <N>       数值列数，不含 time 列（默认 8）\n"
+              << "  --format <F>        fixed / scientific / integer / mixed（默认 fixed）\n"
+              << "  --precision <N>     小数位数（默认 6）\n"
+              << "  --noise <X>         噪声幅度，相对信号幅度（默认 0.1）\n"
+              << "  --malformed <X>     异常行比例 0~1（默认 0）\n"
+              << "  --seed <N>          随机种子（默认 42）\n"
+              << "\n"
+              << "运行:\n"
+              << "  --iterations <N>    每个基准的计时次数（默认 5）\n"
+              << "  --filter <S>        只运行名称包含 S 的基准\n"
+              << "  --json <文件>       结果写为 JSON\n"
+              << "  -h, --help          显示帮助\n";
+}
+
+static bool parseNumber(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+static bool setPluginParameter(const std::shared_ptr<PluginInterface>& plugin, const std::string& key,
+                               const std::string& value) {
+    return plugin->setParameter(key, QVariant(QString::fromStdString(value)));
+}
+
+// 按 CSVDataSource 的方式加载文件：不使用解析缓存
+static std::shared_ptr<DataModel> loadCsv(const std::string& filename, std::string& errorMessage) {
+    CSVDataSource source;
+    source.setUseParseCache(false);
+    source.setErrorCallback([&errorMessage](const std::string& message) { errorMessage = message; });
+    source.initialize(filename);
+    if (!source.start()) {
+        if (errorMessage.empty()) {
+            errorMessage = "加载失败: " + filename;
+        }
+        return nullptr;
+    }
+    return source.getDataModel();
+}
+
+static bool runPlugin(const std::string& name, const std::map<std::string, std::string>& parameters,
+                      const std::shared_ptr<DataModel>& input, std::shared_ptr<DataModel>& output,
+                      std::string& errorMessage) {
+    std::shared_ptr<PluginInterface> plugin = PluginManager::getInstance().createPlugin(name);
+    if (!plugin) {
+        errorMessage = "无法创建插件: " + name;
+        return false;
+    }
+    for (std::map<std::string, std::string>::const_iterator it = parameters.begin(); it != parameters.end(); ++it) {
+        if (!setPluginParameter(plugin, it->first, it->second)) {
+            errorMessage = name + ": " + plugin->getLastError();
+            return false;
+        }
+    }
+    output = std::make_shared<DataModel>();
+    if (!plugin->processData(input, output)) {
+        errorMessage = name + ": " + plugin->getLastError();
+        return false;
+    }
+    return true;
+}
+
+static bool exportData(const std::string& pluginName, const std::shared_ptr<DataModel>& data,
+                       const std::string& filename, std::string& errorMessage) {
+    std::shared_ptr<ExportPlugin> exporter = std::dynamic_pointer_cast<ExportPlugin>(
+        PluginManager::getInstance().createPlugin(pluginName));
+    if (!exporter) {
+        errorMessage = "无法创建插件: " + pluginName;
+        return false;
+    }
+    if (!exporter->exportToFile(filename, data)) {
+        errorMessage = exporter->getLastError();
+        return false;
+    }
+    return true;
+}
+
+// 以最高速度回放预写日志，像界面一样批量取走新行，直到回放结束
+static bool replayLog(const std::string& filename, uint64_t expectedRows, std::string& errorMessage) {
+    ReplayDataSource source;
+    ReplayDataSource::ReplayConfig config;
+    config.speed = 0.0;
+    source.setConfig(config);
+    std::mutex mutex;
+    std::condition_variable dataReady;
+    source.setDataReadyCallback([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        dataReady.notify_all();
+    });
+    source.setErrorCallback([&errorMessage](const std::string& message) { errorMessage = message; });
+    source.initialize(filename);
+    if (!source.start()) {
+        return false;
+    }
+
+    std::vector<std::vector<double> > columns;
+    uint64_t rows = 0;
+    while (true) {
+        // 先读状态再取数据：读到已结束时，这次取走的就是最后一批
+        ReplayDataSource::ReplayStats stats = source.getStatistics();
+        rows += source.takePendingRows(columns);
+        if (stats.finished) {
+            rows += stats.droppedRows;
+            break;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        dataReady.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    source.stop();
+
+    if (rows != expectedRows) {
+        errorMessage = "回放行数不符: " + std::to_string(rows) + " / " + std::to_string(expectedRows);
+        return false;
+    }
+    return true;
+}
+
+// 经本机回环把预先编码的帧发给套接字数据源，直到全部解码进模型。
+// 数据报没有流控：在途帧超过窗口时等待接收端追上，测的是可持续的接收速率而不是丢包
+static bool ingestLoopback(SocketDataSource::Transport transport, const std::string& unixPath,
+                           const std::vector<std::string>& frames, uint64_t expectedRows,
+                           std::string& errorMessage) {
+    SocketDataSource source;
+    SocketDataSource::SocketConfig config;
+    config.transport = transport;
+    if (transport == SocketDataSource::Transport::Unix || transport == SocketDataSource::Transport::UnixDatagram) {
+        config.address = unixPath;
+    }
+    config.bufferSize = 0;
+    source.setConfig(config);
+    source.setErrorCallback([&errorMessage](const std::string& message) { errorMessage = message; });
+    if (!source.start()) {
+        return false;
+    }
+
+    LoopbackSender sender;
+    if (!sender.connect(transport, config.address, source.getBoundPort(), errorMessage)) {
+        return false;
+    }
+
+    const size_t chunkFrames = 256;
+    const uint64_t windowFrames = 4096;
+    std::vector<std::vector<double> > columns;
+    for (size_t first = 0; first < frames.size(); first += chunkFrames) {
+        size_t last = std::min(first + chunkFrames, frames.size());
+        if (!sender.send(frames, first, last, errorMessage)) {
+            return false;
+        }
+        while (sender.isDatagram()) {
+            SocketDataSource::SocketStats stats = source.getStatistics();
+            if (last - (stats.framesDecoded + stats.framesLost) <= windowFrames) {
+                break;
+            }
+            source.takePendingRows(columns);
+            std::this_thread::yield();
+        }
+    }
+    sender.close();
+
+    // 等待剩余的帧；一秒内没有进展视为超时
+    uint64_t lastRows = 0;
+    std::chrono::steady_clock::time_point lastProgress = std::chrono::steady_clock::now();
+    while (true) {
+        SocketDataSource::SocketStats stats = source.getStatistics();
+        source.takePendingRows(columns);
+        if (stats.rowsDecoded >= expectedRows) {
+            break;
+        }
+        if (stats.rowsDecoded != lastRows) {
+            lastRows = stats.rowsDecoded;
+            lastProgress = std::chrono::steady_clock::now();
+        } else if (std::chrono::steady_clock::now() - lastProgress > std::chrono::seconds(1)) {
+            errorMessage = "接收超时: " + std::to_string(stats.rowsDecoded) + " / " + std::to_string(expectedRows) +
+                           " 行, 丢失 " + std::to_string(stats.framesLost) + " 帧";
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    source.stop();
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    SyntheticData::Config dataConfig;
+    int iterations = 5;
+    std::string filter;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "未知选项或缺少参数: " << arg << std::endl;
+            return 2;
+        }
+
+        std::string value = argv[++i];
+        double number = 0.0;
+        bool valid = true;
+        if (arg == "--format") {
+            valid = SyntheticData::parseFormat(value, dataConfig.format);
+        } else if (arg == "--filter") {
+            filter = value;
+        } else if (arg == "--json") {
+            jsonPath = value;
+        } else if (parseNumber(value, number) && number >= 0.0) {
+            if (arg == "--rows") {
+                dataConfig.rows = static_cast<size_t>(number);
+            } else if (arg == "--columns") {
+                dataConfig.columns = static_cast<size_t>(number);
+            } else if (arg == "--precision") {
+                dataConfig.precision = static_cast<int>(number);
+            } else if (arg == "--noise") {
+                dataConfig.noise = number;
+            } else if (arg == "--malformed") {
+                valid = number <= 1.0;
+                dataConfig.malformedRatio = number;
+            } else if (arg == "--seed") {
+                dataConfig.seed = static_cast<uint64_t>(std::strtoull(value.c_str(), nullptr, 10));
+            } else if (arg == "--iterations") {
+                iterations = static_cast<int>(number);
+                valid = iterations > 0;
+            } else {
+                std::cerr << "未知选项: " << arg << std::endl;
+                return 2;
+            }
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            std::cerr << "无效的参数: " << arg << " " << value << std::endl;
+            return 2;
+        }
+    }
+
+    BenchHarness harness;
+    harness.setIterations(iterations);
+    harness.setFilter(filter);
+    harness.setContext("rows", std::to_string(dataConfig.rows));
+    harness.setContext("columns", std::to_string(dataConfig.columns));
+    harness.setContext("format", SyntheticData::formatName(dataConfig.format));
+    harness.setContext("precision", std::to_string(dataConfig.precision));
+    harness.setContext("noise", std::to_string(dataConfig.noise));
+    harness.setContext("malformed_ratio", std::to_string(dataConfig.malformedRatio));
+    harness.setContext("seed", std::to_string(dataConfig.seed));
+    harness.setContext("iterations", std::to_string(iterations));
+    harness.setContext("compiler", __VERSION__);
+#ifdef NDEBUG
+    harness.setContext("build", "release");
+#else
+    harness.setContext("build", "debug");
+#endif
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    harness.setContext("timestamp", timestamp);
+
+    // 准备数据：生成一次，所有基准共用
+    SyntheticData generator(dataConfig);
+    std::vector<std::string> lines = generator.generateLines();
+    std::vector<std::string> names = generator.fieldNames();
+    uint64_t lineBytes = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        lineBytes += lines[i].size() + 1;
+    }
+
+    std::string tempDirectory = FileUtils::getTempDirectory();
+    std::string inputFile = FileUtils::joinPath(tempDirectory, "dat_bench_input.csv");
+    std::string outputFile = FileUtils::joinPath(tempDirectory, "dat_bench_output.csv");
+    std::string errorMessage;
+    if (!generator.writeCsv(inputFile, errorMessage)) {
+        std::cerr << errorMessage << std::endl;
+        return 2;
+    }
+    FileUtils::FileInfo inputInfo;
+    FileUtils::getFileInfo(inputFile, inputInfo);
+
+    std::streambuf* stdoutBuffer = std::cout.rdbuf();
+    NullBuffer discarded;
+    std::cout.rdbuf(&discarded);
+
+    std::shared_ptr<DataModel> model = loadCsv(inputFile, errorMessage);
+    if (!model) {
+        std::cout.rdbuf(stdoutBuffer);
+        std::cerr << errorMessage << std::endl;
+        return 2;
+    }
+    BenchHarness::Workload modelWorkload;
+    modelWorkload.rows = model->size();
+    modelWorkload.bytes = model->size() * model->getFieldNames().size() * sizeof(double);
+
+    // ---- 微基准 ----
+
+    // 数值解析：CSV 数据源的字段解析函数
+    std::vector<std::string> fields = generator.generateFields(dataConfig.rows);
+    BenchHarness::Workload fieldWorkload;
+    fieldWorkload.rows = fields.size();
+    for (size_t i = 0; i < fields.size(); ++i) {
+        fieldWorkload.bytes += fields[i].size();
+    }
+    volatile double parseSink = 0.0;
+    harness.run("micro", "parse.number", fieldWorkload, [&](std::string& error) {
+        ParseArena& arena = ParseArena::forThread();
+        ParseArena::Scope scope(arena);
+        double sum = 0.0;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            const std::string& field = fields[i];
+            double value = 0.0;
+            if (!CSVDataSource::parseDouble(arena, field.data(), field.data() + field.size(), value)) {
+                error = "无法解析: " + field;
+                return false;
+            }
+            sum += value;
+        }
+        parseSink = sum;
+        return true;
+    });
+
+    // 分词 + 解析整行
+    BenchHarness::Workload lineWorkload;
+    lineWorkload.rows = lines.size();
+    lineWorkload.bytes = lineBytes;
+    harness.run("micro", "parse.tokenize", lineWorkload, [&](std::string&) {
+        DefaultDataParser parser;
+        parser.setConfig(std::string(1, dataConfig.delimiter));
+        std::vector<double> values;
+        size_t parsed = 0;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (parser.parseLine(lines[i], values)) {
+                parsed += values.size();
+            }
+        }
+        parseSink = static_cast<double>(parsed);
+        return true;
+    });
+
+    // DataModel 逐行追加：值预先展开为行主序数组
+    size_t fieldCount = names.size();
+    std::vector<double> rowValues(model->size() * fieldCount);
+    std::unique_ptr<bool[]> rowValid(new bool[rowValues.size()]);
+    for (size_t f = 0; f < fieldCount; ++f) {
+        for (size_t row = 0; row < model->size(); ++row) {
+            double value = model->getValue(names[f], row);
+            rowValues[row * fieldCount + f] = value;
+            rowValid[row * fieldCount + f] = value == value;
+        }
+    }
+    std::shared_ptr<DataModel> appendTarget;
+    harness.run("micro", "model.append", modelWorkload, [&](std::string&) {
+        for (size_t row = 0; row < model->size(); ++row) {
+            appendTarget->addDataPoint(names.data(), &rowValues[row * fieldCount], &rowValid[row * fieldCount],
+                                       fieldCount);
+        }
+        return true;
+    }, [&]() { appendTarget = std::make_shared<DataModel>(); });
+
+    // 各插件的处理核心，输入为已加载的模型
+    struct PluginCase {
+        const char* benchName;
+        const char* pluginName;
+        std::map<std::string, std::string> parameters;
+    };
+    std::vector<PluginCase> pluginCases;
+    pluginCases.push_back({"filter.moving_average", "MovingAverageFilter", {{"window_size", "16"}}});
+    pluginCases.push_back({"filter.low_pass", "LowPassFilter", {{"cutoff_frequency", "0.1"}, {"filter_order", "2"}}});
+    pluginCases.push_back({"interpolate.linear", "LinearInterpolationPlugin", {{"step_size", "0.0005"}}});
+    for (size_t i = 0; i < pluginCases.size(); ++i) {
+        const PluginCase& pluginCase = pluginCases[i];
+        harness.run("micro", pluginCase.benchName, modelWorkload, [&](std::string& error) {
+            std::shared_ptr<DataModel> output;
+            return runPlugin(pluginCase.pluginName, pluginCase.parameters, model, output, error);
+        });
+    }
+
+    // 各格式的导出：先导出一次得到输出大小
+    struct ExportCase {
+        std::string benchName;
+        std::string pluginName;
+        std::string filename;
+    };
+    std::vector<ExportCase> exportCases;
+    exportCases.push_back({"export.csv", "CSVExportPlugin", outputFile});
+    exportCases.push_back({"export.npz", "NpyExportPlugin", FileUtils::joinPath(tempDirectory, "dat_bench_output.npz")});
+    exportCases.push_back({"export.arrow", "ArrowExportPlugin", FileUtils::joinPath(tempDirectory, "dat_bench_output.arrow")});
+    for (size_t i = 0; i < exportCases.size(); ++i) {
+        const ExportCase& exportCase = exportCases[i];
+        BenchHarness::Workload exportWorkload;
+        exportWorkload.rows = model->size();
+        if (harness.shouldRun(exportCase.benchName) &&
+            exportData(exportCase.pluginName, model, exportCase.filename, errorMessage)) {
+            FileUtils::FileInfo outputInfo;
+            FileUtils::getFileInfo(exportCase.filename, outputInfo);
+            exportWorkload.bytes = outputInfo.size;
+        }
+        harness.run("micro", exportCase.benchName, exportWorkload, [&](std::string& error) {
+            return exportData(exportCase.pluginName, model, exportCase.filename, error);
+        });
+        if (exportCase.filename != outputFile) {
+            FileUtils::removeFile(exportCase.filename);
+        }
+    }
+
+    // 预写日志追加：不同步（只写系统缓存）与组提交两种策略
+    std::string walFile = FileUtils::joinPath(tempDirectory, "dat_bench_output.wal");
+    struct WalCase {
+        const char* benchName;
+        RecordingLogWriter::SyncPolicy syncPolicy;
+    };
+    std::vector<WalCase> walCases;
+    walCases.push_back({"wal.append", RecordingLogWriter::SyncPolicy::None});
+    walCases.push_back({"wal.append_group_commit", RecordingLogWriter::SyncPolicy::GroupCommit});
+    for (size_t i = 0; i < walCases.size(); ++i) {
+        const WalCase& walCase = walCases[i];
+        harness.run("micro", walCase.benchName, modelWorkload, [&](std::string& error) {
+            RecordingLogWriter writer;
+            RecordingLogWriter::Options options;
+            options.batchRows = 4096;
+            options.syncPolicy = walCase.syncPolicy;
+            if (!writer.open(walFile, names, options, error)) {
+                return false;
+            }
+            for (size_t row = 0; row < model->size(); ++row) {
+                if (!writer.appendRow(&rowValues[row * fieldCount])) {
+                    error = writer.getLastError();
+                    return false;
+                }
+            }
+            return writer.close();
+        }, [&]() { FileUtils::removeFile(walFile); });
+    }
+
+    // ---- 端到端 ----
+
+    BenchHarness::Workload fileWorkload;
+    fileWorkload.rows = lines.size();
+    fileWorkload.bytes = inputInfo.size;
+    harness.run("e2e", "e2e.csv_load", fileWorkload, [&](std::string& error) {
+        return loadCsv(inputFile, error) != nullptr;
+    });
+
+    // 逐行分配检查：同一份数据的前一半与全部分别经 CSVDataSource::start() 加载，
+    // 两次分配次数之差除以多出的行数即稳态下每行的分配次数。列存储按块分配，
+    // 每行摊到的分配远小于 1，超过上限说明解析路径又出现了逐行分配
+    const double maxAllocationsPerRow = 0.01;
+    std::string halfFile = FileUtils::joinPath(tempDirectory, "dat_bench_input_half.csv");
+    BenchHarness::Workload halfWorkload;
+    if (harness.shouldRun("e2e.csv_row_allocations")) {
+        std::string csv = generator.generateCsv();
+        size_t halfRows = lines.size() / 2;
+        size_t end = 0;
+        // 表头一行 + 前一半数据行
+        for (size_t i = 0; i <= halfRows && end != std::string::npos; ++i) {
+            end = csv.find('\n', end);
+            if (end != std::string::npos) {
+                end++;
+            }
+        }
+        std::ofstream half(halfFile.c_str(), std::ios::binary);
+        half.write(csv.data(), static_cast<std::streamsize>(end == std::string::npos ? csv.size() : end));
+        halfWorkload.rows = lines.size() - halfRows;
+        halfWorkload.bytes = inputInfo.size - static_cast<uint64_t>(end == std::string::npos ? csv.size() : end);
+    }
+    harness.run("e2e", "e2e.csv_row_allocations", halfWorkload, [&](std::string& error) {
+        uint64_t before = BenchHarness::allocationCount();
+        std::shared_ptr<DataModel> halfModel = loadCsv(halfFile, error);
+        uint64_t halfAllocations = BenchHarness::allocationCount() - before;
+        halfModel.reset();
+
+        before = BenchHarness::allocationCount();
+        std::shared_ptr<DataModel> fullModel = loadCsv(inputFile, error);
+        uint64_t fullAllocations = BenchHarness::allocationCount() - before;
+        if (!fullModel) {
+            return false;
+        }
+        if (halfWorkload.rows == 0) {
+            error = "数据行数不足";
+            return false;
+        }
+
+        double perRow = (static_cast<double>(fullAllocations) - static_cast<double>(halfAllocations)) /
+                        static_cast<double>(halfWorkload.rows);
+        if (perRow > maxAllocationsPerRow) {
+            error = "CSV 加载每行分配 " + std::to_string(perRow) + " 次，上限 " +
+                    std::to_string(maxAllocationsPerRow);
+            return false;
+        }
+        return true;
+    });
+    FileUtils::removeFile(halfFile);
+
+    harness.run("e2e", "e2e.load_filter_export", fileWorkload, [&](std::string& error) {
+        std::shared_ptr<DataModel> loaded = loadCsv(inputFile, error);
+        std::shared_ptr<DataModel> filtered;
+        return loaded && runPlugin("MovingAverageFilter", {{"window_size", "16"}}, loaded, filtered, error) &&
+               exportData("CSVExportPlugin", filtered, outputFile, error);
+    });
+
+    // 预写日志以最高速度回放：回放线程追加并发布模型，消费端批量取走，可重复的整条链路负载
+    BenchHarness::Workload replayWorkload;
+    replayWorkload.rows = model->size();
+    if (harness.shouldRun("e2e.wal_replay")) {
+        FileUtils::removeFile(walFile);
+        RecordingLogWriter writer;
+        RecordingLogWriter::Options options;
+        options.batchRows = 4096;
+        options.syncPolicy = RecordingLogWriter::SyncPolicy::None;
+        if (writer.open(walFile, names, options, errorMessage)) {
+            for (size_t row = 0; row < model->size(); ++row) {
+                writer.appendRow(&rowValues[row * fieldCount]);
+            }
+            writer.close();
+        }
+        FileUtils::FileInfo walInfo;
+        FileUtils::getFileInfo(walFile, walInfo);
+        replayWorkload.bytes = walInfo.size;
+    }
+    harness.run("e2e", "e2e.wal_replay", replayWorkload, [&](std::string& error) {
+        return replayLog(walFile, replayWorkload.rows, error);
+    });
+
+    // 套接字接收：每行编码为一个二进制帧，经本机回环发送，接收端解码后写入模型
+    std::vector<std::string> socketFrames(model->size());
+    BenchHarness::Workload socketWorkload;
+    socketWorkload.rows = model->size();
+    for (size_t row = 0; row < model->size(); ++row) {
+        SocketDataSource::encodeFrame(static_cast<uint32_t>(row), &rowValues[row * fieldCount], 1, fieldCount,
+                                      socketFrames[row]);
+        socketWorkload.bytes += socketFrames[row].size();
+    }
+    std::string socketPath = FileUtils::joinPath(tempDirectory, "dat_bench_ingest.sock");
+    struct SocketCase {
+        const char* benchName;
+        SocketDataSource::Transport transport;
+    };
+    std::vector<SocketCase> socketCases;
+    socketCases.push_back({"e2e.socket_udp", SocketDataSource::Transport::Udp});
+    socketCases.push_back({"e2e.socket_tcp", SocketDataSource::Transport::Tcp});
+    socketCases.push_back({"e2e.socket_unix", SocketDataSource::Transport::Unix});
+    for (size_t i = 0; i < socketCases.size(); ++i) {
+        const SocketCase& socketCase = socketCases[i];
+        harness.run("e2e", socketCase.benchName, socketWorkload, [&](std::string& error) {
+            return ingestLoopback(socketCase.transport, socketPath, socketFrames, socketWorkload.rows, error);
+        });
+    }
+
+    std::cout.rdbuf(stdoutBuffer);
+    FileUtils::removeFile(walFile);
+    FileUtils::removeFile(inputFile);
+    FileUtils::removeFile(outputFile);
+
+    harness.printTable(std::cout);
+    if (!jsonPath.empty()) {
+        if (!harness.writeJson(jsonPath, errorMessage)) {
+            std::cerr << errorMessage << std::endl;
+            return 1;
+        }
+        std::cout << "结果已写入 " << jsonPath << std::endl;
+    }
+
+    return harness.failureCount() == 0 ? 0 : 1;
+}
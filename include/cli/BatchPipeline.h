@@ -0,0 +1,66 @@
+#ifndef BATCHPIPELINE_H
+#define BATCHPIPELINE_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+ * @brief 批处理流水线描述：数据源、插件链和导出方式
+ *
+ * 从 key = value 文本加载，格式与应用配置文件相同（# 或 ; 开头的行为注释）：
+ *
+ *     source/type = csv                           # csv / custom / snapshot
+ *     source/delimiter = ,                        # \t 表示制表符
+ *     source/has_header = true
+ *     source/skip_lines = 0
+ *     source/parse_cache = false
+ *     pipeline/plugins = MovingAverageFilter, LinearInterpolationPlugin
+ *     plugin/MovingAverageFilter/window_size = 5
+ *     export/plugin = CSVExportPlugin             # 为空时只处理不导出
+ *     export/directory = out
+ *     export/suffix = .csv
+ *     export/param/delimiter = ;
+ *     run/workers = 4                             # 0 表示按CPU核数
+ *     report/json = report.json
+ *
+ * 插件按 PluginManager 中注册的工厂名称查找，参数值以字符串交给插件的 setParameter。
+ */
+struct BatchPipeline {
+    struct PluginStep {
+        std::string name;
+        std::map<std::string, std::string> parameters;
+    };
+
+    // 数据源
+    std::string sourceType = "csv";
+    char delimiter = ',';
+    bool hasHeader = true;
+    int skipLines = 0;
+    bool useParseCache = false;     // 批量处理的文件通常只读一次，默认不写解析缓存
+
+    // 按顺序执行的插件链
+    std::vector<PluginStep> plugins;
+
+    // 导出
+    std::string exportPlugin;
+    std::map<std::string, std::string> exportParameters;
+    std::string outputDirectory = ".";
+    std::string outputSuffix = ".csv";
+
+    // 运行
+    int workers = 0;
+    std::string reportPath;
+
+    bool loadFromFile(const std::string& filename, std::string& errorMessage);
+    bool loadFromString(const std::string& text, std::string& errorMessage);
+    // 检查数据源类型和插件名称是否可用
+    bool validate(std::string& errorMessage) const;
+
+    // 输入文件对应的导出文件路径：导出目录 + 去掉扩展名的文件名 + 后缀
+    std::string outputPathFor(const std::string& inputPath) const;
+    // 目录输入时按数据源类型筛选的扩展名，为空表示不筛选
+    std::string inputExtension() const;
+};
+
+#endif // BATCHPIPELINE_H
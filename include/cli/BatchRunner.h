@@ -0,0 +1,85 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "cli/BatchPipeline.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <cstdint>
+
+class DataModel;
+class DataSource;
+
+/**
+ * @brief 按流水线批量处理文件
+ *
+ * 固定数量的工作线程依次领取下一个文件，完整执行 加载 → 插件链 → 导出 后再领取下一个，
+ * 同时驻留内存的数据最多为工作线程数个文件。每个文件使用各自新建的数据源和插件实例，
+ * 文件之间没有共享状态；单个文件失败只记入结果，不影响其他文件。
+ */
+class BatchRunner {
+public:
+    struct FileResult {
+        std::string inputPath;
+        std::string outputPath;
+        bool success = false;
+        std::string errorMessage;
+        uint64_t inputBytes = 0;
+        size_t rows = 0;            // 加载的行数
+        size_t outputRows = 0;      // 插件链处理后的行数
+        size_t fieldCount = 0;
+        double loadMs = 0.0;
+        double processMs = 0.0;
+        double exportMs = 0.0;
+        double totalMs = 0.0;
+    };
+
+    struct Summary {
+        size_t files = 0;
+        size_t succeeded = 0;
+        size_t failed = 0;
+        uint64_t inputBytes = 0;
+        size_t rows = 0;
+        double wallMs = 0.0;        // 整批耗时
+        double busyMs = 0.0;        // 各文件处理耗时之和
+        int workers = 0;
+    };
+
+    explicit BatchRunner(const BatchPipeline& pipeline);
+
+    // 每个文件完成时调用（在工作线程中，调用之间已串行化）；completed 为已完成的文件数
+    void setFileCallback(std::function<void(const FileResult&, size_t completed, size_t total)> callback);
+    // 停止领取新文件，已开始的文件处理完后 run() 返回
+    void requestCancel() { m_cancelRequested.store(true); }
+
+    Summary run(const std::vector<std::string>& files);
+    const std::vector<FileResult>& getResults() const { return m_results; }
+
+    // 实际并行处理的文件数：配置为0时按共享线程池的线程数，且不超过文件数
+    static int resolveWorkerCount(int configured, size_t fileCount);
+
+    static void writeJsonReport(std::ostream& out, const BatchPipeline& pipeline, const Summary& summary,
+                                const std::vector<FileResult>& results);
+    static bool writeJsonReport(const std::string& filename, const BatchPipeline& pipeline,
+                                const Summary& summary, const std::vector<FileResult>& results,
+                                std::string& errorMessage);
+
+private:
+    FileResult processFile(const std::string& path) const;
+    std::shared_ptr<DataSource> createSource(const std::string& path) const;
+    bool runPlugins(std::shared_ptr<DataModel>& data, std::string& errorMessage) const;
+    bool exportData(const std::shared_ptr<DataModel>& data, const std::string& outputPath,
+                    std::string& errorMessage) const;
+
+    BatchPipeline m_pipeline;
+    std::vector<FileResult> m_results;
+    std::function<void(const FileResult&, size_t, size_t)> m_fileCallback;
+    std::atomic<bool> m_cancelRequested;
+    std::mutex m_callbackMutex;
+};
+
+#endif // BATCHRUNNER_H
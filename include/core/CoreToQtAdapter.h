@@ -5,7 +5,11 @@
 #include <QString>
 #include <QVector>
 #include <QMap>
+#include <QElapsedTimer>
+#include <QSharedPointer>
 #include <memory>
+#include <atomic>
+#include <vector>
 
 // 前向声明纯C++类
 class DataSource;
@@ -13,6 +17,10 @@ class DataModel;
 class DataSourceFactory;
 class PluginManager;
 class PluginInterface;
+class StreamingExporter;
+class RecordingLogWriter;
+class QTimer;
+class QThread;
 
 /**
  * @brief 核心层到QT层的适配器类
@@ -33,8 +41,17 @@ public:
     // === 数据源管理 ===
     bool loadCSVFile(const QString& filename);
     bool loadCustomData(const QString& filename, const QMap<QString, QVariant>& config);
+    bool loadSnapshotFile(const QString& filename);
+    bool saveSnapshot(const QString& filename);
+    // config 含 transport（udp/tcp/unix/unixgram）时从本机套接字接收数据，否则生成波形
     bool startRealTimeData(const QMap<QString, QVariant>& config);
     void stopRealTimeData();
+    // 回放预写日志，与实时数据一样按帧投递；speed 为 0 时尽快回放。用 stopRealTimeData() 停止
+    bool startReplay(const QString& filename, double speed = 1.0);
+    
+    // 文件加载在工作线程中进行，可随时取消
+    void cancelLoading();
+    bool isLoading() const { return m_loadThread != nullptr; }
     
     // === 插件管理 ===
     bool loadPlugin(const QString& pluginPath);
@@ -47,12 +64,27 @@ public:
     QVector<QPair<double, double>> getDataPairs(const QString& xField, const QString& yField) const;
     QVariantMap getDataPoint(int index) const;
     QStringList getFieldNames() const;
+    // 已加载的数据模型，供绘图控件降采样使用；与适配器共享所有权，之后替换数据源不影响已取得的模型。
+    // 实时数据的模型由采集线程写入，不应交给绘图控件，实时数据通过 realTimeBatchReady 投递
+    QSharedPointer<DataModel> getDataModel() const;
     
     // === 数据操作 ===
     bool saveDataToFile(const QString& filename);
     bool exportData(const QString& filename, const QString& format);
     void clearData();
     
+    // === 实时数据录制 ===
+    // 把流式数据源（实时、回放、网络）每帧取走的新行按批写入 directory 下的文件，字段取自数据源，
+    // 文件按配置的大小/时长轮转；exportPlugin 为支持增量导出的导出插件名。
+    // 与界面显示共用按帧取走的数据，显示端来不及取走而丢弃的行同样不会录制。停止实时数据时自动停止录制
+    bool startRecording(const QString& directory, const QString& exportPlugin = "CSVExportPlugin");
+    void stopRecording();
+    bool isRecording() const { return m_recorder != nullptr; }
+    // 队列积压、写出吞吐量、丢弃行数等
+    QVariantMap getRecordingStats() const;
+    // 启用 recording/wal_enabled 时，实时数据同时写入的预写日志路径，未写入时为空
+    QString getWriteAheadLogPath() const;
+    
     // === 配置管理 ===
     void setDataSourceConfig(const QMap<QString, QVariant>& config);
     void setPluginConfig(const QString& pluginName, const QMap<QString, QVariant>& config);
@@ -62,6 +94,8 @@ public:
     bool hasData() const;
     int getDataPointCount() const;
     QString getCurrentDataSourceType() const;
+    QVariantMap getParseCacheStats() const;
+    quint64 getDroppedSampleCount() const { return m_droppedSamples; }
 
 public slots:
     // === 数据源控制 ===
@@ -69,6 +103,7 @@ public slots:
     void onStartRealTimeRequested(const QMap<QString, QVariant>& config);
     void onStopRealTimeRequested();
     void onClearDataRequested();
+    void onCancelLoadRequested();
     
     // === 数据处理 ===
     void onApplyFilterRequested(const QString& filterType, const QMap<QString, QVariant>& parameters);
@@ -83,11 +118,20 @@ signals:
     // === 数据状态信号 ===
     void dataLoaded(bool success, const QString& message);
     void dataLoadProgress(int progress, const QString& status);
+    // 加载吞吐量（在加载线程中发出，跨线程连接自动排队）
+    void dataLoadThroughput(qint64 bytesRead, qint64 totalBytes,
+                            double megabytesPerSecond, double etaSeconds);
     void dataCleared();
     
     // === 数据更新信号 ===
+    // 当前模型整体变化（加载完成、插件处理后），消费端应重新读取 getDataModel()
     void dataUpdated();
-    void realTimeDataPointAdded(const QVariantMap& dataPoint);
+    // 每帧一次：自上一帧以来的全部新样本，按字段存放在连续缓冲中。
+    // 实时、回放与套接字数据只通过此信号投递，不再伴随 dataUpdated
+    void realTimeBatchReady(const QString& xField, const QVector<double>& xData,
+                            const QMap<QString, QVector<double>>& seriesData);
+    // 消费端跟不上时被丢弃的样本累计数
+    void realTimeSamplesDropped(quint64 droppedSamples);
     void dataProcessed(const QString& operation, bool success);
     
     // === 错误信号 ===
@@ -107,16 +151,36 @@ private slots:
     void handleCoreDataReady();
     void handleCoreError(const std::string& errorMessage);
     void handleCoreRealTimeData(double value);
+    void onRealTimeTick();
 
 private:
     // 初始化方法
     void initializeCoreComponents();
     void setupConnections();
     
+    // 异步加载：所有文件类数据源共用
+    bool startAsyncLoad(std::shared_ptr<DataSource> source, const QString& filename,
+                        const QString& sourceType);
+    void reportLoadProgress(size_t bytesRead, size_t totalBytes);
+    
+    // 预写日志：按配置为实时数据源打开，停止实时数据时关闭
+    std::shared_ptr<RecordingLogWriter> openWriteAheadLog();
+    void closeWriteAheadLog();
+    // 回放数据源的按帧投递，回放结束后停止定时器
+    void deliverReplayBatch();
+    void deliverSocketBatch();
+    // 按字段取走的一批行（m_batchColumns）作为 realTimeBatchReady 发出，录制中时同时提交给录制器
+    void emitColumnBatch(const std::vector<std::string>& fieldNames);
+    void recordColumnBatch(const std::vector<std::string>& fieldNames);
+    void finishAsyncLoad(std::shared_ptr<DataSource> source, bool success,
+                         const QString& filename, const QString& sourceType);
+    
     // 数据转换方法
     QVector<double> convertToQVector(const std::vector<double>& vec) const;
     QVariantMap convertDataPointToVariantMap(const std::map<std::string, double>& point) const;
     QVariantMap convertStatisticsToVariantMap() const;
+    // 供读取的当前数据：实时数据为最近发布的快照
+    std::shared_ptr<const DataModel> currentData() const;
     
     // 工具方法
     std::string qstringToString(const QString& qstr) const;
@@ -133,6 +197,23 @@ private:
     QString m_currentDataSourceType;
     bool m_isRealTimeRunning;
     
+    // 实时数据批量投递：生成线程只置位标志，按帧定时取走新样本
+    QTimer* m_realTimeTimer;
+    std::atomic<bool> m_realTimePending;
+    // 按字段取走的新行，各数据源共用
+    std::vector<std::vector<double> > m_batchColumns;
+    quint64 m_droppedSamples;
+    
+    // 实时数据录制：界面线程按帧提交批次，录制器的写线程写文件
+    std::shared_ptr<StreamingExporter> m_recorder;
+    std::shared_ptr<RecordingLogWriter> m_writeAheadLog;
+    
+    // 异步加载状态：完成后才替换当前数据源和数据模型
+    QThread* m_loadThread;
+    std::shared_ptr<DataSource> m_loadingSource;
+    QElapsedTimer m_loadClock;
+    std::atomic<qint64> m_lastProgressMs;
+    
     // 配置管理
     QMap<QString, QVariant> m_dataSourceConfig;
     QMap<QString, QMap<QString, QVariant>> m_pluginConfigs;
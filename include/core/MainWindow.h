@@ -21,7 +21,8 @@ private slots:
     void onOpenFile();
     void onSaveImage();
     void onPluginSelected();
-    void onDataReady();
+    void onDataLoaded(bool success, const QString& message);
+    void onDataCleared();
     void onErrorOccurred(const QString& error);
 
 private:
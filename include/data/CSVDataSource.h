@@ -3,6 +3,7 @@
 
 #include "DataSource.h"
 #include "DataModel.h"
+#include "ParseArena.h"
 #include <string>
 #include <memory>
 
@@ -23,9 +24,14 @@ public:
     void setDelimiter(char delimiter) { m_delimiter = delimiter; }
     void setHasHeader(bool hasHeader) { m_hasHeader = hasHeader; }
     void setSkipLines(int skipLines) { m_skipLines = skipLines; }
+    // 是否使用解析缓存（ParseCache），默认启用
+    void setUseParseCache(bool useCache) { m_useParseCache = useCache; }
+    // 指定列的物理类型（按表头名），未指定的列在启用推断时取能精确表示的最窄类型
+    void setColumnTypes(const DataModel::Schema& columnTypes) { m_columnTypes = columnTypes; }
+    void setInferColumnTypes(bool infer) { m_inferColumnTypes = infer; }
     
     // 数据访问
-    std::shared_ptr<DataModel> getDataModel() const { return m_dataModel; }
+    std::shared_ptr<DataModel> getDataModel() const override { return m_dataModel; }
     const std::vector<std::string>& getHeaders() const { return m_headers; }
     
     // 数据验证和统计
@@ -34,23 +40,36 @@ public:
         int totalLines;
         int validLines;
         int skippedLines;
+        size_t nullValues;          // 记为空值的字段数
+        bool fromCache;             // 结果来自解析缓存
         std::string errorMessage;
         
-        ParseResult() : success(false), totalLines(0), validLines(0), skippedLines(0) {}
+        ParseResult() : success(false), totalLines(0), validLines(0), skippedLines(0), nullValues(0), fromCache(false) {}
     };
     
     ParseResult getParseResult() const { return m_parseResult; }
+    
+    // 解析一个字段 [begin, end)：去除首尾空白后整个字段须是 double 范围内的数值。
+    // 需要 '\0' 结尾的副本放在 arena 中；失败（空字段、无法解析或超出范围）时返回 false
+    static bool parseDouble(ParseArena& arena, const char* begin, const char* end, double& value);
 
 private:
-    bool parseLine(const std::string& line, std::vector<double>& values);
-    bool parseDouble(const std::string& str, double& value);
+    // 解析一行 [begin, end)，values/validMask 分配在 arena 中，count 为字段数。
+    // 只读取解析设置，可在多个线程中同时调用
+    bool parseLine(const char* begin, const char* end, ParseArena& arena,
+                   double*& values, bool*& validMask, size_t& count) const;
     void detectDelimiter(const std::string& firstLine);
     void extractHeaders(const std::string& headerLine);
+    std::string parseSettingsKey() const;
+    bool loadFromCache(const std::string& cacheKey);
     
     std::string m_filename;
     char m_delimiter;
     bool m_hasHeader;
     int m_skipLines;
+    bool m_useParseCache;
+    bool m_inferColumnTypes;
+    DataModel::Schema m_columnTypes;
     std::shared_ptr<DataModel> m_dataModel;
     State m_state;
     
@@ -0,0 +1,52 @@
+#ifndef CHUNKPOOL_H
+#define CHUNKPOOL_H
+
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+/**
+ * @brief 列存储数据块的池化分配器
+ *
+ * 所有块大小相同（CHUNK_VALUES 个 double），释放的块放回空闲链表供下一次追加复用，
+ * 持续采集时不再反复向系统申请/归还大块内存。空闲块超过上限的部分直接释放。
+ *
+ * 线程安全：可在多个线程中同时申请和释放。
+ */
+class ChunkPool {
+public:
+    static const size_t CHUNK_VALUES = 65536;
+    
+    struct Stats {
+        size_t allocated;   // 当前由池分配且未归还系统的块数（含空闲块）
+        size_t cached;      // 空闲链表中的块数
+        size_t acquires;
+        size_t reuses;      // 从空闲链表取得的次数
+        
+        Stats() : allocated(0), cached(0), acquires(0), reuses(0) {}
+    };
+    
+    static ChunkPool& getInstance();
+    
+    double* acquire();
+    void release(double* chunk);
+    
+    // 空闲链表上限（块数），默认 64 块（32 MB）
+    void setMaxCachedChunks(size_t count);
+    size_t getMaxCachedChunks() const;
+    // 释放全部空闲块
+    void trim();
+    Stats getStats() const;
+
+private:
+    ChunkPool();
+    ChunkPool(const ChunkPool&);
+    ChunkPool& operator=(const ChunkPool&);
+    
+    mutable std::mutex m_mutex;
+    std::vector<double*> m_freeChunks;
+    size_t m_maxCached;
+    Stats m_stats;
+};
+
+#endif // CHUNKPOOL_H
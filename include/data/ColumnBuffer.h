@@ -0,0 +1,131 @@
+#ifndef COLUMNBUFFER_H
+#define COLUMNBUFFER_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <atomic>
+
+/**
+ * @brief 引用计数、分块存储的 double 列缓冲区视图
+ *
+ * 数据保存在定长块中（CHUNK_SIZE 个值，由 ChunkPool 分配），块指针记录在块目录里。
+ * 追加只会填充尾块或新增一块，不会整体重新分配和搬移已有数据，追加延迟平稳；
+ * 不足一块的小列首块按需倍增，避免每列至少占用一整块。
+ * 也可以接管一个 std::vector 或引用由持有者保活的外部内存（如映射文件），
+ * 此时按块大小切分为只读块，不复制数据。
+ *
+ * 多个视图共享同一目录和数据块，复制视图和 slice() 均为 O(1)。
+ * 位于写入尾部的视图可以直接在共享存储上追加：每个视图只读取自身长度内的元素，
+ * 新元素对已有视图不可见，因此写入方可与持有旧视图的读取线程并发而无需加锁。
+ * 其他修改按块写时复制，其他视图看到的数据不变。
+ *
+ * 数据不保证整体连续：顺序处理用 forEachSpan/spanAt 按连续片段访问，
+ * 需要整段指针时用 contiguousData。
+ */
+class ColumnBuffer {
+public:
+    typedef std::vector<double> Storage;
+
+    static const size_t CHUNK_SHIFT = 16;
+    static const size_t CHUNK_SIZE = static_cast<size_t>(1) << CHUNK_SHIFT;
+
+    ColumnBuffer();
+    // 接管数组，不复制
+    explicit ColumnBuffer(Storage values);
+    ColumnBuffer(const double* data, size_t count);
+    // 引用外部内存，owner 保证 data 在所有视图释放前有效
+    ColumnBuffer(const std::shared_ptr<const void>& owner, const double* data, size_t count);
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    double operator[](size_t index) const {
+        size_t position = m_offset + index;
+        return m_directory->chunks[position >> CHUNK_SHIFT]->values[position & (CHUNK_SIZE - 1)];
+    }
+
+    // === 按连续片段访问 ===
+    // 从 index 开始、到所在块末尾（不超过视图末尾）的连续片段，返回片段长度
+    size_t spanAt(size_t index, const double*& values) const;
+    // 按连续片段遍历 [startIndex, endIndex)：visitor(片段起始下标, values, count)
+    template <typename Visitor>
+    void forEachSpan(size_t startIndex, size_t endIndex, Visitor visitor) const {
+        if (endIndex > m_size) {
+            endIndex = m_size;
+        }
+        while (startIndex < endIndex) {
+            const double* values = nullptr;
+            size_t count = spanAt(startIndex, values);
+            if (count > endIndex - startIndex) {
+                count = endIndex - startIndex;
+            }
+            visitor(startIndex, values, count);
+            startIndex += count;
+        }
+    }
+    void copyTo(size_t startIndex, size_t count, double* output) const;
+    // 视图整体位于一段连续内存（单个块、接管的数组或映射文件）时返回其首指针，否则返回 nullptr
+    const double* contiguousData() const;
+    // 同上，不连续时复制到 scratch 并返回 scratch 的数据
+    const double* contiguousData(Storage& scratch) const;
+
+    // [startIndex, endIndex) 的子视图，与本视图共享存储
+    ColumnBuffer slice(size_t startIndex, size_t endIndex) const;
+    // 丢弃前 count 个元素，只移动视图起点
+    void dropFront(size_t count);
+
+    // 视图恰好覆盖整个接管的数组时返回该数组（只读，不会再变化），否则返回 nullptr
+    const Storage* storage() const;
+    // 块目录是否还被其他视图引用
+    bool isShared() const;
+
+    void push_back(double value);
+    // 预留块目录槽位，之后追加到 count 个元素都不必重建目录
+    void reserve(size_t count);
+    // 从 index 开始的可写连续片段，返回片段长度；必要时先复制目录和该块（按块写时复制）
+    size_t mutableSpanAt(size_t index, double*& values);
+    void clear();
+
+    // 视图涉及的数据块字节数（共享的块按全量计）
+    size_t memoryBytes() const;
+
+private:
+    struct Chunk {
+        double* values;
+        size_t capacity;
+        std::shared_ptr<const void> owner;     // 外部内存的持有者；非空时块只读
+
+        Chunk(double* data, size_t count) : values(data), capacity(count) {}
+        ~Chunk();
+        bool writable() const { return !owner; }
+    };
+
+    struct Directory {
+        // 创建时定长，之后只由写入尾部的视图填充空槽，读取方不会看到正在写的槽
+        std::vector<std::shared_ptr<Chunk> > chunks;
+        // 已被视图占用的元素数；最高位为1表示尾块已移交给其他目录，不再允许在此追加
+        std::atomic<size_t> length;
+        std::shared_ptr<const Storage> source;  // 接管的数组
+        const double* base;                     // 只读块在内存中连续时的首地址
+        size_t baseSize;
+
+        Directory(size_t slots, size_t count)
+            : chunks(slots), length(count), base(nullptr), baseSize(0) {}
+    };
+
+    static const size_t TAIL_LOCKED = ~(~static_cast<size_t>(0) >> 1);
+
+    // 由连续只读内存建立目录
+    void adopt(const std::shared_ptr<const void>& owner, const double* data, size_t count);
+    static std::shared_ptr<Chunk> allocateChunk(size_t capacity);
+    // 占用尾部下一个位置；需要新块时分配并填入空槽
+    bool claimTail();
+    // 为本视图建立独占的新目录，保留至少 extraCapacity 个追加位置
+    void rebuild(size_t extraCapacity);
+
+    std::shared_ptr<Directory> m_directory;
+    size_t m_offset;
+    size_t m_size;
+};
+
+#endif // COLUMNBUFFER_H
@@ -4,6 +4,7 @@
 #include "DataSource.h"
 #include "DataModel.h"
 #include "DataParser.h"
+#include "ParseArena.h"
 #include <string>
 #include <memory>
 #include <vector>
@@ -64,7 +65,7 @@ public:
     void setCustomParser(std::unique_ptr<DataParser> parser);
     
     // 数据访问
-    std::shared_ptr<DataModel> getDataModel() const { return m_dataModel; }
+    std::shared_ptr<DataModel> getDataModel() const override { return m_dataModel; }
     
     // 批量数据操作
     bool appendData(const std::vector<std::vector<double>>& newData);
@@ -75,14 +76,20 @@ public:
         size_t totalPoints;
         size_t validPoints;
         size_t skippedPoints;
+        size_t nullValues;      // 缺失或未通过验证、记为空值的字段数
         std::map<std::string, std::pair<double, double>> ranges; // 各字段范围
     };
     
     DataStats getStatistics() const;
 
 private:
-    bool parseLine(const std::string& line, std::vector<double>& values);
-    bool validateValue(double value, const ParseConfig::ValidationRule& rule);
+    // 解析一行 [begin, end)，values/validMask 分配在 arena 中，validMask 为空表示全部有效。
+    // 默认解析只读取配置，可在多个线程中同时调用；使用自定义解析器时只能在一个线程中调用
+    bool parseLine(const char* begin, const char* end, ParseArena& arena,
+                   const double*& values, const bool*& validMask, size_t& count);
+    // 列号对应的字段名（列映射或默认名），按需扩展 names
+    void resolveFieldNames(std::vector<std::string>& names, size_t count) const;
+    bool validateValue(double value, const ParseConfig::ValidationRule& rule) const;
     void updateDataReady();
     
     std::string m_sourcePath;
@@ -92,6 +99,8 @@ private:
     bool m_hasNewData;
     
     std::unique_ptr<DataParser> m_customParser;
+    std::vector<double> m_parserValues;     // 自定义解析器的输出，跨行复用
+    std::string m_lineText;                 // 交给自定义解析器的一行文本，跨行复用
     DataStats m_stats;
 };
 
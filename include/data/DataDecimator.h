@@ -0,0 +1,81 @@
+#ifndef DATADECIMATOR_H
+#define DATADECIMATOR_H
+
+#include <vector>
+#include <cstddef>
+#include "ColumnBuffer.h"
+
+class LodPyramid;
+
+/**
+ * @brief 绘图降采样器
+ *
+ * 将可见区间内的数据压缩到与屏幕像素数相当的点数：
+ * - MinMax：每个像素桶保留最小值和最大值，保证峰值不丢失
+ * - LTTB：Largest-Triangle-Three-Buckets，保留视觉形状
+ *
+ * 纯C++实现，可在任意线程调用
+ */
+class DataDecimator {
+public:
+    enum class Mode {
+        None,       // 不降采样
+        MinMax,     // 最小/最大值包络
+        LTTB        // 最大三角形三桶算法
+    };
+
+    /**
+     * @brief 对 [startIndex, endIndex) 区间降采样
+     *
+     * @param x x数据（要求单调递增）
+     * @param y y数据
+     * @param maxPoints 输出点数上限
+     * @param outX 输出x
+     * @param outY 输出y
+     */
+    static void decimate(const double* x, const double* y,
+                         size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                         std::vector<double>& outX, std::vector<double>& outY);
+    // 直接读取分块存储的列视图
+    static void decimate(const ColumnBuffer& x, const ColumnBuffer& y,
+                         size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                         std::vector<double>& outX, std::vector<double>& outY);
+
+    static void minMaxDecimate(const double* x, const double* y,
+                               size_t startIndex, size_t endIndex, size_t maxPoints,
+                               std::vector<double>& outX, std::vector<double>& outY);
+
+    static void lttbDecimate(const double* x, const double* y,
+                             size_t startIndex, size_t endIndex, size_t maxPoints,
+                             std::vector<double>& outX, std::vector<double>& outY);
+
+    /**
+     * @brief 基于LOD金字塔降采样
+     *
+     * 根据可见点数和输出上限选择 y 列金字塔的层，只读取 O(maxPoints) 个节点，
+     * 节点的 x 取原始 x 列中该桶首末点的中点；区间两端不足一个桶的部分从原始数据读取。
+     */
+    static void decimateLod(const double* x, const double* y,
+                            size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                            const LodPyramid& yLod,
+                            std::vector<double>& outX, std::vector<double>& outY);
+    static void decimateLod(const ColumnBuffer& x, const ColumnBuffer& y,
+                            size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                            const LodPyramid& yLod,
+                            std::vector<double>& outX, std::vector<double>& outY);
+
+    /**
+     * @brief 计算可见x范围对应的索引区间（两侧各多保留一个点，保证曲线连到边缘）
+     */
+    static void visibleRange(const double* x, size_t count, double xMin, double xMax,
+                             size_t& startIndex, size_t& endIndex);
+    static void visibleRange(const ColumnBuffer& x, double xMin, double xMax,
+                             size_t& startIndex, size_t& endIndex);
+
+    /**
+     * @brief 每像素两个点的输出上限
+     */
+    static size_t pointsForPixels(int pixelWidth);
+};
+
+#endif // DATADECIMATOR_H
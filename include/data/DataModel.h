@@ -4,6 +4,14 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <set>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include "ColumnBuffer.h"
+#include "EncodedColumn.h"
+#include "TypedColumn.h"
 
 class DataModel {
 public:
@@ -26,6 +34,21 @@ public:
         MetadataValue(bool val) : type(BOOL), boolValue(val), intValue(0), doubleValue(0.0) {}
     };
     
+    // 分块摘要（Zone Map），每 ZONE_BLOCK_SIZE 行记录一次 min/max/count/sum
+    struct ZoneBlock {
+        double minValue;
+        double maxValue;
+        double sum;
+        size_t count;   // 块内有效值（非NaN）数量
+        
+        ZoneBlock() : minValue(0.0), maxValue(0.0), sum(0.0), count(0) {}
+    };
+    
+    static const size_t ZONE_BLOCK_SIZE = 4096;
+    
+    // 字段名 -> 物理类型；未列出的字段按 Float64 存储
+    typedef std::map<std::string, ColumnType> Schema;
+    
     DataModel();
     
     // === 字段管理 ===
@@ -38,21 +61,61 @@ public:
     void clear();
     void clearField(const std::string& fieldName);
     
-    // 添加单点数据
+    // 添加单点数据（一行）。nullFields 中的字段在该行记为空值；
+    // 本行未出现的已有字段同样补空值，新字段在之前各行上为空值，保证各列按行对齐
     void addDataPoint(const std::map<std::string, double>& pointData);
+    void addDataPoint(const std::map<std::string, double>& pointData,
+                      const std::vector<std::string>& nullFields);
+    // 按列位置添加一行：fieldNames[i] 的值为 values[i]，valid 非空且 valid[i] 为 false 时记为空值。
+    // 不构造临时 map，供解析器逐行调用；同一行中重复的字段名只取第一个
+    void addDataPoint(const std::string* fieldNames, const double* values, const bool* valid,
+                      size_t count);
     
     // 批量添加数据
     void addDataSeries(const std::string& fieldName, const DataSeries& data);
+    // 从连续内存整块设置一列；zoneMap 非空且块数匹配时直接采用，不再扫描数据
+    void addDataSeries(const std::string& fieldName, const double* data, size_t count,
+                       const std::vector<ZoneBlock>* zoneMap = nullptr);
+    // 共享已有缓冲区设置一列，不复制数据；zoneMap 为空时分块摘要在首次使用时计算
+    void addDataSeries(const std::string& fieldName, const ColumnBuffer& column,
+                       const std::vector<ZoneBlock>* zoneMap = nullptr);
     void addDataPoints(const std::vector<std::map<std::string, double> >& points);
     
+    // 丢弃最早的 count 行；各种存储都只移动起点，不重建整列。
+    // 分块摘要只移除整块丢弃的块并重扫首块的剩余行，不改变结构版本号
+    void removeFront(size_t count);
+    
     // === 数据访问 ===
+    // 兼容接口：不是整块接管的数组时首次访问复制为连续数组缓存，缓存常驻到列被修改或
+    // releaseDecodedCache()，分块列因此占用双倍内存。库内已不再使用，优先使用 getColumnBuffer
     const DataSeries& getDataSeries(const std::string& fieldName) const;
+    // 与模型共享存储的只读视图，模型之后的修改不影响已取得的视图。
+    // 编码字段每次解码出独立视图，不写入展开缓存，需要反复读取时由调用方保留视图
+    ColumnBuffer getColumnBuffer(const std::string& fieldName) const;
     double getValue(const std::string& fieldName, size_t index) const;
+    // 空值字段不出现在 point 中
     bool getDataPoint(size_t index, std::map<std::string, double>& point) const;
     
+    // === 空值（有效位图） ===
+    // 每列一个位图，位为1表示有效；没有空值的列不分配位图。
+    // 空值在 double 视图（getDataSeries/getValue/scanField）中为 NaN，不计入分块摘要
+    bool isNull(const std::string& fieldName, size_t index) const;
+    bool hasNulls(const std::string& fieldName) const;
+    size_t getNullCount(const std::string& fieldName) const;
+    // 按位计数：区间内非空值数量
+    size_t getValidCount(const std::string& fieldName, size_t startIndex, size_t endIndex) const;
+    // 没有空值时返回 nullptr
+    const std::vector<uint64_t>* getValidityBitmap(const std::string& fieldName) const;
+    // 替换一列的有效位图，位数不足的部分视为有效
+    void setValidityBitmap(const std::string& fieldName, const std::vector<uint64_t>& bitmap);
+    // 同上，但不扫描列：空值位置已是 NaN 且分块摘要不含空值时使用（如快照文件中的列）。
+    // 取走 bitmap 的内容
+    void adoptValidityBitmap(const std::string& fieldName, std::vector<uint64_t>& bitmap);
+    
     // === 元数据管理 ===
     void setFieldMetadata(const std::string& fieldName, const std::string& key, const MetadataValue& value);
     MetadataValue getFieldMetadata(const std::string& fieldName, const std::string& key) const;
+    std::map<std::string, MetadataValue> getAllFieldMetadata(const std::string& fieldName) const;
     
     void setFieldColor(const std::string& fieldName, const std::string& color);
     void setFieldVisible(const std::string& fieldName, bool visible);
@@ -62,6 +125,14 @@ public:
     size_t size() const;
     bool empty() const;
     
+    // 结构版本号：清空、替换或删除字段时递增，纯追加数据和 removeFront 不改变
+    size_t getRevision() const { return m_revision; }
+    // removeFront 累计丢弃的行数；按行号缓存的调用方据此与版本号一起判断需要丢弃多少行
+    size_t getRemovedRowCount() const { return m_removedRows; }
+    // 实例编号：进程内单调递增、不复用（clone/publish 的版本也有新编号），
+    // 缓存按此区分模型，避免新模型复用已释放模型的地址时误用旧缓存
+    uint64_t getInstanceId() const { return m_instanceId; }
+    
     struct Statistics {
         size_t totalPoints;
         size_t validPoints;
@@ -73,15 +144,115 @@ public:
     
     Statistics calculateStatistics() const;
     
+    // === 区间查询（基于Zone Map，O(块数) + 两端部分扫描） ===
+    bool getRangeMinMax(const std::string& fieldName, size_t startIndex, size_t endIndex,
+                        double& minValue, double& maxValue) const;
+    bool getFieldRange(const std::string& fieldName, double& minValue, double& maxValue) const;
+    const std::vector<ZoneBlock>& getZoneMap(const std::string& fieldName) const;
+    // removeFront 后首块只剩后半部分：第 k 块覆盖行 [k*ZONE_BLOCK_SIZE - offset, (k+1)*ZONE_BLOCK_SIZE - offset)，
+    // offset 为本函数的返回值（小于 ZONE_BLOCK_SIZE），未丢弃过行时为0
+    size_t getZoneMapOffset(const std::string& fieldName) const;
+    
+    // === 列类型 ===
+    // 非 Float64 字段以 TypedColumn 紧凑存储，getDataSeries 首次访问时展开到缓存。
+    // 值无法用目标类型精确表示时 setFieldType 返回 false 且字段不变；
+    // 追加的值超出类型范围时字段退回 Float64
+    bool setFieldType(const std::string& fieldName, ColumnType type);
+    ColumnType getFieldType(const std::string& fieldName) const;
+    // 能精确表示该字段全部值的最窄类型
+    ColumnType inferFieldType(const std::string& fieldName) const;
+    // 对未编码且模式中未指定类型的字段应用推断类型，返回类型发生变化的字段数
+    size_t applyInferredTypes();
+    // 合并到现有模式：已有字段立即转换，之后创建或整列设置的字段按模式存储
+    void setSchema(const Schema& schema);
+    const Schema& getSchema() const { return m_schema; }
+    
+    // === 压缩编码 ===
+    // 编码后原始数组被释放；只有 getDataSeries 会把整列解码到缓存，区间统计与分块摘要逐块解码。
+    // 之前取得的列引用在编码/解码后失效。编码与列类型互斥，编码会把字段还原为 Float64
+    bool encodeField(const std::string& fieldName,
+                     EncodedColumn::Encoding encoding = EncodedColumn::Encoding::Auto);
+    bool decodeField(const std::string& fieldName);
+    bool isFieldEncoded(const std::string& fieldName) const;
+    // 字段实际占用字节数（编码/类型化数据 + 展开缓存，或原始数组）
+    size_t getFieldMemoryBytes(const std::string& fieldName) const;
+    // 释放所有编码/类型化字段的展开缓存
+    void releaseDecodedCache();
+    
+    // 按块遍历一列，编码/类型化字段逐块转换而不物化整列
+    typedef std::function<void(size_t startIndex, const double* values, size_t count)> BlockVisitor;
+    bool scanField(const std::string& fieldName, const BlockVisitor& visitor) const;
+    
     // === 数据子集 ===
+    // 子集与本模型共享列存储（写时复制），原始字段的切片与字段投影均不复制数据
     std::shared_ptr<DataModel> getSubset(size_t startIndex, size_t endIndex) const;
     std::shared_ptr<DataModel> getSubsetByFields(const std::vector<std::string>& fieldNames) const;
+    // 与本模型共享全部列存储的可写副本，含元数据与模式
+    std::shared_ptr<DataModel> clone() const;
+    
+    // === 并发快照 ===
+    // 写入方在一批修改后调用 publish()，把当前内容作为不可变版本以原子指针交换发布；
+    // 读取方随时用 snapshot() 取得最近发布的版本（O(1)，不加锁，未发布过时为空）。
+    // 版本与模型共享列存储：之后的原始列追加写在版本可见长度之外，不复制已有数据；
+    // 类型化列在发布后的首次追加会复制紧凑存储。publish() 须与其他修改在同一线程调用
+    void publish();
+    std::shared_ptr<const DataModel> snapshot() const;
 
 private:
-    std::map<std::string, DataSeries> m_dataSeries;
+    std::map<std::string, ColumnBuffer> m_dataSeries;
     std::map<std::string, std::map<std::string, MetadataValue> > m_fieldMetadata;
+    mutable std::map<std::string, std::vector<ZoneBlock> > m_zoneMaps;
+    mutable std::set<std::string> m_staleZoneMaps;     // 待重算分块摘要的字段
+    mutable std::map<std::string, size_t> m_zoneOffsets;   // 分块摘要首块中已丢弃的行数，为0时不记录
+    mutable std::set<std::string> m_staleZoneHeads;    // 首块丢弃过行、摘要待按剩余行重算的字段
+    mutable std::mutex m_zoneMutex;
     size_t m_pointCount;
+    size_t m_revision;
+    size_t m_removedRows;
+    uint64_t m_instanceId;
+    
+    std::map<std::string, EncodedColumn> m_encodedColumns;
+    std::map<std::string, TypedColumn> m_typedColumns;
+    Schema m_schema;
+    std::map<std::string, std::vector<uint64_t> > m_validity;
+    mutable std::map<std::string, ColumnBuffer> m_decodedCache;
+    mutable std::mutex m_decodeMutex;
+    std::shared_ptr<const DataModel> m_published;      // 只通过 std::atomic_load/atomic_store 访问
     
     bool checkConsistency() const;
+    // 把一个字段的存储、类型、有效位图与分块摘要共享给 target
+    void shareField(const std::string& fieldName, DataModel& target) const;
+    bool isRawField(const std::string& fieldName) const;
+    // 展开后的 double 列，contiguous 为真时保证是一个连续数组；调用方须持有 m_decodeMutex
+    const ColumnBuffer& decodedColumn(const std::string& fieldName, bool contiguous = false) const;
+    size_t getFieldSize(const std::string& fieldName) const;
+    void releaseFieldStorage(const std::string& fieldName);
+    void restoreRawStorage(const std::string& fieldName);
+    bool applySchemaType(const std::string& fieldName);
+    void appendValue(const std::string& fieldName, double value, bool valid);
+    // 行内新出现的字段：创建并为之前的 rowIndex 行补空值
+    void addFieldForRow(const std::string& fieldName, size_t rowIndex);
+    // 为本行未出现的字段补空值并更新点数；appended 为本行已追加的字段数
+    void finishRow(size_t rowIndex, size_t appended);
+    void appendValidity(const std::string& fieldName, size_t index, bool valid);
+    // 按字段长度截齐并保存位图（取走 validity 的内容），全部有效时不保存；返回是否有空值
+    bool storeValidity(const std::string& fieldName, std::vector<uint64_t>& validity);
+    // 将 [startIndex, startIndex + count) 中空值位置的 values 改为 fillValue
+    void fillNulls(const std::string& fieldName, size_t startIndex, double* values,
+                   size_t count, double fillValue) const;
+    std::vector<uint64_t> sliceValidity(const std::string& fieldName, size_t startIndex, size_t endIndex) const;
+    void appendToZoneMap(const std::string& fieldName, size_t index, double value);
+    void rebuildZoneMap(const std::string& fieldName);
+    void markZoneMapStale(const std::string& fieldName);
+    // 存储丢弃前 count 行之后调用：移除整块丢弃的摘要，部分丢弃的首块在下次读取摘要时重扫
+    void dropZoneMapFront(const std::string& fieldName, size_t count);
+    void buildZoneMap(const std::string& fieldName, std::vector<ZoneBlock>& zones) const;
+    // 区间部分扫描：类型化字段使用按类型实例化的统计循环
+    void scanFieldRange(const std::string& fieldName, size_t startIndex, size_t endIndex, ZoneBlock& result) const;
+    static void scanRange(const double* values, size_t startIndex, size_t endIndex, ZoneBlock& result);
+    static void mergeZone(ZoneBlock& target, const ZoneBlock& source);
+    
+    static std::atomic<uint64_t> s_nextInstanceId;
     static DataSeries s_emptySeries; // 静态空数据，用于返回引用
+    static std::vector<ZoneBlock> s_emptyZoneMap;
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef DATASNAPSHOT_H
+#define DATASNAPSHOT_H
+
+#include "DataModel.h"
+#include "utils/MappedFile.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @brief DataModel 的列式二进制快照
+ *
+ * 文件布局（全部小端）：
+ * - 固定头：魔数、版本、标志、行数、列数、分块大小、目录长度
+ * - 目录：每列的名称、行数、数据偏移、分块摘要偏移与块数、有效位图偏移与字数（v2）、字段元数据
+ * - 列数据：每列连续的 double 数组，起始偏移按64字节对齐
+ * - 分块摘要（可选）：每块 min/max/sum(double) + count(uint64)，同样64字节对齐
+ * - 有效位图（仅含空值的列）：uint64 字数组，位为1表示有效，同样64字节对齐
+ *
+ * v1 文件仍可读取，视为没有空值。
+ *
+ * 写入时各列并行定位写入；读取时整个文件只读映射，
+ * 打开耗时只与列数有关，与行数无关。toDataModel(true) 生成的模型直接引用映射内存，
+ * 映射在快照关闭后仍由模型的列保活。
+ */
+class DataSnapshot {
+public:
+    static const char MAGIC[8];
+    static const uint32_t VERSION = 2;
+    static const uint32_t FLAG_ZONE_MAPS = 0x1;
+    static const size_t COLUMN_ALIGNMENT = 64;
+
+    struct ColumnInfo {
+        std::string name;
+        uint64_t rowCount;
+        uint64_t dataOffset;
+        uint64_t zoneOffset;    // 无分块摘要时为0
+        uint64_t zoneCount;
+        uint64_t validityOffset;    // 无空值时为0
+        uint64_t validityWords;
+        std::map<std::string, DataModel::MetadataValue> metadata;
+
+        ColumnInfo() : rowCount(0), dataOffset(0), zoneOffset(0), zoneCount(0),
+                       validityOffset(0), validityWords(0) {}
+    };
+
+    DataSnapshot();
+    ~DataSnapshot();
+
+    // === 写入 ===
+    static bool write(const DataModel& model, const std::string& path,
+                      bool withZoneMaps, std::string& errorMessage);
+
+    // === 读取 ===
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_file && m_file->isOpen(); }
+
+    uint64_t getRowCount() const { return m_rowCount; }
+    uint32_t getZoneBlockSize() const { return m_zoneBlockSize; }
+    const std::vector<ColumnInfo>& getColumns() const { return m_columns; }
+
+    // 直接指向映射内存，快照关闭前有效
+    const double* getColumnData(size_t column) const;
+    bool getZoneMap(size_t column, std::vector<DataModel::ZoneBlock>& zones) const;
+    // 无空值的列返回 false
+    bool getValidityBitmap(size_t column, std::vector<uint64_t>& bitmap) const;
+
+    // 生成数据模型：分块大小一致时直接采用文件中的分块摘要。
+    // mapColumns 为 false 时每列一次整块复制并按 column_type 恢复列类型；为 true 时列直接引用
+    // 映射内存（零复制），保持 Float64 视图、列类型只记录在元数据中，此时文件在模型释放前应保持不变
+    std::shared_ptr<DataModel> toDataModel(bool mapColumns = false) const;
+
+    const std::string& getLastError() const { return m_lastError; }
+
+    // 仅检查魔数
+    static bool isSnapshotFile(const std::string& path);
+
+private:
+    bool parseHeader();
+
+    std::shared_ptr<MappedFile> m_file;
+    uint64_t m_rowCount;
+    uint32_t m_flags;
+    uint32_t m_zoneBlockSize;
+    std::vector<ColumnInfo> m_columns;
+    std::string m_lastError;
+};
+
+#endif // DATASNAPSHOT_H
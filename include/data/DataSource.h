@@ -5,6 +5,9 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <atomic>
+
+class DataModel;
 
 class DataSource {
 public:
@@ -20,6 +23,18 @@ public:
     virtual std::vector<double> getData() = 0;
     virtual bool hasNewData() const = 0;
     
+    // 加载结果；不产生数据模型的数据源返回空
+    virtual std::shared_ptr<DataModel> getDataModel() const { return nullptr; }
+    
+    // 流式数据源（实时、回放、网络）的字段名，第一个为时间戳；其他数据源返回空
+    virtual std::vector<std::string> getFieldNames() const { return std::vector<std::string>(); }
+    // 流式数据源按帧批量取走新行：columns 按 getFieldNames() 的顺序每个字段一个数组，
+    // 与内部缓冲交换，稳态下不产生内存分配。消费端来不及取走时较旧的行会被丢弃。返回取到的行数
+    virtual size_t takePendingRows(std::vector<std::vector<double> >& columns) {
+        columns.clear();
+        return 0;
+    }
+    
     // 回调机制替代QT信号槽
     void setDataReadyCallback(std::function<void()> callback) { 
         m_dataReadyCallback = callback; 
@@ -28,10 +43,27 @@ public:
     void setErrorCallback(std::function<void(const std::string&)> callback) { 
         m_errorCallback = callback; 
     }
+    
+    // 进度回调：已读取字节数、总字节数（总数未知时为0），在解析线程中调用
+    void setProgressCallback(std::function<void(size_t, size_t)> callback) {
+        m_progressCallback = callback;
+    }
+    
+    // 协作式取消：可从任意线程调用，解析循环定期检查后提前返回
+    void requestCancel() { m_cancelRequested.store(true); }
+    bool isCancelRequested() const { return m_cancelRequested.load(); }
 
 protected:
+    void reportProgress(size_t bytesRead, size_t totalBytes) {
+        if (m_progressCallback) {
+            m_progressCallback(bytesRead, totalBytes);
+        }
+    }
+    
     std::function<void()> m_dataReadyCallback;
     std::function<void(const std::string&)> m_errorCallback;
+    std::function<void(size_t, size_t)> m_progressCallback;
+    std::atomic<bool> m_cancelRequested{false};
 };
 
 #endif // DATASOURCE_H
\ No newline at end of file
@@ -11,13 +11,17 @@
 // 纯C++数据源工厂
 class DataSourceFactory {
 public:
-    enum class SourceType { CSV, RealTime, Custom };
+    enum class SourceType { CSV, RealTime, Custom, Snapshot, Socket };
     
     static DataSourceFactory& getInstance();
     
     std::shared_ptr<DataSource> createCSVSource(const std::string& filename);
     std::shared_ptr<DataSource> createRealTimeSource();
+    // config 含 transport 时创建套接字数据源（其余键见 SocketDataSource::SocketConfig），否则创建波形生成源
+    std::shared_ptr<DataSource> createRealTimeSource(const std::map<std::string, std::string>& config);
+    std::shared_ptr<DataSource> createSocketSource(const std::string& config);
     std::shared_ptr<DataSource> createCustomSource(const std::string& config);
+    std::shared_ptr<DataSource> createSnapshotSource(const std::string& filename);
 
 private:
     DataSourceFactory() = default;
@@ -0,0 +1,92 @@
+#ifndef ENCODEDCOLUMN_H
+#define ENCODEDCOLUMN_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief 压缩编码的数据列
+ *
+ * 数据按 BLOCK_SIZE 分块独立编码，最后不足一块的数据以原始值保存在尾部，
+ * 追加时尾部写满一块再编码。每块可选：
+ * - DeltaOfDelta：对IEEE位模式做二阶差分后位打包，适合单调、等间隔的时间列
+ * - GorillaXor：与前值异或后只保存有效位，适合缓慢变化的测量值
+ * - FrameOfReference：整数值减去块内最小值后按最小位宽打包，适合计数/整型列
+ * 若某块不适用所选编码或压缩后不更小，该块保存原始值。所有编码均无损。
+ *
+ * 解码按块进行；位打包解码为无分支的定宽循环，Gorilla 为逐位串行解码。
+ * 已编码的块不可变，复制列时各块按引用共享，只复制未编码的尾部。
+ * 丢弃开头的数据只记录首块内的偏移，整块丢弃后才释放该块，不重新编码。
+ */
+class EncodedColumn {
+public:
+    enum class Encoding {
+        Raw,
+        DeltaOfDelta,
+        GorillaXor,
+        FrameOfReference,
+        Auto            // 根据数据特征自动选择
+    };
+
+    static const size_t BLOCK_SIZE = 4096;
+
+    EncodedColumn();
+
+    // 编码整列（替换原有内容）
+    void encode(const double* data, size_t count, Encoding encoding = Encoding::Auto);
+    void append(double value);
+    // 丢弃前 count 个元素：整块丢弃的块直接释放，首块只记录偏移
+    void dropFront(size_t count);
+    void clear();
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    Encoding getEncoding() const { return m_encoding; }
+
+    // 块数（含未编码的尾部）
+    size_t blockCount() const;
+    // 第 index 个元素所在的块，以及第 block 块首元素的下标（首块可能因 dropFront 只剩后半部分）
+    size_t blockOf(size_t index) const { return (index + m_offset) / BLOCK_SIZE; }
+    size_t blockStart(size_t block) const { return block == 0 ? 0 : block * BLOCK_SIZE - m_offset; }
+    // 解码第 block 块到 output（至少 BLOCK_SIZE 个元素），返回该块元素数
+    size_t decodeBlock(size_t block, double* output) const;
+    void decodeAll(std::vector<double>& output) const;
+    double valueAt(size_t index) const;
+
+    // 编码后占用的内存字节数
+    size_t memoryBytes() const;
+
+    static Encoding chooseEncoding(const double* data, size_t count);
+
+private:
+    struct Block {
+        Encoding encoding;
+        uint32_t count;
+        uint32_t bitWidth;          // 位打包宽度
+        uint64_t firstBits;         // DeltaOfDelta：首值位模式
+        uint64_t firstDelta;        // DeltaOfDelta：首个一阶差分
+        int64_t reference;          // 位打包的参考值（块内最小值）
+        std::vector<uint64_t> words;
+
+        Block() : encoding(Encoding::Raw), count(0), bitWidth(0),
+                  firstBits(0), firstDelta(0), reference(0) {}
+    };
+
+    static void encodeBlock(const double* data, size_t count, Encoding encoding, Block& block);
+    static bool encodeDeltaOfDelta(const double* data, size_t count, Block& block);
+    static bool encodeGorilla(const double* data, size_t count, Block& block);
+    static bool encodeFrameOfReference(const double* data, size_t count, Block& block);
+    static void encodeRaw(const double* data, size_t count, Block& block);
+
+    static void decodeBlockData(const Block& block, double* output);
+
+    std::vector<std::shared_ptr<const Block> > m_blocks;
+    std::vector<double> m_tail;
+    Encoding m_encoding;
+    size_t m_size;
+    size_t m_offset;        // 首块中已丢弃的元素数，只在有已编码块时非零
+};
+
+#endif // ENCODEDCOLUMN_H
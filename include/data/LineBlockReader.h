@@ -0,0 +1,70 @@
+#ifndef LINEBLOCKREADER_H
+#define LINEBLOCKREADER_H
+
+#include "ParseArena.h"
+#include <istream>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+/**
+ * @brief 按行块并行解析文本数据
+ *
+ * 每轮从流中读入若干个约 BLOCK_BYTES 字节、在换行处对齐的行块，在共享线程池中
+ * 并行解析各块，再按文件顺序逐块交给调用方合并，结果与逐行顺序解析一致。
+ * 每个块有自己的解析区，一行的解析结果（值与有效标记）留在其中直到该块合并完；
+ * 块与读缓冲跨轮复用，稳态下不再向堆申请内存。
+ *
+ * 行按 '\n' 切分，不含换行符本身，与 std::getline 一致。
+ */
+class LineBlockReader {
+public:
+    static const size_t BLOCK_BYTES = 1024 * 1024;
+
+    // 一行的解析结果，values/valid 分配在所在块的解析区中；valid 为空表示全部有效
+    struct Row {
+        const double* values;
+        const bool* valid;
+        size_t count;
+
+        Row() : values(nullptr), valid(nullptr), count(0) {}
+    };
+
+    struct Block {
+        ParseArena arena;
+        std::vector<Row> rows;      // 解析成功的行，按文件顺序
+        size_t lines;               // 块内总行数
+        size_t skippedLines;        // 解析函数返回 false 的行
+
+        Block() : lines(0), skippedLines(0) {}
+    };
+
+    // 解析一行 [begin, end)，返回 false 表示跳过该行。并行模式下会在多个线程中同时调用
+    typedef std::function<bool(const char* begin, const char* end, ParseArena& arena, Row& row)> LineParser;
+    // 在调用线程中按文件顺序调用，bytesRead 为到该块末尾为止读取的字节数；返回 false 时停止读取
+    typedef std::function<bool(const Block& block, size_t bytesRead)> BlockConsumer;
+
+    LineBlockReader();
+
+    // 解析函数不能在多个线程中同时调用时（如共享输出缓冲的自定义解析器）关闭并行，各块在调用线程中依次解析
+    void setParallel(bool parallel) { m_parallel = parallel; }
+
+    /**
+     * @brief 从流的当前位置读到末尾
+     * @return 读取出错或被 consumer 中止时返回 false
+     */
+    bool read(std::istream& stream, const LineParser& parser, const BlockConsumer& consumer);
+
+private:
+    // 把 [begin, end) 切成在换行处对齐的块，返回块数
+    size_t splitBlocks(const char* begin, const char* end);
+    static void parseBlock(const char* begin, const char* end, const LineParser& parser, Block& block);
+
+    bool m_parallel;
+    std::vector<char> m_buffer;
+    std::vector<std::unique_ptr<Block> > m_blocks;
+    std::vector<const char*> m_boundaries;      // 第 i 块为 [m_boundaries[i], m_boundaries[i + 1])
+};
+
+#endif // LINEBLOCKREADER_H
@@ -0,0 +1,112 @@
+#ifndef LODPYRAMID_H
+#define LODPYRAMID_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <cstddef>
+#include "ColumnBuffer.h"
+
+class DataModel;
+
+/**
+ * @brief 单列多分辨率金字塔（Level of Detail）
+ *
+ * 第 k 层（k >= 1）每个节点汇总 BASE_BUCKET·2^(k-1) 个原始点的 min/max/sum/count，
+ * 第 k+1 层由第 k 层两两合并得到，节点总数约为原始点数的 2/BASE_BUCKET。
+ * 比第1层更细的缩放级别直接读取原始数据。只保存完整的桶，
+ * 末尾不足一个桶的点由调用方从原始数据读取。
+ *
+ * 只为 y 列构建：x 列单调，桶的位置直接取原始数据中该桶的首末点。
+ * 任意缩放级别下，选择合适的层即可只读取 O(像素数) 个节点。
+ *
+ * 数据开头被丢弃（DataModel::removeFront）时由 dropFront 同步：桶按丢弃前的行号划分，
+ * 部分被丢弃的桶不再使用，完全丢弃的节点攒够一半时才从各层移除，逐行丢弃为均摊 O(1)。
+ */
+class LodPyramid {
+public:
+    struct Node {
+        double minValue;
+        double maxValue;
+        double sum;
+        size_t count;   // 有效值（非NaN）数量
+
+        Node() : minValue(0.0), maxValue(0.0), sum(0.0), count(0) {}
+        double mean() const { return count > 0 ? sum / count : 0.0; }
+    };
+
+    // 第1层的桶大小
+    static const size_t BASE_BUCKET = 64;
+
+    LodPyramid();
+
+    // 从头构建
+    void build(const ColumnBuffer& data);
+    // 数据追加后增量扩展（只处理新增的完整桶）；
+    // 已汇总部分的抽样值与 data 不一致（数据被替换而非追加）时从头重建
+    void extend(const ColumnBuffer& data);
+    // 数据开头被丢弃了 count 行，之后 extend 传入的是丢弃后的数据
+    void dropFront(size_t count);
+    void clear();
+
+    // 已汇总的原始点数（含末尾不足一个桶的部分），丢弃开头的行后相应减少
+    size_t sourceSize() const { return m_sourceSize; }
+    size_t levelCount() const { return m_levels.size(); }
+
+    // 第 level 层（level >= 1）的桶大小为 BASE_BUCKET·2^(level-1)；第0层即原始数据
+    static size_t bucketSize(size_t level) { return level == 0 ? 1 : BASE_BUCKET << (level - 1); }
+
+    /**
+     * @brief 第 level 层完整落在 [startIndex, endIndex) 内的连续节点
+     *
+     * @param nodes 输出首节点
+     * @param firstRow 输出首节点覆盖的第一行，之后第 i 个节点覆盖 firstRow + i·bucketSize(level) 起的一个桶
+     * @return 节点数
+     */
+    size_t nodesInRange(size_t level, size_t startIndex, size_t endIndex,
+                        const Node*& nodes, size_t& firstRow) const;
+
+    /**
+     * @brief 选择满足精度要求的最粗层
+     *
+     * @param visibleRows 可见区间的原始点数
+     * @param minNodes 该层在可见区间内至少需要的节点数
+     * @return 层号，0 表示应直接使用原始数据
+     */
+    size_t selectLevel(size_t visibleRows, size_t minNodes) const;
+
+    /**
+     * @brief 并行为模型中的多列（y 列）构建金字塔
+     */
+    static std::map<std::string, std::shared_ptr<LodPyramid> >
+    buildForFields(const DataModel& model, const std::vector<std::string>& fieldNames);
+
+private:
+    static void mergeNode(Node& target, const Node& source);
+    // 把连续的 count 个原始值累加到 node，跳过 NaN
+    static void accumulate(Node& node, const double* values, size_t count);
+
+    // 一层的节点：nodes[i] 是按丢弃前行号划分的第 firstNode + i 个桶
+    struct Level {
+        std::vector<Node> nodes;
+        size_t firstNode;
+
+        Level() : firstNode(0) {}
+        size_t endNode() const { return firstNode + nodes.size(); }
+    };
+
+    // 已汇总前缀的抽样值（首、中、尾），扩展前据此确认数据只是追加；
+    // 抽样位置按丢弃前的行号记录，已被丢弃的抽样点不再核对
+    static const size_t PREFIX_SAMPLES = 3;
+    void recordPrefix(const ColumnBuffer& data);
+    bool prefixMatches(const ColumnBuffer& data) const;
+
+    std::vector<Level> m_levels;    // m_levels[0] 对应第1层
+    size_t m_sourceSize;
+    size_t m_origin;                // 已丢弃的行数：当前第 i 行在桶划分中的行号为 m_origin + i
+    size_t m_prefixRows[PREFIX_SAMPLES];
+    double m_prefixSamples[PREFIX_SAMPLES];
+};
+
+#endif // LODPYRAMID_H
@@ -0,0 +1,81 @@
+#ifndef PARSEARENA_H
+#define PARSEARENA_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief 解析临时数据用的线性（bump）分配区
+ *
+ * 分配只移动当前内存块中的偏移，单次分配不释放；reset() 一次性回收全部分配，
+ * 已申请的内存留给下一批复用。一批数据用完首块时追加新块，reset() 时合并成一个
+ * 足够大的块，之后批量相近时每批不再向堆申请内存。
+ *
+ * 每个线程通过 forThread() 取得自己的实例，无需加锁；不同线程的实例互不可见。
+ */
+class ParseArena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    // 分配位置，用于把分配区回退到某一时刻
+    struct Mark {
+        size_t block;
+        size_t offset;
+    };
+
+    // 作用域结束时回退到进入时的位置，供不知道调用方何时 reset() 的解析函数使用
+    class Scope {
+    public:
+        explicit Scope(ParseArena& arena) : m_arena(arena), m_mark(arena.mark()) {}
+        ~Scope() { m_arena.rewind(m_mark); }
+    private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ParseArena& m_arena;
+        Mark m_mark;
+    };
+
+    explicit ParseArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~ParseArena();
+
+    // 当前线程的分配区
+    static ParseArena& forThread();
+
+    void* allocate(size_t bytes, size_t alignment = alignof(double));
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+    // 复制 [begin, end) 并以 '\0' 结尾，供需要C字符串的转换函数使用
+    char* copyString(const char* begin, const char* end);
+
+    Mark mark() const;
+    void rewind(const Mark& position);
+    // 回收全部分配；调用时不能有仍在使用的分配或未结束的 Scope
+    void reset();
+
+    size_t bytesUsed() const;
+    size_t capacity() const;
+    // 累计向堆申请内存块的次数
+    size_t blockAllocations() const { return m_blockAllocations; }
+
+private:
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    void addBlock(size_t size);
+
+    std::vector<Block> m_blocks;
+    size_t m_current;        // 正在分配的块
+    size_t m_offset;         // 当前块中已分配的字节数
+    size_t m_blockSize;
+    size_t m_blockAllocations;
+};
+
+#endif // PARSEARENA_H
@@ -0,0 +1,72 @@
+#ifndef PARSECACHE_H
+#define PARSECACHE_H
+
+#include "DataModel.h"
+#include <string>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * @brief 解析结果缓存
+ *
+ * 以列式快照（DataSnapshot）保存文本文件的解析结果。缓存键包括：
+ * 文件路径、大小、修改时间、首尾数据块的内容哈希以及解析设置，
+ * 任一变化都会导致未命中。缓存目录总大小超过上限时按最近使用时间淘汰。
+ *
+ * 线程安全：可在多个加载线程中同时使用。
+ */
+class ParseCache {
+public:
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t stores;
+        uint64_t evictions;
+        
+        Stats() : hits(0), misses(0), stores(0), evictions(0) {}
+    };
+    
+    static ParseCache& getInstance();
+    
+    // === 配置 ===
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    void setCacheDirectory(const std::string& directory);
+    std::string getCacheDirectory() const;
+    void setMaxBytes(uint64_t maxBytes);
+    uint64_t getMaxBytes() const;
+    
+    /**
+     * @brief 生成缓存键
+     * @param filename 源文件
+     * @param parseSettings 影响解析结果的设置（分隔符、表头、跳过行数等）
+     * @return 文件不可读时返回空串
+     */
+    static std::string makeKey(const std::string& filename, const std::string& parseSettings);
+    
+    // 命中时映射缓存文件并返回数据模型，未命中返回空
+    std::shared_ptr<DataModel> lookup(const std::string& key);
+    bool store(const std::string& key, const DataModel& model);
+    
+    void clear();
+    Stats getStats() const;
+
+private:
+    ParseCache();
+    ParseCache(const ParseCache&);
+    ParseCache& operator=(const ParseCache&);
+    
+    std::string pathForKey(const std::string& key) const;
+    void evictIfNeeded();
+    
+    static uint64_t hashBytes(const char* data, size_t size, uint64_t seed);
+    
+    mutable std::mutex m_mutex;
+    bool m_enabled;
+    std::string m_directory;
+    uint64_t m_maxBytes;
+    Stats m_stats;
+};
+
+#endif // PARSECACHE_H
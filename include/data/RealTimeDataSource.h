@@ -11,6 +11,8 @@
 #include <random>
 #include <pthread.h>
 
+class RecordingLogWriter;
+
 class RealTimeDataSource : public DataSource {
 public:
     // 实时数据生成模式
@@ -65,8 +67,8 @@ public:
     // 自定义数据生成器
     void setCustomDataGenerator(std::function<double(double)> generator);
     
-    // 数据访问
-    std::shared_ptr<DataModel> getDataModel() const { return m_dataModel; }
+    // 数据访问：模型由采集线程写入，其他线程通过 getDataModel()->snapshot() 读取一致的版本
+    std::shared_ptr<DataModel> getDataModel() const override { return m_dataModel; }
     double getCurrentValue() const { return m_currentValue; }
     double getElapsedTime() const;
     
@@ -81,8 +83,37 @@ public:
     };
     
     RealTimeStats getStatistics() const;
+    
+    /**
+     * @brief 批量取走自上次调用以来的新样本（线程安全）
+     * 
+     * 传入的向量与内部缓冲交换，稳态下不产生内存分配
+     * @return 取到的样本数
+     */
+    size_t takePendingSamples(std::vector<double>& times, std::vector<double>& values);
+    // 与其他流式数据源一致的按列接口：字段 time、value
+    std::vector<std::string> getFieldNames() const override;
+    size_t takePendingRows(std::vector<std::vector<double> >& columns) override;
+    
+    // 消费端来不及取走而被丢弃的样本数
+    size_t getDroppedSampleCount() const;
+    
+    // 每个样本生成后在采集线程中调用，不受显示端丢弃的影响，供录制等需要完整数据的消费者使用。
+    // 回调应尽快返回；传空函数取消
+    typedef std::function<void(double time, double value)> SampleCallback;
+    void setSampleCallback(SampleCallback callback);
+    
+    // 预写日志：每个样本先追加到日志（字段 time、value）再写入模型，进程异常退出后可用
+    // ReplayDataSource 回放已写入的部分；日志按批写出并按同步策略落盘，崩溃时最近约 flushIntervalMs
+    // 内的样本可能丢失。stop() 时写出并同步未满的批次；写入失败时通过错误回调报告并停止记录，
+    // 采集继续。传空指针取消
+    void setRecordingLog(std::shared_ptr<RecordingLogWriter> log);
+    std::shared_ptr<RecordingLogWriter> getRecordingLog() const;
 
 private:
+    // 采集线程发布模型版本的最小间隔，约一个显示帧
+    static const int PUBLISH_INTERVAL_MS = 16;
+    
     // 数据生成函数
     double generateSineWave(double time);
     double generateSquareWave(double time);
@@ -94,6 +125,7 @@ private:
     void updateData();
     void addDataPoint(double value);
     void updateStatistics(double value);
+    void appendPendingSample(double time, double value);
     
     // 线程控制
     void dataGenerationThread();
@@ -116,6 +148,17 @@ private:
     double m_maxValue;
     double m_valueSum;
     
+    // 待取走的新样本（生成线程写入，消费端批量取走）
+    mutable pthread_mutex_t m_pendingMutex;
+    std::vector<double> m_pendingTimes;
+    std::vector<double> m_pendingValues;
+    size_t m_droppedSamples;
+    
+    // 样本的其他去向：回调和预写日志，在采集线程中调用
+    mutable pthread_mutex_t m_sampleSinkMutex;
+    SampleCallback m_sampleCallback;
+    std::shared_ptr<RecordingLogWriter> m_recordingLog;
+    
     // 随机数生成器
     std::default_random_engine m_randomEngine;
     std::normal_distribution<double> m_normalDist;
@@ -0,0 +1,173 @@
+#ifndef RECORDINGLOG_H
+#define RECORDINGLOG_H
+
+#include "utils/MappedFile.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief 实时采集的预写日志（只追加的二进制录制文件）
+ *
+ * 文件布局（全部小端，各部分按8字节对齐）：
+ * - 文件头：魔数(8) 版本(4) 字段数(4) 字段名（长度(4) + 字节）… 补齐后的 CRC-32(4) 保留(4)
+ * - 批次帧：帧头 32 字节 —— 标记(4) 行数(4) 序号(8) 载荷长度(4) 载荷 CRC-32(4) 帧头 CRC-32(4) 保留(4)，
+ *   之后是载荷：按列存放的 double，先是字段0的全部行，再是字段1……
+ *
+ * 帧写入后不再修改。进程在写帧途中退出时，文件末尾可能留下不完整或校验失败的帧：
+ * 读取时在第一个无效帧处结束，写入端重新打开同一文件时先把它截掉再继续追加，之前的帧不受影响。
+ * 第一个字段按约定为时间戳（秒），回放按它还原采样间隔。
+ *
+ * 持久化窗口：追加的行先在内存中攒批，满 batchRows 行或等待超过 flushIntervalMs 时写成一帧
+ * （后者由写入端的后台线程按时检查，不依赖下一次追加）。同步全部在后台线程中进行且不持锁，
+ * appendRow 最多写一帧、不会等待落盘。因此进程崩溃最多丢失最近约 flushIntervalMs 内追加的行，
+ * 断电还可能丢失尚未同步的帧（EveryBatch 下为后台线程尚未同步的几帧，GroupCommit 下最多约 syncIntervalMs）。
+ */
+class RecordingLogWriter {
+public:
+    // 同步策略：数据写入后何时调用 fdatasync 落盘
+    enum class SyncPolicy {
+        None,           // 只写入系统缓存：进程崩溃不丢数据，断电可能丢失最近的帧
+        EveryBatch,     // 每写一帧即通知后台线程同步，同步期间写出的帧合并到下一次
+        GroupCommit     // 距上次同步超过 syncIntervalMs 或未同步数据超过 syncBytes 时同步一次
+    };
+
+    struct Options {
+        size_t batchRows;           // 攒满这么多行写一帧
+        int flushIntervalMs;        // 未满的批次最长等待时间，超时由后台线程写出
+        SyncPolicy syncPolicy;
+        int syncIntervalMs;
+        uint64_t syncBytes;
+
+        Options()
+            : batchRows(256), flushIntervalMs(100), syncPolicy(SyncPolicy::GroupCommit),
+              syncIntervalMs(200), syncBytes(4 * 1024 * 1024) {}
+    };
+
+    struct Stats {
+        uint64_t rowsAppended;
+        uint64_t framesWritten;
+        uint64_t bytesWritten;
+        uint64_t syncCount;
+        double maxSyncMs;           // 单次同步的最长耗时
+        double totalSyncMs;
+        uint64_t recoveredBytes;    // 重新打开时截掉的损坏尾部字节数
+
+        Stats() : rowsAppended(0), framesWritten(0), bytesWritten(0), syncCount(0),
+                  maxSyncMs(0.0), totalSyncMs(0.0), recoveredBytes(0) {}
+    };
+
+    static const char MAGIC[8];
+    static const uint32_t VERSION = 1;
+
+    RecordingLogWriter();
+    ~RecordingLogWriter();
+
+    /**
+     * @brief 打开日志用于追加
+     *
+     * 文件不存在时新建；已存在且字段一致时截掉末尾的损坏帧后继续追加，字段不一致时失败。
+     */
+    bool open(const std::string& path, const std::vector<std::string>& fieldNames,
+              const Options& options, std::string& errorMessage);
+    // 写出未满的批次并同步后关闭
+    bool close();
+    bool isOpen() const;
+
+    // 追加一行，values 按字段顺序，个数等于字段数。批次满时在调用线程写出一帧，不同步
+    bool appendRow(const double* values);
+    // 把未满的批次写成一帧；sync 为 true 时随后在调用线程同步落盘
+    bool flush(bool sync);
+
+    Stats getStats() const;
+    std::string getLastError() const;
+    const std::string& getPath() const { return m_path; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    RecordingLogWriter(const RecordingLogWriter&);
+    RecordingLogWriter& operator=(const RecordingLogWriter&);
+
+    bool writeFrameLocked();
+    bool syncLocked();
+    void recordSyncLocked(Clock::time_point start, Clock::time_point end);
+    bool writeAllLocked(const std::string& data);
+    // 后台线程：定期写出超时的批次，并按同步策略同步已写出的帧
+    void flushThread(std::chrono::milliseconds period);
+    bool flushDueLocked();
+    // 写帧时请求过同步或组提交超时时同步；同步期间释放 lock
+    bool syncIfDue(std::unique_lock<std::mutex>& lock);
+    void stopFlushThread();
+
+    mutable std::mutex m_mutex;
+    int m_fd;
+    std::string m_path;
+    Options m_options;
+    size_t m_fieldCount;
+    std::vector<std::vector<double> > m_pending;    // 按列积累的当前批次
+    size_t m_pendingRows;
+    Clock::time_point m_pendingSince;
+    uint64_t m_sequence;
+    uint64_t m_unsyncedBytes;
+    Clock::time_point m_lastSync;
+    std::string m_frame;                            // 复用的帧缓冲
+    bool m_writeFailed;                             // 后台写出失败，之后的追加返回 false
+    std::thread m_flushThread;
+    std::condition_variable m_flushCondition;
+    bool m_stopFlush;
+    bool m_syncRequested;                           // 已写出的帧等待后台线程同步
+    Stats m_stats;
+    std::string m_lastError;
+};
+
+/**
+ * @brief 读取预写日志
+ *
+ * 打开时只读映射整个文件并逐帧校验，在第一个不完整、校验失败或序号不连续的帧处停止；
+ * 之后的内容计入 getDiscardedBytes()。列数据直接指向映射内存。
+ */
+class RecordingLogReader {
+public:
+    RecordingLogReader();
+    ~RecordingLogReader();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    const std::vector<std::string>& getFieldNames() const { return m_fieldNames; }
+    size_t getFrameCount() const { return m_frames.size(); }
+    uint64_t getRowCount() const { return m_rowCount; }
+    size_t getFrameRows(size_t frame) const { return m_frames[frame].rows; }
+    // 第 frame 帧中字段 field 的全部值，日志关闭前有效
+    const double* getColumn(size_t frame, size_t field) const;
+
+    // 最后一个有效帧的结尾位置，以及其后被丢弃的字节数
+    uint64_t getValidBytes() const { return m_validBytes; }
+    uint64_t getDiscardedBytes() const { return m_file.size() - m_validBytes; }
+
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    RecordingLogReader(const RecordingLogReader&);
+    RecordingLogReader& operator=(const RecordingLogReader&);
+
+    struct Frame {
+        uint64_t payloadOffset;
+        uint32_t rows;
+    };
+
+    MappedFile m_file;
+    std::vector<std::string> m_fieldNames;
+    std::vector<Frame> m_frames;
+    uint64_t m_rowCount;
+    uint64_t m_validBytes;
+    std::string m_lastError;
+};
+
+#endif // RECORDINGLOG_H
@@ -0,0 +1,119 @@
+#ifndef REPLAYDATASOURCE_H
+#define REPLAYDATASOURCE_H
+
+#include "DataSource.h"
+#include "DataModel.h"
+#include "RecordingLog.h"
+#include <string>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief 回放预写日志的数据源
+ *
+ * 回放线程按日志中的顺序把各行追加到数据模型并发布，与实时数据源一样通过
+ * setDataReadyCallback 通知、通过 getDataModel()->snapshot() 读取。
+ * 第一个字段作为时间戳：speed 为 1 时按原始间隔回放，为 k 时加快 k 倍，
+ * 为 0 时不等待，尽快回放全部数据，可作为整条处理链路的可重复负载测试。
+ * 日志末尾的损坏帧在打开时被忽略，见 ReplayStats::discardedBytes。
+ */
+class ReplayDataSource : public DataSource {
+public:
+    struct ReplayConfig {
+        double speed;           // 回放倍速，0 表示尽快回放
+        size_t bufferSize;      // 模型中保留的最多行数，0 表示全部保留
+
+        ReplayConfig() : speed(1.0), bufferSize(0) {}
+    };
+
+    struct ReplayStats {
+        uint64_t rowsReplayed;
+        uint64_t totalRows;
+        size_t framesReplayed;
+        uint64_t droppedRows;       // 消费端来不及取走而被丢弃的待取行数
+        uint64_t discardedBytes;    // 日志末尾被忽略的损坏字节数
+        double elapsedSeconds;
+        double rowsPerSecond;
+        bool finished;              // 已回放到日志末尾
+
+        ReplayStats() : rowsReplayed(0), totalRows(0), framesReplayed(0), droppedRows(0),
+                        discardedBytes(0), elapsedSeconds(0.0), rowsPerSecond(0.0), finished(false) {}
+    };
+
+    ReplayDataSource();
+    ~ReplayDataSource();
+
+    // DataSource 接口实现：config 为日志文件路径
+    bool initialize(const std::string& config) override;
+    bool start() override;
+    void stop() override;
+    State getState() const override { return m_state.load(); }
+
+    // 最近回放的一行
+    std::vector<double> getData() override;
+    bool hasNewData() const override { return m_hasNewData.load(); }
+
+    // 模型由回放线程写入，其他线程通过 getDataModel()->snapshot() 读取一致的版本
+    std::shared_ptr<DataModel> getDataModel() const override { return m_dataModel; }
+
+    void setConfig(const ReplayConfig& config) { m_config = config; }
+    ReplayConfig getConfig() const { return m_config; }
+
+    // 日志中的字段，start() 之后有效
+    std::vector<std::string> getFieldNames() const override { return m_fieldNames; }
+
+    /**
+     * @brief 批量取走自上次调用以来回放的新行（线程安全）
+     *
+     * columns 按字段顺序每个字段一个数组，与内部缓冲交换，稳态下不产生内存分配
+     * @return 取到的行数
+     */
+    size_t takePendingRows(std::vector<std::vector<double> >& columns) override;
+
+    ReplayStats getStatistics() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void replayThread();
+    // 把第 frame 帧的 [first, last) 行追加到模型和待取缓冲
+    void appendRows(size_t frame, size_t first, size_t last);
+    // 可被 stop() 打断的等待，返回 false 表示已请求停止
+    bool waitUntil(Clock::time_point deadline);
+
+    std::string m_filename;
+    ReplayConfig m_config;
+    std::shared_ptr<DataModel> m_dataModel;
+    RecordingLogReader m_reader;
+    std::vector<std::string> m_fieldNames;
+    std::atomic<State> m_state;
+    std::atomic<bool> m_hasNewData;
+
+    std::thread m_thread;
+    std::mutex m_threadMutex;
+    std::condition_variable m_threadCond;
+    bool m_stopRequested;
+
+    // 待取走的新行（回放线程写入，消费端批量取走）
+    mutable std::mutex m_pendingMutex;
+    std::vector<std::vector<double> > m_pendingColumns;
+    std::vector<double> m_lastRow;
+
+    // 统计信息，受 m_pendingMutex 保护
+    uint64_t m_totalRows;
+    uint64_t m_discardedBytes;
+    uint64_t m_rowsReplayed;
+    size_t m_framesReplayed;
+    uint64_t m_droppedRows;
+    bool m_finished;
+    Clock::time_point m_startTime;
+    Clock::time_point m_endTime;
+};
+
+#endif // REPLAYDATASOURCE_H
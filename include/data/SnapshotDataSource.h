@@ -0,0 +1,43 @@
+#ifndef SNAPSHOTDATASOURCE_H
+#define SNAPSHOTDATASOURCE_H
+
+#include "DataSource.h"
+#include "DataModel.h"
+#include "DataSnapshot.h"
+#include <string>
+#include <memory>
+
+/**
+ * @brief 列式二进制快照数据源
+ *
+ * 映射快照文件后按列整块复制到数据模型，无需文本解析；
+ * 文件中的分块摘要直接复用，不再扫描数据。
+ */
+class SnapshotDataSource : public DataSource {
+public:
+    SnapshotDataSource();
+    ~SnapshotDataSource();
+    
+    // DataSource 接口实现
+    bool initialize(const std::string& config) override;
+    bool start() override;
+    void stop() override;
+    State getState() const override { return m_state; }
+    
+    std::vector<double> getData() override;
+    bool hasNewData() const override { return m_dataModel && !m_dataModel->empty(); }
+    
+    // 数据访问
+    std::shared_ptr<DataModel> getDataModel() const override { return m_dataModel; }
+    
+    // 将数据模型保存为快照
+    static bool save(const DataModel& model, const std::string& filename,
+                     bool withZoneMaps, std::string& errorMessage);
+
+private:
+    std::string m_filename;
+    std::shared_ptr<DataModel> m_dataModel;
+    State m_state;
+};
+
+#endif // SNAPSHOTDATASOURCE_H
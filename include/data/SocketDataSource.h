@@ -0,0 +1,210 @@
+#ifndef SOCKETDATASOURCE_H
+#define SOCKETDATASOURCE_H
+
+#include "DataSource.h"
+#include "DataModel.h"
+#include <string>
+#include <memory>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief 从本机套接字接收样本的实时数据源（UDP、TCP、Unix 域套接字）
+ *
+ * 接收线程用 epoll 等待、recvmmsg 一次取多个数据报（其他平台退回 poll + recvfrom），
+ * 解码后直接逐行追加到数据模型，超过 bufferSize 时丢弃最早的行，每轮接收后发布一次。
+ * 与其他实时数据源一样通过 setDataReadyCallback 通知、通过 takePendingRows 批量取走新行。
+ *
+ * 两种线路格式：
+ * - 二进制帧（小端）：帧头 16 字节 —— 标记(4) 序号(4) 字段数(2) 行数(2) 保留(4)，
+ *   之后是按行存放的 double。一个数据报可以包含多个完整的帧；流式连接中帧首尾相接。
+ *   每个发送端的帧序号依次递增，用于统计丢失、乱序和重复的帧。
+ * - 文本行：每行一个样本，数值以逗号、分号、空格或制表符分隔，没有序号。
+ *
+ * 第一个字段按约定为时间戳。未配置字段名时由第一个帧（行）的字段数决定。
+ */
+class SocketDataSource : public DataSource {
+public:
+    enum class Transport {
+        Udp,
+        Tcp,
+        Unix,           // Unix 域流套接字
+        UnixDatagram    // Unix 域数据报套接字
+    };
+
+    enum class Format {
+        Binary,
+        Text
+    };
+
+    /**
+     * 配置字符串格式（initialize 的参数）：
+     * "transport=udp;address=127.0.0.1;port=9000;format=binary;fields=time,x,y;buffer=100000;batch=64;rcvbuf=4194304"
+     * Unix 域套接字的 address 为套接字文件路径，不需要 port
+     */
+    struct SocketConfig {
+        Transport transport;
+        std::string address;            // 监听地址或 Unix 套接字路径
+        int port;                       // 0 表示由系统分配，见 getBoundPort()
+        Format format;
+        std::vector<std::string> fieldNames;
+        size_t bufferSize;              // 模型中保留的最多行数，0 表示全部保留
+        size_t batchSize;               // 一次 recvmmsg 最多取的数据报数
+        int receiveBufferBytes;         // SO_RCVBUF，0 表示使用系统默认值
+
+        SocketConfig()
+            : transport(Transport::Udp), address("127.0.0.1"), port(0), format(Format::Binary),
+              bufferSize(100000), batchSize(64), receiveBufferBytes(4 * 1024 * 1024) {}
+    };
+
+    struct SocketStats {
+        uint64_t packetsReceived;       // 数据报数，流式连接为读取次数
+        uint64_t bytesReceived;
+        uint64_t receiveCalls;          // recvmmsg/recv 调用次数
+        uint64_t framesDecoded;         // 二进制帧或文本行
+        uint64_t rowsDecoded;
+        uint64_t framesLost;            // 按序号推断未收到的帧
+        uint64_t framesOutOfOrder;      // 迟于后续帧到达的帧（仍追加到模型）
+        uint64_t framesDuplicate;       // 重复到达的帧（丢弃）
+        uint64_t malformedFrames;       // 无法解码或字段数不符的帧/行
+        uint64_t droppedRows;           // 消费端来不及取走而被丢弃的待取行数
+        uint64_t connectionsAccepted;
+        size_t activeConnections;
+        double elapsedSeconds;
+        double packetsPerSecond;
+        double rowsPerSecond;
+
+        SocketStats() : packetsReceived(0), bytesReceived(0), receiveCalls(0), framesDecoded(0),
+                        rowsDecoded(0), framesLost(0), framesOutOfOrder(0), framesDuplicate(0),
+                        malformedFrames(0), droppedRows(0), connectionsAccepted(0), activeConnections(0),
+                        elapsedSeconds(0.0), packetsPerSecond(0.0), rowsPerSecond(0.0) {}
+    };
+
+    static const uint32_t FRAME_MAGIC = 0x46534144u;    // "DASF"
+    static const size_t FRAME_HEADER_SIZE = 16;
+    // 单帧载荷上限；流式连接中超过上限的帧视为格式错误并断开连接
+    static const size_t MAX_FRAME_PAYLOAD = 1024 * 1024;
+
+    SocketDataSource();
+    ~SocketDataSource();
+
+    // DataSource 接口实现：config 见 SocketConfig
+    bool initialize(const std::string& config) override;
+    bool start() override;
+    void stop() override;
+    State getState() const override { return m_state.load(); }
+
+    // 最近解码的一行
+    std::vector<double> getData() override;
+    bool hasNewData() const override { return m_hasNewData.load(); }
+
+    // 模型由接收线程写入，其他线程通过 getDataModel()->snapshot() 读取一致的版本
+    std::shared_ptr<DataModel> getDataModel() const override { return m_dataModel; }
+
+    void setConfig(const SocketConfig& config) { m_config = config; }
+    SocketConfig getConfig() const { return m_config; }
+    static bool parseConfig(const std::string& text, SocketConfig& config, std::string& errorMessage);
+
+    // 实际监听的端口，start() 之后有效（配置为 0 时由系统分配）
+    int getBoundPort() const { return m_boundPort.load(); }
+
+    // 字段名，未配置时在收到第一个帧后确定
+    std::vector<std::string> getFieldNames() const override;
+
+    /**
+     * @brief 批量取走自上次调用以来解码的新行（线程安全）
+     *
+     * columns 按字段顺序每个字段一个数组，与内部缓冲交换，稳态下不产生内存分配
+     * @return 取到的行数
+     */
+    size_t takePendingRows(std::vector<std::vector<double> >& columns) override;
+
+    SocketStats getStatistics() const;
+
+    // 按二进制帧格式编码 rowCount 行（按行存放的 values）并追加到 out，供发送端使用
+    static void encodeFrame(uint32_t sequence, const double* values, size_t rowCount, size_t fieldCount,
+                            std::string& out);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // 每个发送端的序号跟踪：next 为期望的下一个序号，seen 的第 i 位表示 next-1-i 已收到
+    struct SequenceState {
+        bool started;
+        uint32_t next;
+        uint64_t seen;
+
+        SequenceState() : started(false), next(0), seen(0) {}
+    };
+
+    // 流式连接：未解码完的字节留在 buffer 中
+    struct Connection {
+        int fd;
+        std::vector<char> buffer;
+        size_t used;
+        SequenceState sequence;
+
+        Connection() : fd(-1), used(0) {}
+    };
+
+    bool openSocket(std::string& errorMessage);
+    void closeSockets();
+    void receiveThread();
+    void acceptConnections();
+    void receiveDatagrams();
+    // 返回 false 表示连接已关闭
+    bool receiveStream(Connection& connection);
+
+    // 解码一段完整数据（一个数据报）
+    void decodeDatagram(char* data, size_t size, SequenceState& sequence);
+    // 解码流式缓冲中的完整帧/行，返回已消费的字节数；格式错误无法继续时返回 -1
+    long decodeStream(char* data, size_t size, SequenceState& sequence);
+    // 解码一个二进制帧，返回帧长度；数据不足时返回 0，格式错误时返回 -1
+    long decodeFrame(const char* data, size_t size, SequenceState& sequence);
+    void decodeLine(char* begin, char* end);
+    // 按序号判断帧是否应追加，同时更新丢失/乱序/重复计数
+    bool acceptSequence(uint32_t sequence, SequenceState& state);
+    // 确认字段数与模型一致，未配置字段名时据此创建字段
+    bool ensureFields(size_t fieldCount);
+    void appendRow(const double* values);
+    // 一轮接收结束：限制模型大小、发布、移交待取行并通知
+    void finishBatch();
+
+    SocketConfig m_config;
+    std::shared_ptr<DataModel> m_dataModel;
+    std::atomic<State> m_state;
+    std::atomic<bool> m_hasNewData;
+    std::atomic<int> m_boundPort;
+    bool m_unlinkPath;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopRequested;
+    int m_socketFd;
+    int m_pollFd;
+    int m_wakePipe[2];
+
+    // 以下只由接收线程访问
+    std::vector<std::string> m_modelFields;
+    std::map<int, std::unique_ptr<Connection> > m_connections;
+    std::map<uint64_t, SequenceState> m_datagramSenders;
+    std::vector<char> m_datagramBuffer;
+    std::vector<double> m_row;
+    std::vector<std::vector<double> > m_batchColumns;
+    size_t m_batchRows;
+    SocketStats m_threadStats;
+
+    // 待取走的新行与统计（接收线程写入，消费端批量取走）
+    mutable std::mutex m_pendingMutex;
+    std::vector<std::string> m_fieldNames;
+    std::vector<std::vector<double> > m_pendingColumns;
+    std::vector<double> m_lastRow;
+    SocketStats m_stats;
+    Clock::time_point m_startTime;
+};
+
+#endif // SOCKETDATASOURCE_H
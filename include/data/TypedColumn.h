@@ -0,0 +1,88 @@
+#ifndef TYPEDCOLUMN_H
+#define TYPEDCOLUMN_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief 列的物理存储类型
+ */
+enum class ColumnType {
+    Bool,       // 位图，每值1位
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float32,
+    Float64
+};
+
+/**
+ * @brief 按物理类型紧凑存储的数据列
+ *
+ * 对外统一以 double 读写：写入的值必须能被该类型精确表示（见 canRepresent），
+ * 读取时由按类型实例化的转换循环批量展开为 double。
+ * 整数类型只接受 |v| <= 2^53 的值，保证与 double 往返无损。
+ * 复制列只增加存储的引用计数，修改被共享的存储前先复制（写时复制）。
+ * 丢弃开头的数据只移动起点，丢弃部分超过剩余数据时才整理到新存储。
+ */
+class TypedColumn {
+public:
+    explicit TypedColumn(ColumnType type = ColumnType::Float64);
+
+    ColumnType getType() const { return m_type; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void clear();
+    void reserve(size_t count);
+
+    // 整列替换；存在无法精确表示的值时返回 false 且内容不变
+    bool assign(const double* data, size_t count);
+    // 无法精确表示时返回 false，不追加
+    bool append(double value);
+    // 丢弃前 count 个值，均摊 O(1)
+    void dropFront(size_t count);
+
+    double valueAt(size_t index) const;
+    // 将 [startIndex, startIndex + count) 转换为 double 写入 output
+    void toDoubles(size_t startIndex, size_t count, double* output) const;
+
+    // 区间统计：最小/最大值、和、有效值数量（浮点类型跳过 NaN）
+    void computeRange(size_t startIndex, size_t endIndex,
+                      double& minValue, double& maxValue, double& sum, size_t& count) const;
+
+    size_t memoryBytes() const;
+
+    // === 类型信息 ===
+    static size_t elementBits(ColumnType type);
+    static bool isIntegral(ColumnType type);
+    static const char* typeName(ColumnType type);
+    static bool typeFromName(const std::string& name, ColumnType& type);
+    static bool canRepresent(ColumnType type, double value);
+
+    // 能精确表示全部数据的最窄类型
+    static ColumnType inferType(const double* data, size_t count);
+
+private:
+    template <typename T> T* typedData() { return reinterpret_cast<T*>(mutableStorage().data()); }
+    template <typename T> const T* typedData() const { return reinterpret_cast<const T*>(m_storage->data()); }
+
+    std::vector<uint64_t>& mutableStorage();
+    void ensureCapacity(size_t count);
+    void storeValue(size_t index, double value);
+
+    std::shared_ptr<std::vector<uint64_t> > m_storage;     // 按8字节对齐的原始存储，可被多个列共享
+    ColumnType m_type;
+    size_t m_size;
+    size_t m_offset;        // 存储中已丢弃的前部元素数，下标 i 对应存储中第 m_offset + i 个元素
+};
+
+#endif // TYPEDCOLUMN_H
@@ -0,0 +1,127 @@
+#ifndef BINARYEXPORTPLUGIN_H
+#define BINARYEXPORTPLUGIN_H
+
+#include "ExportPlugin.h"
+#include <vector>
+#include <map>
+
+/**
+ * @brief NumPy .npy/.npz 导出插件
+ *
+ * 每个字段写成一个一维 .npy 数组，按列存储直接写出，不做文本格式化。
+ * bundle 为 true（默认）时所有数组打包进一个不压缩的 .npz（ZIP stored），
+ * 各数组数据在文件中按64字节对齐；为 false 时每个字段写为 <文件名去扩展名>_<字段名>.npy，
+ * 可用 numpy.load(..., mmap_mode='r') 直接映射。
+ *
+ * 整数和布尔字段含空值时导出为 float64，空值为 NaN；浮点字段的空值为 NaN。
+ * 短于数据行数的字段在末尾按空值补齐。
+ */
+class NpyExportPlugin : public ExportPlugin {
+public:
+    NpyExportPlugin();
+    ~NpyExportPlugin() override;
+
+    // PluginInterface 实现
+    std::string getName() const override;
+    std::string getVersion() const override;
+    std::string getDescription() const override;
+    std::string getAuthor() const override;
+    std::vector<std::string> getDependencies() const override;
+
+    bool initialize() override;
+    bool shutdown() override;
+    bool isInitialized() const override;
+
+    bool processData(std::shared_ptr<DataModel> input,
+                    std::shared_ptr<DataModel> output) override;
+
+    bool setParameter(const std::string& key, const QVariant& value) override;
+    QVariant getParameter(const std::string& key) const override;
+    std::map<std::string, QVariant> getDefaultParameters() const override;
+    bool validateParameters() const override;
+
+    std::string getLastError() const override;
+    int getProcessingTime() const override;
+    size_t getProcessedCount() const override;
+
+    // ExportPlugin 实现
+    bool exportToFile(const std::string& filename,
+                     std::shared_ptr<DataModel> data) override;
+    std::vector<std::string> getSupportedFormats() const override;
+
+private:
+    bool m_bundle;
+    mutable std::string m_lastError;
+    int m_processingTime;
+    size_t m_processedCount;
+
+    bool writeNpzFile(const std::string& filename, std::shared_ptr<DataModel> data);
+    bool writeNpyFiles(const std::string& filename, std::shared_ptr<DataModel> data);
+};
+
+/**
+ * @brief Apache Arrow IPC 导出插件
+ *
+ * format 为 file（默认）时写 Arrow IPC 文件格式（.arrow/.feather），
+ * 可用 pyarrow.ipc.open_file(pyarrow.memory_map(path)) 零拷贝读取；
+ * 为 stream 时写 IPC 流格式（.arrows）。
+ * 元数据（FlatBuffers）由内置的最小编码器生成，不依赖 Arrow 库；
+ * 列数据按原类型直接写入消息体，空值写入有效位图。
+ * 每 batch_rows 行写一个记录批次。
+ *
+ * 支持增量导出：每次 appendBatch 写一个记录批次，Schema 按首个批次的字段类型确定，
+ * 之后批次的值按该类型写出；endStream 时写结束标记（文件格式再写 Footer）。
+ */
+class ArrowExportPlugin : public ExportPlugin {
+public:
+    ArrowExportPlugin();
+    ~ArrowExportPlugin() override;
+
+    // PluginInterface 实现
+    std::string getName() const override;
+    std::string getVersion() const override;
+    std::string getDescription() const override;
+    std::string getAuthor() const override;
+    std::vector<std::string> getDependencies() const override;
+
+    bool initialize() override;
+    bool shutdown() override;
+    bool isInitialized() const override;
+
+    bool processData(std::shared_ptr<DataModel> input,
+                    std::shared_ptr<DataModel> output) override;
+
+    bool setParameter(const std::string& key, const QVariant& value) override;
+    QVariant getParameter(const std::string& key) const override;
+    std::map<std::string, QVariant> getDefaultParameters() const override;
+    bool validateParameters() const override;
+
+    std::string getLastError() const override;
+    int getProcessingTime() const override;
+    size_t getProcessedCount() const override;
+
+    // ExportPlugin 实现
+    bool exportToFile(const std::string& filename,
+                     std::shared_ptr<DataModel> data) override;
+    std::vector<std::string> getSupportedFormats() const override;
+
+    bool supportsStreaming() const override { return true; }
+    bool beginStream(const std::string& filename, const std::vector<std::string>& fieldNames) override;
+    bool appendBatch(const DataModel& batch) override;
+    bool endStream() override;
+    uint64_t getStreamBytes() const override;
+
+private:
+    struct StreamState;             // 增量导出的文件和已写批次，定义在实现文件中
+
+    bool m_fileFormat;              // true: IPC 文件格式，false: IPC 流格式
+    size_t m_batchRows;
+    mutable std::string m_lastError;
+    int m_processingTime;
+    size_t m_processedCount;
+    std::unique_ptr<StreamState> m_stream;
+
+    bool writeArrowFile(const std::string& filename, std::shared_ptr<DataModel> data);
+};
+
+#endif // BINARYEXPORTPLUGIN_H
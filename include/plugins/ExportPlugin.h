@@ -2,6 +2,8 @@
 #define EXPORTPLUGIN_H
 
 #include "PluginInterface.h"
+#include <fstream>
+#include <cstdint>
 
 /**
  * @brief 导出插件基类
@@ -18,6 +20,16 @@ public:
     virtual bool exportToFile(const std::string& filename, 
                             std::shared_ptr<DataModel> data) = 0;
     virtual std::vector<std::string> getSupportedFormats() const = 0;
+    
+    // === 增量导出：先 beginStream，再按批 appendBatch，最后 endStream ===
+    // 批次中的字段按名称对应 beginStream 给出的字段，缺少的字段写为空值。
+    // 不支持增量导出的插件保留默认实现，失败原因见 getLastError()。
+    virtual bool supportsStreaming() const { return false; }
+    virtual bool beginStream(const std::string& filename, const std::vector<std::string>& fieldNames);
+    virtual bool appendBatch(const DataModel& batch);
+    virtual bool endStream();
+    // 当前流文件已写出的字节数
+    virtual uint64_t getStreamBytes() const { return 0; }
 };
 
 /**
@@ -56,15 +68,29 @@ public:
                      std::shared_ptr<DataModel> data) override;
     std::vector<std::string> getSupportedFormats() const override;
     
+    bool supportsStreaming() const override { return true; }
+    bool beginStream(const std::string& filename, const std::vector<std::string>& fieldNames) override;
+    bool appendBatch(const DataModel& batch) override;
+    bool endStream() override;
+    uint64_t getStreamBytes() const override { return m_streamBytes; }
+    
 private:
     std::string m_delimiter;
     bool m_includeHeader;
     std::string m_encoding;
+    int m_precision;                // 浮点列小数位数，-1 表示最短的无损往返表示
     mutable std::string m_lastError;
     int m_processingTime;
     size_t m_processedCount;
     
+    // 增量导出状态
+    std::ofstream m_streamFile;
+    std::vector<std::string> m_streamFields;
+    uint64_t m_streamBytes;
+    
     bool writeCSVFile(const std::string& filename, std::shared_ptr<DataModel> data);
+    std::string buildHeader(const std::vector<std::string>& fieldNames);
+    std::string escapeCSVField(const std::string& field);
 };
 
 #endif // EXPORTPLUGIN_H
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "PluginInterface.h"
 
+class ColumnBuffer;
+
 /**
  * @brief 插值插件基类
  */
@@ -61,7 +63,12 @@ private:
     int m_processingTime;
     size_t m_processedCount;
     
-    bool linearInterpolate(const std::vector<double>& x, const std::vector<double>& y,
+    bool processWithTimeField(std::shared_ptr<DataModel> input, std::shared_ptr<DataModel> output,
+                              const std::vector<std::string>& fieldNames);
+    bool processWithoutTimeField(std::shared_ptr<DataModel> input, std::shared_ptr<DataModel> output,
+                                 const std::vector<std::string>& fieldNames);
+    // x、y 为模型的列视图，按下标顺序读取，不需要连续内存
+    bool linearInterpolate(const ColumnBuffer& x, const ColumnBuffer& y,
                           std::vector<double>& newX, std::vector<double>& newY);
 };
 
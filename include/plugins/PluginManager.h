@@ -6,6 +6,8 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <functional>
+#include <mutex>
 
 // 前向声明
 class DataModel;
@@ -13,7 +15,8 @@ class DataModel;
 /**
  * @brief 插件管理器类
  * 
- * 负责插件的加载、管理和调度
+ * 负责插件的加载、管理和调度。
+ * 已加载的插件每个名称只有一个实例；需要多线程各自处理时通过插件工厂创建独立实例。
  */
 class PluginManager {
 public:
@@ -28,6 +31,16 @@ public:
     bool unloadPlugin(const std::string& name);
     bool reloadPlugin(const std::string& name);
     
+    // === 插件工厂 ===
+    typedef std::function<std::shared_ptr<PluginInterface>()> PluginFactory;
+    
+    // 注册按名称创建插件的工厂，内置插件已按类名注册；同名时覆盖
+    void registerFactory(const std::string& name, PluginFactory factory);
+    bool hasFactory(const std::string& name) const;
+    std::vector<std::string> getFactoryNames() const;
+    // 创建并初始化一个新实例，不加入已加载列表；名称未注册或初始化失败时返回空。线程安全
+    std::shared_ptr<PluginInterface> createPlugin(const std::string& name) const;
+    
     // === 插件查询 ===
     std::shared_ptr<PluginInterface> getPlugin(const std::string& name) const;
     std::vector<std::string> getLoadedPlugins() const;
@@ -67,7 +80,7 @@ public:
     std::map<std::string, PluginStats> getAllPluginStats() const;
 
 private:
-    PluginManager() = default;
+    PluginManager();
     ~PluginManager();
     
     struct PluginInfo {
@@ -79,6 +92,8 @@ private:
     };
     
     std::map<std::string, PluginInfo> m_plugins;
+    std::map<std::string, PluginFactory> m_factories;
+    mutable std::mutex m_factoryMutex;
     
     void updatePluginStats(const std::string& name, int processingTime, bool success);
 };
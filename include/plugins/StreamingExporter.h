@@ -0,0 +1,144 @@
+#ifndef STREAMINGEXPORTER_H
+#define STREAMINGEXPORTER_H
+
+#include "ExportPlugin.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+class DataModel;
+
+/**
+ * @brief 采集过程中的流式导出
+ *
+ * 采集线程用 appendRow/appendBatch 提交数据，按 batchRows 行封成批次放入有界队列；
+ * 专用写线程按到达顺序调用导出插件的 appendBatch 写出，不在内存中保留已写出的数据。
+ * 未满的批次在 flushIntervalMs 后也会写出，采集停顿时文件内容不落后太多。
+ *
+ * 文件按大小或时长轮转，文件名为 <baseName>_<YYYYmmdd_HHMMSS>_<序号><extension>。
+ * 队列满时默认阻塞提交线程直到写线程腾出位置，保证不丢数据；
+ * dropWhenFull 为 true 时改为丢弃新批次并计入 droppedRows，不阻塞采集。
+ * 写入失败后停止写出，之后提交的数据计入 droppedRows，错误通过错误回调报告。
+ *
+ * 写线程是长期阻塞的循环，不使用共享线程池。
+ */
+class StreamingExporter {
+public:
+    struct Config {
+        std::string directory;          // 输出目录，空表示当前目录
+        std::string baseName;           // 文件名前缀
+        std::string extension;          // 文件扩展名，含点
+        size_t batchRows;               // 每批行数
+        int flushIntervalMs;            // 未满批次的最长等待时间
+        size_t queueCapacity;           // 队列中最多的批次数
+        bool dropWhenFull;              // 队列满时丢弃而不是阻塞
+        uint64_t rotateBytes;           // 单个文件达到该大小后轮转，0 表示不按大小轮转
+        double rotateSeconds;           // 单个文件写满该时长后轮转，0 表示不按时间轮转
+
+        Config()
+            : baseName("recording"), extension(".csv"), batchRows(4096), flushIntervalMs(500),
+              queueCapacity(64), dropWhenFull(false), rotateBytes(0), rotateSeconds(0.0) {}
+    };
+
+    struct Metrics {
+        size_t queuedBatches;           // 等待写出的批次数（含未封装的当前批次）
+        size_t queuedRows;              // 等待写出的行数
+        size_t peakQueuedBatches;       // 队列中批次数的峰值
+        uint64_t rowsWritten;
+        uint64_t bytesWritten;          // 所有文件累计写出的字节数
+        uint64_t droppedRows;
+        size_t filesCompleted;          // 已轮转关闭的文件数
+        double elapsedSeconds;
+        double megabytesPerSecond;      // 写出吞吐量
+        double rowsPerSecond;
+        std::string currentFile;
+
+        Metrics()
+            : queuedBatches(0), queuedRows(0), peakQueuedBatches(0), rowsWritten(0), bytesWritten(0),
+              droppedRows(0), filesCompleted(0), elapsedSeconds(0.0), megabytesPerSecond(0.0),
+              rowsPerSecond(0.0) {}
+    };
+
+    typedef std::function<void(const std::string&)> ErrorCallback;
+
+    // plugin 由本对象独占使用，应是新建的实例（PluginManager::createPlugin）
+    StreamingExporter(std::shared_ptr<ExportPlugin> plugin, const Config& config = Config());
+    ~StreamingExporter();
+
+    StreamingExporter(const StreamingExporter&) = delete;
+    StreamingExporter& operator=(const StreamingExporter&) = delete;
+
+    // 打开第一个文件并启动写线程；插件不支持增量导出或文件无法创建时返回 false
+    bool start(const std::vector<std::string>& fieldNames, std::string* errorMessage = nullptr);
+    // 写出队列中剩余的数据，关闭当前文件并结束写线程
+    void stop();
+    bool isRunning() const;
+
+    // 提交一行，values 按 start 时的字段顺序，count 少于字段数时其余字段记为空值
+    void appendRow(const double* values, size_t count);
+    // 提交一个完整批次，按字段名对应；提交后调用方不应再修改 batch
+    void appendBatch(std::shared_ptr<const DataModel> batch);
+
+    Metrics getMetrics() const;
+    std::string getLastError() const;
+    // 回调在写线程中调用
+    void setErrorCallback(ErrorCallback callback);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    std::shared_ptr<ExportPlugin> m_plugin;
+    Config m_config;
+    std::vector<std::string> m_fieldNames;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notEmpty;         // 有批次可写或需要停止
+    std::condition_variable m_notFull;          // 队列腾出位置或写出失败
+    std::deque<std::shared_ptr<const DataModel> > m_queue;
+    std::vector<std::vector<double> > m_pendingColumns;     // 正在积累的批次，按列
+    std::vector<std::vector<uint64_t> > m_pendingValidity;  // 空表示该列本批没有空值
+    size_t m_pendingRows;
+    size_t m_queuedRows;
+    Clock::time_point m_pendingSince;
+    bool m_running;
+    bool m_stopping;
+    bool m_failed;
+
+    std::thread m_writer;
+    std::string m_lastError;
+    ErrorCallback m_errorCallback;
+
+    // 统计，受 m_mutex 保护
+    size_t m_peakQueuedBatches;
+    uint64_t m_rowsWritten;
+    uint64_t m_bytesWritten;
+    uint64_t m_droppedRows;
+    size_t m_filesCompleted;
+    uint64_t m_fileBytes;                       // 当前文件已写字节数，用于汇总 m_bytesWritten
+    size_t m_fileSequence;
+    std::string m_currentFile;
+    Clock::time_point m_startTime;
+    Clock::time_point m_stopTime;
+    Clock::time_point m_fileOpened;
+
+    void writerLoop();
+    // 把积累的行封成一个批次取出，调用前持有 m_mutex
+    std::shared_ptr<const DataModel> takePendingLocked(size_t& rows);
+    // 等待队列有位置后放入批次；队列满且允许丢弃或已写出失败时丢弃并计数
+    void enqueueLocked(std::unique_lock<std::mutex>& lock, std::shared_ptr<const DataModel> batch, size_t rows);
+    // 以下在写线程中调用，不持有 m_mutex
+    bool openNextFile(std::string& errorMessage);
+    bool finishFile(std::string& errorMessage);
+    bool shouldRotate() const;
+    std::string nextFileName();
+    void reportError(const std::string& message);
+};
+
+#endif // STREAMINGEXPORTER_H
@@ -0,0 +1,19 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief CRC-32（ZIP/zlib 使用的多项式 0xEDB88320）
+ *
+ * 按 slicing-by-8 查表，每次处理8字节。分段计算时把上一段的结果作为 crc 传入，
+ * 初始值为0：update(update(0, a, n), b, m) 等于整段的 CRC。
+ */
+class Crc32 {
+public:
+    static uint32_t update(uint32_t crc, const void* data, size_t size);
+    static uint32_t compute(const void* data, size_t size) { return update(0, data, size); }
+};
+
+#endif // CRC32_H
@@ -0,0 +1,40 @@
+#ifndef FILEUTILS_H
+#define FILEUTILS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief 文件系统工具（stat/dirent 实现，不依赖 std::filesystem）
+ */
+class FileUtils {
+public:
+    struct FileInfo {
+        std::string path;
+        uint64_t size;
+        int64_t modifiedTime;   // 秒
+
+        FileInfo() : size(0), modifiedTime(0) {}
+    };
+
+    static bool getFileInfo(const std::string& path, FileInfo& info);
+    static bool exists(const std::string& path);
+    static bool isDirectory(const std::string& path);
+
+    // 逐级创建目录，已存在时返回true
+    static bool createDirectories(const std::string& path);
+
+    // 列出目录下指定扩展名的普通文件（不递归），extension 为空时列出全部
+    static std::vector<FileInfo> listFiles(const std::string& directory,
+                                           const std::string& extension = std::string());
+
+    // 将修改时间更新为当前时间
+    static bool touch(const std::string& path);
+    static bool removeFile(const std::string& path);
+
+    static std::string joinPath(const std::string& directory, const std::string& name);
+    static std::string getTempDirectory();
+};
+
+#endif // FILEUTILS_H
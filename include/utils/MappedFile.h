@@ -0,0 +1,42 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief 只读内存映射文件
+ *
+ * POSIX 下使用 mmap，Windows 下使用 CreateFileMapping/MapViewOfFile。
+ * 映射期间 data() 返回的指针一直有效，析构或 close() 时解除映射。
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_isOpen; }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    // 禁止拷贝
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* m_data;
+    size_t m_size;
+    bool m_isOpen;
+    std::string m_lastError;
+
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_H
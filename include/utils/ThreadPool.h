@@ -0,0 +1,183 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief 进程共享的工作窃取线程池
+ *
+ * 每个工作线程有自己的任务队列：本线程提交的任务压到队尾并从队尾取（后进先出，缓存友好），
+ * 空闲时从其他线程的队头窃取；非工作线程提交的任务进入公共队列。
+ * 等待任务组的线程会帮忙执行任务，因此任务中可以再嵌套 parallelFor 而不会死锁。
+ *
+ * 所有并行处理共用这一个线程池，多个功能同时运行时线程总数不超过配置值。
+ * 长期阻塞的循环（如实时数据生成）不应放进线程池，以免占住工作线程。
+ */
+class ThreadPool {
+public:
+    typedef std::function<void()> Task;
+
+    struct Stats {
+        uint64_t executed;      // 已执行的任务数
+        uint64_t stolen;        // 从其他工作线程窃取的任务数
+
+        Stats() : executed(0), stolen(0) {}
+    };
+
+    static ThreadPool& getInstance();
+
+    /**
+     * @brief 重新设置工作线程数和CPU绑定
+     * @param threadCount 工作线程数，0 表示按CPU核数
+     * @param pinThreads 是否把第 i 个工作线程绑定到第 i 个CPU（不支持的平台忽略）
+     *
+     * 会等待已提交的任务完成后重建工作线程，应在启动时、没有并行任务运行时调用。
+     */
+    void configure(size_t threadCount, bool pinThreads);
+    size_t getThreadCount() const { return m_threadCount.load(); }
+    bool isPinned() const { return m_pinThreads; }
+    Stats getStats() const;
+
+    void submit(Task task);
+    // 在当前线程执行一个待处理任务（用于等待时帮忙），没有可执行的任务时返回 false
+    bool runPendingTask();
+    bool isWorkerThread() const;
+
+    /**
+     * @brief 把 [begin, end) 切成若干段并行执行 body(rangeBegin, rangeEnd)
+     * @param grain 每段的最小长度，0 表示按线程数自动选择
+     *
+     * 当前线程也参与执行；任一段抛出的异常在所有段结束后重新抛出。
+     */
+    template <typename Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, Body body);
+
+    /**
+     * @brief 分段计算后按段的顺序合并，结果与线程数和调度无关
+     *
+     * map(rangeBegin, rangeEnd) 返回该段的结果，combine(累计值, 段结果) 返回新的累计值。
+     */
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(size_t begin, size_t end, size_t grain, T identity, Map map, Combine combine);
+
+private:
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::thread thread;
+    };
+
+    ThreadPool();
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    void start(size_t threadCount);
+    void stop();
+    void workerLoop(size_t index);
+    bool takeTask(int workerIndex, bool fromShared, Task& task);
+    void execute(Task& task);
+    size_t chunkSize(size_t count, size_t grain) const;
+
+    std::vector<std::unique_ptr<Worker> > m_workers;
+    std::deque<Task> m_sharedTasks;             // 非工作线程提交的任务
+    std::mutex m_sharedMutex;
+
+    std::atomic<size_t> m_pendingTasks;         // 已提交未取走的任务数
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_stopping;
+
+    std::atomic<size_t> m_threadCount;
+    bool m_pinThreads;
+    std::mutex m_configureMutex;
+    std::atomic<uint64_t> m_executed;
+    std::atomic<uint64_t> m_stolen;
+};
+
+/**
+ * @brief 一组在线程池中运行的任务，可整体等待和取消
+ *
+ * 取消后尚未开始的任务不再执行，已开始的任务可通过 isCancelled() 提前结束。
+ * 任务抛出的第一个异常会取消整组，并在 wait() 中重新抛出。析构时自动等待。
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::getInstance());
+    ~TaskGroup();
+
+    void run(std::function<void()> task);
+    void wait();
+    void cancel() { m_cancelled.store(true); }
+    bool isCancelled() const { return m_cancelled.load(); }
+
+private:
+    TaskGroup(const TaskGroup&);
+    TaskGroup& operator=(const TaskGroup&);
+
+    void finishTask();
+
+    ThreadPool& m_pool;
+    std::atomic<size_t> m_pending;
+    std::atomic<bool> m_cancelled;
+    std::mutex m_mutex;
+    std::condition_variable m_doneCondition;
+    std::exception_ptr m_error;
+};
+
+template <typename Body>
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, Body body) {
+    if (begin >= end) {
+        return;
+    }
+
+    size_t chunk = chunkSize(end - begin, grain);
+    if (chunk >= end - begin) {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group(*this);
+    for (size_t rangeBegin = begin; rangeBegin < end; rangeBegin += chunk) {
+        size_t rangeEnd = std::min(end, rangeBegin + chunk);
+        group.run([&body, rangeBegin, rangeEnd]() { body(rangeBegin, rangeEnd); });
+    }
+    group.wait();
+}
+
+template <typename T, typename Map, typename Combine>
+T ThreadPool::parallelReduce(size_t begin, size_t end, size_t grain, T identity, Map map, Combine combine) {
+    if (begin >= end) {
+        return identity;
+    }
+
+    size_t chunk = chunkSize(end - begin, grain);
+    size_t chunkCount = (end - begin + chunk - 1) / chunk;
+    // 不用 std::vector：vector<bool> 的元素共享存储字，并行写入不安全
+    std::deque<T> partials(chunkCount, identity);
+
+    parallelFor(0, chunkCount, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            size_t rangeBegin = begin + i * chunk;
+            partials[i] = map(rangeBegin, std::min(end, rangeBegin + chunk));
+        }
+    });
+
+    T result = identity;
+    for (size_t i = 0; i < partials.size(); ++i) {
+        result = combine(result, partials[i]);
+    }
+    return result;
+}
+
+#endif // THREADPOOL_H
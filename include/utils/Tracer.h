@@ -0,0 +1,149 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <cstdint>
+
+/**
+ * @brief 进程内跟踪：记录耗时区间，导出为 Chrome trace-event JSON
+ *
+ * 每个线程把区间写入自己的缓冲（只有本线程写，不加锁），导出时汇总所有线程的缓冲。
+ * 未启用时 TRACE_SCOPE 只有一次原子读和一次分支；定义 NO_TRACING 时宏展开为空。
+ * 导出文件可直接在 chrome://tracing 或 ui.perfetto.dev 中打开。
+ *
+ * 区间名称和分类须在程序运行期间一直有效（通常为字符串字面量）；
+ * 运行时才知道的名称（如插件名）经 intern() 保存一份。
+ */
+class Tracer {
+public:
+    static Tracer& getInstance();
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    // 丢弃已记录的区间；各线程在下一次记录时清空自己的缓冲
+    void clear();
+
+    // 为当前线程命名，显示在跟踪视图的线程标题中
+    void setThreadName(const std::string& name);
+    const char* intern(const std::string& text);
+
+    void record(const char* category, const char* name, int64_t startNs, int64_t endNs);
+    // 相对于跟踪起点的纳秒数
+    int64_t nowNs() const;
+
+    size_t eventCount() const;
+    // 单个线程的缓冲写满后丢弃的区间数
+    uint64_t droppedCount() const;
+
+    void writeChromeTrace(std::ostream& out) const;
+    bool writeChromeTrace(const std::string& filename, std::string& errorMessage) const;
+
+    static const size_t EVENTS_PER_CHUNK = 4096;
+    static const size_t MAX_CHUNKS_PER_THREAD = 256;   // 每个线程最多约 100 万个区间
+
+private:
+    struct Event {
+        const char* category;
+        const char* name;
+        int64_t startNs;
+        int64_t durationNs;
+    };
+
+    struct Chunk {
+        Event events[EVENTS_PER_CHUNK];
+        std::atomic<size_t> count;
+        std::atomic<Chunk*> next;
+
+        Chunk() : count(0), next(nullptr) {}
+    };
+
+    // 一个线程的区间缓冲：本线程追加，导出线程按已发布的 count 读取
+    struct ThreadBuffer {
+        ThreadBuffer(uint32_t threadId, uint64_t generation);
+        ~ThreadBuffer();
+
+        uint32_t threadId;
+        std::atomic<const char*> threadName;
+        std::atomic<uint64_t> generation;
+        std::atomic<uint64_t> dropped;
+        std::atomic<bool> retired;      // 所属线程已退出
+        Chunk* head;
+        Chunk* tail;                    // 只由所属线程访问
+        size_t chunkCount;
+    };
+
+    class ThreadHandle;
+    friend class ThreadHandle;
+
+    Tracer();
+    Tracer(const Tracer&);
+    Tracer& operator=(const Tracer&);
+
+    ThreadBuffer& localBuffer();
+    void resetBuffer(ThreadBuffer& buffer, uint64_t generation);
+
+    static std::atomic<bool> s_enabled;
+
+    const int64_t m_originNs;
+    std::atomic<uint64_t> m_generation;
+    std::atomic<uint32_t> m_nextThreadId;
+    mutable std::mutex m_mutex;                         // 保护线程列表和字符串表
+    std::vector<std::shared_ptr<ThreadBuffer> > m_buffers;
+    std::set<std::string> m_strings;
+};
+
+/**
+ * @brief 作用域区间：构造时记下开始时间，析构时记录
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(category), m_name(Tracer::isEnabled() ? name : nullptr), m_startNs(0) {
+        if (m_name) {
+            m_startNs = Tracer::getInstance().nowNs();
+        }
+    }
+
+    TraceScope(const char* category, const std::string& name)
+        : m_category(category), m_name(nullptr), m_startNs(0) {
+        if (Tracer::isEnabled()) {
+            Tracer& tracer = Tracer::getInstance();
+            m_name = tracer.intern(name);
+            m_startNs = tracer.nowNs();
+        }
+    }
+
+    ~TraceScope() {
+        if (m_name) {
+            Tracer& tracer = Tracer::getInstance();
+            tracer.record(m_category, m_name, m_startNs, tracer.nowNs());
+        }
+    }
+
+private:
+    TraceScope(const TraceScope&);
+    TraceScope& operator=(const TraceScope&);
+
+    const char* m_category;
+    const char* m_name;
+    int64_t m_startNs;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef NO_TRACING
+#define TRACE_SCOPE(category, name)
+#else
+// name 为字符串字面量或 std::string
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+#endif
+
+#endif // TRACER_H
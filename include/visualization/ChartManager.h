@@ -9,6 +9,7 @@
 // 前向声明
 class QCustomPlot;
 class DataModel;
+class ColumnBuffer;
 class QCPGraph;
 
 /**
@@ -65,7 +66,11 @@ public:
     // === 数据更新 ===
     void updateGraphData(const QString& name, 
                         const QVector<double>& xData, 
-                        const QVector<double>& yData);
+                        const QVector<double>& yData,
+                        bool alreadySorted = false);
+    // 直接从列内存填充曲线数据，不产生中间副本
+    void setGraphData(const QString& name, const double* xData, const double* yData, size_t count);
+    void setGraphData(const QString& name, const ColumnBuffer& xData, const ColumnBuffer& yData);
     void addDataPoint(const QString& name, double x, double y);
     void clearGraphData(const QString& name = QString());
     
@@ -81,6 +86,7 @@ public:
     void setAxisLabels(const QString& xLabel, const QString& yLabel);
     void setAxisAutoScale(bool autoScale);
     void fitToData();
+    void fitToRange(double xMin, double xMax, double yMin, double yMax);
     
     // === 图例管理 ===
     void setLegendVisible(bool visible);
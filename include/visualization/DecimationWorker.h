@@ -0,0 +1,84 @@
+#ifndef DECIMATIONWORKER_H
+#define DECIMATIONWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QSharedPointer>
+#include <QMetaType>
+#include <atomic>
+#include <string>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include "data/DataDecimator.h"
+
+// 前向声明
+class DataModel;
+class LodPyramid;
+
+/**
+ * @brief 降采样请求
+ */
+struct DecimationRequest {
+    quint64 generation;                 // 请求代数，用于丢弃过期结果
+    QString seriesName;
+    QSharedPointer<DataModel> dataModel;
+    std::string xField;
+    std::string yField;
+    double xMin;
+    double xMax;
+    int pixelWidth;
+    DataDecimator::Mode mode;
+
+    DecimationRequest()
+        : generation(0), xMin(0.0), xMax(0.0), pixelWidth(0),
+          mode(DataDecimator::Mode::MinMax) {}
+};
+
+Q_DECLARE_METATYPE(DecimationRequest)
+Q_DECLARE_METATYPE(QSharedPointer<DataModel>)
+
+/**
+ * @brief 降采样工作对象
+ *
+ * 运行在独立线程中，根据当前可见范围和像素宽度对曲线数据降采样，
+ * 结果通过信号回到GUI线程。
+ *
+ * 每个 y 列的LOD金字塔在模型加载完成后由 prepare() 并行构建（未预先构建时在首次请求时构建），
+ * 数据追加后按需增量扩展，开头的行被丢弃时同步丢弃，因此任意缩放级别只读取 O(像素数) 个节点。
+ * 缓存按模型实例编号与结构版本号区分，不依赖模型地址
+ */
+class DecimationWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DecimationWorker(QObject* parent = nullptr);
+
+    // 由GUI线程设置最新请求代数，工作线程据此跳过排队中的过期请求
+    void setLatestGeneration(quint64 generation);
+
+public slots:
+    // 为模型中 xField 以外的所有列并行构建LOD金字塔，供之后的请求直接使用
+    void prepare(const QSharedPointer<DataModel>& dataModel, const QString& xField);
+    void process(const DecimationRequest& request);
+
+signals:
+    void decimated(quint64 generation, const QString& seriesName,
+                   const QVector<double>& xData, const QVector<double>& yData);
+
+private:
+    void preparePyramids(const DecimationRequest& request);
+    // 模型实例或结构版本变化时并行重建 xField 以外的所有列
+    void rebuildPyramids(const DataModel& model, const std::string& xField);
+
+    std::atomic<quint64> m_latestGeneration;
+
+    // LOD金字塔缓存（只在工作线程中访问）
+    uint64_t m_pyramidModelId;          // DataModel::getInstanceId()，0 表示尚未构建
+    size_t m_pyramidRevision;
+    size_t m_pyramidRemovedRows;        // DataModel::getRemovedRowCount()
+    std::map<std::string, std::shared_ptr<LodPyramid> > m_pyramids;
+};
+
+#endif // DECIMATIONWORKER_H
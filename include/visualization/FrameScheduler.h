@@ -0,0 +1,65 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+/**
+ * @brief 帧调度器
+ *
+ * 合并两帧之间的所有重绘请求，按刷新率（display/refresh_rate）
+ * 最多每帧触发一次 frameRequested 信号。没有待处理请求时定时器停止，
+ * 空闲时不产生唤醒。
+ *
+ * frameRequested 的接收者应使用直接连接，帧耗时统计才包含绘制时间。
+ */
+class FrameScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 帧耗时统计
+     */
+    struct FrameStats {
+        quint64 frameCount;         // 已绘制帧数
+        quint64 requestCount;       // 收到的重绘请求数
+        quint64 coalescedCount;     // 被合并掉的请求数
+        double lastFrameMs;         // 最近一帧耗时（毫秒）
+        double averageFrameMs;      // 平均帧耗时
+        double maxFrameMs;          // 最大帧耗时
+        double actualFps;           // 实际帧率
+
+        FrameStats()
+            : frameCount(0), requestCount(0), coalescedCount(0),
+              lastFrameMs(0.0), averageFrameMs(0.0), maxFrameMs(0.0), actualFps(0.0) {}
+    };
+
+    explicit FrameScheduler(QObject* parent = nullptr);
+
+    void setRefreshRate(int framesPerSecond);
+    int getRefreshRate() const { return m_refreshRate; }
+
+    FrameStats getStats() const { return m_stats; }
+    void resetStats();
+
+public slots:
+    // 请求在下一帧重绘，同一帧内的多次请求只绘制一次
+    void requestFrame();
+
+signals:
+    void frameRequested();
+
+private slots:
+    void onTimeout();
+
+private:
+    QTimer m_timer;
+    QElapsedTimer m_fpsClock;
+    int m_refreshRate;
+    bool m_pending;
+    quint64 m_framesSinceClock;
+    FrameStats m_stats;
+};
+
+#endif // FRAMESCHEDULER_H
@@ -0,0 +1,29 @@
+#ifndef PLOTDATABRIDGE_H
+#define PLOTDATABRIDGE_H
+
+#include <QSharedPointer>
+#include <QCustomPlot>
+#include <cstddef>
+#include "data/ColumnBuffer.h"
+
+/**
+ * @brief DataModel列内存到QCustomPlot曲线数据的桥接
+ *
+ * 直接从两列内存（连续数组或分块的 ColumnBuffer）一次填充 QCPGraphDataContainer，
+ * 不经过中间的 std::vector / QVector 副本；x已有序时不再排序，
+ * 否则只做一次排序。生成的容器以共享指针交给曲线，不再复制。
+ */
+class PlotDataBridge {
+public:
+    static QSharedPointer<QCPGraphDataContainer> toGraphData(const double* x, const double* y,
+                                                             size_t count);
+
+    // 按列的连续片段逐段填充，分块的列不先拼成连续数组；count 取两列长度的较小值
+    static QSharedPointer<QCPGraphDataContainer> toGraphData(const ColumnBuffer& x, const ColumnBuffer& y);
+
+    // 用列内存替换曲线数据
+    static void setGraphData(QCPGraph* graph, const double* x, const double* y, size_t count);
+    static void setGraphData(QCPGraph* graph, const ColumnBuffer& x, const ColumnBuffer& y);
+};
+
+#endif // PLOTDATABRIDGE_H
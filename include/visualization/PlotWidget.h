@@ -7,11 +7,15 @@
 #include <QMap>
 #include <QSharedPointer>
 #include <memory>
+#include "data/DataDecimator.h"
+#include "FrameScheduler.h"
 
 // 前向声明
 class DataModel;
 class InteractionHandler;
 class ChartManager;
+class DecimationWorker;
+class QThread;
 
 /**
  * @brief 主绘图控件类
@@ -35,6 +39,8 @@ public:
     void addDataSeries(const QString& name, const QVector<double>& xData, 
                       const QVector<double>& yData);
     void addRealTimeData(const QString& seriesName, double x, double y);
+    void addRealTimeBatch(const QString& seriesName, const QVector<double>& xData,
+                          const QVector<double>& yData);
     void clearData();
     void clearSeries(const QString& seriesName = QString());
     
@@ -45,6 +51,14 @@ public:
     void setAxisRange(double xMin, double xMax, double yMin, double yMax);
     void setAutoScale(bool autoScale);
     
+    // === 降采样 ===
+    void setDecimationMode(DataDecimator::Mode mode);
+    DataDecimator::Mode getDecimationMode() const { return m_decimationMode; }
+    
+    // === 刷新控制 ===
+    void setRefreshRate(int framesPerSecond);
+    FrameScheduler::FrameStats getFrameStats() const;
+    
     // === 曲线样式 ===
     void setSeriesColor(const QString& seriesName, const QColor& color);
     void setSeriesWidth(const QString& seriesName, double width);
@@ -70,6 +84,8 @@ public:
 public slots:
     void onDataUpdated();
     void onRealTimeDataAdded(const QString& seriesName, double x, double y);
+    void onRealTimeBatchReady(const QString& xField, const QVector<double>& xData,
+                              const QMap<QString, QVector<double>>& seriesData);
     void onSeriesVisibilityChanged(const QString& seriesName, bool visible);
     void onReplotRequested();
 
@@ -87,12 +103,21 @@ private slots:
     void onMouseWheel(QWheelEvent* event);
     void onSelectionChanged();
     void onLegendClick(QCPLegend* legend, QCPAbstractLegendItem* item, QMouseEvent* event);
+    void onXAxisRangeChanged(const QCPRange& newRange);
+    void onDecimated(quint64 generation, const QString& seriesName,
+                     const QVector<double>& xData, const QVector<double>& yData);
+    void onFrame();
 
 private:
     void setupPlot();
     void setupInteractions();
     void setupLegend();
+    void setupDecimation();
+    void requestDecimation();
     void updatePlot();
+    void setSeriesData(const QString& name, const QVector<double>& xData, 
+                       const QVector<double>& yData);
+    void setSeriesData(const QString& name, const ColumnBuffer& xData, const ColumnBuffer& yData);
     void autoScaleAxes();
     void showValueTooltip(double x, double y, const QPoint& screenPos);
     QColor generateColor(int index) const;
@@ -111,6 +136,21 @@ private:
     bool m_showTooltips;
     bool m_isRealTime;
     
+    // 降采样（在独立线程中按可见范围计算）
+    QThread* m_decimationThread;
+    DecimationWorker* m_decimationWorker;
+    DataDecimator::Mode m_decimationMode;
+    quint64 m_decimationGeneration;
+    QString m_xFieldName;
+    
+    // 实时数据：两帧之间的新点先缓存，每帧批量追加并重绘一次
+    struct PendingSamples {
+        QVector<double> xData;
+        QVector<double> yData;
+    };
+    FrameScheduler* m_frameScheduler;
+    QMap<QString, PendingSamples> m_pendingSamples;
+    
     // 样式配置
     QFont m_titleFont;
     QFont m_axisFont;
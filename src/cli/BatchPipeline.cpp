@@ -0,0 +1,187 @@
+#include "cli/BatchPipeline.h"
+#include "plugins/PluginManager.h"
+#include "utils/FileUtils.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+static std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+static bool parseBool(const std::string& value, bool& result) {
+    if (value == "true" || value == "1" || value == "yes") {
+        result = true;
+        return true;
+    }
+    if (value == "false" || value == "0" || value == "no") {
+        result = false;
+        return true;
+    }
+    return false;
+}
+
+static bool parseInt(const std::string& value, int& result) {
+    char* end = nullptr;
+    long parsed = std::strtol(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0') {
+        return false;
+    }
+    result = static_cast<int>(parsed);
+    return true;
+}
+
+bool BatchPipeline::loadFromFile(const std::string& filename, std::string& errorMessage) {
+    std::ifstream file(filename.c_str());
+    if (!file.is_open()) {
+        errorMessage = "无法打开流水线描述文件: " + filename;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return loadFromString(buffer.str(), errorMessage);
+}
+
+bool BatchPipeline::loadFromString(const std::string& text, std::string& errorMessage) {
+    std::istringstream ss(text);
+    std::string line;
+    int lineNumber = 0;
+    std::vector<std::string> pluginNames;
+    std::map<std::string, std::map<std::string, std::string> > pluginParameters;
+
+    while (std::getline(ss, line)) {
+        lineNumber++;
+        line = trim(line);
+
+        // 跳过空行和注释
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+
+        size_t pos = line.find('=');
+        if (pos == std::string::npos) {
+            errorMessage = "第 " + std::to_string(lineNumber) + " 行缺少 '='";
+            return false;
+        }
+
+        std::string key = trim(line.substr(0, pos));
+        std::string value = trim(line.substr(pos + 1));
+        bool valid = true;
+
+        if (key == "source/type") {
+            sourceType = value;
+        } else if (key == "source/delimiter") {
+            if (value == "\\t" || value == "tab") {
+                delimiter = '\t';
+            } else if (value == "space") {
+                delimiter = ' ';
+            } else {
+                valid = value.size() == 1;
+                delimiter = valid ? value[0] : delimiter;
+            }
+        } else if (key == "source/has_header") {
+            valid = parseBool(value, hasHeader);
+        } else if (key == "source/skip_lines") {
+            valid = parseInt(value, skipLines) && skipLines >= 0;
+        } else if (key == "source/parse_cache") {
+            valid = parseBool(value, useParseCache);
+        } else if (key == "pipeline/plugins") {
+            pluginNames.clear();
+            std::istringstream names(value);
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                name = trim(name);
+                if (!name.empty()) {
+                    pluginNames.push_back(name);
+                }
+            }
+        } else if (key.compare(0, 7, "plugin/") == 0) {
+            // plugin/<插件名>/<参数名>
+            size_t slash = key.find('/', 7);
+            valid = slash != std::string::npos && slash > 7 && slash + 1 < key.size();
+            if (valid) {
+                pluginParameters[key.substr(7, slash - 7)][key.substr(slash + 1)] = value;
+            }
+        } else if (key == "export/plugin") {
+            exportPlugin = value;
+        } else if (key == "export/directory") {
+            outputDirectory = value.empty() ? "." : value;
+        } else if (key == "export/suffix") {
+            outputSuffix = value;
+        } else if (key.compare(0, 13, "export/param/") == 0 && key.size() > 13) {
+            exportParameters[key.substr(13)] = value;
+        } else if (key == "run/workers") {
+            valid = parseInt(value, workers) && workers >= 0;
+        } else if (key == "report/json") {
+            reportPath = value;
+        } else {
+            errorMessage = "第 " + std::to_string(lineNumber) + " 行: 未知配置项 " + key;
+            return false;
+        }
+
+        if (!valid) {
+            errorMessage = "第 " + std::to_string(lineNumber) + " 行: 无效的值 " + key + " = " + value;
+            return false;
+        }
+    }
+
+    plugins.clear();
+    for (size_t i = 0; i < pluginNames.size(); ++i) {
+        PluginStep step;
+        step.name = pluginNames[i];
+        std::map<std::string, std::map<std::string, std::string> >::const_iterator it =
+            pluginParameters.find(step.name);
+        if (it != pluginParameters.end()) {
+            step.parameters = it->second;
+        }
+        plugins.push_back(step);
+    }
+
+    return true;
+}
+
+bool BatchPipeline::validate(std::string& errorMessage) const {
+    if (sourceType != "csv" && sourceType != "custom" && sourceType != "snapshot") {
+        errorMessage = "不支持的数据源类型: " + sourceType;
+        return false;
+    }
+
+    PluginManager& manager = PluginManager::getInstance();
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        if (!manager.hasFactory(plugins[i].name)) {
+            errorMessage = "未注册的插件: " + plugins[i].name;
+            return false;
+        }
+    }
+    if (!exportPlugin.empty() && !manager.hasFactory(exportPlugin)) {
+        errorMessage = "未注册的导出插件: " + exportPlugin;
+        return false;
+    }
+    return true;
+}
+
+std::string BatchPipeline::outputPathFor(const std::string& inputPath) const {
+    size_t slash = inputPath.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? inputPath : inputPath.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos && dot > 0) {
+        name = name.substr(0, dot);
+    }
+    return FileUtils::joinPath(outputDirectory, name + outputSuffix);
+}
+
+std::string BatchPipeline::inputExtension() const {
+    if (sourceType == "csv") {
+        return ".csv";
+    }
+    if (sourceType == "snapshot") {
+        return ".snap";
+    }
+    return std::string();
+}
@@ -0,0 +1,332 @@
+#include "cli/BatchRunner.h"
+#include "data/DataModel.h"
+#include "data/CSVDataSource.h"
+#include "data/CustomDataSource.h"
+#include "data/SnapshotDataSource.h"
+#include "plugins/PluginManager.h"
+#include "plugins/ExportPlugin.h"
+#include "utils/FileUtils.h"
+#include "utils/Tracer.h"
+#include "utils/ThreadPool.h"
+#include <QVariant>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size() + 2);
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        switch (c) {
+        case '"':  escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\r': escaped += "\\r"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            if (c < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                escaped += buffer;
+            } else {
+                escaped += static_cast<char>(c);
+            }
+        }
+    }
+    return escaped;
+}
+
+BatchRunner::BatchRunner(const BatchPipeline& pipeline)
+    : m_pipeline(pipeline), m_cancelRequested(false) {}
+
+void BatchRunner::setFileCallback(std::function<void(const FileResult&, size_t, size_t)> callback) {
+    m_fileCallback = callback;
+}
+
+int BatchRunner::resolveWorkerCount(int configured, size_t fileCount) {
+    int workers = configured;
+    if (workers <= 0) {
+        workers = static_cast<int>(ThreadPool::getInstance().getThreadCount());
+    }
+    workers = std::max(workers, 1);
+    if (fileCount > 0 && static_cast<size_t>(workers) > fileCount) {
+        workers = static_cast<int>(fileCount);
+    }
+    return workers;
+}
+
+BatchRunner::Summary BatchRunner::run(const std::vector<std::string>& files) {
+    Summary summary;
+    summary.files = files.size();
+    summary.workers = resolveWorkerCount(m_pipeline.workers, files.size());
+
+    m_results.assign(files.size(), FileResult());
+    m_cancelRequested.store(false);
+    if (files.empty()) {
+        return summary;
+    }
+
+    if (!m_pipeline.exportPlugin.empty()) {
+        FileUtils::createDirectories(m_pipeline.outputDirectory);
+    }
+
+    Clock::time_point start = Clock::now();
+    std::atomic<size_t> nextIndex(0);
+    size_t completed = 0;
+
+    // 每个工作任务领取下一个未处理的文件，结果写入各自的下标，无需加锁
+    auto worker = [&]() {
+        while (!m_cancelRequested.load()) {
+            size_t index = nextIndex.fetch_add(1);
+            if (index >= files.size()) {
+                break;
+            }
+            m_results[index] = processFile(files[index]);
+
+            if (m_fileCallback) {
+                std::lock_guard<std::mutex> lock(m_callbackMutex);
+                m_fileCallback(m_results[index], ++completed, files.size());
+            }
+        }
+    };
+
+    // 工作任务在共享线程池中运行，当前线程等待时也参与执行；
+    // 插件内部的并行处理与之共用同一组线程，总线程数不会超过线程池的配置
+    TaskGroup group;
+    for (int i = 0; i < summary.workers; ++i) {
+        group.run(worker);
+    }
+    group.wait();
+
+    summary.wallMs = elapsedMs(start);
+
+    // 取消后未领取的文件不计入
+    size_t processed = std::min(nextIndex.load(), files.size());
+    m_results.resize(processed);
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const FileResult& result = m_results[i];
+        if (result.success) {
+            summary.succeeded++;
+        } else {
+            summary.failed++;
+        }
+        summary.inputBytes += result.inputBytes;
+        summary.rows += result.rows;
+        summary.busyMs += result.totalMs;
+    }
+    return summary;
+}
+
+BatchRunner::FileResult BatchRunner::processFile(const std::string& path) const {
+    TRACE_SCOPE("batch", "BatchRunner::processFile");
+    FileResult result;
+    result.inputPath = path;
+    Clock::time_point fileStart = Clock::now();
+
+    FileUtils::FileInfo info;
+    if (FileUtils::getFileInfo(path, info)) {
+        result.inputBytes = info.size;
+    }
+
+    try {
+        // 加载
+        Clock::time_point stageStart = Clock::now();
+        std::shared_ptr<DataSource> source = createSource(path);
+        std::string sourceError;
+        source->setErrorCallback([&sourceError](const std::string& message) { sourceError = message; });
+        if (!source->start() || !source->getDataModel()) {
+            result.errorMessage = sourceError.empty() ? "加载失败" : sourceError;
+            result.totalMs = elapsedMs(fileStart);
+            return result;
+        }
+        std::shared_ptr<DataModel> data = source->getDataModel();
+        result.rows = data->size();
+        result.fieldCount = data->getFieldNames().size();
+        result.loadMs = elapsedMs(stageStart);
+
+        // 插件链
+        stageStart = Clock::now();
+        if (!runPlugins(data, result.errorMessage)) {
+            result.totalMs = elapsedMs(fileStart);
+            return result;
+        }
+        result.outputRows = data->size();
+        result.processMs = elapsedMs(stageStart);
+
+        // 导出
+        if (!m_pipeline.exportPlugin.empty()) {
+            stageStart = Clock::now();
+            result.outputPath = m_pipeline.outputPathFor(path);
+            if (!exportData(data, result.outputPath, result.errorMessage)) {
+                result.totalMs = elapsedMs(fileStart);
+                return result;
+            }
+            result.exportMs = elapsedMs(stageStart);
+        }
+
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.errorMessage = std::string("处理异常: ") + e.what();
+    }
+
+    result.totalMs = elapsedMs(fileStart);
+    return result;
+}
+
+std::shared_ptr<DataSource> BatchRunner::createSource(const std::string& path) const {
+    if (m_pipeline.sourceType == "snapshot") {
+        std::shared_ptr<SnapshotDataSource> source = std::make_shared<SnapshotDataSource>();
+        source->initialize(path);
+        return source;
+    }
+
+    if (m_pipeline.sourceType == "custom") {
+        std::shared_ptr<CustomDataSource> source = std::make_shared<CustomDataSource>();
+        CustomDataSource::ParseConfig config;
+        config.delimiter = m_pipeline.delimiter;
+        config.hasHeader = m_pipeline.hasHeader;
+        config.skipLines = m_pipeline.skipLines;
+        source->setParseConfig(config);
+        source->initialize(path);
+        return source;
+    }
+
+    std::shared_ptr<CSVDataSource> source = std::make_shared<CSVDataSource>();
+    source->setDelimiter(m_pipeline.delimiter);
+    source->setHasHeader(m_pipeline.hasHeader);
+    source->setSkipLines(m_pipeline.skipLines);
+    source->setUseParseCache(m_pipeline.useParseCache);
+    source->initialize(path);
+    return source;
+}
+
+bool BatchRunner::runPlugins(std::shared_ptr<DataModel>& data, std::string& errorMessage) const {
+    PluginManager& manager = PluginManager::getInstance();
+
+    for (size_t i = 0; i < m_pipeline.plugins.size(); ++i) {
+        const BatchPipeline::PluginStep& step = m_pipeline.plugins[i];
+        TRACE_SCOPE("plugin", step.name);
+
+        // 每个文件新建插件实例，滤波器等有状态的插件不会在文件之间串扰
+        std::shared_ptr<PluginInterface> plugin = manager.createPlugin(step.name);
+        if (!plugin) {
+            errorMessage = "无法创建插件: " + step.name;
+            return false;
+        }
+
+        for (std::map<std::string, std::string>::const_iterator it = step.parameters.begin();
+             it != step.parameters.end(); ++it) {
+            if (!plugin->setParameter(it->first, QVariant(QString::fromStdString(it->second)))) {
+                errorMessage = step.name + ": " + plugin->getLastError();
+                return false;
+            }
+        }
+
+        std::shared_ptr<DataModel> output = std::make_shared<DataModel>();
+        if (!plugin->processData(data, output)) {
+            errorMessage = step.name + ": " + plugin->getLastError();
+            return false;
+        }
+        data = output;
+    }
+
+    return true;
+}
+
+bool BatchRunner::exportData(const std::shared_ptr<DataModel>& data, const std::string& outputPath,
+                             std::string& errorMessage) const {
+    std::shared_ptr<ExportPlugin> exporter = std::dynamic_pointer_cast<ExportPlugin>(
+        PluginManager::getInstance().createPlugin(m_pipeline.exportPlugin));
+    if (!exporter) {
+        errorMessage = "无法创建导出插件: " + m_pipeline.exportPlugin;
+        return false;
+    }
+
+    for (std::map<std::string, std::string>::const_iterator it = m_pipeline.exportParameters.begin();
+         it != m_pipeline.exportParameters.end(); ++it) {
+        if (!exporter->setParameter(it->first, QVariant(QString::fromStdString(it->second)))) {
+            errorMessage = m_pipeline.exportPlugin + ": " + exporter->getLastError();
+            return false;
+        }
+    }
+
+    if (!exporter->exportToFile(outputPath, data)) {
+        errorMessage = m_pipeline.exportPlugin + ": " + exporter->getLastError();
+        return false;
+    }
+    return true;
+}
+
+void BatchRunner::writeJsonReport(std::ostream& out, const BatchPipeline& pipeline, const Summary& summary,
+                                  const std::vector<FileResult>& results) {
+    double seconds = summary.wallMs / 1000.0;
+    double megabytes = static_cast<double>(summary.inputBytes) / (1024.0 * 1024.0);
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"source_type\": \"" << jsonEscape(pipeline.sourceType) << "\",\n";
+    out << "  \"plugins\": [";
+    for (size_t i = 0; i < pipeline.plugins.size(); ++i) {
+        out << (i > 0 ? ", " : "") << "\"" << jsonEscape(pipeline.plugins[i].name) << "\"";
+    }
+    out << "],\n";
+    out << "  \"export_plugin\": \"" << jsonEscape(pipeline.exportPlugin) << "\",\n";
+    out << "  \"summary\": {\n";
+    out << "    \"files\": " << summary.files << ",\n";
+    out << "    \"processed\": " << results.size() << ",\n";
+    out << "    \"succeeded\": " << summary.succeeded << ",\n";
+    out << "    \"failed\": " << summary.failed << ",\n";
+    out << "    \"workers\": " << summary.workers << ",\n";
+    out << "    \"input_bytes\": " << summary.inputBytes << ",\n";
+    out << "    \"rows\": " << summary.rows << ",\n";
+    out << "    \"wall_ms\": " << summary.wallMs << ",\n";
+    out << "    \"busy_ms\": " << summary.busyMs << ",\n";
+    out << "    \"mb_per_second\": " << (seconds > 0.0 ? megabytes / seconds : 0.0) << ",\n";
+    out << "    \"rows_per_second\": " << (seconds > 0.0 ? summary.rows / seconds : 0.0) << "\n";
+    out << "  },\n";
+    out << "  \"files\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const FileResult& result = results[i];
+        double fileSeconds = result.totalMs / 1000.0;
+        out << (i > 0 ? "," : "") << "\n    {";
+        out << "\"input\": \"" << jsonEscape(result.inputPath) << "\", ";
+        out << "\"output\": \"" << jsonEscape(result.outputPath) << "\", ";
+        out << "\"success\": " << (result.success ? "true" : "false") << ", ";
+        out << "\"error\": \"" << jsonEscape(result.errorMessage) << "\", ";
+        out << "\"input_bytes\": " << result.inputBytes << ", ";
+        out << "\"rows\": " << result.rows << ", ";
+        out << "\"output_rows\": " << result.outputRows << ", ";
+        out << "\"fields\": " << result.fieldCount << ", ";
+        out << "\"load_ms\": " << result.loadMs << ", ";
+        out << "\"process_ms\": " << result.processMs << ", ";
+        out << "\"export_ms\": " << result.exportMs << ", ";
+        out << "\"total_ms\": " << result.totalMs << ", ";
+        out << "\"rows_per_second\": " << (fileSeconds > 0.0 ? result.rows / fileSeconds : 0.0) << "}";
+    }
+    out << (results.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+}
+
+bool BatchRunner::writeJsonReport(const std::string& filename, const BatchPipeline& pipeline,
+                                  const Summary& summary, const std::vector<FileResult>& results,
+                                  std::string& errorMessage) {
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        errorMessage = "无法创建报告文件: " + filename;
+        return false;
+    }
+    writeJsonReport(file, pipeline, summary, results);
+    if (!file.good()) {
+        errorMessage = "写入报告文件失败: " + filename;
+        return false;
+    }
+    return true;
+}
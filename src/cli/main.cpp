@@ -0,0 +1,233 @@
+#include "cli/BatchPipeline.h"
+#include "cli/BatchRunner.h"
+#include "plugins/PluginManager.h"
+#include "utils/FileUtils.h"
+#include "utils/Tracer.h"
+#include "utils/ThreadPool.h"
+#include <iostream>
+#include <fstream>
+#include <streambuf>
+#include <iomanip>
+#include <cstdlib>
+
+// 丢弃所有输出；没有内部状态，多个工作线程同时写入也安全
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+static void printUsage(const char* program) {
+    std::cerr << "用法: " << program << " --pipeline <文件> [选项] <输入文件或目录>...\n"
+              << "\n"
+              << "选项:\n"
+              << "  -p, --pipeline <文件>    流水线描述文件（必需）\n"
+              << "  -j, --workers <N>        工作线程数，0 表示按CPU核数（覆盖 run/workers）\n"
+              << "  -o, --output-dir <目录>  导出目录（覆盖 export/directory）\n"
+              << "  -r, --report <文件>      JSON 报告路径，- 表示输出到标准输出（覆盖 report/json）\n"
+              << "      --file-list <文件>   从文件读取输入列表，每行一个路径\n"
+              << "      --trace <文件>       记录处理过程的跟踪，写为 Chrome trace-event JSON\n"
+              << "  -q, --quiet              不输出数据源的解析日志\n"
+              << "      --list-plugins       列出可用的插件名称\n"
+              << "  -h, --help               显示帮助\n"
+              << "\n"
+              << "目录输入按数据源类型筛选扩展名（csv: .csv, snapshot: .snap），不递归。\n"
+              << "退出码: 0 全部成功，1 存在失败的文件，2 参数或流水线错误。\n";
+}
+
+static bool expandInput(const std::string& path, const BatchPipeline& pipeline,
+                        std::vector<std::string>& files) {
+    if (FileUtils::isDirectory(path)) {
+        std::vector<FileUtils::FileInfo> entries = FileUtils::listFiles(path, pipeline.inputExtension());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            files.push_back(entries[i].path);
+        }
+        return true;
+    }
+    if (!FileUtils::exists(path)) {
+        std::cerr << "输入不存在: " << path << std::endl;
+        return false;
+    }
+    files.push_back(path);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string pipelineFile;
+    std::string workersOption;
+    std::string outputDirOption;
+    std::string reportOption;
+    std::string fileListOption;
+    std::string traceOption;
+    bool quiet = false;
+    bool listPlugins = false;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool needsValue = arg == "-p" || arg == "--pipeline" || arg == "-j" || arg == "--workers" ||
+                          arg == "-o" || arg == "--output-dir" || arg == "-r" || arg == "--report" ||
+                          arg == "--file-list" || arg == "--trace";
+        if (needsValue && i + 1 >= argc) {
+            std::cerr << "选项缺少参数: " << arg << std::endl;
+            return 2;
+        }
+
+        if (arg == "-p" || arg == "--pipeline") {
+            pipelineFile = argv[++i];
+        } else if (arg == "-j" || arg == "--workers") {
+            workersOption = argv[++i];
+        } else if (arg == "-o" || arg == "--output-dir") {
+            outputDirOption = argv[++i];
+        } else if (arg == "-r" || arg == "--report") {
+            reportOption = argv[++i];
+        } else if (arg == "--file-list") {
+            fileListOption = argv[++i];
+        } else if (arg == "--trace") {
+            traceOption = argv[++i];
+        } else if (arg == "-q" || arg == "--quiet") {
+            quiet = true;
+        } else if (arg == "--list-plugins") {
+            listPlugins = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::cerr << "未知选项: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 2;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (listPlugins) {
+        std::vector<std::string> names = PluginManager::getInstance().getFactoryNames();
+        for (size_t i = 0; i < names.size(); ++i) {
+            std::cout << names[i] << std::endl;
+        }
+        return 0;
+    }
+
+    if (pipelineFile.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    BatchPipeline pipeline;
+    std::string errorMessage;
+    if (!pipeline.loadFromFile(pipelineFile, errorMessage)) {
+        std::cerr << pipelineFile << ": " << errorMessage << std::endl;
+        return 2;
+    }
+    if (!workersOption.empty()) {
+        char* end = nullptr;
+        long workers = std::strtol(workersOption.c_str(), &end, 10);
+        if (*end != '\0' || workers < 0) {
+            std::cerr << "无效的工作线程数: " << workersOption << std::endl;
+            return 2;
+        }
+        pipeline.workers = static_cast<int>(workers);
+    }
+    // 文件级任务和插件内部的并行处理共用一个线程池，按指定的工作线程数建立
+    if (pipeline.workers > 0) {
+        ThreadPool::getInstance().configure(static_cast<size_t>(pipeline.workers), false);
+    }
+    if (!outputDirOption.empty()) {
+        pipeline.outputDirectory = outputDirOption;
+    }
+    if (!reportOption.empty()) {
+        pipeline.reportPath = reportOption;
+    }
+    if (!pipeline.validate(errorMessage)) {
+        std::cerr << pipelineFile << ": " << errorMessage << std::endl;
+        return 2;
+    }
+
+    if (!fileListOption.empty()) {
+        std::ifstream list(fileListOption.c_str());
+        if (!list.is_open()) {
+            std::cerr << "无法打开输入列表: " << fileListOption << std::endl;
+            return 2;
+        }
+        std::string line;
+        while (std::getline(list, line)) {
+            if (!line.empty() && line[line.size() - 1] == '\r') {
+                line.erase(line.size() - 1);
+            }
+            if (!line.empty() && line[0] != '#') {
+                inputs.push_back(line);
+            }
+        }
+    }
+
+    std::vector<std::string> files;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!expandInput(inputs[i], pipeline, files)) {
+            return 2;
+        }
+    }
+    if (files.empty()) {
+        std::cerr << "没有要处理的输入文件" << std::endl;
+        return 2;
+    }
+
+    // 数据源和插件的日志写到 std::cout；报告输出到标准输出时不能混在一起，
+    // 因此处理期间把 std::cout 转到标准错误，--quiet 时直接丢弃
+    bool reportToStdout = pipeline.reportPath == "-";
+    std::streambuf* stdoutBuffer = std::cout.rdbuf();
+    std::ostream out(stdoutBuffer);
+    NullBuffer discarded;
+    std::cout.rdbuf(quiet ? &discarded : std::cerr.rdbuf());
+
+    // 报告输出到标准输出时逐文件进度写到标准错误
+    std::ostream& progress = reportToStdout ? std::cerr : out;
+    BatchRunner runner(pipeline);
+    runner.setFileCallback([&progress](const BatchRunner::FileResult& result, size_t completed, size_t total) {
+        progress << "[" << completed << "/" << total << "] ";
+        if (result.success) {
+            double seconds = result.totalMs / 1000.0;
+            progress << "完成 " << result.inputPath << ": " << result.rows << " 行, "
+                     << std::fixed << std::setprecision(1) << result.totalMs << " ms, "
+                     << std::setprecision(0) << (seconds > 0.0 ? result.rows / seconds : 0.0) << " 行/秒";
+            if (!result.outputPath.empty()) {
+                progress << " -> " << result.outputPath;
+            }
+        } else {
+            progress << "失败 " << result.inputPath << ": " << result.errorMessage;
+        }
+        progress << std::endl;
+    });
+
+    Tracer::getInstance().setEnabled(!traceOption.empty());
+    BatchRunner::Summary summary = runner.run(files);
+    std::cout.rdbuf(stdoutBuffer);
+
+    if (!traceOption.empty()) {
+        Tracer::getInstance().setEnabled(false);
+        if (!Tracer::getInstance().writeChromeTrace(traceOption, errorMessage)) {
+            std::cerr << errorMessage << std::endl;
+        }
+    }
+
+    double seconds = summary.wallMs / 1000.0;
+    double megabytes = static_cast<double>(summary.inputBytes) / (1024.0 * 1024.0);
+    progress << std::fixed << std::setprecision(2)
+             << "共 " << summary.files << " 个文件, 成功 " << summary.succeeded << ", 失败 " << summary.failed
+             << ", " << summary.workers << " 个工作线程\n"
+             << "总计 " << summary.rows << " 行, " << megabytes << " MB, 耗时 " << seconds << " 秒"
+             << ", 吞吐 " << (seconds > 0.0 ? megabytes / seconds : 0.0) << " MB/秒, "
+             << std::setprecision(0) << (seconds > 0.0 ? summary.rows / seconds : 0.0) << " 行/秒"
+             << std::endl;
+
+    if (reportToStdout) {
+        BatchRunner::writeJsonReport(out, pipeline, summary, runner.getResults());
+    } else if (!pipeline.reportPath.empty()) {
+        if (!BatchRunner::writeJsonReport(pipeline.reportPath, pipeline, summary, runner.getResults(),
+                                          errorMessage)) {
+            std::cerr << errorMessage << std::endl;
+            return 1;
+        }
+    }
+
+    return summary.failed == 0 ? 0 : 1;
+}
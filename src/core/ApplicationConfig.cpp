@@ -72,6 +72,32 @@ void ApplicationConfig::setDefaultConfig() {
     setValue("data_source/csv_delimiter", ",");
     setValue("data_source/csv_has_header", true);
     setValue("data_source/realtime_sample_rate", 10.0);
+    setValue("data_source/csv_infer_column_types", false);
+    
+    // 解析缓存默认配置（目录为空时使用系统临时目录）
+    setValue("cache/parse_cache_enabled", true);
+    setValue("cache/directory", "");
+    setValue("cache/max_size_mb", 2048);
+    
+    // 跟踪（Chrome trace-event JSON），输出路径为空时不写文件
+    setValue("tracing/enabled", false);
+    setValue("tracing/output", "");
+    
+    // 共享线程池：线程数为0时按CPU核数，绑定CPU仅在Windows和Linux上生效
+    setValue("threading/thread_count", 0);
+    setValue("threading/pin_threads", false);
+    
+    // 实时数据录制：轮转大小/时长为0时不轮转，队列满时阻塞采集线程而不丢数据
+    setValue("recording/batch_rows", 4096);
+    setValue("recording/queue_batches", 64);
+    setValue("recording/rotate_size_mb", 0);
+    setValue("recording/rotate_seconds", 0);
+    
+    // 实时数据预写日志：目录为空时写到系统临时目录；同步策略 none/batch/group
+    setValue("recording/wal_enabled", false);
+    setValue("recording/wal_directory", "");
+    setValue("recording/wal_sync", "group");
+    setValue("recording/wal_sync_interval_ms", 200);
     
     // 显示默认配置
     setValue("display/refresh_rate", 30);
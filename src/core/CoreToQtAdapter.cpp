@@ -3,15 +3,31 @@
 #include "data/DataSourceFactory.h"
 #include "data/CSVDataSource.h"
 #include "data/RealTimeDataSource.h"
+#include "data/CustomDataSource.h"
+#include "data/SnapshotDataSource.h"
+#include "data/ReplayDataSource.h"
+#include "data/SocketDataSource.h"
+#include "data/RecordingLog.h"
+#include "data/ParseCache.h"
 #include "data/DataModel.h"
 #include "plugins/PluginManager.h"
 #include "plugins/PluginInterface.h"
+#include "plugins/ExportPlugin.h"
+#include "plugins/StreamingExporter.h"
+#include "utils/Tracer.h"
+#include "utils/ThreadPool.h"
+#include "ApplicationConfig.h"
 
 #include <QDebug>
 #include <QFile>
 #include <QTextStream>
 #include <QVariant>
 #include <QPair>
+#include <QTimer>
+#include <QThread>
+#include <QDir>
+#include <QDateTime>
+#include <algorithm>
 #include <memory>
 #include <map>
 
@@ -26,6 +42,11 @@ CoreToQtAdapter::CoreToQtAdapter(QObject* parent)
     : QObject(parent)
     , m_isRealTimeRunning(false)
     , m_currentDataSourceType("none")
+    , m_realTimeTimer(new QTimer(this))
+    , m_realTimePending(false)
+    , m_droppedSamples(0)
+    , m_loadThread(nullptr)
+    , m_lastProgressMs(0)
     , m_coreComponents(new CoreComponentHolder())
 {
     initializeCoreComponents();
@@ -33,7 +54,21 @@ CoreToQtAdapter::CoreToQtAdapter(QObject* parent)
 }
 
 CoreToQtAdapter::~CoreToQtAdapter() {
+    if (m_loadThread) {
+        m_loadingSource->requestCancel();
+        m_loadThread->wait();
+    }
     stopRealTimeData();
+    stopRecording();
+    
+    // 启用跟踪且配置了输出路径时，退出前写出本次运行的跟踪
+    std::string traceOutput = ApplicationConfig::getInstance().getString("tracing/output", "");
+    if (Tracer::isEnabled() && !traceOutput.empty()) {
+        std::string errorMessage;
+        if (!Tracer::getInstance().writeChromeTrace(traceOutput, errorMessage)) {
+            qWarning() << stringToQString(errorMessage);
+        }
+    }
 }
 
 void CoreToQtAdapter::initializeCoreComponents() {
@@ -44,6 +79,24 @@ void CoreToQtAdapter::initializeCoreComponents() {
         // 初始化插件管理器
         m_coreComponents->pluginManager = std::make_shared<PluginManager>();
         
+        // 解析缓存配置
+        ApplicationConfig& config = ApplicationConfig::getInstance();
+        ParseCache& parseCache = ParseCache::getInstance();
+        parseCache.setEnabled(config.getBool("cache/parse_cache_enabled", true));
+        std::string cacheDirectory = config.getString("cache/directory", "");
+        if (!cacheDirectory.empty()) {
+            parseCache.setCacheDirectory(cacheDirectory);
+        }
+        parseCache.setMaxBytes(static_cast<uint64_t>(config.getInt("cache/max_size_mb", 2048)) * 1024 * 1024);
+        
+        // 跟踪默认关闭，关闭时各处区间标记几乎没有开销
+        Tracer::getInstance().setEnabled(config.getBool("tracing/enabled", false));
+        
+        // 在启动任何并行处理之前确定共享线程池的规模
+        ThreadPool::getInstance().configure(
+            static_cast<size_t>(std::max(0, config.getInt("threading/thread_count", 0))),
+            config.getBool("threading/pin_threads", false));
+        
         qDebug() << "核心组件初始化完成";
     } catch (const std::exception& e) {
         qWarning() << "核心组件初始化失败:" << e.what();
@@ -52,7 +105,12 @@ void CoreToQtAdapter::initializeCoreComponents() {
 }
 
 void CoreToQtAdapter::setupConnections() {
-    // 连接将在具体数据源设置时建立
+    // 数据源连接在具体数据源设置时建立
+    
+    // 实时数据按显示刷新率成批投递
+    int refreshRate = std::max(1, ApplicationConfig::getInstance().getPlotRefreshRate());
+    m_realTimeTimer->setInterval(1000 / refreshRate);
+    connect(m_realTimeTimer, &QTimer::timeout, this, &CoreToQtAdapter::onRealTimeTick);
 }
 
 bool CoreToQtAdapter::loadCSVFile(const QString& filename) {
@@ -61,59 +119,235 @@ bool CoreToQtAdapter::loadCSVFile(const QString& filename) {
         return false;
     }
     
-    emit dataLoadProgress(0, "开始加载CSV文件...");
-    
     try {
-        // 停止当前数据源
-        if (m_currentDataSource) {
-            m_currentDataSource->stop();
-        }
-        
         // 创建CSV数据源
         std::string stdFilename = qstringToString(filename);
-        m_currentDataSource = m_coreComponents->dataSourceFactory->createCSVSource(stdFilename);
+        auto source = m_coreComponents->dataSourceFactory->createCSVSource(stdFilename);
         
-        if (!m_currentDataSource) {
+        if (!source) {
             emit errorOccurred("创建CSV数据源失败", 1002);
             return false;
         }
         
-        // 设置回调
-        m_currentDataSource->setDataReadyCallback([this]() {
-            QMetaObject::invokeMethod(this, "handleCoreDataReady", Qt::QueuedConnection);
-        });
+        std::shared_ptr<CSVDataSource> csvSource = std::dynamic_pointer_cast<CSVDataSource>(source);
+        if (csvSource) {
+            csvSource->setInferColumnTypes(
+                ApplicationConfig::getInstance().getBool("data_source/csv_infer_column_types", false));
+        }
         
-        m_currentDataSource->setErrorCallback([this](const std::string& error) {
-            QMetaObject::invokeMethod(this, "handleCoreError", Qt::QueuedConnection,
-                                   Q_ARG(std::string, error));
-        });
+        return startAsyncLoad(source, filename, "csv");
         
-        emit dataLoadProgress(50, "正在解析CSV数据...");
+    } catch (const std::exception& e) {
+        QString errorMsg = QString("加载CSV文件时发生异常: %1").arg(e.what());
+        emit errorOccurred(errorMsg, 1004);
+        qCritical() << errorMsg;
+        return false;
+    }
+}
+
+bool CoreToQtAdapter::loadCustomData(const QString& filename, const QMap<QString, QVariant>& config) {
+    if (filename.isEmpty() || !QFile::exists(filename)) {
+        emit errorOccurred("文件不存在或路径为空: " + filename, 1001);
+        return false;
+    }
+    
+    try {
+        std::string stdFilename = qstringToString(filename);
+        auto source = m_coreComponents->dataSourceFactory->createCustomSource(stdFilename);
+        auto customSource = std::dynamic_pointer_cast<CustomDataSource>(source);
         
-        // 启动数据源
-        if (m_currentDataSource->start()) {
-            m_currentDataSourceType = "csv";
-            m_currentDataModel = std::dynamic_pointer_cast<CSVDataSource>(m_currentDataSource)->getDataModel();
-            
-            emit dataLoadProgress(100, "CSV文件加载完成");
-            emit dataLoaded(true, QString("成功加载文件: %1").arg(filename));
-            emit dataSourceStatusChanged("csv_loaded");
-            
-            qDebug() << "CSV文件加载成功:" << filename;
-            return true;
-        } else {
-            emit errorOccurred("CSV数据解析失败", 1003);
+        if (!customSource) {
+            emit errorOccurred("创建自定义数据源失败", 1002);
             return false;
         }
         
+        // 应用解析配置
+        CustomDataSource::ParseConfig parseConfig = customSource->getParseConfig();
+        QString delimiter = config.value("delimiter").toString();
+        if (!delimiter.isEmpty()) {
+            parseConfig.delimiter = delimiter.at(0).toLatin1();
+        }
+        QString commentChar = config.value("comment_char").toString();
+        if (!commentChar.isEmpty()) {
+            parseConfig.commentChar = commentChar.at(0).toLatin1();
+        }
+        parseConfig.hasHeader = config.value("has_header", parseConfig.hasHeader).toBool();
+        parseConfig.skipLines = config.value("skip_lines", parseConfig.skipLines).toInt();
+        customSource->setParseConfig(parseConfig);
+        
+        return startAsyncLoad(source, filename, "custom");
+        
     } catch (const std::exception& e) {
-        QString errorMsg = QString("加载CSV文件时发生异常: %1").arg(e.what());
+        QString errorMsg = QString("加载自定义数据时发生异常: %1").arg(e.what());
         emit errorOccurred(errorMsg, 1004);
         qCritical() << errorMsg;
         return false;
     }
 }
 
+bool CoreToQtAdapter::loadSnapshotFile(const QString& filename) {
+    if (filename.isEmpty() || !QFile::exists(filename)) {
+        emit errorOccurred("文件不存在或路径为空: " + filename, 1001);
+        return false;
+    }
+    
+    auto source = m_coreComponents->dataSourceFactory->createSnapshotSource(qstringToString(filename));
+    if (!source) {
+        emit errorOccurred("创建快照数据源失败", 1002);
+        return false;
+    }
+    
+    return startAsyncLoad(source, filename, "snapshot");
+}
+
+bool CoreToQtAdapter::saveSnapshot(const QString& filename) {
+    TRACE_SCOPE("export", "CoreToQtAdapter::saveSnapshot");
+    std::shared_ptr<const DataModel> model = currentData();
+    if (!model || model->empty()) {
+        emit errorOccurred("没有数据可保存", 5001);
+        return false;
+    }
+    
+    std::string errorMessage;
+    if (!SnapshotDataSource::save(*model, qstringToString(filename), true, errorMessage)) {
+        emit errorOccurred(stringToQString(errorMessage), 5002);
+        return false;
+    }
+    
+    qDebug() << "快照已保存:" << filename;
+    return true;
+}
+
+bool CoreToQtAdapter::startAsyncLoad(std::shared_ptr<DataSource> source, const QString& filename,
+                                     const QString& sourceType) {
+    // 同一时间只有一个加载任务：取消并等待上一个（解析循环会很快响应取消）
+    if (m_loadThread) {
+        m_loadingSource->requestCancel();
+        m_loadThread->wait();
+        m_loadThread = nullptr;
+    }
+    
+    m_loadingSource = source;
+    
+    source->setErrorCallback([this](const std::string& error) {
+        QMetaObject::invokeMethod(this, "handleCoreError", Qt::QueuedConnection,
+                               Q_ARG(std::string, error));
+    });
+    source->setProgressCallback([this](size_t bytesRead, size_t totalBytes) {
+        reportLoadProgress(bytesRead, totalBytes);
+    });
+    
+    emit dataLoadProgress(0, "开始加载: " + filename);
+    emit dataSourceStatusChanged(sourceType + "_loading");
+    
+    m_loadClock.start();
+    m_lastProgressMs.store(0);
+    
+    // 解析在工作线程中进行，完成后回到GUI线程替换数据模型
+    m_loadThread = QThread::create([this, source, filename, sourceType]() {
+        TRACE_SCOPE("adapter", "CoreToQtAdapter::load");
+        bool success = false;
+        try {
+            success = source->start();
+        } catch (const std::exception& e) {
+            qCritical() << "加载线程异常:" << e.what();
+        }
+        
+        QMetaObject::invokeMethod(this, [this, source, success, filename, sourceType]() {
+            finishAsyncLoad(source, success, filename, sourceType);
+        }, Qt::QueuedConnection);
+    });
+    connect(m_loadThread, &QThread::finished, m_loadThread, &QObject::deleteLater);
+    m_loadThread->start();
+    
+    return true;
+}
+
+void CoreToQtAdapter::reportLoadProgress(size_t bytesRead, size_t totalBytes) {
+    // 在加载线程中调用，最多每100毫秒发出一次
+    qint64 elapsedMs = m_loadClock.elapsed();
+    bool finished = totalBytes > 0 && bytesRead >= totalBytes;
+    if (!finished && elapsedMs - m_lastProgressMs.load() < 100) {
+        return;
+    }
+    m_lastProgressMs.store(elapsedMs);
+    
+    double seconds = std::max(elapsedMs, qint64(1)) / 1000.0;
+    double bytesPerSecond = bytesRead / seconds;
+    double megabytesPerSecond = bytesPerSecond / (1024.0 * 1024.0);
+    double etaSeconds = (totalBytes > bytesRead && bytesPerSecond > 0.0) ?
+                        (totalBytes - bytesRead) / bytesPerSecond : 0.0;
+    int progress = totalBytes > 0 ? static_cast<int>(bytesRead * 100.0 / totalBytes) : 0;
+    
+    QString status = QString("已读取 %1 / %2 MB，%3 MB/s，剩余约 %4 秒")
+                     .arg(bytesRead / (1024.0 * 1024.0), 0, 'f', 1)
+                     .arg(totalBytes / (1024.0 * 1024.0), 0, 'f', 1)
+                     .arg(megabytesPerSecond, 0, 'f', 1)
+                     .arg(etaSeconds, 0, 'f', 0);
+    
+    emit dataLoadProgress(progress, status);
+    emit dataLoadThroughput(static_cast<qint64>(bytesRead), static_cast<qint64>(totalBytes),
+                            megabytesPerSecond, etaSeconds);
+}
+
+void CoreToQtAdapter::finishAsyncLoad(std::shared_ptr<DataSource> source, bool success,
+                                      const QString& filename, const QString& sourceType) {
+    TRACE_SCOPE("adapter", "CoreToQtAdapter::finishAsyncLoad");
+    
+    // 已被更新的加载任务替代
+    if (source != m_loadingSource) {
+        return;
+    }
+    
+    m_loadThread = nullptr;
+    m_loadingSource.reset();
+    
+    if (source->isCancelRequested()) {
+        emit dataLoaded(false, "加载已取消: " + filename);
+        emit dataSourceStatusChanged(sourceType + "_cancelled");
+        return;
+    }
+    
+    if (!success || !source->getDataModel()) {
+        emit errorOccurred("数据解析失败: " + filename, 1003);
+        emit dataLoaded(false, "加载失败: " + filename);
+        return;
+    }
+    
+    // 一次性替换数据源和数据模型，加载期间旧数据保持可用
+    if (m_isRealTimeRunning) {
+        stopRealTimeData();
+    }
+    m_currentDataSource = source;
+    m_currentDataModel = source->getDataModel();
+    m_currentDataSourceType = sourceType;
+    
+    emit dataLoadProgress(100, "加载完成");
+    emit dataLoaded(true, QString("成功加载文件: %1").arg(filename));
+    emit dataSourceStatusChanged(sourceType + "_loaded");
+    emit dataUpdated();
+    
+    qDebug() << "文件加载成功:" << filename << "耗时" << m_loadClock.elapsed() << "ms";
+}
+
+QVariantMap CoreToQtAdapter::getParseCacheStats() const {
+    ParseCache::Stats stats = ParseCache::getInstance().getStats();
+    
+    QVariantMap result;
+    result["hits"] = static_cast<qulonglong>(stats.hits);
+    result["misses"] = static_cast<qulonglong>(stats.misses);
+    result["stores"] = static_cast<qulonglong>(stats.stores);
+    result["evictions"] = static_cast<qulonglong>(stats.evictions);
+    result["directory"] = stringToQString(ParseCache::getInstance().getCacheDirectory());
+    return result;
+}
+
+void CoreToQtAdapter::cancelLoading() {
+    if (m_loadingSource) {
+        m_loadingSource->requestCancel();
+    }
+}
+
 bool CoreToQtAdapter::startRealTimeData(const QMap<QString, QVariant>& config) {
     if (m_isRealTimeRunning) {
         stopRealTimeData();
@@ -133,9 +367,9 @@ bool CoreToQtAdapter::startRealTimeData(const QMap<QString, QVariant>& config) {
             return false;
         }
         
-        // 设置实时数据回调
+        // 设置实时数据回调：每个样本只置位标志，不分配内存也不投递事件
         m_currentDataSource->setDataReadyCallback([this]() {
-            QMetaObject::invokeMethod(this, "handleCoreDataReady", Qt::QueuedConnection);
+            m_realTimePending.store(true, std::memory_order_release);
         });
         
         m_currentDataSource->setErrorCallback([this](const std::string& error) {
@@ -143,16 +377,25 @@ bool CoreToQtAdapter::startRealTimeData(const QMap<QString, QVariant>& config) {
                                    Q_ARG(std::string, error));
         });
         
+        // 在采集开始前挂上预写日志，第一个样本起就被记录
+        std::shared_ptr<RealTimeDataSource> realTimeSource = std::dynamic_pointer_cast<RealTimeDataSource>(m_currentDataSource);
+        if (realTimeSource) {
+            realTimeSource->setRecordingLog(openWriteAheadLog());
+        }
+        
         // 启动实时数据
         if (m_currentDataSource->start()) {
             m_isRealTimeRunning = true;
-            m_currentDataSourceType = "realtime";
-            m_currentDataModel = std::dynamic_pointer_cast<RealTimeDataSource>(m_currentDataSource)->getDataModel();
+            m_currentDataSourceType = realTimeSource ? "realtime" : "socket";
+            m_currentDataModel = m_currentDataSource->getDataModel();
+            m_droppedSamples = 0;
+            m_realTimeTimer->start();
             
             emit dataSourceStatusChanged("realtime_running");
             qDebug() << "实时数据源启动成功";
             return true;
         }
+        closeWriteAheadLog();
         
     } catch (const std::exception& e) {
         QString errorMsg = QString("启动实时数据源失败: %1").arg(e.what());
@@ -163,15 +406,210 @@ bool CoreToQtAdapter::startRealTimeData(const QMap<QString, QVariant>& config) {
     return false;
 }
 
+bool CoreToQtAdapter::startReplay(const QString& filename, double speed) {
+    if (filename.isEmpty() || !QFile::exists(filename)) {
+        emit errorOccurred("文件不存在或路径为空: " + filename, 2003);
+        return false;
+    }
+    if (m_isRealTimeRunning) {
+        stopRealTimeData();
+    }
+    
+    std::shared_ptr<ReplayDataSource> source = std::make_shared<ReplayDataSource>();
+    ReplayDataSource::ReplayConfig replayConfig;
+    replayConfig.speed = std::max(0.0, speed);
+    source->setConfig(replayConfig);
+    source->initialize(qstringToString(filename));
+    
+    source->setDataReadyCallback([this]() {
+        m_realTimePending.store(true, std::memory_order_release);
+    });
+    source->setErrorCallback([this](const std::string& error) {
+        QMetaObject::invokeMethod(this, "handleCoreError", Qt::QueuedConnection,
+                               Q_ARG(std::string, error));
+    });
+    
+    if (!source->start()) {
+        emit errorOccurred("无法回放录制日志: " + filename, 2003);
+        return false;
+    }
+    
+    m_currentDataSource = source;
+    m_currentDataModel = source->getDataModel();
+    m_currentDataSourceType = "replay";
+    m_isRealTimeRunning = true;
+    m_droppedSamples = 0;
+    m_realTimeTimer->start();
+    
+    emit dataSourceStatusChanged("replay_running");
+    qDebug() << "开始回放:" << filename << "倍速" << replayConfig.speed;
+    return true;
+}
+
 void CoreToQtAdapter::stopRealTimeData() {
     if (m_currentDataSource && m_isRealTimeRunning) {
         m_currentDataSource->stop();
+        m_realTimeTimer->stop();
+        closeWriteAheadLog();
+        
+        // 投递停止前剩余的样本，录制也在这一批之后停止
+        m_realTimePending.store(true);
+        onRealTimeTick();
+        stopRecording();
+        
         m_isRealTimeRunning = false;
-        emit dataSourceStatusChanged("realtime_stopped");
+        emit dataSourceStatusChanged(m_currentDataSourceType == "replay" ? "replay_stopped" : "realtime_stopped");
         qDebug() << "实时数据源已停止";
     }
 }
 
+bool CoreToQtAdapter::startRecording(const QString& directory, const QString& exportPlugin) {
+    if (!m_currentDataSource || !m_isRealTimeRunning) {
+        emit errorOccurred("录制需要先启动实时数据源", 5003);
+        return false;
+    }
+    std::vector<std::string> fieldNames = m_currentDataSource->getFieldNames();
+    if (fieldNames.empty()) {
+        emit errorOccurred("数据源尚未确定字段，暂时无法录制", 5003);
+        return false;
+    }
+    stopRecording();
+    
+    std::shared_ptr<ExportPlugin> plugin = std::dynamic_pointer_cast<ExportPlugin>(
+        m_coreComponents->pluginManager->createPlugin(qstringToString(exportPlugin)));
+    if (!plugin || !plugin->supportsStreaming()) {
+        emit errorOccurred("导出插件不支持录制: " + exportPlugin, 5003);
+        return false;
+    }
+    
+    ApplicationConfig& appConfig = ApplicationConfig::getInstance();
+    StreamingExporter::Config config;
+    config.directory = qstringToString(directory);
+    config.extension = "." + plugin->getSupportedFormats().front();
+    config.batchRows = static_cast<size_t>(std::max(1, appConfig.getInt("recording/batch_rows", 4096)));
+    config.queueCapacity = static_cast<size_t>(std::max(1, appConfig.getInt("recording/queue_batches", 64)));
+    config.rotateBytes = static_cast<uint64_t>(std::max(0, appConfig.getInt("recording/rotate_size_mb", 0))) * 1024 * 1024;
+    config.rotateSeconds = std::max(0, appConfig.getInt("recording/rotate_seconds", 0));
+    // 批次在界面线程按帧提交，队列满时丢弃并计入 dropped_rows，不阻塞界面
+    config.dropWhenFull = true;
+    
+    std::shared_ptr<StreamingExporter> recorder = std::make_shared<StreamingExporter>(plugin, config);
+    recorder->setErrorCallback([this](const std::string& error) {
+        QMetaObject::invokeMethod(this, "handleCoreError", Qt::QueuedConnection,
+                               Q_ARG(std::string, error));
+    });
+    
+    std::string errorMessage;
+    if (!recorder->start(fieldNames, &errorMessage)) {
+        emit errorOccurred(stringToQString(errorMessage), 5004);
+        return false;
+    }
+    
+    // 之后每帧取走的新行（onRealTimeTick）整批提交给录制器
+    m_recorder = recorder;
+    
+    emit dataSourceStatusChanged("recording_started");
+    qDebug() << "开始录制:" << stringToQString(recorder->getMetrics().currentFile);
+    return true;
+}
+
+void CoreToQtAdapter::stopRecording() {
+    if (!m_recorder) {
+        return;
+    }
+    
+    // 批次都在界面线程提交，这里写完队列中的数据即可
+    m_recorder->stop();
+    
+    StreamingExporter::Metrics metrics = m_recorder->getMetrics();
+    qDebug() << "录制已停止: 写出" << metrics.rowsWritten << "行," << metrics.filesCompleted
+             << "个文件, 丢弃" << metrics.droppedRows << "行";
+    m_recorder.reset();
+    emit dataSourceStatusChanged("recording_stopped");
+}
+
+std::shared_ptr<RecordingLogWriter> CoreToQtAdapter::openWriteAheadLog() {
+    closeWriteAheadLog();
+    
+    ApplicationConfig& appConfig = ApplicationConfig::getInstance();
+    if (!appConfig.getBool("recording/wal_enabled", false)) {
+        return nullptr;
+    }
+    
+    QString directory = stringToQString(appConfig.getString("recording/wal_directory", ""));
+    if (directory.isEmpty()) {
+        directory = QDir::tempPath();
+    }
+    QDir().mkpath(directory);
+    QString path = QDir(directory).filePath(
+        "realtime_" + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss") + ".wal");
+    
+    RecordingLogWriter::Options options;
+    std::string syncPolicy = appConfig.getString("recording/wal_sync", "group");
+    if (syncPolicy == "none") {
+        options.syncPolicy = RecordingLogWriter::SyncPolicy::None;
+    } else if (syncPolicy == "batch") {
+        options.syncPolicy = RecordingLogWriter::SyncPolicy::EveryBatch;
+    } else {
+        options.syncPolicy = RecordingLogWriter::SyncPolicy::GroupCommit;
+    }
+    options.syncIntervalMs = std::max(1, appConfig.getInt("recording/wal_sync_interval_ms", 200));
+    
+    std::shared_ptr<RecordingLogWriter> log = std::make_shared<RecordingLogWriter>();
+    std::string errorMessage;
+    if (!log->open(qstringToString(path), {"time", "value"}, options, errorMessage)) {
+        // 预写日志打不开时照常采集，只给出警告
+        emit warningOccurred("无法创建预写日志: " + stringToQString(errorMessage));
+        return nullptr;
+    }
+    
+    m_writeAheadLog = log;
+    qDebug() << "预写日志:" << path;
+    return log;
+}
+
+void CoreToQtAdapter::closeWriteAheadLog() {
+    if (!m_writeAheadLog) {
+        return;
+    }
+    
+    std::shared_ptr<RealTimeDataSource> source = std::dynamic_pointer_cast<RealTimeDataSource>(m_currentDataSource);
+    if (source) {
+        source->setRecordingLog(nullptr);
+    }
+    m_writeAheadLog->close();
+    
+    RecordingLogWriter::Stats stats = m_writeAheadLog->getStats();
+    qDebug() << "预写日志已关闭: 写入" << stats.rowsAppended << "行," << stats.framesWritten
+             << "帧, 同步" << stats.syncCount << "次, 最长" << stats.maxSyncMs << "ms";
+    m_writeAheadLog.reset();
+}
+
+QString CoreToQtAdapter::getWriteAheadLogPath() const {
+    return m_writeAheadLog ? stringToQString(m_writeAheadLog->getPath()) : QString();
+}
+
+QVariantMap CoreToQtAdapter::getRecordingStats() const {
+    QVariantMap result;
+    result["recording"] = m_recorder != nullptr;
+    if (!m_recorder) {
+        return result;
+    }
+    
+    StreamingExporter::Metrics metrics = m_recorder->getMetrics();
+    result["queued_batches"] = static_cast<qulonglong>(metrics.queuedBatches);
+    result["queued_rows"] = static_cast<qulonglong>(metrics.queuedRows);
+    result["peak_queued_batches"] = static_cast<qulonglong>(metrics.peakQueuedBatches);
+    result["rows_written"] = static_cast<qulonglong>(metrics.rowsWritten);
+    result["bytes_written"] = static_cast<qulonglong>(metrics.bytesWritten);
+    result["dropped_rows"] = static_cast<qulonglong>(metrics.droppedRows);
+    result["files_completed"] = static_cast<qulonglong>(metrics.filesCompleted);
+    result["megabytes_per_second"] = metrics.megabytesPerSecond;
+    result["rows_per_second"] = metrics.rowsPerSecond;
+    result["current_file"] = stringToQString(metrics.currentFile);
+    return result;
+}
+
 bool CoreToQtAdapter::loadPlugin(const QString& pluginPath) {
     if (pluginPath.isEmpty()) {
         emit errorOccurred("插件路径为空", 3001);
@@ -198,6 +636,7 @@ bool CoreToQtAdapter::loadPlugin(const QString& pluginPath) {
 }
 
 bool CoreToQtAdapter::applyPlugin(const QString& pluginName, const QMap<QString, QVariant>& parameters) {
+    TRACE_SCOPE("adapter", "CoreToQtAdapter::applyPlugin");
     if (!m_currentDataModel || m_currentDataModel->empty()) {
         emit errorOccurred("没有可处理的数据", 4001);
         return false;
@@ -228,49 +667,65 @@ bool CoreToQtAdapter::applyPlugin(const QString& pluginName, const QMap<QString,
 }
 
 QVector<double> CoreToQtAdapter::getDataSeries(const QString& fieldName) const {
-    if (!m_currentDataModel) {
+    TRACE_SCOPE("adapter", "CoreToQtAdapter::getDataSeries");
+    std::shared_ptr<const DataModel> model = currentData();
+    if (!model) {
         return QVector<double>();
     }
     
     std::string stdFieldName = qstringToString(fieldName);
-    if (!m_currentDataModel->hasField(stdFieldName)) {
+    if (!model->hasField(stdFieldName)) {
         return QVector<double>();
     }
     
-    const auto& dataSeries = m_currentDataModel->getDataSeries(stdFieldName);
-    return convertToQVector(dataSeries);
+    // 按块复制列视图，不经过 getDataSeries 的整列缓存
+    ColumnBuffer series = model->getColumnBuffer(stdFieldName);
+    QVector<double> result(static_cast<int>(series.size()));
+    series.copyTo(0, series.size(), result.data());
+    return result;
 }
 
 QVector<QPair<double, double>> CoreToQtAdapter::getDataPairs(const QString& xField, const QString& yField) const {
+    TRACE_SCOPE("adapter", "CoreToQtAdapter::getDataPairs");
+    std::shared_ptr<const DataModel> model = currentData();
     QVector<QPair<double, double>> pairs;
     
-    if (!m_currentDataModel || m_currentDataModel->empty()) {
+    if (!model || model->empty()) {
         return pairs;
     }
     
-    auto xData = getDataSeries(xField);
-    auto yData = getDataSeries(yField);
+    std::string stdXField = qstringToString(xField);
+    std::string stdYField = qstringToString(yField);
+    if (!model->hasField(stdXField) || !model->hasField(stdYField)) {
+        return pairs;
+    }
+    
+    // 直接读取模型列视图，不再先复制成QVector
+    ColumnBuffer xData = model->getColumnBuffer(stdXField);
+    ColumnBuffer yData = model->getColumnBuffer(stdYField);
     
-    if (xData.size() != yData.size() || xData.isEmpty()) {
+    if (xData.size() != yData.size() || xData.empty()) {
         return pairs;
     }
     
-    for (int i = 0; i < xData.size(); ++i) {
-        pairs.append(qMakePair(xData[i], yData[i]));
+    pairs.resize(static_cast<int>(xData.size()));
+    for (size_t i = 0; i < xData.size(); ++i) {
+        pairs[static_cast<int>(i)] = qMakePair(xData[i], yData[i]);
     }
     
     return pairs;
 }
 
 QVariantMap CoreToQtAdapter::getDataPoint(int index) const {
+    std::shared_ptr<const DataModel> model = currentData();
     QVariantMap point;
     
-    if (!m_currentDataModel || index < 0 || index >= static_cast<int>(m_currentDataModel->size())) {
+    if (!model || index < 0 || index >= static_cast<int>(model->size())) {
         return point;
     }
     
     std::map<std::string, double> stdPoint;
-    if (m_currentDataModel->getDataPoint(static_cast<size_t>(index), stdPoint)) {
+    if (model->getDataPoint(static_cast<size_t>(index), stdPoint)) {
         point = convertDataPointToVariantMap(stdPoint);
     }
     
@@ -278,13 +733,14 @@ QVariantMap CoreToQtAdapter::getDataPoint(int index) const {
 }
 
 QStringList CoreToQtAdapter::getFieldNames() const {
+    std::shared_ptr<const DataModel> model = currentData();
     QStringList fields;
     
-    if (!m_currentDataModel) {
+    if (!model) {
         return fields;
     }
     
-    auto stdFields = m_currentDataModel->getFieldNames();
+    auto stdFields = model->getFieldNames();
     for (const auto& field : stdFields) {
         fields.append(stringToQString(field));
     }
@@ -306,9 +762,14 @@ bool CoreToQtAdapter::saveDataToFile(const QString& filename) {
 }
 
 void CoreToQtAdapter::clearData() {
+    cancelLoading();
     if (m_currentDataSource) {
         m_currentDataSource->stop();
     }
+    stopRecording();
+    closeWriteAheadLog();
+    m_realTimeTimer->stop();
+    m_realTimePending.store(false);
     
     m_currentDataModel.reset();
     m_currentDataSource.reset();
@@ -326,6 +787,10 @@ void CoreToQtAdapter::clearData() {
 void CoreToQtAdapter::onLoadDataRequested(const QString& filename, const QString& dataType) {
     if (dataType.toLower() == "csv") {
         loadCSVFile(filename);
+    } else if (dataType.toLower() == "custom") {
+        loadCustomData(filename, m_dataSourceConfig);
+    } else if (dataType.toLower() == "snapshot") {
+        loadSnapshotFile(filename);
     } else {
         emit errorOccurred("不支持的数据类型: " + dataType, 6001);
     }
@@ -343,6 +808,10 @@ void CoreToQtAdapter::onClearDataRequested() {
     clearData();
 }
 
+void CoreToQtAdapter::onCancelLoadRequested() {
+    cancelLoading();
+}
+
 void CoreToQtAdapter::onApplyFilterRequested(const QString& filterType, const QMap<QString, QVariant>& parameters) {
     applyPlugin(filterType, parameters);
 }
@@ -361,16 +830,115 @@ void CoreToQtAdapter::onGetStatisticsRequested() {
 
 void CoreToQtAdapter::handleCoreDataReady() {
     emit dataUpdated();
+}
+
+void CoreToQtAdapter::onRealTimeTick() {
+    if (!m_realTimePending.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
     
-    if (m_isRealTimeRunning && m_currentDataModel && !m_currentDataModel->empty()) {
-        // 获取最新数据点
-        size_t lastIndex = m_currentDataModel->size() - 1;
-        std::map<std::string, double> latestPoint;
-        if (m_currentDataModel->getDataPoint(lastIndex, latestPoint)) {
-            QVariantMap point = convertDataPointToVariantMap(latestPoint);
-            emit realTimeDataPointAdded(point);
-        }
+    TRACE_SCOPE("adapter", "CoreToQtAdapter::onRealTimeTick");
+    if (m_currentDataSourceType == "replay") {
+        deliverReplayBatch();
+        return;
+    }
+    if (m_currentDataSourceType == "socket") {
+        deliverSocketBatch();
+        return;
+    }
+    auto realTimeSource = std::dynamic_pointer_cast<RealTimeDataSource>(m_currentDataSource);
+    if (!realTimeSource) {
+        return;
+    }
+    
+    size_t count = realTimeSource->takePendingRows(m_batchColumns);
+    
+    quint64 dropped = realTimeSource->getDroppedSampleCount();
+    if (dropped != m_droppedSamples) {
+        m_droppedSamples = dropped;
+        emit realTimeSamplesDropped(m_droppedSamples);
+    }
+    
+    if (count > 0) {
+        emitColumnBatch(realTimeSource->getFieldNames());
+    }
+}
+
+void CoreToQtAdapter::deliverReplayBatch() {
+    auto replaySource = std::dynamic_pointer_cast<ReplayDataSource>(m_currentDataSource);
+    if (!replaySource) {
+        return;
+    }
+    
+    // 先读统计再取数据：读到已结束时，之后取走的一定是最后一批
+    ReplayDataSource::ReplayStats stats = replaySource->getStatistics();
+    size_t count = replaySource->takePendingRows(m_batchColumns);
+    
+    if (stats.droppedRows != m_droppedSamples) {
+        m_droppedSamples = stats.droppedRows;
+        emit realTimeSamplesDropped(m_droppedSamples);
+    }
+    
+    if (count > 0) {
+        emitColumnBatch(replaySource->getFieldNames());
+    }
+    
+    if (stats.finished && m_isRealTimeRunning) {
+        m_realTimeTimer->stop();
+        m_isRealTimeRunning = false;
+        emit dataSourceStatusChanged("replay_finished");
+        qDebug() << "回放结束:" << stats.rowsReplayed << "行," << stats.rowsPerSecond << "行/秒";
+    }
+}
+
+void CoreToQtAdapter::deliverSocketBatch() {
+    auto socketSource = std::dynamic_pointer_cast<SocketDataSource>(m_currentDataSource);
+    if (!socketSource) {
+        return;
+    }
+    
+    size_t count = socketSource->takePendingRows(m_batchColumns);
+    
+    // 丢失的帧与显示端来不及取走的行都算作丢弃的样本
+    SocketDataSource::SocketStats stats = socketSource->getStatistics();
+    quint64 dropped = stats.droppedRows + stats.framesLost;
+    if (dropped != m_droppedSamples) {
+        m_droppedSamples = dropped;
+        emit realTimeSamplesDropped(m_droppedSamples);
+    }
+    
+    if (count > 0) {
+        emitColumnBatch(socketSource->getFieldNames());
+    }
+}
+
+void CoreToQtAdapter::emitColumnBatch(const std::vector<std::string>& fieldNames) {
+    if (fieldNames.empty() || m_batchColumns.size() != fieldNames.size()) {
+        return;
+    }
+    recordColumnBatch(fieldNames);
+    
+    // 第一个字段是时间戳，其余字段各为一条曲线
+    QVector<double> xData = convertToQVector(m_batchColumns[0]);
+    QMap<QString, QVector<double>> seriesData;
+    for (size_t j = 1; j < fieldNames.size(); ++j) {
+        seriesData.insert(stringToQString(fieldNames[j]), convertToQVector(m_batchColumns[j]));
     }
+    
+    emit realTimeBatchReady(stringToQString(fieldNames[0]), xData, seriesData);
+}
+
+void CoreToQtAdapter::recordColumnBatch(const std::vector<std::string>& fieldNames) {
+    if (!m_recorder) {
+        return;
+    }
+    
+    // 一帧的新行整批提交，字段按名称对应；录制器的写线程负责写文件
+    std::shared_ptr<DataModel> batch = std::make_shared<DataModel>();
+    for (size_t j = 0; j < fieldNames.size(); ++j) {
+        batch->addDataSeries(fieldNames[j], m_batchColumns[j].data(), m_batchColumns[j].size());
+    }
+    m_recorder->appendBatch(batch);
 }
 
 void CoreToQtAdapter::handleCoreError(const std::string& errorMessage) {
@@ -380,13 +948,9 @@ void CoreToQtAdapter::handleCoreError(const std::string& errorMessage) {
 }
 
 QVector<double> CoreToQtAdapter::convertToQVector(const std::vector<double>& vec) const {
-    QVector<double> result;
-    result.reserve(static_cast<int>(vec.size()));
-    
-    for (double value : vec) {
-        result.append(value);
-    }
-    
+    // 一次整块复制
+    QVector<double> result(static_cast<int>(vec.size()));
+    std::copy(vec.begin(), vec.end(), result.begin());
     return result;
 }
 
@@ -401,13 +965,14 @@ QVariantMap CoreToQtAdapter::convertDataPointToVariantMap(const std::map<std::st
 }
 
 QVariantMap CoreToQtAdapter::convertStatisticsToVariantMap() const {
+    std::shared_ptr<const DataModel> model = currentData();
     QVariantMap statistics;
     
-    if (!m_currentDataModel) {
+    if (!model) {
         return statistics;
     }
     
-    auto stats = m_currentDataModel->calculateStatistics();
+    auto stats = model->calculateStatistics();
     
     statistics["totalPoints"] = static_cast<int>(stats.totalPoints);
     statistics["validPoints"] = static_cast<int>(stats.validPoints);
@@ -438,16 +1003,36 @@ QString CoreToQtAdapter::stringToQString(const std::string& str) const {
     return QString::fromStdString(str);
 }
 
+QSharedPointer<DataModel> CoreToQtAdapter::getDataModel() const {
+    std::shared_ptr<DataModel> model = m_currentDataModel;
+    if (!model) {
+        return QSharedPointer<DataModel>();
+    }
+    // 删除器只释放持有的 std::shared_ptr 引用，模型由最后一个持有者释放
+    return QSharedPointer<DataModel>(model.get(), [model](DataModel*) mutable { model.reset(); });
+}
+
+std::shared_ptr<const DataModel> CoreToQtAdapter::currentData() const {
+    if (!m_currentDataModel) {
+        return nullptr;
+    }
+    // 实时数据源的模型由采集线程写入，读取其最近发布的版本；静态数据不发布，直接读取
+    std::shared_ptr<const DataModel> snapshot = m_currentDataModel->snapshot();
+    return snapshot ? snapshot : m_currentDataModel;
+}
+
 bool CoreToQtAdapter::isDataSourceReady() const {
     return m_currentDataSource && m_currentDataSource->getState() == DataSource::State::Running;
 }
 
 bool CoreToQtAdapter::hasData() const {
-    return m_currentDataModel && !m_currentDataModel->empty();
+    std::shared_ptr<const DataModel> model = currentData();
+    return model && !model->empty();
 }
 
 int CoreToQtAdapter::getDataPointCount() const {
-    return m_currentDataModel ? static_cast<int>(m_currentDataModel->size()) : 0;
+    std::shared_ptr<const DataModel> model = currentData();
+    return model ? static_cast<int>(model->size()) : 0;
 }
 
 QString CoreToQtAdapter::getCurrentDataSourceType() const {
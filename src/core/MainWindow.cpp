@@ -1,5 +1,6 @@
 #include "MainWindow.h"
 #include "CoreToQtAdapter.h"
+#include "ApplicationConfig.h"
 #include "visualization/PlotWidget.h"
 #include <QMenuBar>
 #include <QToolBar>
@@ -19,11 +20,19 @@ MainWindow::MainWindow(QWidget* parent)
 }
 
 void MainWindow::setupConnections() {
-    // 连接适配器信号
-    connect(m_adapter, &CoreToQtAdapter::dataReady, 
-            this, &MainWindow::onDataReady);
+    // 连接适配器信号：文件加载完成后把数据模型交给绘图控件，由其按可见范围降采样
+    connect(m_adapter, &CoreToQtAdapter::dataLoaded,
+            this, &MainWindow::onDataLoaded);
+    connect(m_adapter, &CoreToQtAdapter::dataCleared,
+            this, &MainWindow::onDataCleared);
     connect(m_adapter, &CoreToQtAdapter::errorOccurred,
             this, &MainWindow::onErrorOccurred);
+    
+    connect(m_adapter, &CoreToQtAdapter::realTimeBatchReady,
+            m_plotWidget, &PlotWidget::onRealTimeBatchReady);
+    
+    // 绘图刷新率取自 display/refresh_rate
+    m_plotWidget->setRefreshRate(ApplicationConfig::getInstance().getPlotRefreshRate());
 }
 
 void MainWindow::onOpenFile() {
@@ -35,11 +44,19 @@ void MainWindow::onOpenFile() {
     }
 }
 
-void MainWindow::onDataReady(const QVector<double>& data) {
-    // 将数据传递给绘图控件
-    QVector<double> xData;
-    for (int i = 0; i < data.size(); ++i) {
-        xData.append(i);
+void MainWindow::onDataLoaded(bool success, const QString& message) {
+    if (!success) {
+        statusBar()->showMessage(message);
+        return;
     }
-    m_plotWidget->addDataset("数据", xData, data);
+    
+    // 替换上一份数据的曲线，第一个字段作为x轴
+    m_plotWidget->clearData();
+    m_plotWidget->setDataModel(m_adapter->getDataModel());
+    statusBar()->showMessage(message);
+}
+
+void MainWindow::onDataCleared() {
+    m_plotWidget->setDataModel(QSharedPointer<DataModel>());
+    m_plotWidget->clearData();
 }
\ No newline at end of file
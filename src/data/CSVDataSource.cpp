@@ -1,12 +1,22 @@
 #include "CSVDataSource.h"
+#include "ParseCache.h"
+#include "LineBlockReader.h"
+#include "utils/Tracer.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+// 字段首尾忽略的空白字符
+static bool isFieldSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
 
 CSVDataSource::CSVDataSource() 
-    : m_delimiter(','), m_hasHeader(true), m_skipLines(0), 
+    : m_delimiter(','), m_hasHeader(true), m_skipLines(0), m_useParseCache(true), m_inferColumnTypes(false),
       m_state(State::Stopped), m_dataModel(std::make_shared<DataModel>()) {}
 
 bool CSVDataSource::initialize(const std::string& config) {
@@ -14,11 +24,14 @@ bool CSVDataSource::initialize(const std::string& config) {
     m_state = State::Stopped;
     m_headers.clear();
     m_parseResult = ParseResult();
+    m_cancelRequested.store(false);
     
     return true;
 }
 
 bool CSVDataSource::start() {
+    TRACE_SCOPE("data", "CSVDataSource::start");
+    
     if (m_filename.empty()) {
         if (m_errorCallback) {
             m_errorCallback("文件名不能为空");
@@ -26,6 +39,15 @@ bool CSVDataSource::start() {
         return false;
     }
     
+    // 文件和解析设置都未变化时直接使用缓存的解析结果
+    std::string cacheKey;
+    if (m_useParseCache && ParseCache::getInstance().isEnabled()) {
+        cacheKey = ParseCache::makeKey(m_filename, parseSettingsKey());
+        if (loadFromCache(cacheKey)) {
+            return true;
+        }
+    }
+    
     std::ifstream file(m_filename.c_str());
     if (!file.is_open()) {
         if (m_errorCallback) {
@@ -34,8 +56,15 @@ bool CSVDataSource::start() {
         return false;
     }
     
+    // 文件总字节数，用于进度计算
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    size_t totalBytes = fileSize > 0 ? static_cast<size_t>(fileSize) : 0;
+    file.seekg(0, std::ios::beg);
+    
     // 重置数据模型
     m_dataModel->clear();
+    m_dataModel->setSchema(m_columnTypes);
     m_headers.clear();
     m_parseResult = ParseResult();
     
@@ -74,53 +103,70 @@ bool CSVDataSource::start() {
         }
     }
     
-    // 解析数据行
-    while (std::getline(file, line)) {
-        lineNumber++;
-        
-        // 跳过空行和注释行（以#开头）
-        if (line.empty() || line[0] == '#') {
-            skippedLines++;
-            continue;
-        }
-        
-        std::vector<double> values;
-        if (parseLine(line, values)) {
-            if (values.empty()) {
-                skippedLines++;
-                continue;
+    std::streamoff headerEnd = file.tellg();
+    size_t bytesRead = headerEnd > 0 ? static_cast<size_t>(headerEnd) : 0;
+    reportProgress(bytesRead, totalBytes);
+    
+    // 数据行按换行对齐的块在共享线程池中并行解析，再按文件顺序写入模型，结果与逐行解析一致。
+    // 列号到字段名的映射只在遇到更多列时扩展，稳定后每行不再申请堆内存
+    std::vector<std::string> fieldNames(m_headers);
+    LineBlockReader reader;
+    reader.read(file,
+        [this](const char* begin, const char* end, ParseArena& arena, LineBlockReader::Row& row) {
+            // 跳过空行和注释行（以#开头）
+            if (begin == end || *begin == '#') {
+                return false;
             }
+            double* values = nullptr;
+            bool* validMask = nullptr;
+            size_t fieldCount = 0;
+            if (!parseLine(begin, end, arena, values, validMask, fieldCount)) {
+                return false;
+            }
+            row.values = values;
+            row.valid = validMask;
+            row.count = fieldCount;
+            return true;
+        },
+        [&](const LineBlockReader::Block& block, size_t blockBytes) {
+            lineNumber += static_cast<int>(block.lines);
+            skippedLines += static_cast<int>(block.skippedLines);
             
-            // 创建数据点
-            std::map<std::string, double> point;
-            
-            // 如果有表头，使用表头作为字段名
-            if (!m_headers.empty()) {
-                for (size_t i = 0; i < values.size() && i < m_headers.size(); ++i) {
-                    point[m_headers[i]] = values[i];
+            for (size_t r = 0; r < block.rows.size(); ++r) {
+                const LineBlockReader::Row& row = block.rows[r];
+                // 有表头时使用表头作为字段名，多余的列和无表头时生成默认字段名
+                while (fieldNames.size() < row.count) {
+                    fieldNames.push_back("Column_" + std::to_string(fieldNames.size() + 1));
                 }
                 
-                // 如果值比表头多，为多余的列生成字段名
-                for (size_t i = m_headers.size(); i < values.size(); ++i) {
-                    std::string fieldName = "Column_" + std::to_string(i + 1);
-                    point[fieldName] = values[i];
-                }
-            } else {
-                // 没有表头，使用默认字段名
-                for (size_t i = 0; i < values.size(); ++i) {
-                    std::string fieldName = "Column_" + std::to_string(i + 1);
-                    point[fieldName] = values[i];
+                // 空字段和无法解析的字段在原位置记为空值
+                for (size_t i = 0; i < row.count; ++i) {
+                    if (!row.valid[i]) {
+                        m_parseResult.nullValues++;
+                    }
                 }
+                
+                m_dataModel->addDataPoint(fieldNames.data(), row.values, row.valid, row.count);
+                validLines++;
             }
             
-            m_dataModel->addDataPoint(point);
-            validLines++;
-        } else {
-            skippedLines++;
-        }
+            // 每块检查一次取消请求并报告进度
+            if (isCancelRequested()) {
+                return false;
+            }
+            reportProgress(bytesRead + blockBytes, totalBytes);
+            return true;
+        });
+    
+    if (isCancelRequested()) {
+        m_dataModel->clear();
+        m_parseResult.errorMessage = "加载已取消";
+        m_state = State::Stopped;
+        return false;
     }
     
     file.close();
+    reportProgress(totalBytes, totalBytes);
     
     // 更新解析结果
     m_parseResult.success = true;
@@ -128,6 +174,20 @@ bool CSVDataSource::start() {
     m_parseResult.validLines = validLines;
     m_parseResult.skippedLines = skippedLines;
     
+    if (m_inferColumnTypes) {
+        m_dataModel->applyInferredTypes();
+    }
+    
+    // 记录列顺序（数据模型按字段名排序），缓存命中时据此恢复表头
+    for (size_t i = 0; i < m_headers.size(); ++i) {
+        m_dataModel->setFieldMetadata(m_headers[i], "column_index",
+                                      DataModel::MetadataValue(static_cast<int>(i)));
+    }
+    
+    if (!cacheKey.empty()) {
+        ParseCache::getInstance().store(cacheKey, *m_dataModel);
+    }
+    
     m_state = State::Running;
     
     if (m_dataReadyCallback) {
@@ -139,6 +199,63 @@ bool CSVDataSource::start() {
     return true;
 }
 
+std::string CSVDataSource::parseSettingsKey() const {
+    std::ostringstream settings;
+    settings << "csv;delimiter=" << static_cast<int>(m_delimiter)
+             << ";header=" << m_hasHeader << ";skip=" << m_skipLines
+             << ";infer=" << m_inferColumnTypes;
+    for (DataModel::Schema::const_iterator it = m_columnTypes.begin(); it != m_columnTypes.end(); ++it) {
+        settings << ";type:" << it->first << "=" << TypedColumn::typeName(it->second);
+    }
+    return settings.str();
+}
+
+bool CSVDataSource::loadFromCache(const std::string& cacheKey) {
+    std::shared_ptr<DataModel> cached = ParseCache::getInstance().lookup(cacheKey);
+    if (!cached) {
+        return false;
+    }
+    
+    m_dataModel = cached;
+    
+    // 按记录的列顺序恢复表头
+    m_headers.clear();
+    if (m_hasHeader) {
+        std::vector<std::string> fieldNames = m_dataModel->getFieldNames();
+        std::vector<std::pair<int, std::string> > ordered;
+        for (size_t i = 0; i < fieldNames.size(); ++i) {
+            DataModel::MetadataValue index = m_dataModel->getFieldMetadata(fieldNames[i], "column_index");
+            if (index.type == DataModel::MetadataValue::INT) {
+                ordered.push_back(std::make_pair(index.intValue, fieldNames[i]));
+            }
+        }
+        std::sort(ordered.begin(), ordered.end());
+        for (size_t i = 0; i < ordered.size(); ++i) {
+            m_headers.push_back(ordered[i].second);
+        }
+    }
+    
+    m_parseResult = ParseResult();
+    m_parseResult.success = true;
+    m_parseResult.validLines = static_cast<int>(m_dataModel->size());
+    m_parseResult.totalLines = m_parseResult.validLines;
+    m_parseResult.fromCache = true;
+    std::vector<std::string> cachedFields = m_dataModel->getFieldNames();
+    for (size_t i = 0; i < cachedFields.size(); ++i) {
+        m_parseResult.nullValues += m_dataModel->getNullCount(cachedFields[i]);
+    }
+    
+    reportProgress(1, 1);
+    m_state = State::Running;
+    
+    if (m_dataReadyCallback) {
+        m_dataReadyCallback();
+    }
+    
+    std::cout << "CSV解析缓存命中: " << m_filename << std::endl;
+    return true;
+}
+
 void CSVDataSource::stop() {
     m_dataModel->clear();
     m_state = State::Stopped;
@@ -148,66 +265,60 @@ std::vector<double> CSVDataSource::getData() {
     // 返回第一个字段的数据作为示例
     auto fieldNames = m_dataModel->getFieldNames();
     if (!fieldNames.empty()) {
-        return m_dataModel->getDataSeries(fieldNames[0]);
+        ColumnBuffer series = m_dataModel->getColumnBuffer(fieldNames[0]);
+        std::vector<double> values(series.size());
+        series.copyTo(0, values.size(), values.data());
+        return values;
     }
     return std::vector<double>();
 }
 
-bool CSVDataSource::parseLine(const std::string& line, std::vector<double>& values) {
-    std::istringstream ss(line);
-    std::string token;
-    std::vector<double> parsedValues;
+bool CSVDataSource::parseLine(const char* begin, const char* end, ParseArena& arena,
+                              double*& values, bool*& validMask, size_t& count) const {
+    // 字段数 = 分隔符数 + 1（行尾分隔符之后是一个空字段），一次分配
+    count = static_cast<size_t>(std::count(begin, end, m_delimiter)) + 1;
+    values = arena.allocateArray<double>(count);
+    validMask = arena.allocateArray<bool>(count);
     
-    while (std::getline(ss, token, m_delimiter)) {
-        // 去除首尾空白字符
-        token.erase(0, token.find_first_not_of(" \t\r\n"));
-        token.erase(token.find_last_not_of(" \t\r\n") + 1);
+    bool anyValid = false;
+    const char* fieldBegin = begin;
+    for (size_t i = 0; i < count; ++i) {
+        const char* fieldEnd = std::find(fieldBegin, end, m_delimiter);
         
-        if (token.empty()) {
-            // 空字段，跳过或使用默认值
-            continue;
-        }
+        // 空字段或无法解析的字段保留位置，记为空值
+        double value = 0.0;
+        bool valid = parseDouble(arena, fieldBegin, fieldEnd, value);
+        values[i] = valid ? value : 0.0;
+        validMask[i] = valid;
+        anyValid = anyValid || valid;
         
-        double value;
-        if (parseDouble(token, value)) {
-            parsedValues.push_back(value);
-        } else {
-            // 解析失败，跳过这一行
-            return false;
-        }
-    }
-    
-    if (!parsedValues.empty()) {
-        values = parsedValues;
-        return true;
+        fieldBegin = fieldEnd == end ? end : fieldEnd + 1;
     }
     
-    return false;
+    // 整行没有任何数值（如重复的表头）时跳过
+    return anyValid;
 }
 
-bool CSVDataSource::parseDouble(const std::string& str, double& value) {
-    if (str.empty()) {
-        return false;
+bool CSVDataSource::parseDouble(ParseArena& arena, const char* begin, const char* end, double& value) {
+    // 去除首尾空白字符
+    while (begin < end && isFieldSpace(*begin)) {
+        ++begin;
     }
-    
-    try {
-        size_t pos;
-        value = std::stod(str, &pos);
-        
-        // 检查是否整个字符串都被成功转换
-        if (pos != str.length()) {
-            // 可能有尾随字符，尝试再次检查
-            std::string remaining = str.substr(pos);
-            // 去除尾随空白字符后再次检查
-            remaining.erase(0, remaining.find_first_not_of(" \t\r\n"));
-            if (!remaining.empty()) {
-                return false; // 有非空白尾随字符，转换失败
-            }
-        }
-        return true;
-    } catch (const std::exception& e) {
+    while (end > begin && isFieldSpace(end[-1])) {
+        --end;
+    }
+    if (begin == end) {
         return false;
     }
+    
+    // strtod 需要以 '\0' 结尾的字符串，字段副本放在解析区中
+    char* text = arena.copyString(begin, end);
+    char* parsedEnd = nullptr;
+    errno = 0;
+    value = std::strtod(text, &parsedEnd);
+    
+    // 整个字段都须被转换；超出 double 范围按无法解析处理
+    return parsedEnd == text + (end - begin) && errno != ERANGE;
 }
 
 void CSVDataSource::detectDelimiter(const std::string& firstLine) {
@@ -0,0 +1,83 @@
+#include "ChunkPool.h"
+
+const size_t ChunkPool::CHUNK_VALUES;
+
+ChunkPool& ChunkPool::getInstance() {
+    // 有意不析构：静态对象析构时仍可能有列归还数据块
+    static ChunkPool* instance = new ChunkPool();
+    return *instance;
+}
+
+ChunkPool::ChunkPool() : m_maxCached(64) {}
+
+double* ChunkPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.acquires++;
+        if (!m_freeChunks.empty()) {
+            double* chunk = m_freeChunks.back();
+            m_freeChunks.pop_back();
+            m_stats.cached = m_freeChunks.size();
+            m_stats.reuses++;
+            return chunk;
+        }
+        m_stats.allocated++;
+    }
+    return new double[CHUNK_VALUES];
+}
+
+void ChunkPool::release(double* chunk) {
+    if (!chunk) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_freeChunks.size() < m_maxCached) {
+            m_freeChunks.push_back(chunk);
+            m_stats.cached = m_freeChunks.size();
+            return;
+        }
+        m_stats.allocated--;
+    }
+    delete[] chunk;
+}
+
+void ChunkPool::setMaxCachedChunks(size_t count) {
+    std::vector<double*> released;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxCached = count;
+        while (m_freeChunks.size() > m_maxCached) {
+            released.push_back(m_freeChunks.back());
+            m_freeChunks.pop_back();
+        }
+        m_stats.allocated -= released.size();
+        m_stats.cached = m_freeChunks.size();
+    }
+    for (size_t i = 0; i < released.size(); ++i) {
+        delete[] released[i];
+    }
+}
+
+size_t ChunkPool::getMaxCachedChunks() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxCached;
+}
+
+void ChunkPool::trim() {
+    std::vector<double*> released;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        released.swap(m_freeChunks);
+        m_stats.allocated -= released.size();
+        m_stats.cached = 0;
+    }
+    for (size_t i = 0; i < released.size(); ++i) {
+        delete[] released[i];
+    }
+}
+
+ChunkPool::Stats ChunkPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,292 @@
+#include "ColumnBuffer.h"
+#include "ChunkPool.h"
+#include <algorithm>
+#include <cstring>
+
+const size_t ColumnBuffer::CHUNK_SHIFT;
+const size_t ColumnBuffer::CHUNK_SIZE;
+const size_t ColumnBuffer::TAIL_LOCKED;
+
+static_assert(ColumnBuffer::CHUNK_SIZE == ChunkPool::CHUNK_VALUES, "列块大小须与块池一致");
+
+// 首块的初始容量，之后按需倍增直到一整块
+static const size_t FIRST_CHUNK_CAPACITY = 16;
+static const size_t MIN_DIRECTORY_SLOTS = 4;
+
+ColumnBuffer::Chunk::~Chunk() {
+    if (owner) {
+        return;
+    }
+    if (capacity == CHUNK_SIZE) {
+        ChunkPool::getInstance().release(values);
+    } else {
+        delete[] values;
+    }
+}
+
+ColumnBuffer::ColumnBuffer() : m_offset(0), m_size(0) {}
+
+ColumnBuffer::ColumnBuffer(Storage values) : m_offset(0), m_size(0) {
+    if (!values.empty()) {
+        std::shared_ptr<const Storage> source = std::make_shared<const Storage>(std::move(values));
+        adopt(source, source->data(), source->size());
+        m_directory->source = source;
+    }
+}
+
+ColumnBuffer::ColumnBuffer(const double* data, size_t count) : m_offset(0), m_size(0) {
+    if (data && count > 0) {
+        std::shared_ptr<const Storage> source = std::make_shared<const Storage>(data, data + count);
+        adopt(source, source->data(), count);
+        m_directory->source = source;
+    }
+}
+
+ColumnBuffer::ColumnBuffer(const std::shared_ptr<const void>& owner, const double* data, size_t count)
+    : m_offset(0), m_size(0) {
+    if (data && count > 0) {
+        adopt(owner, data, count);
+    }
+}
+
+void ColumnBuffer::adopt(const std::shared_ptr<const void>& owner, const double* data, size_t count) {
+    size_t slots = (count + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    m_directory = std::make_shared<Directory>(slots, count);
+    for (size_t slot = 0; slot < slots; ++slot) {
+        size_t start = slot << CHUNK_SHIFT;
+        std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>(const_cast<double*>(data + start),
+                                                               std::min(CHUNK_SIZE, count - start));
+        chunk->owner = owner;
+        m_directory->chunks[slot] = chunk;
+    }
+    m_directory->base = data;
+    m_directory->baseSize = count;
+    m_offset = 0;
+    m_size = count;
+}
+
+std::shared_ptr<ColumnBuffer::Chunk> ColumnBuffer::allocateChunk(size_t capacity) {
+    double* values = capacity == CHUNK_SIZE ? ChunkPool::getInstance().acquire() : new double[capacity];
+    return std::make_shared<Chunk>(values, capacity);
+}
+
+size_t ColumnBuffer::spanAt(size_t index, const double*& values) const {
+    if (index >= m_size) {
+        values = nullptr;
+        return 0;
+    }
+    const Directory& directory = *m_directory;
+    size_t position = m_offset + index;
+    if (directory.base && m_offset + m_size <= directory.baseSize) {
+        values = directory.base + position;
+        return m_size - index;
+    }
+    size_t within = position & (CHUNK_SIZE - 1);
+    values = directory.chunks[position >> CHUNK_SHIFT]->values + within;
+    return std::min(CHUNK_SIZE - within, m_size - index);
+}
+
+void ColumnBuffer::copyTo(size_t startIndex, size_t count, double* output) const {
+    size_t endIndex = std::min(m_size, startIndex + count);
+    forEachSpan(startIndex, endIndex, [&](size_t index, const double* values, size_t spanCount) {
+        std::memcpy(output + (index - startIndex), values, spanCount * sizeof(double));
+    });
+}
+
+const double* ColumnBuffer::contiguousData() const {
+    if (m_size == 0) {
+        return nullptr;
+    }
+    const double* values = nullptr;
+    return spanAt(0, values) == m_size ? values : nullptr;
+}
+
+const double* ColumnBuffer::contiguousData(Storage& scratch) const {
+    const double* values = contiguousData();
+    if (values || m_size == 0) {
+        return values;
+    }
+    scratch.resize(m_size);
+    copyTo(0, m_size, scratch.data());
+    return scratch.data();
+}
+
+ColumnBuffer ColumnBuffer::slice(size_t startIndex, size_t endIndex) const {
+    ColumnBuffer view(*this);
+    endIndex = std::min(endIndex, m_size);
+    startIndex = std::min(startIndex, endIndex);
+    view.m_offset = m_offset + startIndex;
+    view.m_size = endIndex - startIndex;
+    return view;
+}
+
+void ColumnBuffer::dropFront(size_t count) {
+    count = std::min(count, m_size);
+    size_t firstSlot = m_offset >> CHUNK_SHIFT;
+    m_offset += count;
+    m_size -= count;
+    
+    // 独占目录时立即把整块丢弃的数据块还给块池
+    if (m_directory && !isShared()) {
+        size_t newFirstSlot = m_offset >> CHUNK_SHIFT;
+        for (size_t slot = firstSlot; slot < newFirstSlot; ++slot) {
+            m_directory->chunks[slot].reset();
+        }
+        if (newFirstSlot > firstSlot) {
+            m_directory->source.reset();
+            m_directory->base = nullptr;
+        }
+    }
+}
+
+const ColumnBuffer::Storage* ColumnBuffer::storage() const {
+    if (m_directory && m_directory->source && m_offset == 0 && m_size == m_directory->source->size()) {
+        return m_directory->source.get();
+    }
+    return nullptr;
+}
+
+bool ColumnBuffer::isShared() const {
+    return m_directory && m_directory.use_count() > 1;
+}
+
+void ColumnBuffer::push_back(double value) {
+    if (!claimTail()) {
+        rebuild(1);
+        claimTail();
+    }
+    size_t position = m_offset + m_size;
+    m_directory->chunks[position >> CHUNK_SHIFT]->values[position & (CHUNK_SIZE - 1)] = value;
+    ++m_size;
+}
+
+void ColumnBuffer::reserve(size_t count) {
+    size_t slots = ((m_offset + std::max(count, m_size)) >> CHUNK_SHIFT) + 1;
+    if (!m_directory || slots > m_directory->chunks.size()) {
+        rebuild(count > m_size ? count - m_size : 0);
+    }
+}
+
+size_t ColumnBuffer::mutableSpanAt(size_t index, double*& values) {
+    if (index >= m_size) {
+        values = nullptr;
+        return 0;
+    }
+    if (isShared()) {
+        rebuild(0);
+    }
+    
+    size_t position = m_offset + index;
+    size_t slot = position >> CHUNK_SHIFT;
+    size_t within = position & (CHUNK_SIZE - 1);
+    std::shared_ptr<Chunk>& chunk = m_directory->chunks[slot];
+    if (!chunk->writable() || chunk.use_count() > 1) {
+        // 只复制被修改的块
+        size_t used = std::min(chunk->capacity, m_offset + m_size - (slot << CHUNK_SHIFT));
+        std::shared_ptr<Chunk> copy = allocateChunk(slot == 0 ? chunk->capacity : CHUNK_SIZE);
+        std::memcpy(copy->values, chunk->values, used * sizeof(double));
+        chunk = copy;
+        m_directory->source.reset();
+        m_directory->base = nullptr;
+    }
+    
+    values = chunk->values + within;
+    return std::min(CHUNK_SIZE - within, m_size - index);
+}
+
+void ColumnBuffer::clear() {
+    m_directory.reset();
+    m_offset = 0;
+    m_size = 0;
+}
+
+size_t ColumnBuffer::memoryBytes() const {
+    if (!m_directory || m_size == 0) {
+        return 0;
+    }
+    size_t bytes = 0;
+    size_t lastSlot = (m_offset + m_size - 1) >> CHUNK_SHIFT;
+    for (size_t slot = m_offset >> CHUNK_SHIFT; slot <= lastSlot; ++slot) {
+        bytes += m_directory->chunks[slot]->capacity * sizeof(double);
+    }
+    return bytes;
+}
+
+bool ColumnBuffer::claimTail() {
+    if (!m_directory) {
+        return false;
+    }
+    Directory& directory = *m_directory;
+    size_t end = m_offset + m_size;
+    size_t slot = end >> CHUNK_SHIFT;
+    size_t within = end & (CHUNK_SIZE - 1);
+    if (slot >= directory.chunks.size()) {
+        return false;
+    }
+    if (within != 0) {
+        // 尾块在本视图取得之前已写入，可以安全读取其属性
+        const Chunk& chunk = *directory.chunks[slot];
+        if (!chunk.writable() || within >= chunk.capacity) {
+            return false;
+        }
+    }
+    
+    // 只有恰好停在尾部的视图能占用下一个位置；其他视图（包括已被追加越过的旧视图）失败后重建
+    size_t expected = end;
+    if (!directory.length.compare_exchange_strong(expected, end + 1)) {
+        return false;
+    }
+    if (within == 0) {
+        // 新块的槽位只有占用了该块首位置的视图会写入
+        directory.chunks[slot] = allocateChunk(slot == 0 ? FIRST_CHUNK_CAPACITY : CHUNK_SIZE);
+    }
+    return true;
+}
+
+void ColumnBuffer::rebuild(size_t extraCapacity) {
+    size_t end = m_offset + m_size;
+    size_t firstSlot = m_offset >> CHUNK_SHIFT;
+    size_t lastSlot = m_size > 0 ? (end - 1) >> CHUNK_SHIFT : firstSlot;
+    size_t within = end & (CHUNK_SIZE - 1);
+    
+    std::shared_ptr<Directory> directory;
+    if (m_size == 0 || (lastSlot == firstSlot && within != 0)) {
+        // 视图落在一个未满的块内：复制到新的首块并去掉已丢弃的前缀，首块容量按需倍增
+        size_t capacity = FIRST_CHUNK_CAPACITY;
+        while (capacity < CHUNK_SIZE && (capacity < m_size * 2 || capacity < m_size + extraCapacity)) {
+            capacity *= 2;
+        }
+        size_t slots = std::max(MIN_DIRECTORY_SLOTS, ((m_size + extraCapacity) >> CHUNK_SHIFT) + 2);
+        directory = std::make_shared<Directory>(slots, m_size);
+        if (m_size > 0) {
+            std::shared_ptr<Chunk> chunk = allocateChunk(capacity);
+            copyTo(0, m_size, chunk->values);
+            directory->chunks[0] = chunk;
+        }
+        m_offset = 0;
+    } else {
+        // 已写满的块只读，直接共享；目录从视图首元素所在的块开始
+        size_t offset = m_offset & (CHUNK_SIZE - 1);
+        size_t usedSlots = lastSlot - firstSlot + 1;
+        size_t slots = std::max(MIN_DIRECTORY_SLOTS, usedSlots * 2);
+        slots = std::max(slots, ((offset + m_size + extraCapacity) >> CHUNK_SHIFT) + 1);
+        directory = std::make_shared<Directory>(slots, offset + m_size);
+        for (size_t slot = firstSlot; slot <= lastSlot; ++slot) {
+            directory->chunks[slot - firstSlot] = m_directory->chunks[slot];
+        }
+        if (within != 0) {
+            // 未满的尾块可能还会被原目录上的其他视图写入：能锁定原目录尾部时接管，否则复制已写部分
+            std::shared_ptr<Chunk>& tail = directory->chunks[lastSlot - firstSlot];
+            size_t expected = end;
+            bool takeOver = tail->writable() && tail->capacity == CHUNK_SIZE &&
+                            m_directory->length.compare_exchange_strong(expected, end | TAIL_LOCKED);
+            if (!takeOver) {
+                std::shared_ptr<Chunk> copy = allocateChunk(CHUNK_SIZE);
+                std::memcpy(copy->values, tail->values, within * sizeof(double));
+                tail = copy;
+            }
+        }
+        m_offset = offset;
+    }
+    m_directory = directory;
+}
@@ -1,9 +1,13 @@
 #include "CustomDataSource.h"
+#include "LineBlockReader.h"
+#include "utils/Tracer.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
 #include <stdexcept>
 
 CustomDataSource::CustomDataSource() 
@@ -15,6 +19,7 @@ CustomDataSource::CustomDataSource()
     m_stats.totalPoints = 0;
     m_stats.validPoints = 0;
     m_stats.skippedPoints = 0;
+    m_stats.nullValues = 0;
 }
 
 CustomDataSource::~CustomDataSource() {
@@ -30,12 +35,16 @@ bool CustomDataSource::initialize(const std::string& config) {
     m_stats.totalPoints = 0;
     m_stats.validPoints = 0;
     m_stats.skippedPoints = 0;
+    m_stats.nullValues = 0;
     m_stats.ranges.clear();
+    m_cancelRequested.store(false);
     
     return true;
 }
 
 bool CustomDataSource::start() {
+    TRACE_SCOPE("data", "CustomDataSource::start");
+    
     if (m_sourcePath.empty()) {
         if (m_errorCallback) {
             m_errorCallback("数据源路径未设置");
@@ -51,11 +60,19 @@ bool CustomDataSource::start() {
         return false;
     }
     
+    // 文件总字节数，用于进度计算
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    size_t totalBytes = fileSize > 0 ? static_cast<size_t>(fileSize) : 0;
+    file.seekg(0, std::ios::beg);
+    size_t bytesRead = 0;
+    
     // 重置数据模型
     m_dataModel->clear();
     m_stats.totalPoints = 0;
     m_stats.validPoints = 0;
     m_stats.skippedPoints = 0;
+    m_stats.nullValues = 0;
     m_stats.ranges.clear();
     
     std::string line;
@@ -66,72 +83,90 @@ bool CustomDataSource::start() {
     for (int i = 0; i < m_config.skipLines && std::getline(file, line); ++i) {
         skippedLines++;
         lineNumber++;
+        bytesRead += line.size() + 1;
     }
     
     // 如果有标题行，跳过
     if (m_config.hasHeader && std::getline(file, line)) {
         skippedLines++;
         lineNumber++;
+        bytesRead += line.size() + 1;
     }
+    reportProgress(bytesRead, totalBytes);
     
-    // 解析数据行
-    while (std::getline(file, line)) {
-        lineNumber++;
-        
-        // 跳过空行和注释行
-        if (line.empty() || line[0] == m_config.commentChar) {
-            skippedLines++;
-            continue;
-        }
-        
-        std::vector<double> values;
-        if (!parseLine(line, values)) {
-            m_stats.skippedPoints++;
-            continue;
-        }
-        
-        if (values.empty()) {
-            m_stats.skippedPoints++;
-            continue;
-        }
-        
-        // 创建数据点映射
-        std::map<std::string, double> pointData;
-        
-        // 使用列映射
-        for (size_t i = 0; i < values.size(); ++i) {
-            std::string fieldName;
+    // 数据行按换行对齐的块在共享线程池中并行解析（含取值验证），再按文件顺序写入模型。
+    // 自定义解析器共用输出缓冲，不能并行调用，此时各块在本线程中依次解析
+    std::vector<std::string> fieldNames;
+    LineBlockReader reader;
+    reader.setParallel(!m_customParser);
+    reader.read(file,
+        [this](const char* begin, const char* end, ParseArena& arena, LineBlockReader::Row& row) {
+            // 跳过空行和注释行
+            if (begin == end || *begin == m_config.commentChar) {
+                return false;
+            }
             
-            // 查找列映射
-            std::map<int, std::string>::const_iterator it = m_config.columnMapping.find(i);
-            if (it != m_config.columnMapping.end()) {
-                fieldName = it->second;
-            } else {
-                // 如果没有映射，生成默认字段名
-                fieldName = "Column_" + std::to_string(i + 1);
+            const double* values = nullptr;
+            const bool* validMask = nullptr;
+            size_t fieldCount = 0;
+            if (!parseLine(begin, end, arena, values, validMask, fieldCount) || fieldCount == 0) {
+                return false;
             }
             
-            // 验证数据
-            if (!validateValue(values[i], m_config.validationRule)) {
-                m_stats.skippedPoints++;
-                break;
+            // 缺失或未通过验证的值在原位置记为空值
+            bool* rowValid = arena.allocateArray<bool>(fieldCount);
+            for (size_t i = 0; i < fieldCount; ++i) {
+                rowValid[i] = (!validMask || validMask[i]) && validateValue(values[i], m_config.validationRule);
             }
+            row.values = values;
+            row.valid = rowValid;
+            row.count = fieldCount;
+            return true;
+        },
+        [&](const LineBlockReader::Block& block, size_t blockBytes) {
+            // 空行、注释行与无法解析的行最终都计入 skippedPoints
+            lineNumber += static_cast<int>(block.lines);
+            skippedLines += static_cast<int>(block.skippedLines);
             
-            pointData[fieldName] = values[i];
-        }
-        
-        if (!pointData.empty()) {
-            m_dataModel->addDataPoint(pointData);
-            m_stats.validPoints++;
-        } else {
-            m_stats.skippedPoints++;
-        }
+            for (size_t r = 0; r < block.rows.size(); ++r) {
+                const LineBlockReader::Row& row = block.rows[r];
+                // 使用列映射确定字段名
+                resolveFieldNames(fieldNames, row.count);
+                bool anyValid = false;
+                for (size_t i = 0; i < row.count; ++i) {
+                    if (!row.valid[i]) {
+                        m_stats.nullValues++;
+                    }
+                    anyValid = anyValid || row.valid[i];
+                }
+                
+                if (anyValid) {
+                    m_dataModel->addDataPoint(fieldNames.data(), row.values, row.valid, row.count);
+                    m_stats.validPoints++;
+                } else {
+                    m_stats.skippedPoints++;
+                }
+            }
+            
+            // 每块检查一次取消请求并报告进度
+            if (isCancelRequested()) {
+                return false;
+            }
+            reportProgress(bytesRead + blockBytes, totalBytes);
+            return true;
+        });
+    
+    if (isCancelRequested()) {
+        m_dataModel->clear();
+        m_state = State::Stopped;
+        return false;
     }
     
     m_stats.totalPoints = lineNumber;
     m_stats.skippedPoints += skippedLines;
     
     file.close();
+    reportProgress(totalBytes, totalBytes);
     m_state = State::Running;
     updateDataReady();
     
@@ -153,52 +188,89 @@ std::vector<double> CustomDataSource::getData() {
     // 返回第一个字段的数据作为示例
     std::vector<std::string> fieldNames = m_dataModel->getFieldNames();
     if (!fieldNames.empty()) {
-        const DataModel::DataSeries& series = m_dataModel->getDataSeries(fieldNames[0]);
-        return std::vector<double>(series.begin(), series.end());
+        ColumnBuffer series = m_dataModel->getColumnBuffer(fieldNames[0]);
+        std::vector<double> values(series.size());
+        series.copyTo(0, values.size(), values.data());
+        return values;
     }
     
     return std::vector<double>();
 }
 
-bool CustomDataSource::parseLine(const std::string& line, std::vector<double>& values) {
+bool CustomDataSource::parseLine(const char* begin, const char* end, ParseArena& arena,
+                                 const double*& values, const bool*& validMask, size_t& count) {
     if (m_customParser) {
-        // 使用自定义解析器
-        return m_customParser->parseLine(line, values);
+        // 使用自定义解析器，解析出的值均视为有效；输出缓冲跨行复用，结果复制到解析区
+        m_lineText.assign(begin, end);
+        bool parsed = m_customParser->parseLine(m_lineText, m_parserValues);
+        count = m_parserValues.size();
+        double* copied = arena.allocateArray<double>(count);
+        std::copy(m_parserValues.begin(), m_parserValues.end(), copied);
+        values = copied;
+        validMask = nullptr;
+        return parsed;
     }
     
-    // 使用默认解析逻辑
-    std::istringstream ss(line);
-    std::string token;
-    std::vector<double> parsedValues;
+    // 使用默认解析逻辑：行尾分隔符之后不再算一个字段
+    count = static_cast<size_t>(std::count(begin, end, m_config.delimiter)) + 1;
+    if (count > 1 && end[-1] == m_config.delimiter) {
+        count--;
+    }
+    double* parsedValues = arena.allocateArray<double>(count);
+    bool* parsedMask = arena.allocateArray<bool>(count);
     
-    while (std::getline(ss, token, m_config.delimiter)) {
-        // 去除首尾空白字符
-        token.erase(0, token.find_first_not_of(" \t\r\n"));
-        token.erase(token.find_last_not_of(" \t\r\n") + 1);
+    bool anyValid = false;
+    const char* fieldBegin = begin;
+    for (size_t i = 0; i < count; ++i) {
+        const char* fieldEnd = std::find(fieldBegin, end, m_config.delimiter);
+        const char* next = fieldEnd == end ? end : fieldEnd + 1;
         
-        if (token.empty()) {
-            // 空字段，跳过
-            continue;
+        // 去除首尾空白字符
+        while (fieldBegin < fieldEnd && std::isspace(static_cast<unsigned char>(*fieldBegin))) {
+            ++fieldBegin;
+        }
+        while (fieldEnd > fieldBegin && std::isspace(static_cast<unsigned char>(fieldEnd[-1]))) {
+            --fieldEnd;
         }
         
-        try {
-            double value = std::stod(token);
-            parsedValues.push_back(value);
-        } catch (const std::exception& e) {
-            // 解析失败
-            return false;
+        // 空字段或解析失败的字段保留位置，记为空值；与 std::stod 一致，接受以数值开头的字段
+        double value = 0.0;
+        bool valid = false;
+        if (fieldBegin < fieldEnd) {
+            char* text = arena.copyString(fieldBegin, fieldEnd);
+            char* parsedEnd = nullptr;
+            errno = 0;
+            double parsed = std::strtod(text, &parsedEnd);
+            if (parsedEnd != text && errno != ERANGE) {
+                value = parsed;
+                valid = true;
+            }
         }
+        parsedValues[i] = value;
+        parsedMask[i] = valid;
+        anyValid = anyValid || valid;
+        fieldBegin = next;
     }
     
-    if (!parsedValues.empty()) {
-        values = parsedValues;
-        return true;
+    values = parsedValues;
+    validMask = parsedMask;
+    return anyValid;
+}
+
+void CustomDataSource::resolveFieldNames(std::vector<std::string>& names, size_t count) const {
+    while (names.size() < count) {
+        int column = static_cast<int>(names.size());
+        std::map<int, std::string>::const_iterator it = m_config.columnMapping.find(column);
+        if (it != m_config.columnMapping.end()) {
+            names.push_back(it->second);
+        } else {
+            // 如果没有映射，生成默认字段名
+            names.push_back("Column_" + std::to_string(column + 1));
+        }
     }
-    
-    return false;
 }
 
-bool CustomDataSource::validateValue(double value, const ParseConfig::ValidationRule& rule) {
+bool CustomDataSource::validateValue(double value, const ParseConfig::ValidationRule& rule) const {
     if (std::isnan(value) && !rule.allowNaN) {
         return false;
     }
@@ -300,20 +372,14 @@ CustomDataSource::DataStats CustomDataSource::getStatistics() const {
     std::vector<std::string> fieldNames = m_dataModel->getFieldNames();
     for (size_t i = 0; i < fieldNames.size(); ++i) {
         const std::string& fieldName = fieldNames[i];
-        const DataModel::DataSeries& series = m_dataModel->getDataSeries(fieldName);
         
-        if (series.empty()) {
+        // 使用DataModel的分块摘要，避免全列扫描
+        double minVal = 0.0;
+        double maxVal = 0.0;
+        if (!m_dataModel->getFieldRange(fieldName, minVal, maxVal)) {
             continue;
         }
         
-        double minVal = series[0];
-        double maxVal = series[0];
-        
-        for (size_t j = 0; j < series.size(); ++j) {
-            minVal = std::min(minVal, series[j]);
-            maxVal = std::max(maxVal, series[j]);
-        }
-        
         stats.ranges[fieldName] = std::make_pair(minVal, maxVal);
     }
     
@@ -0,0 +1,351 @@
+#include "DataDecimator.h"
+#include "LodPyramid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 各算法按列访问方式实例化：连续数组（const double*）或分块存储的列视图（ColumnBuffer）
+inline bool isMissing(const double* data) { return data == nullptr; }
+inline bool isMissing(const ColumnBuffer&) { return false; }
+
+template <typename Column>
+void minMaxImpl(const Column& x, const Column& y,
+                size_t startIndex, size_t endIndex, size_t maxPoints,
+                std::vector<double>& outX, std::vector<double>& outY) {
+    size_t count = endIndex - startIndex;
+    size_t bucketCount = std::max<size_t>(1, maxPoints / 2);
+
+    outX.reserve(bucketCount * 2);
+    outY.reserve(bucketCount * 2);
+
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        size_t bucketStart = startIndex + count * bucket / bucketCount;
+        size_t bucketEnd = startIndex + count * (bucket + 1) / bucketCount;
+
+        size_t minIndex = bucketEnd;
+        size_t maxIndex = bucketEnd;
+        for (size_t i = bucketStart; i < bucketEnd; ++i) {
+            if (std::isnan(y[i])) {
+                continue;
+            }
+            if (minIndex == bucketEnd || y[i] < y[minIndex]) {
+                minIndex = i;
+            }
+            if (maxIndex == bucketEnd || y[i] > y[maxIndex]) {
+                maxIndex = i;
+            }
+        }
+
+        if (minIndex == bucketEnd) {
+            continue; // 整个桶都是无效值
+        }
+
+        // 按原始顺序输出，保持x单调
+        size_t first = std::min(minIndex, maxIndex);
+        size_t second = std::max(minIndex, maxIndex);
+        outX.push_back(x[first]);
+        outY.push_back(y[first]);
+        if (second != first) {
+            outX.push_back(x[second]);
+            outY.push_back(y[second]);
+        }
+    }
+}
+
+template <typename Column>
+void lttbImpl(const Column& x, const Column& y,
+              size_t startIndex, size_t endIndex, size_t maxPoints,
+              std::vector<double>& outX, std::vector<double>& outY) {
+    size_t count = endIndex - startIndex;
+    if (maxPoints < 3) {
+        outX.push_back(x[startIndex]);
+        outY.push_back(y[startIndex]);
+        outX.push_back(x[endIndex - 1]);
+        outY.push_back(y[endIndex - 1]);
+        return;
+    }
+
+    outX.reserve(maxPoints);
+    outY.reserve(maxPoints);
+
+    // 首点总是保留
+    outX.push_back(x[startIndex]);
+    outY.push_back(y[startIndex]);
+
+    double every = static_cast<double>(count - 2) / static_cast<double>(maxPoints - 2);
+    size_t a = startIndex;
+
+    for (size_t i = 0; i < maxPoints - 2; ++i) {
+        // 下一个桶的平均点
+        size_t avgStart = startIndex + static_cast<size_t>(std::floor((i + 1) * every)) + 1;
+        size_t avgEnd = startIndex + static_cast<size_t>(std::floor((i + 2) * every)) + 1;
+        avgEnd = std::min(avgEnd, endIndex);
+
+        double avgX = 0.0;
+        double avgY = 0.0;
+        size_t avgCount = 0;
+        for (size_t j = avgStart; j < avgEnd; ++j) {
+            if (std::isnan(y[j])) {
+                continue;
+            }
+            avgX += x[j];
+            avgY += y[j];
+            avgCount++;
+        }
+        if (avgCount > 0) {
+            avgX /= avgCount;
+            avgY /= avgCount;
+        } else {
+            avgX = x[endIndex - 1];
+            avgY = y[endIndex - 1];
+        }
+
+        // 当前桶中与前一选中点、下一桶平均点构成最大三角形的点
+        size_t rangeStart = startIndex + static_cast<size_t>(std::floor(i * every)) + 1;
+        size_t rangeEnd = startIndex + static_cast<size_t>(std::floor((i + 1) * every)) + 1;
+        rangeEnd = std::min(rangeEnd, endIndex - 1);
+
+        double pointAX = x[a];
+        double pointAY = y[a];
+        double maxArea = -1.0;
+        size_t selected = rangeStart;
+
+        for (size_t j = rangeStart; j < rangeEnd; ++j) {
+            if (std::isnan(y[j])) {
+                continue;
+            }
+            double area = std::fabs((pointAX - avgX) * (y[j] - pointAY) -
+                                    (pointAX - x[j]) * (avgY - pointAY)) * 0.5;
+            if (area > maxArea) {
+                maxArea = area;
+                selected = j;
+            }
+        }
+
+        if (maxArea < 0.0) {
+            continue; // 桶内全部为无效值
+        }
+
+        outX.push_back(x[selected]);
+        outY.push_back(y[selected]);
+        a = selected;
+    }
+
+    // 末点总是保留
+    outX.push_back(x[endIndex - 1]);
+    outY.push_back(y[endIndex - 1]);
+}
+
+template <typename Column>
+void decimateImpl(const Column& x, const Column& y,
+                  size_t startIndex, size_t endIndex, size_t maxPoints, DataDecimator::Mode mode,
+                  std::vector<double>& outX, std::vector<double>& outY) {
+    outX.clear();
+    outY.clear();
+
+    if (isMissing(x) || isMissing(y) || startIndex >= endIndex) {
+        return;
+    }
+
+    size_t count = endIndex - startIndex;
+    if (mode == DataDecimator::Mode::None || count <= maxPoints) {
+        // 点数已足够少，直接复制
+        outX.resize(count);
+        outY.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            outX[i] = x[startIndex + i];
+            outY[i] = y[startIndex + i];
+        }
+        return;
+    }
+
+    switch (mode) {
+    case DataDecimator::Mode::MinMax:
+        minMaxImpl(x, y, startIndex, endIndex, maxPoints, outX, outY);
+        break;
+    case DataDecimator::Mode::LTTB:
+        lttbImpl(x, y, startIndex, endIndex, maxPoints, outX, outY);
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename Column>
+void decimateLodImpl(const Column& x, const Column& y,
+                     size_t startIndex, size_t endIndex, size_t maxPoints, DataDecimator::Mode mode,
+                     const LodPyramid& yLod,
+                     std::vector<double>& outX, std::vector<double>& outY) {
+    size_t count = endIndex > startIndex ? endIndex - startIndex : 0;
+    if (mode == DataDecimator::Mode::None || count <= maxPoints) {
+        decimateImpl(x, y, startIndex, endIndex, maxPoints, mode, outX, outY);
+        return;
+    }
+
+    // 所选层在可见区间内的节点数大致落在 [minNodes, 2*minNodes]。
+    // MinMax每个节点输出两个点，取 maxPoints/4；LTTB需要比输出多几倍的候选点
+    size_t minNodes = (mode == DataDecimator::Mode::MinMax) ? std::max<size_t>(1, maxPoints / 4) : maxPoints * 4;
+    size_t level = yLod.selectLevel(count, minNodes);
+
+    const LodPyramid::Node* yNodes = nullptr;
+    size_t firstRow = startIndex;
+    size_t nodeCount = yLod.nodesInRange(level, startIndex, endIndex, yNodes, firstRow);
+    if (mode == DataDecimator::Mode::MinMax) {
+        // 节点各两个点加两端各至多两个原始点必须不超过上限，超出时换更粗的层；
+        // 最粗的层仍超出时退回逐点降采样
+        const size_t edgePoints = 4;
+        while (nodeCount > 0 && nodeCount * 2 + edgePoints > maxPoints) {
+            if (level >= yLod.levelCount()) {
+                nodeCount = 0;
+                break;
+            }
+            ++level;
+            nodeCount = yLod.nodesInRange(level, startIndex, endIndex, yNodes, firstRow);
+        }
+    }
+    size_t bucket = LodPyramid::bucketSize(level);
+    size_t lastRow = firstRow + nodeCount * bucket;
+
+    if (nodeCount == 0) {
+        decimateImpl(x, y, startIndex, endIndex, maxPoints, mode, outX, outY);
+        return;
+    }
+
+    std::vector<double> nodeX, nodeY;
+    std::vector<double> edgeX, edgeY;
+    nodeX.reserve(nodeCount * 2 + 4);
+    nodeY.reserve(nodeCount * 2 + 4);
+
+    // 区间开头不足一个桶的原始点
+    minMaxImpl(x, y, startIndex, firstRow, 2, edgeX, edgeY);
+    nodeX.insert(nodeX.end(), edgeX.begin(), edgeX.end());
+    nodeY.insert(nodeY.end(), edgeY.begin(), edgeY.end());
+
+    for (size_t i = 0; i < nodeCount; ++i) {
+        const LodPyramid::Node& yNode = yNodes[i];
+        if (yNode.count == 0) {
+            continue;
+        }
+        // x 单调，取桶首末点的中点
+        size_t bucketStart = firstRow + i * bucket;
+        double nodeXValue = 0.5 * (x[bucketStart] + x[bucketStart + bucket - 1]);
+        if (mode == DataDecimator::Mode::MinMax) {
+            nodeX.push_back(nodeXValue);
+            nodeY.push_back(yNode.minValue);
+            if (yNode.maxValue != yNode.minValue) {
+                nodeX.push_back(nodeXValue);
+                nodeY.push_back(yNode.maxValue);
+            }
+        } else {
+            nodeX.push_back(nodeXValue);
+            nodeY.push_back(yNode.mean());
+        }
+    }
+
+    // 区间末尾不足一个桶的原始点
+    edgeX.clear();
+    edgeY.clear();
+    minMaxImpl(x, y, lastRow, endIndex, 2, edgeX, edgeY);
+    nodeX.insert(nodeX.end(), edgeX.begin(), edgeX.end());
+    nodeY.insert(nodeY.end(), edgeY.begin(), edgeY.end());
+
+    if (mode == DataDecimator::Mode::MinMax || nodeX.size() <= maxPoints) {
+        outX.swap(nodeX);
+        outY.swap(nodeY);
+        return;
+    }
+
+    outX.clear();
+    outY.clear();
+    lttbImpl(nodeX.data(), nodeY.data(), 0, nodeX.size(), maxPoints, outX, outY);
+}
+
+template <typename Column>
+void visibleRangeImpl(const Column& x, size_t count, double xMin, double xMax,
+                      size_t& startIndex, size_t& endIndex) {
+    // 第一个 >= xMin 的位置与第一个 > xMax 的位置
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (x[middle] < xMin) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    startIndex = low;
+    high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (x[middle] <= xMax) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    endIndex = low;
+
+    // 两侧各多保留一个点
+    if (startIndex > 0) {
+        startIndex--;
+    }
+    if (endIndex < count) {
+        endIndex++;
+    }
+}
+
+} // namespace
+
+void DataDecimator::decimate(const double* x, const double* y,
+                             size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                             std::vector<double>& outX, std::vector<double>& outY) {
+    decimateImpl(x, y, startIndex, endIndex, maxPoints, mode, outX, outY);
+}
+
+void DataDecimator::decimate(const ColumnBuffer& x, const ColumnBuffer& y,
+                             size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                             std::vector<double>& outX, std::vector<double>& outY) {
+    decimateImpl(x, y, startIndex, endIndex, maxPoints, mode, outX, outY);
+}
+
+void DataDecimator::minMaxDecimate(const double* x, const double* y,
+                                   size_t startIndex, size_t endIndex, size_t maxPoints,
+                                   std::vector<double>& outX, std::vector<double>& outY) {
+    minMaxImpl(x, y, startIndex, endIndex, maxPoints, outX, outY);
+}
+
+void DataDecimator::lttbDecimate(const double* x, const double* y,
+                                 size_t startIndex, size_t endIndex, size_t maxPoints,
+                                 std::vector<double>& outX, std::vector<double>& outY) {
+    lttbImpl(x, y, startIndex, endIndex, maxPoints, outX, outY);
+}
+
+void DataDecimator::decimateLod(const double* x, const double* y,
+                                size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                                const LodPyramid& yLod,
+                                std::vector<double>& outX, std::vector<double>& outY) {
+    decimateLodImpl(x, y, startIndex, endIndex, maxPoints, mode, yLod, outX, outY);
+}
+
+void DataDecimator::decimateLod(const ColumnBuffer& x, const ColumnBuffer& y,
+                                size_t startIndex, size_t endIndex, size_t maxPoints, Mode mode,
+                                const LodPyramid& yLod,
+                                std::vector<double>& outX, std::vector<double>& outY) {
+    decimateLodImpl(x, y, startIndex, endIndex, maxPoints, mode, yLod, outX, outY);
+}
+
+void DataDecimator::visibleRange(const double* x, size_t count, double xMin, double xMax,
+                                 size_t& startIndex, size_t& endIndex) {
+    visibleRangeImpl(x, count, xMin, xMax, startIndex, endIndex);
+}
+
+void DataDecimator::visibleRange(const ColumnBuffer& x, double xMin, double xMax,
+                                 size_t& startIndex, size_t& endIndex) {
+    visibleRangeImpl(x, x.size(), xMin, xMax, startIndex, endIndex);
+}
+
+size_t DataDecimator::pointsForPixels(int pixelWidth) {
+    return static_cast<size_t>(std::max(pixelWidth, 1)) * 2;
+}
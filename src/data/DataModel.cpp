@@ -1,26 +1,42 @@
 #include "DataModel.h"
+#include "utils/ThreadPool.h"
 #include <algorithm>
 #include <numeric>
 #include <stdexcept>
 #include <iostream>
+#include <cmath>
+#include <limits>
 
 // 静态成员初始化
 DataModel::DataSeries DataModel::s_emptySeries;
+std::vector<DataModel::ZoneBlock> DataModel::s_emptyZoneMap;
+const size_t DataModel::ZONE_BLOCK_SIZE;
+std::atomic<uint64_t> DataModel::s_nextInstanceId(1);
 
-DataModel::DataModel() : m_pointCount(0) {}
+DataModel::DataModel()
+    : m_pointCount(0), m_revision(0), m_removedRows(0), m_instanceId(s_nextInstanceId.fetch_add(1)) {}
 
 void DataModel::addField(const std::string& fieldName) {
     if (m_dataSeries.find(fieldName) == m_dataSeries.end()) {
-        m_dataSeries[fieldName] = DataSeries();
+        m_dataSeries[fieldName] = ColumnBuffer();
+        m_zoneMaps[fieldName] = std::vector<ZoneBlock>();
         // 为新字段初始化元数据
         m_fieldMetadata[fieldName]["color"] = MetadataValue("auto");
         m_fieldMetadata[fieldName]["visible"] = MetadataValue(true);
+        applySchemaType(fieldName);
     }
 }
 
 void DataModel::removeField(const std::string& fieldName) {
     m_dataSeries.erase(fieldName);
     m_fieldMetadata.erase(fieldName);
+    m_zoneMaps.erase(fieldName);
+    m_zoneOffsets.erase(fieldName);
+    m_staleZoneHeads.erase(fieldName);
+    m_staleZoneMaps.erase(fieldName);
+    m_validity.erase(fieldName);
+    releaseFieldStorage(fieldName);
+    m_revision++;
 }
 
 bool DataModel::hasField(const std::string& fieldName) const {
@@ -29,7 +45,7 @@ bool DataModel::hasField(const std::string& fieldName) const {
 
 std::vector<std::string> DataModel::getFieldNames() const {
     std::vector<std::string> names;
-    for (std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.begin(); 
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
          it != m_dataSeries.end(); ++it) {
         names.push_back(it->first);
     }
@@ -37,74 +53,423 @@ std::vector<std::string> DataModel::getFieldNames() const {
 }
 
 void DataModel::clear() {
-    for (std::map<std::string, DataSeries>::iterator it = m_dataSeries.begin(); 
+    for (std::map<std::string, ColumnBuffer>::iterator it = m_dataSeries.begin(); 
          it != m_dataSeries.end(); ++it) {
         it->second.clear();
     }
+    for (std::map<std::string, std::vector<ZoneBlock> >::iterator it = m_zoneMaps.begin(); 
+         it != m_zoneMaps.end(); ++it) {
+        it->second.clear();
+    }
+    m_zoneOffsets.clear();
+    m_staleZoneHeads.clear();
+    m_staleZoneMaps.clear();
+    for (std::map<std::string, TypedColumn>::iterator it = m_typedColumns.begin(); 
+         it != m_typedColumns.end(); ++it) {
+        it->second.clear();
+    }
+    m_encodedColumns.clear();
+    m_validity.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        m_decodedCache.clear();
+    }
     m_pointCount = 0;
+    m_revision++;
 }
 
 void DataModel::clearField(const std::string& fieldName) {
     if (hasField(fieldName)) {
         m_dataSeries[fieldName].clear();
+        m_zoneMaps[fieldName].clear();
+        m_zoneOffsets.erase(fieldName);
+        m_staleZoneHeads.erase(fieldName);
+        m_staleZoneMaps.erase(fieldName);
+        m_validity.erase(fieldName);
+        releaseFieldStorage(fieldName);
+        applySchemaType(fieldName);
+        m_revision++;
         // 重新计算点数
         size_t maxSize = 0;
-        for (std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.begin(); 
+        for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
              it != m_dataSeries.end(); ++it) {
-            maxSize = std::max(maxSize, it->second.size());
+            maxSize = std::max(maxSize, getFieldSize(it->first));
         }
         m_pointCount = maxSize;
     }
 }
 
 void DataModel::addDataPoint(const std::map<std::string, double>& pointData) {
+    addDataPoint(pointData, std::vector<std::string>());
+}
+
+void DataModel::addDataPoint(const std::map<std::string, double>& pointData,
+                             const std::vector<std::string>& nullFields) {
+    size_t rowIndex = m_pointCount;
+    size_t appended = pointData.size();
+    
     for (std::map<std::string, double>::const_iterator it = pointData.begin(); 
          it != pointData.end(); ++it) {
         const std::string& fieldName = it->first;
-        double value = it->second;
         
-        // 如果字段不存在，自动创建
+        // 如果字段不存在，自动创建，之前的行记为空值
         if (!hasField(fieldName)) {
-            addField(fieldName);
+            addFieldForRow(fieldName, rowIndex);
         }
         
-        m_dataSeries[fieldName].push_back(value);
+        appendValue(fieldName, it->second, true);
+    }
+    
+    for (size_t i = 0; i < nullFields.size(); ++i) {
+        const std::string& fieldName = nullFields[i];
+        if (pointData.find(fieldName) != pointData.end()) {
+            continue;
+        }
+        if (!hasField(fieldName)) {
+            addFieldForRow(fieldName, rowIndex);
+        }
+        appendValue(fieldName, 0.0, false);
+        appended++;
+    }
+    
+    finishRow(rowIndex, appended);
+}
+
+void DataModel::addDataPoint(const std::string* fieldNames, const double* values, const bool* valid,
+                             size_t count) {
+    size_t rowIndex = m_pointCount;
+    size_t appended = 0;
+    
+    for (size_t i = 0; i < count; ++i) {
+        const std::string& fieldName = fieldNames[i];
+        if (!hasField(fieldName)) {
+            addFieldForRow(fieldName, rowIndex);
+        } else if (getFieldSize(fieldName) > rowIndex) {
+            continue;  // 同名字段在本行已写入
+        }
+        
+        bool isValid = !valid || valid[i];
+        appendValue(fieldName, isValid ? values[i] : 0.0, isValid);
+        appended++;
+    }
+    
+    finishRow(rowIndex, appended);
+}
+
+void DataModel::addFieldForRow(const std::string& fieldName, size_t rowIndex) {
+    addField(fieldName);
+    for (size_t i = 0; i < rowIndex; ++i) {
+        appendValue(fieldName, 0.0, false);
+    }
+}
+
+void DataModel::finishRow(size_t rowIndex, size_t appended) {
+    // 本行未出现、且此前与各列对齐的字段补空值，保持按行对齐
+    if (appended < m_dataSeries.size()) {
+        for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
+             it != m_dataSeries.end(); ++it) {
+            if (getFieldSize(it->first) == rowIndex) {
+                appendValue(it->first, 0.0, false);
+            }
+        }
     }
     
     // 更新点数
     size_t maxSize = 0;
-    for (std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.begin(); 
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
          it != m_dataSeries.end(); ++it) {
-        maxSize = std::max(maxSize, it->second.size());
+        maxSize = std::max(maxSize, getFieldSize(it->first));
     }
     m_pointCount = maxSize;
 }
 
+void DataModel::appendValue(const std::string& fieldName, double value, bool valid) {
+    size_t index = getFieldSize(fieldName);
+    appendValidity(fieldName, index, valid);
+    
+    // 空值在 double 视图中为 NaN，在整数列中以0占位
+    double viewValue = valid ? value : std::numeric_limits<double>::quiet_NaN();
+    
+    std::map<std::string, EncodedColumn>::iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        // 编码字段：追加到尾部，已有解码缓存时同步更新
+        encodedIt->second.append(viewValue);
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        std::map<std::string, ColumnBuffer>::iterator cacheIt = m_decodedCache.find(fieldName);
+        if (cacheIt != m_decodedCache.end()) {
+            cacheIt->second.push_back(viewValue);
+        }
+        appendToZoneMap(fieldName, index, viewValue);
+        return;
+    }
+    
+    std::map<std::string, TypedColumn>::iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end()) {
+        double storedValue = valid ? value :
+            (TypedColumn::isIntegral(typedIt->second.getType()) ? 0.0 : viewValue);
+        if (typedIt->second.append(storedValue)) {
+            std::lock_guard<std::mutex> lock(m_decodeMutex);
+            std::map<std::string, ColumnBuffer>::iterator cacheIt = m_decodedCache.find(fieldName);
+            if (cacheIt != m_decodedCache.end()) {
+                cacheIt->second.push_back(viewValue);
+            }
+            appendToZoneMap(fieldName, index, viewValue);
+            return;
+        }
+        
+        // 超出类型范围：整数列放宽到能容纳新值的整数/浮点类型，否则退回 Float64
+        ColumnType widened = ColumnType::Float64;
+        if (TypedColumn::isIntegral(typedIt->second.getType())) {
+            ZoneBlock total;
+            const std::vector<ZoneBlock>& zones = getZoneMap(fieldName);
+            for (size_t i = 0; i < zones.size(); ++i) {
+                mergeZone(total, zones[i]);
+            }
+            double bounds[3] = { value, total.minValue, total.maxValue };
+            widened = TypedColumn::inferType(bounds, total.count > 0 ? 3 : 1);
+        }
+        
+        if (widened != ColumnType::Float64 && setFieldType(fieldName, widened) &&
+            m_typedColumns[fieldName].append(value)) {
+            appendToZoneMap(fieldName, index, value);
+            return;
+        }
+        
+        restoreRawStorage(fieldName);
+        m_schema.erase(fieldName);
+        m_fieldMetadata[fieldName]["column_type"] = MetadataValue(std::string(TypedColumn::typeName(ColumnType::Float64)));
+        m_revision++;
+    }
+    
+    // 位于写入尾部的视图原地追加（已发布的版本只看到各自长度内的数据），
+    // 其他被共享或只覆盖部分存储的视图先复制出独占存储（写时复制）
+    m_dataSeries[fieldName].push_back(viewValue);
+    {
+        // 切片或共享视图的展开缓存已过期
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        if (!m_decodedCache.empty()) {
+            m_decodedCache.erase(fieldName);
+        }
+    }
+    appendToZoneMap(fieldName, index, viewValue);
+}
+
 void DataModel::addDataSeries(const std::string& fieldName, const DataSeries& data) {
     if (!hasField(fieldName)) {
         addField(fieldName);
     }
     
-    m_dataSeries[fieldName] = data;
+    releaseFieldStorage(fieldName);
+    m_validity.erase(fieldName);
+    m_dataSeries[fieldName] = ColumnBuffer(data);
+    rebuildZoneMap(fieldName);
+    applySchemaType(fieldName);
+    m_revision++;
     m_pointCount = std::max(m_pointCount, data.size());
 }
 
+void DataModel::addDataSeries(const std::string& fieldName, const double* data, size_t count,
+                              const std::vector<ZoneBlock>* zoneMap) {
+    if (!hasField(fieldName)) {
+        addField(fieldName);
+    }
+    
+    releaseFieldStorage(fieldName);
+    m_validity.erase(fieldName);
+    ColumnBuffer& series = m_dataSeries[fieldName];
+    series = ColumnBuffer(data, count);
+    
+    size_t blockCount = (series.size() + ZONE_BLOCK_SIZE - 1) / ZONE_BLOCK_SIZE;
+    if (zoneMap && zoneMap->size() == blockCount) {
+        m_zoneMaps[fieldName] = *zoneMap;
+        m_zoneOffsets.erase(fieldName);
+        m_staleZoneHeads.erase(fieldName);
+        m_staleZoneMaps.erase(fieldName);
+    } else {
+        rebuildZoneMap(fieldName);
+    }
+    
+    m_revision++;
+    m_pointCount = std::max(m_pointCount, count);
+    applySchemaType(fieldName);
+}
+
+void DataModel::addDataSeries(const std::string& fieldName, const ColumnBuffer& column,
+                              const std::vector<ZoneBlock>* zoneMap) {
+    if (!hasField(fieldName)) {
+        addField(fieldName);
+    }
+    
+    releaseFieldStorage(fieldName);
+    m_validity.erase(fieldName);
+    m_dataSeries[fieldName] = column;
+    
+    size_t blockCount = (column.size() + ZONE_BLOCK_SIZE - 1) / ZONE_BLOCK_SIZE;
+    if (zoneMap && zoneMap->size() == blockCount) {
+        m_zoneMaps[fieldName] = *zoneMap;
+        m_zoneOffsets.erase(fieldName);
+        m_staleZoneHeads.erase(fieldName);
+        m_staleZoneMaps.erase(fieldName);
+    } else {
+        markZoneMapStale(fieldName);
+    }
+    
+    m_revision++;
+    m_pointCount = std::max(m_pointCount, column.size());
+    applySchemaType(fieldName);
+}
+
 void DataModel::addDataPoints(const std::vector<std::map<std::string, double> >& points) {
     for (size_t i = 0; i < points.size(); ++i) {
         addDataPoint(points[i]);
     }
 }
 
+void DataModel::removeFront(size_t count) {
+    count = std::min(count, m_pointCount);
+    if (count == 0) {
+        return;
+    }
+    
+    for (std::map<std::string, ColumnBuffer>::iterator it = m_dataSeries.begin(); 
+         it != m_dataSeries.end(); ++it) {
+        const std::string& fieldName = it->first;
+        size_t fieldSize = getFieldSize(fieldName);
+        size_t dropCount = std::min(count, fieldSize);
+        if (dropCount == 0) {
+            continue;
+        }
+        
+        std::vector<uint64_t> validity;
+        bool nullable = hasNulls(fieldName);
+        if (nullable) {
+            validity = sliceValidity(fieldName, dropCount, fieldSize);
+        }
+        
+        // 各种存储都只移动起点：编码列整块丢弃后才释放块，类型化列均摊整理
+        std::map<std::string, EncodedColumn>::iterator encodedIt = m_encodedColumns.find(fieldName);
+        std::map<std::string, TypedColumn>::iterator typedIt = m_typedColumns.find(fieldName);
+        if (encodedIt != m_encodedColumns.end()) {
+            encodedIt->second.dropFront(dropCount);
+        } else if (typedIt != m_typedColumns.end()) {
+            typedIt->second.dropFront(dropCount);
+        } else {
+            it->second.dropFront(dropCount);
+        }
+        
+        if (nullable) {
+            m_validity[fieldName].swap(validity);
+            size_t remaining = fieldSize - dropCount;
+            if (getValidCount(fieldName, 0, remaining) == remaining) {
+                m_validity.erase(fieldName);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_decodeMutex);
+            std::map<std::string, ColumnBuffer>::iterator cacheIt = m_decodedCache.find(fieldName);
+            if (cacheIt != m_decodedCache.end()) {
+                cacheIt->second.dropFront(dropCount);
+            }
+        }
+        dropZoneMapFront(fieldName, dropCount);
+    }
+    
+    size_t maxSize = 0;
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
+         it != m_dataSeries.end(); ++it) {
+        maxSize = std::max(maxSize, getFieldSize(it->first));
+    }
+    m_pointCount = maxSize;
+    // 只丢弃开头的行不改变结构版本号，缓存按 getRemovedRowCount() 的差值同步丢弃
+    m_removedRows += count;
+}
+
 const DataModel::DataSeries& DataModel::getDataSeries(const std::string& fieldName) const {
-    std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.find(fieldName);
-    if (it != m_dataSeries.end()) {
+    std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.find(fieldName);
+    if (it == m_dataSeries.end()) {
+        return s_emptySeries;
+    }
+    if (isRawField(fieldName)) {
+        // 视图恰好覆盖接管的整个数组时直接返回，无需复制
+        const DataSeries* storage = it->second.storage();
+        if (storage) {
+            return *storage;
+        }
+        if (it->second.empty()) {
+            return s_emptySeries;
+        }
+    }
+    
+    // 编码/类型化字段、分块存储、切片或映射内存：首次访问时整理为连续数组缓存，之后复用
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    const DataSeries* storage = decodedColumn(fieldName, true).storage();
+    return storage ? *storage : s_emptySeries;
+}
+
+ColumnBuffer DataModel::getColumnBuffer(const std::string& fieldName) const {
+    std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.find(fieldName);
+    if (it == m_dataSeries.end()) {
+        return ColumnBuffer();
+    }
+    if (isRawField(fieldName)) {
         return it->second;
     }
-    return s_emptySeries;
+    
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end() && m_decodedCache.find(fieldName) == m_decodedCache.end()) {
+        // 编码字段解码为独立视图，随调用方释放，不常驻展开缓存
+        DataSeries values;
+        encodedIt->second.decodeAll(values);
+        return ColumnBuffer(std::move(values));
+    }
+    return decodedColumn(fieldName);
+}
+
+const ColumnBuffer& DataModel::decodedColumn(const std::string& fieldName, bool contiguous) const {
+    std::map<std::string, ColumnBuffer>::iterator cacheIt = m_decodedCache.find(fieldName);
+    if (cacheIt != m_decodedCache.end()) {
+        if (!contiguous || cacheIt->second.storage() || cacheIt->second.empty()) {
+            return cacheIt->second;
+        }
+        // 追加过的缓存已转为分块存储，重新整理为一个连续数组
+        DataSeries values(cacheIt->second.size());
+        cacheIt->second.copyTo(0, values.size(), values.data());
+        cacheIt->second = ColumnBuffer(std::move(values));
+        return cacheIt->second;
+    }
+    
+    DataSeries values;
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        encodedIt->second.decodeAll(values);
+    } else if (typedIt != m_typedColumns.end()) {
+        values.resize(typedIt->second.size());
+        typedIt->second.toDoubles(0, values.size(), values.data());
+        fillNulls(fieldName, 0, values.data(), values.size(), std::numeric_limits<double>::quiet_NaN());
+    } else {
+        std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.find(fieldName);
+        if (it != m_dataSeries.end()) {
+            values.resize(it->second.size());
+            it->second.copyTo(0, values.size(), values.data());
+        }
+    }
+    return m_decodedCache.insert(std::make_pair(fieldName, ColumnBuffer(std::move(values)))).first->second;
 }
 
 double DataModel::getValue(const std::string& fieldName, size_t index) const {
-    std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.find(fieldName);
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        return encodedIt->second.valueAt(index);
+    }
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end()) {
+        return isNull(fieldName, index) ? std::numeric_limits<double>::quiet_NaN()
+                                        : typedIt->second.valueAt(index);
+    }
+    
+    std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.find(fieldName);
     if (it == m_dataSeries.end() || index >= it->second.size()) {
         return 0.0;
     }
@@ -117,15 +482,13 @@ bool DataModel::getDataPoint(size_t index, std::map<std::string, double>& point)
     }
     
     point.clear();
-    for (std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.begin(); 
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
          it != m_dataSeries.end(); ++it) {
         const std::string& fieldName = it->first;
-        const DataSeries& series = it->second;
         
-        if (index < series.size()) {
-            point[fieldName] = series[index];
-        } else {
-            point[fieldName] = 0.0; // 默认值
+        // 空值和超出该列长度的位置不出现在结果中
+        if (index < getFieldSize(fieldName) && !isNull(fieldName, index)) {
+            point[fieldName] = getValue(fieldName, index);
         }
     }
     
@@ -152,6 +515,16 @@ DataModel::MetadataValue DataModel::getFieldMetadata(const std::string& fieldNam
     return MetadataValue(); // 返回默认值
 }
 
+std::map<std::string, DataModel::MetadataValue> DataModel::getAllFieldMetadata(
+        const std::string& fieldName) const {
+    std::map<std::string, std::map<std::string, MetadataValue> >::const_iterator fieldIt = 
+        m_fieldMetadata.find(fieldName);
+    if (fieldIt != m_fieldMetadata.end()) {
+        return fieldIt->second;
+    }
+    return std::map<std::string, MetadataValue>();
+}
+
 void DataModel::setFieldColor(const std::string& fieldName, const std::string& color) {
     setFieldMetadata(fieldName, "color", MetadataValue(color));
 }
@@ -173,9 +546,10 @@ bool DataModel::empty() const {
 }
 
 bool DataModel::checkConsistency() const {
-    for (std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.begin(); 
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
          it != m_dataSeries.end(); ++it) {
-        if (it->second.size() != m_pointCount && !it->second.empty()) {
+        size_t fieldSize = getFieldSize(it->first);
+        if (fieldSize != m_pointCount && fieldSize != 0) {
             return false;
         }
     }
@@ -187,29 +561,27 @@ DataModel::Statistics DataModel::calculateStatistics() const {
     stats.totalPoints = m_pointCount;
     stats.validPoints = 0;
     
-    for (std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.begin(); 
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
          it != m_dataSeries.end(); ++it) {
         const std::string& fieldName = it->first;
-        const DataSeries& series = it->second;
+        size_t fieldSize = getFieldSize(fieldName);
         
-        if (series.empty()) {
+        if (fieldSize == 0) {
             continue;
         }
         
-        // 计算范围
-        double minVal = series[0];
-        double maxVal = series[0];
-        double sum = 0.0;
-        
-        for (size_t i = 0; i < series.size(); ++i) {
-            minVal = std::min(minVal, series[i]);
-            maxVal = std::max(maxVal, series[i]);
-            sum += series[i];
+        // 直接合并各块摘要，无需扫描整列
+        ZoneBlock total;
+        const std::vector<ZoneBlock>& zones = getZoneMap(fieldName);
+        for (size_t i = 0; i < zones.size(); ++i) {
+            mergeZone(total, zones[i]);
         }
         
-        stats.ranges[fieldName] = std::make_pair(minVal, maxVal);
-        stats.averages[fieldName] = sum / series.size();
-        stats.validPoints = std::max(stats.validPoints, series.size());
+        if (total.count > 0) {
+            stats.ranges[fieldName] = std::make_pair(total.minValue, total.maxValue);
+            stats.averages[fieldName] = total.sum / total.count;
+        }
+        stats.validPoints = std::max(stats.validPoints, fieldSize - getNullCount(fieldName));
     }
     
     return stats;
@@ -222,15 +594,23 @@ std::shared_ptr<DataModel> DataModel::getSubset(size_t startIndex, size_t endInd
         return subset;
     }
     
-    for (std::map<std::string, DataSeries>::const_iterator it = m_dataSeries.begin(); 
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
          it != m_dataSeries.end(); ++it) {
         const std::string& fieldName = it->first;
-        const DataSeries& series = it->second;
+        size_t fieldSize = getFieldSize(fieldName);
+        if (fieldSize <= startIndex) {
+            continue;
+        }
         
-        if (series.size() > startIndex) {
-            size_t actualEnd = std::min(endIndex, series.size());
-            DataSeries subSeries(series.begin() + startIndex, series.begin() + actualEnd);
-            subset->addDataSeries(fieldName, subSeries);
+        // 原始字段直接切片共享存储；编码/类型化字段切片其展开缓存，再按原类型紧凑存储
+        size_t actualEnd = std::min(endIndex, fieldSize);
+        subset->addDataSeries(fieldName, getColumnBuffer(fieldName).slice(startIndex, actualEnd));
+        if (hasNulls(fieldName)) {
+            subset->setValidityBitmap(fieldName, sliceValidity(fieldName, startIndex, actualEnd));
+        }
+        ColumnType type = getFieldType(fieldName);
+        if (type != ColumnType::Float64) {
+            subset->setFieldType(fieldName, type);
         }
     }
     
@@ -241,11 +621,818 @@ std::shared_ptr<DataModel> DataModel::getSubsetByFields(const std::vector<std::s
     std::shared_ptr<DataModel> subset(new DataModel());
     
     for (size_t i = 0; i < fieldNames.size(); ++i) {
-        const std::string& fieldName = fieldNames[i];
-        if (hasField(fieldName)) {
-            subset->addDataSeries(fieldName, getDataSeries(fieldName));
+        if (hasField(fieldNames[i])) {
+            shareField(fieldNames[i], *subset);
         }
     }
     
     return subset;
-}
\ No newline at end of file
+}
+
+std::shared_ptr<DataModel> DataModel::clone() const {
+    std::shared_ptr<DataModel> copy(new DataModel());
+    
+    for (std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.begin(); 
+         it != m_dataSeries.end(); ++it) {
+        shareField(it->first, *copy);
+    }
+    copy->m_fieldMetadata = m_fieldMetadata;
+    copy->m_schema = m_schema;
+    copy->m_pointCount = m_pointCount;
+    copy->m_revision = m_revision;
+    copy->m_removedRows = m_removedRows;
+    
+    return copy;
+}
+
+void DataModel::publish() {
+    std::shared_ptr<const DataModel> version = clone();
+    std::atomic_store(&m_published, version);
+}
+
+std::shared_ptr<const DataModel> DataModel::snapshot() const {
+    return std::atomic_load(&m_published);
+}
+
+void DataModel::shareField(const std::string& fieldName, DataModel& target) const {
+    std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.find(fieldName);
+    
+    // 各种存储均按引用共享：原始列共享缓冲区，类型化列共享紧凑存储，编码列共享已编码的块
+    target.addField(fieldName);
+    target.m_dataSeries[fieldName] = it->second;
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        target.m_encodedColumns[fieldName] = encodedIt->second;
+    }
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end()) {
+        target.m_typedColumns[fieldName] = typedIt->second;
+        target.m_fieldMetadata[fieldName]["column_type"] =
+            MetadataValue(std::string(TypedColumn::typeName(typedIt->second.getType())));
+    }
+    Schema::const_iterator schemaIt = m_schema.find(fieldName);
+    if (schemaIt != m_schema.end()) {
+        target.m_schema[fieldName] = schemaIt->second;
+    }
+    std::map<std::string, std::vector<uint64_t> >::const_iterator validityIt = m_validity.find(fieldName);
+    if (validityIt != m_validity.end()) {
+        target.m_validity[fieldName] = validityIt->second;
+    }
+    {
+        // 分块摘要待重算时由目标模型自行计算
+        std::lock_guard<std::mutex> lock(m_zoneMutex);
+        if (m_staleZoneMaps.find(fieldName) != m_staleZoneMaps.end()) {
+            target.m_staleZoneMaps.insert(fieldName);
+        } else {
+            target.m_zoneMaps[fieldName] = m_zoneMaps[fieldName];
+            std::map<std::string, size_t>::const_iterator offsetIt = m_zoneOffsets.find(fieldName);
+            if (offsetIt != m_zoneOffsets.end()) {
+                target.m_zoneOffsets[fieldName] = offsetIt->second;
+            }
+            if (m_staleZoneHeads.find(fieldName) != m_staleZoneHeads.end()) {
+                target.m_staleZoneHeads.insert(fieldName);
+            }
+        }
+    }
+    target.m_pointCount = std::max(target.m_pointCount, getFieldSize(fieldName));
+}
+
+bool DataModel::setFieldType(const std::string& fieldName, ColumnType type) {
+    if (!hasField(fieldName)) {
+        return false;
+    }
+    if (!isFieldEncoded(fieldName) && getFieldType(fieldName) == type) {
+        m_schema[fieldName] = type;
+        return true;
+    }
+    
+    // 先转换到新列，成功后再替换，失败时字段保持不变
+    ColumnBuffer values = getColumnBuffer(fieldName);
+    TypedColumn column(type);
+    if (type != ColumnType::Float64) {
+        bool assigned = false;
+        if (hasNulls(fieldName) && TypedColumn::isIntegral(type)) {
+            // 整数列中空值以0占位
+            DataSeries filled(values.size());
+            values.copyTo(0, filled.size(), filled.data());
+            fillNulls(fieldName, 0, filled.data(), filled.size(), 0.0);
+            assigned = column.assign(filled.data(), filled.size());
+        } else {
+            DataSeries scratch;
+            assigned = column.assign(values.contiguousData(scratch), values.size());
+        }
+        if (!assigned) {
+            return false;
+        }
+    }
+    
+    restoreRawStorage(fieldName);
+    if (type != ColumnType::Float64) {
+        m_dataSeries[fieldName].clear();  // 释放对原始数组的引用
+        m_typedColumns[fieldName] = std::move(column);
+    }
+    
+    m_schema[fieldName] = type;
+    m_fieldMetadata[fieldName]["column_type"] = MetadataValue(std::string(TypedColumn::typeName(type)));
+    m_revision++;
+    return true;
+}
+
+ColumnType DataModel::getFieldType(const std::string& fieldName) const {
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end()) {
+        return typedIt->second.getType();
+    }
+    return ColumnType::Float64;
+}
+
+ColumnType DataModel::inferFieldType(const std::string& fieldName) const {
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end() && TypedColumn::isIntegral(typedIt->second.getType())) {
+        // 整数列只需检查值域，无需展开
+        ZoneBlock total;
+        const std::vector<ZoneBlock>& zones = getZoneMap(fieldName);
+        for (size_t i = 0; i < zones.size(); ++i) {
+            mergeZone(total, zones[i]);
+        }
+        double bounds[2] = { total.minValue, total.maxValue };
+        return TypedColumn::inferType(bounds, total.count > 0 ? 2 : 0);
+    }
+    
+    ColumnBuffer values = getColumnBuffer(fieldName);
+    if (!hasNulls(fieldName)) {
+        DataSeries scratch;
+        return TypedColumn::inferType(values.contiguousData(scratch), values.size());
+    }
+    
+    // 只根据非空值推断
+    DataSeries validValues;
+    validValues.reserve(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!isNull(fieldName, i)) {
+            validValues.push_back(values[i]);
+        }
+    }
+    return TypedColumn::inferType(validValues.data(), validValues.size());
+}
+
+size_t DataModel::applyInferredTypes() {
+    size_t changed = 0;
+    std::vector<std::string> candidates;
+    std::vector<std::string> fieldNames = getFieldNames();
+    for (size_t i = 0; i < fieldNames.size(); ++i) {
+        const std::string& fieldName = fieldNames[i];
+        if (isFieldEncoded(fieldName) || getFieldSize(fieldName) == 0 ||
+            m_schema.find(fieldName) != m_schema.end()) {
+            continue;
+        }
+        candidates.push_back(fieldName);
+    }
+    
+    // 推断只读取数据，各字段并行扫描；转换存储会修改模型，按顺序进行
+    std::vector<ColumnType> inferred(candidates.size(), ColumnType::Float64);
+    ThreadPool::getInstance().parallelFor(0, candidates.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            inferred[i] = inferFieldType(candidates[i]);
+        }
+    });
+    
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (inferred[i] != getFieldType(candidates[i]) && setFieldType(candidates[i], inferred[i])) {
+            changed++;
+        }
+    }
+    return changed;
+}
+
+void DataModel::setSchema(const Schema& schema) {
+    for (Schema::const_iterator it = schema.begin(); it != schema.end(); ++it) {
+        m_schema[it->first] = it->second;
+        if (hasField(it->first)) {
+            setFieldType(it->first, it->second);
+        }
+    }
+}
+
+bool DataModel::encodeField(const std::string& fieldName, EncodedColumn::Encoding encoding) {
+    if (!hasField(fieldName)) {
+        return false;
+    }
+    
+    std::map<std::string, EncodedColumn>::iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end() &&
+        (encoding == EncodedColumn::Encoding::Auto || encoding == encodedIt->second.getEncoding())) {
+        return true;
+    }
+    
+    // 更换编码或从类型化存储转换：先还原为 double 再编码
+    restoreRawStorage(fieldName);
+    if (m_schema.erase(fieldName) > 0) {
+        m_fieldMetadata[fieldName]["column_type"] = MetadataValue(std::string(TypedColumn::typeName(ColumnType::Float64)));
+    }
+    
+    ColumnBuffer& series = m_dataSeries[fieldName];
+    DataSeries scratch;
+    m_encodedColumns[fieldName].encode(series.contiguousData(scratch), series.size(), encoding);
+    series.clear();  // 释放对原始数组的引用
+    m_revision++;
+    return true;
+}
+
+bool DataModel::decodeField(const std::string& fieldName) {
+    if (!isFieldEncoded(fieldName)) {
+        return false;
+    }
+    
+    restoreRawStorage(fieldName);
+    m_revision++;
+    return true;
+}
+
+bool DataModel::isFieldEncoded(const std::string& fieldName) const {
+    return m_encodedColumns.find(fieldName) != m_encodedColumns.end();
+}
+
+size_t DataModel::getFieldMemoryBytes(const std::string& fieldName) const {
+    size_t bytes = 0;
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        bytes = encodedIt->second.memoryBytes();
+    } else if (typedIt != m_typedColumns.end()) {
+        bytes = typedIt->second.memoryBytes();
+    } else {
+        std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.find(fieldName);
+        bytes = it == m_dataSeries.end() ? 0 : it->second.memoryBytes();
+    }
+    
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    std::map<std::string, ColumnBuffer>::const_iterator cacheIt = m_decodedCache.find(fieldName);
+    if (cacheIt != m_decodedCache.end()) {
+        bytes += cacheIt->second.memoryBytes();
+    }
+    return bytes;
+}
+
+void DataModel::releaseDecodedCache() {
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    m_decodedCache.clear();
+}
+
+bool DataModel::scanField(const std::string& fieldName, const BlockVisitor& visitor) const {
+    if (!hasField(fieldName)) {
+        return false;
+    }
+    
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        const EncodedColumn& column = encodedIt->second;
+        std::vector<double> buffer(EncodedColumn::BLOCK_SIZE);
+        size_t startIndex = 0;
+        for (size_t block = 0; block < column.blockCount(); ++block) {
+            size_t count = column.decodeBlock(block, buffer.data());
+            visitor(startIndex, buffer.data(), count);
+            startIndex += count;
+        }
+        return true;
+    }
+    
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end()) {
+        const TypedColumn& column = typedIt->second;
+        std::vector<double> buffer(EncodedColumn::BLOCK_SIZE);
+        for (size_t start = 0; start < column.size(); start += buffer.size()) {
+            size_t count = std::min(buffer.size(), column.size() - start);
+            column.toDoubles(start, count, buffer.data());
+            fillNulls(fieldName, start, buffer.data(), count, std::numeric_limits<double>::quiet_NaN());
+            visitor(start, buffer.data(), count);
+        }
+        return true;
+    }
+    
+    // 原始字段按存储块的连续片段直接访问，再切成不超过 BLOCK_SIZE 的段
+    ColumnBuffer series = getColumnBuffer(fieldName);
+    series.forEachSpan(0, series.size(), [&](size_t spanStart, const double* values, size_t spanCount) {
+        for (size_t offset = 0; offset < spanCount; offset += EncodedColumn::BLOCK_SIZE) {
+            visitor(spanStart + offset, values + offset, std::min(EncodedColumn::BLOCK_SIZE, spanCount - offset));
+        }
+    });
+    return true;
+}
+
+bool DataModel::isRawField(const std::string& fieldName) const {
+    return m_encodedColumns.find(fieldName) == m_encodedColumns.end() &&
+           m_typedColumns.find(fieldName) == m_typedColumns.end();
+}
+
+size_t DataModel::getFieldSize(const std::string& fieldName) const {
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        return encodedIt->second.size();
+    }
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end()) {
+        return typedIt->second.size();
+    }
+    std::map<std::string, ColumnBuffer>::const_iterator it = m_dataSeries.find(fieldName);
+    return it == m_dataSeries.end() ? 0 : it->second.size();
+}
+
+void DataModel::releaseFieldStorage(const std::string& fieldName) {
+    m_encodedColumns.erase(fieldName);
+    m_typedColumns.erase(fieldName);
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    m_decodedCache.erase(fieldName);
+}
+
+void DataModel::restoreRawStorage(const std::string& fieldName) {
+    if (!isRawField(fieldName)) {
+        // 已有展开缓存时直接接管，否则重新展开
+        ColumnBuffer values;
+        {
+            std::lock_guard<std::mutex> lock(m_decodeMutex);
+            values = decodedColumn(fieldName);
+        }
+        m_dataSeries[fieldName] = values;
+    }
+    releaseFieldStorage(fieldName);
+}
+
+bool DataModel::applySchemaType(const std::string& fieldName) {
+    Schema::const_iterator schemaIt = m_schema.find(fieldName);
+    if (schemaIt == m_schema.end() || schemaIt->second == ColumnType::Float64) {
+        return false;
+    }
+    
+    ColumnBuffer& series = m_dataSeries[fieldName];
+    TypedColumn column(schemaIt->second);
+    DataSeries scratch;
+    if (!column.assign(series.contiguousData(scratch), series.size())) {
+        // 数据不符合模式类型，该字段保持 Float64
+        m_schema.erase(fieldName);
+        m_fieldMetadata[fieldName]["column_type"] = MetadataValue(std::string(TypedColumn::typeName(ColumnType::Float64)));
+        return false;
+    }
+    
+    m_fieldMetadata[fieldName]["column_type"] = MetadataValue(std::string(TypedColumn::typeName(column.getType())));
+    m_typedColumns[fieldName] = std::move(column);
+    series.clear();
+    return true;
+}
+
+void DataModel::scanFieldRange(const std::string& fieldName, size_t startIndex, size_t endIndex,
+                               ZoneBlock& result) const {
+    std::map<std::string, TypedColumn>::const_iterator typedIt = m_typedColumns.find(fieldName);
+    if (typedIt != m_typedColumns.end()) {
+        if (!hasNulls(fieldName)) {
+            typedIt->second.computeRange(startIndex, endIndex, result.minValue, result.maxValue,
+                                         result.sum, result.count);
+            return;
+        }
+        
+        // 有空值时逐块展开，空值位置为 NaN 后统一扫描
+        double buffer[ZONE_BLOCK_SIZE];
+        for (size_t start = startIndex; start < endIndex; start += ZONE_BLOCK_SIZE) {
+            size_t count = std::min(ZONE_BLOCK_SIZE, endIndex - start);
+            typedIt->second.toDoubles(start, count, buffer);
+            fillNulls(fieldName, start, buffer, count, std::numeric_limits<double>::quiet_NaN());
+            scanRange(buffer, 0, count, result);
+        }
+        return;
+    }
+    
+    std::map<std::string, EncodedColumn>::const_iterator encodedIt = m_encodedColumns.find(fieldName);
+    if (encodedIt != m_encodedColumns.end()) {
+        // 编码字段逐块解码到栈上缓冲，不经过展开缓存
+        const EncodedColumn& column = encodedIt->second;
+        double buffer[EncodedColumn::BLOCK_SIZE];
+        size_t block = column.blockOf(startIndex);
+        size_t blockStart = column.blockStart(block);
+        while (blockStart < endIndex) {
+            size_t count = column.decodeBlock(block, buffer);
+            if (count == 0) {
+                break;
+            }
+            size_t first = std::max(startIndex, blockStart) - blockStart;
+            size_t last = std::min(endIndex, blockStart + count) - blockStart;
+            scanRange(buffer, first, last, result);
+            blockStart += count;
+            block++;
+        }
+        return;
+    }
+    
+    // 空值在 double 存储中为 NaN，扫描时自然跳过
+    getColumnBuffer(fieldName).forEachSpan(startIndex, endIndex,
+        [&](size_t, const double* values, size_t count) {
+            scanRange(values, 0, count, result);
+        });
+}
+
+bool DataModel::isNull(const std::string& fieldName, size_t index) const {
+    std::map<std::string, std::vector<uint64_t> >::const_iterator it = m_validity.find(fieldName);
+    if (it == m_validity.end()) {
+        return false;
+    }
+    size_t word = index >> 6;
+    return word < it->second.size() && ((it->second[word] >> (index & 63)) & 1) == 0;
+}
+
+bool DataModel::hasNulls(const std::string& fieldName) const {
+    return m_validity.find(fieldName) != m_validity.end();
+}
+
+size_t DataModel::getNullCount(const std::string& fieldName) const {
+    size_t fieldSize = getFieldSize(fieldName);
+    return fieldSize - getValidCount(fieldName, 0, fieldSize);
+}
+
+size_t DataModel::getValidCount(const std::string& fieldName, size_t startIndex, size_t endIndex) const {
+    endIndex = std::min(endIndex, getFieldSize(fieldName));
+    if (startIndex >= endIndex) {
+        return 0;
+    }
+    
+    std::map<std::string, std::vector<uint64_t> >::const_iterator it = m_validity.find(fieldName);
+    if (it == m_validity.end()) {
+        return endIndex - startIndex;
+    }
+    
+    // 按64位字计数，两端的部分字用掩码截取
+    const std::vector<uint64_t>& bitmap = it->second;
+    size_t firstWord = startIndex >> 6;
+    size_t lastWord = (endIndex - 1) >> 6;
+    size_t count = 0;
+    for (size_t word = firstWord; word <= lastWord; ++word) {
+        uint64_t bits = word < bitmap.size() ? bitmap[word] : ~uint64_t(0);
+        if (word == firstWord) {
+            bits &= ~uint64_t(0) << (startIndex & 63);
+        }
+        if (word == lastWord && (endIndex & 63) != 0) {
+            bits &= (uint64_t(1) << (endIndex & 63)) - 1;
+        }
+        count += static_cast<size_t>(__builtin_popcountll(bits));
+    }
+    return count;
+}
+
+const std::vector<uint64_t>* DataModel::getValidityBitmap(const std::string& fieldName) const {
+    std::map<std::string, std::vector<uint64_t> >::const_iterator it = m_validity.find(fieldName);
+    return it != m_validity.end() ? &it->second : nullptr;
+}
+
+void DataModel::setValidityBitmap(const std::string& fieldName, const std::vector<uint64_t>& bitmap) {
+    if (!hasField(fieldName)) {
+        return;
+    }
+    
+    std::vector<uint64_t> validity(bitmap);
+    if (!storeValidity(fieldName, validity)) {
+        return;
+    }
+    
+    // 空值位置的占位值与 double 视图保持一致；已是 NaN 时（如共享的切片、映射的快照列）不必复制
+    if (isRawField(fieldName)) {
+        ColumnBuffer& column = m_dataSeries[fieldName];
+        const std::vector<uint64_t>& bits = m_validity[fieldName];
+        bool filled = true;
+        for (size_t i = 0; i < column.size() && filled; ++i) {
+            if (((bits[i >> 6] >> (i & 63)) & 1) == 0) {
+                filled = std::isnan(column[i]);
+            }
+        }
+        if (!filled) {
+            // 按块写时复制
+            for (size_t index = 0; index < column.size(); ) {
+                double* values = nullptr;
+                size_t count = column.mutableSpanAt(index, values);
+                fillNulls(fieldName, index, values, count, std::numeric_limits<double>::quiet_NaN());
+                index += count;
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        m_decodedCache.erase(fieldName);
+    }
+    markZoneMapStale(fieldName);
+}
+
+void DataModel::adoptValidityBitmap(const std::string& fieldName, std::vector<uint64_t>& bitmap) {
+    if (!hasField(fieldName)) {
+        return;
+    }
+    
+    // 调用方保证空值位置已是 NaN、分块摘要不含空值，只需记录位图
+    storeValidity(fieldName, bitmap);
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    m_decodedCache.erase(fieldName);
+}
+
+bool DataModel::storeValidity(const std::string& fieldName, std::vector<uint64_t>& validity) {
+    size_t fieldSize = getFieldSize(fieldName);
+    size_t wordCount = (fieldSize + 63) / 64;
+    if (validity.size() < wordCount) {
+        validity.resize(wordCount, ~uint64_t(0));  // 不足部分视为有效
+    }
+    validity.resize(wordCount);
+    if ((fieldSize & 63) != 0 && wordCount > 0) {
+        validity[wordCount - 1] &= (uint64_t(1) << (fieldSize & 63)) - 1;
+    }
+    m_validity[fieldName].swap(validity);
+    
+    if (getValidCount(fieldName, 0, fieldSize) == fieldSize) {
+        m_validity.erase(fieldName);
+        return false;
+    }
+    return true;
+}
+
+void DataModel::appendValidity(const std::string& fieldName, size_t index, bool valid) {
+    std::map<std::string, std::vector<uint64_t> >::iterator it = m_validity.find(fieldName);
+    if (it == m_validity.end()) {
+        if (valid) {
+            return;  // 没有空值的列不分配位图
+        }
+        // 首个空值：之前的位置全部有效
+        it = m_validity.insert(std::make_pair(fieldName, std::vector<uint64_t>())).first;
+        it->second.assign(index / 64 + 1, 0);
+        for (size_t word = 0; word < index / 64; ++word) {
+            it->second[word] = ~uint64_t(0);
+        }
+        if ((index & 63) != 0) {
+            it->second[index / 64] = (uint64_t(1) << (index & 63)) - 1;
+        }
+        return;
+    }
+    
+    std::vector<uint64_t>& bitmap = it->second;
+    if (bitmap.size() <= index / 64) {
+        bitmap.resize(index / 64 + 1, 0);
+    }
+    if (valid) {
+        bitmap[index / 64] |= uint64_t(1) << (index & 63);
+    }
+}
+
+void DataModel::fillNulls(const std::string& fieldName, size_t startIndex, double* values,
+                          size_t count, double fillValue) const {
+    std::map<std::string, std::vector<uint64_t> >::const_iterator it = m_validity.find(fieldName);
+    if (it == m_validity.end()) {
+        return;
+    }
+    
+    const std::vector<uint64_t>& bitmap = it->second;
+    size_t i = 0;
+    while (i < count) {
+        size_t index = startIndex + i;
+        size_t word = index >> 6;
+        uint64_t bits = word < bitmap.size() ? bitmap[word] : ~uint64_t(0);
+        size_t span = std::min<size_t>(64 - (index & 63), count - i);
+        
+        // 整字有效时跳过，只处理含空值的字
+        uint64_t invalid = ~(bits >> (index & 63));
+        if (span < 64) {
+            invalid &= (uint64_t(1) << span) - 1;
+        }
+        while (invalid != 0) {
+            values[i + static_cast<size_t>(__builtin_ctzll(invalid))] = fillValue;
+            invalid &= invalid - 1;
+        }
+        i += span;
+    }
+}
+
+std::vector<uint64_t> DataModel::sliceValidity(const std::string& fieldName, size_t startIndex,
+                                               size_t endIndex) const {
+    std::vector<uint64_t> slice;
+    if (endIndex <= startIndex) {
+        return slice;
+    }
+    
+    // 按字移位拼接，位图之外的部分视为有效
+    size_t count = endIndex - startIndex;
+    slice.assign((count + 63) / 64, ~uint64_t(0));
+    std::map<std::string, std::vector<uint64_t> >::const_iterator it = m_validity.find(fieldName);
+    if (it != m_validity.end()) {
+        const std::vector<uint64_t>& bitmap = it->second;
+        size_t firstWord = startIndex >> 6;
+        size_t shift = startIndex & 63;
+        for (size_t i = 0; i < slice.size(); ++i) {
+            size_t word = firstWord + i;
+            uint64_t low = word < bitmap.size() ? bitmap[word] : ~uint64_t(0);
+            if (shift == 0) {
+                slice[i] = low;
+                continue;
+            }
+            uint64_t high = word + 1 < bitmap.size() ? bitmap[word + 1] : ~uint64_t(0);
+            slice[i] = (low >> shift) | (high << (64 - shift));
+        }
+    }
+    if ((count & 63) != 0) {
+        slice.back() &= (uint64_t(1) << (count & 63)) - 1;
+    }
+    return slice;
+}
+
+bool DataModel::getRangeMinMax(const std::string& fieldName, size_t startIndex, size_t endIndex,
+                               double& minValue, double& maxValue) const {
+    size_t fieldSize = getFieldSize(fieldName);
+    const std::vector<ZoneBlock>& zones = getZoneMap(fieldName);
+    size_t offset = getZoneMapOffset(fieldName);
+    
+    endIndex = std::min(endIndex, fieldSize);
+    if (startIndex >= endIndex) {
+        return false;
+    }
+    
+    // 分块按 行号 + offset 划分：第 k 块覆盖行 [k*ZONE_BLOCK_SIZE - offset, (k+1)*ZONE_BLOCK_SIZE - offset)，
+    // 首块只剩 offset 之后的部分。区间覆盖某块的全部现存行时直接使用摘要，否则部分扫描
+    ZoneBlock result;
+    size_t firstBlock = (startIndex + offset) / ZONE_BLOCK_SIZE;
+    size_t lastBlock = (endIndex + offset - 1) / ZONE_BLOCK_SIZE;
+    for (size_t block = firstBlock; block <= lastBlock; ++block) {
+        size_t blockStart = block == 0 ? 0 : block * ZONE_BLOCK_SIZE - offset;
+        size_t blockEnd = std::min((block + 1) * ZONE_BLOCK_SIZE - offset, fieldSize);
+        size_t rangeStart = std::max(startIndex, blockStart);
+        size_t rangeEnd = std::min(endIndex, blockEnd);
+        if (rangeStart == blockStart && rangeEnd == blockEnd && block < zones.size()) {
+            mergeZone(result, zones[block]);
+        } else {
+            scanFieldRange(fieldName, rangeStart, rangeEnd, result);
+        }
+    }
+    
+    if (result.count == 0) {
+        return false;
+    }
+    
+    minValue = result.minValue;
+    maxValue = result.maxValue;
+    return true;
+}
+
+bool DataModel::getFieldRange(const std::string& fieldName, double& minValue, double& maxValue) const {
+    return getRangeMinMax(fieldName, 0, getFieldSize(fieldName), minValue, maxValue);
+}
+
+const std::vector<DataModel::ZoneBlock>& DataModel::getZoneMap(const std::string& fieldName) const {
+    std::lock_guard<std::mutex> lock(m_zoneMutex);
+    if (!m_staleZoneMaps.empty() && m_staleZoneMaps.erase(fieldName) > 0) {
+        buildZoneMap(fieldName, m_zoneMaps[fieldName]);
+        m_zoneOffsets.erase(fieldName);
+        m_staleZoneHeads.erase(fieldName);
+    }
+    if (!m_staleZoneHeads.empty() && m_staleZoneHeads.erase(fieldName) > 0) {
+        std::vector<ZoneBlock>& zones = m_zoneMaps[fieldName];
+        if (!zones.empty()) {
+            std::map<std::string, size_t>::const_iterator offsetIt = m_zoneOffsets.find(fieldName);
+            size_t offset = offsetIt != m_zoneOffsets.end() ? offsetIt->second : 0;
+            zones[0] = ZoneBlock();
+            scanFieldRange(fieldName, 0, std::min(ZONE_BLOCK_SIZE - offset, getFieldSize(fieldName)), zones[0]);
+        }
+    }
+    
+    std::map<std::string, std::vector<ZoneBlock> >::const_iterator it = m_zoneMaps.find(fieldName);
+    if (it != m_zoneMaps.end()) {
+        return it->second;
+    }
+    return s_emptyZoneMap;
+}
+
+size_t DataModel::getZoneMapOffset(const std::string& fieldName) const {
+    std::lock_guard<std::mutex> lock(m_zoneMutex);
+    std::map<std::string, size_t>::const_iterator it = m_zoneOffsets.find(fieldName);
+    return it != m_zoneOffsets.end() ? it->second : 0;
+}
+
+void DataModel::appendToZoneMap(const std::string& fieldName, size_t index, double value) {
+    // 待重算的摘要在首次使用时会包含新值
+    if (!m_staleZoneMaps.empty() && m_staleZoneMaps.find(fieldName) != m_staleZoneMaps.end()) {
+        return;
+    }
+    
+    std::vector<ZoneBlock>& zones = m_zoneMaps[fieldName];
+    size_t block = index / ZONE_BLOCK_SIZE;
+    if (!m_zoneOffsets.empty()) {
+        std::map<std::string, size_t>::const_iterator offsetIt = m_zoneOffsets.find(fieldName);
+        if (offsetIt != m_zoneOffsets.end()) {
+            block = (index + offsetIt->second) / ZONE_BLOCK_SIZE;
+        }
+    }
+    if (block >= zones.size()) {
+        zones.resize(block + 1);
+    }
+    
+    if (std::isnan(value)) {
+        return;
+    }
+    
+    ZoneBlock& zone = zones[block];
+    if (zone.count == 0) {
+        zone.minValue = value;
+        zone.maxValue = value;
+    } else {
+        zone.minValue = std::min(zone.minValue, value);
+        zone.maxValue = std::max(zone.maxValue, value);
+    }
+    zone.sum += value;
+    zone.count++;
+}
+
+void DataModel::rebuildZoneMap(const std::string& fieldName) {
+    std::vector<ZoneBlock> zones;
+    buildZoneMap(fieldName, zones);
+    
+    std::lock_guard<std::mutex> lock(m_zoneMutex);
+    m_zoneMaps[fieldName].swap(zones);
+    m_zoneOffsets.erase(fieldName);
+    m_staleZoneHeads.erase(fieldName);
+    m_staleZoneMaps.erase(fieldName);
+}
+
+void DataModel::markZoneMapStale(const std::string& fieldName) {
+    std::lock_guard<std::mutex> lock(m_zoneMutex);
+    m_zoneMaps[fieldName].clear();
+    m_zoneOffsets.erase(fieldName);
+    m_staleZoneHeads.erase(fieldName);
+    m_staleZoneMaps.insert(fieldName);
+}
+
+void DataModel::dropZoneMapFront(const std::string& fieldName, size_t count) {
+    std::lock_guard<std::mutex> lock(m_zoneMutex);
+    if (m_staleZoneMaps.find(fieldName) != m_staleZoneMaps.end()) {
+        return;  // 重算时按新的起点对齐
+    }
+    
+    // 整块丢弃的摘要直接移除，其余块保持不变
+    std::vector<ZoneBlock>& zones = m_zoneMaps[fieldName];
+    std::map<std::string, size_t>::iterator offsetIt = m_zoneOffsets.find(fieldName);
+    size_t offset = (offsetIt != m_zoneOffsets.end() ? offsetIt->second : 0) + count;
+    size_t dropped = std::min(offset / ZONE_BLOCK_SIZE, zones.size());
+    zones.erase(zones.begin(), zones.begin() + dropped);
+    offset -= dropped * ZONE_BLOCK_SIZE;
+    
+    size_t fieldSize = getFieldSize(fieldName);
+    if (fieldSize == 0) {
+        zones.clear();
+        offset = 0;
+    }
+    if (offset == 0) {
+        if (offsetIt != m_zoneOffsets.end()) {
+            m_zoneOffsets.erase(offsetIt);
+        }
+        m_staleZoneHeads.erase(fieldName);
+        return;
+    }
+    m_zoneOffsets[fieldName] = offset;
+    
+    // 首块只剩后半部分，下次读取摘要时只重新扫描这一块的剩余行；逐行丢弃时不必每次都扫描
+    if (!zones.empty()) {
+        m_staleZoneHeads.insert(fieldName);
+    }
+}
+
+void DataModel::buildZoneMap(const std::string& fieldName, std::vector<ZoneBlock>& zones) const {
+    size_t fieldSize = getFieldSize(fieldName);
+    size_t blockCount = (fieldSize + ZONE_BLOCK_SIZE - 1) / ZONE_BLOCK_SIZE;
+    zones.assign(blockCount, ZoneBlock());
+    
+    for (size_t block = 0; block < blockCount; ++block) {
+        size_t start = block * ZONE_BLOCK_SIZE;
+        size_t end = std::min(start + ZONE_BLOCK_SIZE, fieldSize);
+        scanFieldRange(fieldName, start, end, zones[block]);
+    }
+}
+
+void DataModel::scanRange(const double* values, size_t startIndex, size_t endIndex, ZoneBlock& result) {
+    for (size_t i = startIndex; i < endIndex; ++i) {
+        double value = values[i];
+        if (std::isnan(value)) {
+            continue;
+        }
+        if (result.count == 0) {
+            result.minValue = value;
+            result.maxValue = value;
+        } else {
+            result.minValue = std::min(result.minValue, value);
+            result.maxValue = std::max(result.maxValue, value);
+        }
+        result.sum += value;
+        result.count++;
+    }
+}
+
+void DataModel::mergeZone(ZoneBlock& target, const ZoneBlock& source) {
+    if (source.count == 0) {
+        return;
+    }
+    if (target.count == 0) {
+        target = source;
+        return;
+    }
+    target.minValue = std::min(target.minValue, source.minValue);
+    target.maxValue = std::max(target.maxValue, source.maxValue);
+    target.sum += source.sum;
+    target.count += source.count;
+}
@@ -1,30 +1,49 @@
 #include "DataParser.h"
-#include <sstream>
+#include "ParseArena.h"
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
 
 bool DefaultDataParser::parseLine(const std::string& line, std::vector<double>& values) {
-    std::istringstream ss(line);
-    std::string token;
-    std::vector<double> result;
+    // 字段副本和中间结果放在本线程的解析区中，返回时回收
+    ParseArena& arena = ParseArena::forThread();
+    ParseArena::Scope scope(arena);
     
-    while (std::getline(ss, token, m_delimiter)) {
-        // 去除空白字符
-        token.erase(0, token.find_first_not_of(" \t\r\n"));
-        token.erase(token.find_last_not_of(" \t\r\n") + 1);
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+    double* result = arena.allocateArray<double>(
+        static_cast<size_t>(std::count(begin, end, m_delimiter)) + 1);
+    size_t count = 0;
+    
+    const char* fieldBegin = begin;
+    while (fieldBegin < end) {
+        const char* fieldEnd = std::find(fieldBegin, end, m_delimiter);
+        const char* next = fieldEnd == end ? end : fieldEnd + 1;
         
-        if (token.empty()) {
-            continue;
+        // 去除空白字符
+        while (fieldBegin < fieldEnd && std::isspace(static_cast<unsigned char>(*fieldBegin))) {
+            ++fieldBegin;
+        }
+        while (fieldEnd > fieldBegin && std::isspace(static_cast<unsigned char>(fieldEnd[-1]))) {
+            --fieldEnd;
         }
         
-        try {
-            double value = std::stod(token);
-            result.push_back(value);
-        } catch (const std::exception&) {
-            return false;
+        if (fieldBegin < fieldEnd) {
+            char* text = arena.copyString(fieldBegin, fieldEnd);
+            char* parsedEnd = nullptr;
+            errno = 0;
+            double value = std::strtod(text, &parsedEnd);
+            if (parsedEnd == text || errno == ERANGE) {
+                return false;
+            }
+            result[count++] = value;
         }
+        fieldBegin = next;
     }
     
-    values = std::move(result);
+    // 复用调用方数组的容量
+    values.assign(result, result + count);
     return true;
 }
 
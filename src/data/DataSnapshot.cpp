@@ -0,0 +1,651 @@
+#include "DataSnapshot.h"
+#include "utils/ThreadPool.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <atomic>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+const char DataSnapshot::MAGIC[8] = { 'D', 'A', 'S', 'N', 'A', 'P', '0', '1' };
+const uint32_t DataSnapshot::VERSION;
+const uint32_t DataSnapshot::FLAG_ZONE_MAPS;
+const size_t DataSnapshot::COLUMN_ALIGNMENT;
+
+// 固定头：魔数(8) 版本(4) 标志(4) 行数(8) 列数(4) 分块大小(4) 目录长度(8)
+static const size_t FIXED_HEADER_SIZE = 40;
+// 每个分块摘要：min/max/sum 各8字节 + count 8字节
+static const size_t ZONE_RECORD_SIZE = 32;
+
+// ==================== 小端序列化工具 ====================
+
+static bool isLittleEndianHost() {
+    uint16_t value = 1;
+    return *reinterpret_cast<const uint8_t*>(&value) == 1;
+}
+
+static void putU8(std::string& buffer, uint8_t value) {
+    buffer.push_back(static_cast<char>(value));
+}
+
+static void putU32(std::string& buffer, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void putU64(std::string& buffer, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void putF64(std::string& buffer, double value) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU64(buffer, bits);
+}
+
+static void putString(std::string& buffer, const std::string& value) {
+    putU32(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief 带边界检查的小端读取器
+ */
+class SnapshotReader {
+public:
+    SnapshotReader(const char* data, size_t size) : m_data(data), m_size(size), m_pos(0) {}
+
+    bool readU8(uint8_t& value) {
+        if (m_pos + 1 > m_size) return false;
+        value = static_cast<uint8_t>(m_data[m_pos++]);
+        return true;
+    }
+
+    bool readU32(uint32_t& value) {
+        if (m_pos + 4 > m_size) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(m_data[m_pos + i])) << (8 * i);
+        }
+        m_pos += 4;
+        return true;
+    }
+
+    bool readU64(uint64_t& value) {
+        if (m_pos + 8 > m_size) return false;
+        value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(m_data[m_pos + i])) << (8 * i);
+        }
+        m_pos += 8;
+        return true;
+    }
+
+    bool readF64(double& value) {
+        uint64_t bits = 0;
+        if (!readU64(bits)) return false;
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint32_t length = 0;
+        if (!readU32(length) || m_pos + length > m_size) return false;
+        value.assign(m_data + m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos;
+};
+
+// ==================== 目录序列化 ====================
+
+static std::string serializeDirectory(const std::vector<DataSnapshot::ColumnInfo>& columns) {
+    std::string buffer;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const DataSnapshot::ColumnInfo& column = columns[i];
+        putString(buffer, column.name);
+        putU64(buffer, column.rowCount);
+        putU64(buffer, column.dataOffset);
+        putU64(buffer, column.zoneOffset);
+        putU64(buffer, column.zoneCount);
+        putU64(buffer, column.validityOffset);
+        putU64(buffer, column.validityWords);
+
+        putU32(buffer, static_cast<uint32_t>(column.metadata.size()));
+        std::map<std::string, DataModel::MetadataValue>::const_iterator it;
+        for (it = column.metadata.begin(); it != column.metadata.end(); ++it) {
+            const DataModel::MetadataValue& value = it->second;
+            putString(buffer, it->first);
+            putU8(buffer, static_cast<uint8_t>(value.type));
+            switch (value.type) {
+            case DataModel::MetadataValue::STRING:
+                putString(buffer, value.stringValue);
+                break;
+            case DataModel::MetadataValue::INT:
+                putU64(buffer, static_cast<uint64_t>(static_cast<int64_t>(value.intValue)));
+                break;
+            case DataModel::MetadataValue::DOUBLE:
+                putF64(buffer, value.doubleValue);
+                break;
+            case DataModel::MetadataValue::BOOL:
+                putU8(buffer, value.boolValue ? 1 : 0);
+                break;
+            }
+        }
+    }
+    return buffer;
+}
+
+static bool parseMetadataValue(SnapshotReader& reader, DataModel::MetadataValue& value) {
+    uint8_t type = 0;
+    if (!reader.readU8(type)) {
+        return false;
+    }
+
+    switch (type) {
+    case DataModel::MetadataValue::STRING: {
+        std::string text;
+        if (!reader.readString(text)) return false;
+        value = DataModel::MetadataValue(text);
+        return true;
+    }
+    case DataModel::MetadataValue::INT: {
+        uint64_t bits = 0;
+        if (!reader.readU64(bits)) return false;
+        value = DataModel::MetadataValue(static_cast<int>(static_cast<int64_t>(bits)));
+        return true;
+    }
+    case DataModel::MetadataValue::DOUBLE: {
+        double number = 0.0;
+        if (!reader.readF64(number)) return false;
+        value = DataModel::MetadataValue(number);
+        return true;
+    }
+    case DataModel::MetadataValue::BOOL: {
+        uint8_t flag = 0;
+        if (!reader.readU8(flag)) return false;
+        value = DataModel::MetadataValue(flag != 0);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// ==================== 并行定位写入 ====================
+
+struct SnapshotWriteJob {
+    const char* data;
+    size_t size;
+    uint64_t offset;
+};
+
+#ifdef _WIN32
+
+// Windows 没有 pwrite：每个线程使用独立的文件句柄定位后写入
+static bool writeJobsWithOwnHandle(const std::string& path, const std::vector<SnapshotWriteJob>& jobs,
+                                   size_t first, size_t stride) {
+    FILE* file = std::fopen(path.c_str(), "r+b");
+    if (!file) {
+        return false;
+    }
+
+    bool success = true;
+    for (size_t i = first; i < jobs.size() && success; i += stride) {
+        if (jobs[i].size == 0) {
+            continue;
+        }
+        if (_fseeki64(file, static_cast<__int64>(jobs[i].offset), SEEK_SET) != 0 ||
+            std::fwrite(jobs[i].data, 1, jobs[i].size, file) != jobs[i].size) {
+            success = false;
+        }
+    }
+
+    if (std::fclose(file) != 0) {
+        success = false;
+    }
+    return success;
+}
+
+#else
+
+static bool writeAt(int fd, const char* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+}
+
+#endif
+
+// 目标路径 + ".tmp.<进程号>.<序号>"，同一进程内各次写入互不相同
+static std::string uniqueTempPath(const std::string& path) {
+    static std::atomic<uint64_t> s_nextTempId(0);
+#ifdef _WIN32
+    unsigned long processId = static_cast<unsigned long>(GetCurrentProcessId());
+#else
+    unsigned long processId = static_cast<unsigned long>(getpid());
+#endif
+    return path + ".tmp." + std::to_string(processId) + "." + std::to_string(s_nextTempId.fetch_add(1));
+}
+
+bool DataSnapshot::write(const DataModel& model, const std::string& path,
+                         bool withZoneMaps, std::string& errorMessage) {
+    if (!isLittleEndianHost()) {
+        errorMessage = "快照格式要求小端平台";
+        return false;
+    }
+
+    std::vector<std::string> fieldNames = model.getFieldNames();
+    std::vector<ColumnInfo> columns(fieldNames.size());
+    std::vector<std::string> zoneBuffers(fieldNames.size());
+    // 持有各列视图直到写完，切片/映射/分块的列无需先展开
+    std::vector<ColumnBuffer> series(fieldNames.size());
+
+    for (size_t i = 0; i < fieldNames.size(); ++i) {
+        ColumnInfo& column = columns[i];
+        column.name = fieldNames[i];
+        series[i] = model.getColumnBuffer(fieldNames[i]);
+        column.rowCount = series[i].size();
+        column.metadata = model.getAllFieldMetadata(fieldNames[i]);
+
+        // 丢弃过开头行的模型首块不完整，与文件中从第0行起划分的块不对齐，不写摘要，读取时重算
+        const std::vector<DataModel::ZoneBlock>* zoneMap =
+            withZoneMaps ? &model.getZoneMap(fieldNames[i]) : nullptr;
+        if (zoneMap && model.getZoneMapOffset(fieldNames[i]) == 0) {
+            const std::vector<DataModel::ZoneBlock>& zones = *zoneMap;
+            column.zoneCount = zones.size();
+            std::string& buffer = zoneBuffers[i];
+            buffer.reserve(zones.size() * ZONE_RECORD_SIZE);
+            for (size_t j = 0; j < zones.size(); ++j) {
+                putF64(buffer, zones[j].minValue);
+                putF64(buffer, zones[j].maxValue);
+                putF64(buffer, zones[j].sum);
+                putU64(buffer, zones[j].count);
+            }
+        }
+
+        const std::vector<uint64_t>* validity = model.getValidityBitmap(fieldNames[i]);
+        if (validity) {
+            column.validityWords = validity->size();
+        }
+    }
+
+    // 目录字段均为定长，偏移取值不影响目录长度：先算长度，再分配偏移
+    std::string directory = serializeDirectory(columns);
+    uint64_t offset = alignUp(FIXED_HEADER_SIZE + directory.size(), COLUMN_ALIGNMENT);
+    for (size_t i = 0; i < columns.size(); ++i) {
+        columns[i].dataOffset = offset;
+        offset = alignUp(offset + columns[i].rowCount * sizeof(double), COLUMN_ALIGNMENT);
+        if (columns[i].zoneCount > 0) {
+            columns[i].zoneOffset = offset;
+            offset = alignUp(offset + zoneBuffers[i].size(), COLUMN_ALIGNMENT);
+        }
+        if (columns[i].validityWords > 0) {
+            columns[i].validityOffset = offset;
+            offset = alignUp(offset + columns[i].validityWords * sizeof(uint64_t), COLUMN_ALIGNMENT);
+        }
+    }
+    uint64_t totalSize = offset;
+    directory = serializeDirectory(columns);
+
+    std::string header;
+    header.append(MAGIC, sizeof(MAGIC));
+    putU32(header, VERSION);
+    putU32(header, withZoneMaps ? FLAG_ZONE_MAPS : 0);
+    putU64(header, model.size());
+    putU32(header, static_cast<uint32_t>(columns.size()));
+    putU32(header, static_cast<uint32_t>(DataModel::ZONE_BLOCK_SIZE));
+    putU64(header, directory.size());
+    header.append(directory);
+
+    // 写入任务：头部、各列数据、各列分块摘要、各列有效位图
+    std::vector<SnapshotWriteJob> jobs;
+    SnapshotWriteJob headerJob = { header.data(), header.size(), 0 };
+    jobs.push_back(headerJob);
+    for (size_t i = 0; i < columns.size(); ++i) {
+        // 分块存储的列按连续片段各成一个任务
+        uint64_t dataOffset = columns[i].dataOffset;
+        series[i].forEachSpan(0, series[i].size(), [&](size_t startIndex, const double* values, size_t count) {
+            SnapshotWriteJob dataJob = { reinterpret_cast<const char*>(values), count * sizeof(double),
+                                         dataOffset + startIndex * sizeof(double) };
+            jobs.push_back(dataJob);
+        });
+        if (columns[i].zoneCount > 0) {
+            SnapshotWriteJob zoneJob = { zoneBuffers[i].data(), zoneBuffers[i].size(),
+                                         columns[i].zoneOffset };
+            jobs.push_back(zoneJob);
+        }
+        if (columns[i].validityWords > 0) {
+            const std::vector<uint64_t>* validity = model.getValidityBitmap(columns[i].name);
+            SnapshotWriteJob validityJob = { reinterpret_cast<const char*>(validity->data()),
+                                             validity->size() * sizeof(uint64_t),
+                                             columns[i].validityOffset };
+            jobs.push_back(validityJob);
+        }
+    }
+
+    // 先写临时文件，完成后再替换，避免留下半个快照。临时文件名含进程号与进程内序号，
+    // 同时写同一路径（如多个线程存同一缓存键）时各写各的，最后一次改名生效
+    std::string tempPath = uniqueTempPath(path);
+
+#ifdef _WIN32
+    FILE* file = std::fopen(tempPath.c_str(), "wbx");
+    if (!file) {
+        errorMessage = "无法创建快照文件: " + tempPath;
+        return false;
+    }
+    bool sized = _chsize_s(_fileno(file), static_cast<__int64>(totalSize)) == 0;
+    std::fclose(file);
+    if (!sized) {
+        std::remove(tempPath.c_str());
+        errorMessage = "无法设置快照文件大小: " + tempPath;
+        return false;
+    }
+#else
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        errorMessage = "无法创建快照文件: " + tempPath;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(totalSize)) != 0) {
+        ::close(fd);
+        std::remove(tempPath.c_str());
+        errorMessage = "无法设置快照文件大小: " + tempPath;
+        return false;
+    }
+#endif
+
+    // 各任务互不重叠，按任务交错分成若干份，在共享线程池中并行写入
+    size_t threadCount = std::min(ThreadPool::getInstance().getThreadCount(), jobs.size());
+    std::atomic<bool> success(true);
+
+    ThreadPool::getInstance().parallelFor(0, threadCount, 1, [&](size_t first, size_t last) {
+        for (size_t t = first; t < last; ++t) {
+#ifdef _WIN32
+            if (!writeJobsWithOwnHandle(tempPath, jobs, t, threadCount)) {
+                success.store(false);
+            }
+#else
+            for (size_t i = t; i < jobs.size() && success.load(); i += threadCount) {
+                if (!writeAt(fd, jobs[i].data, jobs[i].size, jobs[i].offset)) {
+                    success.store(false);
+                }
+            }
+#endif
+        }
+    });
+
+#ifndef _WIN32
+    if (::close(fd) != 0) {
+        success.store(false);
+    }
+#endif
+
+    if (!success.load()) {
+        std::remove(tempPath.c_str());
+        errorMessage = "写入快照文件失败: " + tempPath;
+        return false;
+    }
+
+#ifdef _WIN32
+    bool renamed = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    bool renamed = std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    if (!renamed) {
+        std::remove(tempPath.c_str());
+        errorMessage = "无法替换快照文件: " + path;
+        return false;
+    }
+
+    return true;
+}
+
+// ==================== 读取 ====================
+
+DataSnapshot::DataSnapshot() : m_rowCount(0), m_flags(0), m_zoneBlockSize(0) {}
+
+DataSnapshot::~DataSnapshot() {
+    close();
+}
+
+bool DataSnapshot::open(const std::string& path) {
+    close();
+
+    if (!isLittleEndianHost()) {
+        m_lastError = "快照格式要求小端平台";
+        return false;
+    }
+
+    m_file = std::make_shared<MappedFile>();
+    if (!m_file->open(path)) {
+        m_lastError = m_file->getLastError();
+        m_file.reset();
+        return false;
+    }
+
+    if (!parseHeader()) {
+        m_file.reset();
+        m_columns.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void DataSnapshot::close() {
+    // 映射由共享它的模型列保活，最后一个引用释放时解除映射
+    m_file.reset();
+    m_columns.clear();
+    m_rowCount = 0;
+    m_flags = 0;
+    m_zoneBlockSize = 0;
+}
+
+bool DataSnapshot::parseHeader() {
+    const char* data = m_file->data();
+    size_t size = m_file->size();
+
+    if (!data || size < FIXED_HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        m_lastError = "不是有效的快照文件";
+        return false;
+    }
+
+    SnapshotReader header(data + sizeof(MAGIC), FIXED_HEADER_SIZE - sizeof(MAGIC));
+    uint32_t version = 0;
+    uint32_t columnCount = 0;
+    uint64_t directorySize = 0;
+    header.readU32(version);
+    header.readU32(m_flags);
+    header.readU64(m_rowCount);
+    header.readU32(columnCount);
+    header.readU32(m_zoneBlockSize);
+    header.readU64(directorySize);
+
+    if (version == 0 || version > VERSION) {
+        m_lastError = "不支持的快照版本: " + std::to_string(version);
+        return false;
+    }
+    if (directorySize > size - FIXED_HEADER_SIZE) {
+        m_lastError = "快照目录越界";
+        return false;
+    }
+
+    SnapshotReader directory(data + FIXED_HEADER_SIZE, static_cast<size_t>(directorySize));
+    m_columns.resize(columnCount);
+
+    for (uint32_t i = 0; i < columnCount; ++i) {
+        ColumnInfo& column = m_columns[i];
+        uint32_t metadataCount = 0;
+        if (!directory.readString(column.name) ||
+            !directory.readU64(column.rowCount) ||
+            !directory.readU64(column.dataOffset) ||
+            !directory.readU64(column.zoneOffset) ||
+            !directory.readU64(column.zoneCount) ||
+            (version >= 2 && (!directory.readU64(column.validityOffset) ||
+                              !directory.readU64(column.validityWords))) ||
+            !directory.readU32(metadataCount)) {
+            m_lastError = "快照目录损坏";
+            return false;
+        }
+
+        for (uint32_t j = 0; j < metadataCount; ++j) {
+            std::string key;
+            DataModel::MetadataValue value;
+            if (!directory.readString(key) || !parseMetadataValue(directory, value)) {
+                m_lastError = "快照字段元数据损坏: " + column.name;
+                return false;
+            }
+            column.metadata[key] = value;
+        }
+
+        // 数据区必须对齐且在文件范围内
+        if (column.dataOffset % sizeof(double) != 0 || column.dataOffset > size ||
+            column.rowCount > (size - column.dataOffset) / sizeof(double)) {
+            m_lastError = "快照列数据越界: " + column.name;
+            return false;
+        }
+        if (column.zoneCount > 0 &&
+            (column.zoneOffset % sizeof(double) != 0 || column.zoneOffset > size ||
+             column.zoneCount > (size - column.zoneOffset) / ZONE_RECORD_SIZE)) {
+            m_lastError = "快照分块摘要越界: " + column.name;
+            return false;
+        }
+        if (column.validityWords > 0 &&
+            (column.validityOffset % sizeof(uint64_t) != 0 || column.validityOffset > size ||
+             column.validityWords > (size - column.validityOffset) / sizeof(uint64_t) ||
+             column.validityWords < (column.rowCount + 63) / 64)) {
+            m_lastError = "快照有效位图越界: " + column.name;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const double* DataSnapshot::getColumnData(size_t column) const {
+    if (column >= m_columns.size() || m_columns[column].rowCount == 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(m_file->data() + m_columns[column].dataOffset);
+}
+
+bool DataSnapshot::getZoneMap(size_t column, std::vector<DataModel::ZoneBlock>& zones) const {
+    zones.clear();
+    if (column >= m_columns.size() || m_columns[column].zoneCount == 0) {
+        return false;
+    }
+
+    const ColumnInfo& info = m_columns[column];
+    SnapshotReader reader(m_file->data() + info.zoneOffset,
+                          static_cast<size_t>(info.zoneCount * ZONE_RECORD_SIZE));
+    zones.resize(static_cast<size_t>(info.zoneCount));
+    for (size_t i = 0; i < zones.size(); ++i) {
+        uint64_t count = 0;
+        reader.readF64(zones[i].minValue);
+        reader.readF64(zones[i].maxValue);
+        reader.readF64(zones[i].sum);
+        reader.readU64(count);
+        zones[i].count = static_cast<size_t>(count);
+    }
+    return true;
+}
+
+bool DataSnapshot::getValidityBitmap(size_t column, std::vector<uint64_t>& bitmap) const {
+    bitmap.clear();
+    if (column >= m_columns.size() || m_columns[column].validityWords == 0) {
+        return false;
+    }
+
+    const ColumnInfo& info = m_columns[column];
+    const char* source = m_file->data() + info.validityOffset;
+    bitmap.resize(static_cast<size_t>(info.validityWords));
+    std::memcpy(bitmap.data(), source, bitmap.size() * sizeof(uint64_t));
+    return true;
+}
+
+std::shared_ptr<DataModel> DataSnapshot::toDataModel(bool mapColumns) const {
+    std::shared_ptr<DataModel> model = std::make_shared<DataModel>();
+    if (!isOpen()) {
+        return model;
+    }
+
+    // 分块大小与当前编译配置一致时才能直接复用文件中的分块摘要
+    bool reuseZones = m_zoneBlockSize == DataModel::ZONE_BLOCK_SIZE;
+
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        const ColumnInfo& column = m_columns[i];
+        std::vector<DataModel::ZoneBlock> zones;
+        bool hasZones = reuseZones && getZoneMap(i, zones);
+
+        if (mapColumns) {
+            ColumnBuffer buffer(m_file, getColumnData(i), static_cast<size_t>(column.rowCount));
+            model->addDataSeries(column.name, buffer, hasZones ? &zones : nullptr);
+        } else {
+            model->addDataSeries(column.name, getColumnData(i), static_cast<size_t>(column.rowCount),
+                                 hasZones ? &zones : nullptr);
+        }
+
+        std::map<std::string, DataModel::MetadataValue>::const_iterator it;
+        for (it = column.metadata.begin(); it != column.metadata.end(); ++it) {
+            model->setFieldMetadata(column.name, it->first, it->second);
+        }
+
+        // 写入时空值位置已是 NaN、分块摘要不含空值，直接采用文件中的位图，不扫描列。
+        // 空值须在转换列类型前恢复，整数类型才不会把空值位置的 NaN 当作无法表示的值
+        std::vector<uint64_t> validity;
+        if (getValidityBitmap(i, validity)) {
+            model->adoptValidityBitmap(column.name, validity);
+        }
+
+        // 文件中按 double 存储。映射时保持 Float64 视图，记录的列类型只保留在元数据中，
+        // 打开不随行数增长；复制时本来就要逐行读取，按列类型恢复紧凑存储
+        ColumnType type;
+        DataModel::MetadataValue typeName = model->getFieldMetadata(column.name, "column_type");
+        if (!mapColumns && typeName.type == DataModel::MetadataValue::STRING &&
+            TypedColumn::typeFromName(typeName.stringValue, type)) {
+            model->setFieldType(column.name, type);
+        }
+    }
+
+    return model;
+}
+
+bool DataSnapshot::isSnapshotFile(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    char magic[sizeof(MAGIC)] = { 0 };
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
@@ -1,5 +1,9 @@
 #include "DataSourceFactory.h"
 #include "CSVDataSource.h"
+#include "CustomDataSource.h"
+#include "SnapshotDataSource.h"
+#include "RealTimeDataSource.h"
+#include "SocketDataSource.h"
 #include <memory>
 
 DataSourceFactory& DataSourceFactory::getInstance() {
@@ -16,11 +20,42 @@ std::shared_ptr<DataSource> DataSourceFactory::createCSVSource(const std::string
 }
 
 std::shared_ptr<DataSource> DataSourceFactory::createRealTimeSource() {
-    // 实现实时数据源
+    return std::make_shared<RealTimeDataSource>();
+}
+
+std::shared_ptr<DataSource> DataSourceFactory::createRealTimeSource(const std::map<std::string, std::string>& config) {
+    if (config.find("transport") == config.end()) {
+        return createRealTimeSource();
+    }
+    
+    // 转为 SocketDataSource 的 "key=value;..." 配置字符串
+    std::string text;
+    for (std::map<std::string, std::string>::const_iterator it = config.begin(); it != config.end(); ++it) {
+        text += it->first + "=" + it->second + ";";
+    }
+    return createSocketSource(text);
+}
+
+std::shared_ptr<DataSource> DataSourceFactory::createSocketSource(const std::string& config) {
+    auto source = std::make_shared<SocketDataSource>();
+    if (source->initialize(config)) {
+        return source;
+    }
     return nullptr;
 }
 
 std::shared_ptr<DataSource> DataSourceFactory::createCustomSource(const std::string& config) {
-    // 实现自定义数据源
+    auto source = std::make_shared<CustomDataSource>();
+    if (source->initialize(config)) {
+        return source;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<DataSource> DataSourceFactory::createSnapshotSource(const std::string& filename) {
+    auto source = std::make_shared<SnapshotDataSource>();
+    if (source->initialize(filename)) {
+        return source;
+    }
     return nullptr;
-}
\ No newline at end of file
+}
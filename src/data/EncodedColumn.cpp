@@ -0,0 +1,481 @@
+#include "EncodedColumn.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const size_t EncodedColumn::BLOCK_SIZE;
+
+// ==================== 位操作工具 ====================
+
+static inline uint64_t toBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline double fromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline uint32_t bitsNeeded(uint64_t value) {
+    return value == 0 ? 0 : 64 - static_cast<uint32_t>(__builtin_clzll(value));
+}
+
+// 按定宽打包，末尾多留一个字，解包时可无分支地读取相邻字
+static void packBits(const uint64_t* values, size_t count, uint32_t width,
+                     std::vector<uint64_t>& words) {
+    words.assign(width == 0 ? 0 : (count * width + 63) / 64 + 1, 0);
+    if (width == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t bit = i * width;
+        size_t word = bit >> 6;
+        uint32_t shift = static_cast<uint32_t>(bit & 63);
+        words[word] |= values[i] << shift;
+        if (shift + width > 64) {
+            words[word + 1] |= values[i] >> (64 - shift);
+        }
+    }
+}
+
+static void unpackBits(const uint64_t* words, size_t count, uint32_t width, uint64_t* output) {
+    if (width == 0) {
+        std::fill(output, output + count, 0);
+        return;
+    }
+    if (width == 64) {
+        std::copy(words, words + count, output);
+        return;
+    }
+
+    // (next << 1) << (63 - shift) 在 shift 为0时只污染最高位，随后被掩码清除，
+    // 因此循环体内没有分支
+    uint64_t mask = (uint64_t(1) << width) - 1;
+    for (size_t i = 0; i < count; ++i) {
+        size_t bit = i * width;
+        size_t word = bit >> 6;
+        uint32_t shift = static_cast<uint32_t>(bit & 63);
+        uint64_t value = (words[word] >> shift) | ((words[word + 1] << 1) << (63 - shift));
+        output[i] = value & mask;
+    }
+}
+
+/**
+ * @brief 变长位流写入（低位在前）
+ */
+class ColumnBitWriter {
+public:
+    explicit ColumnBitWriter(std::vector<uint64_t>& words) : m_words(words), m_bitPos(0) {
+        m_words.clear();
+    }
+
+    void write(uint64_t value, uint32_t count) {
+        size_t word = m_bitPos >> 6;
+        uint32_t shift = static_cast<uint32_t>(m_bitPos & 63);
+        if (m_words.size() < word + 2) {
+            m_words.resize(word + 2, 0);
+        }
+        m_words[word] |= value << shift;
+        if (shift + count > 64) {
+            m_words[word + 1] |= value >> (64 - shift);
+        }
+        m_bitPos += count;
+    }
+
+    void finish() {
+        // 保留一个填充字，读取时可安全访问相邻字
+        m_words.resize((m_bitPos + 63) / 64 + 1, 0);
+        m_words.shrink_to_fit();
+    }
+
+private:
+    std::vector<uint64_t>& m_words;
+    size_t m_bitPos;
+};
+
+/**
+ * @brief 变长位流读取（低位在前）
+ */
+class ColumnBitReader {
+public:
+    explicit ColumnBitReader(const std::vector<uint64_t>& words) : m_words(words), m_bitPos(0) {}
+
+    uint64_t read(uint32_t count) {
+        size_t word = m_bitPos >> 6;
+        uint32_t shift = static_cast<uint32_t>(m_bitPos & 63);
+        uint64_t value = m_words[word] >> shift;
+        if (shift + count > 64) {
+            value |= m_words[word + 1] << (64 - shift);
+        }
+        m_bitPos += count;
+        return count == 64 ? value : value & ((uint64_t(1) << count) - 1);
+    }
+
+private:
+    const std::vector<uint64_t>& m_words;
+    size_t m_bitPos;
+};
+
+// ==================== EncodedColumn ====================
+
+EncodedColumn::EncodedColumn() : m_encoding(Encoding::Auto), m_size(0), m_offset(0) {}
+
+void EncodedColumn::encode(const double* data, size_t count, Encoding encoding) {
+    clear();
+
+    m_encoding = (encoding == Encoding::Auto && count > 0) ? chooseEncoding(data, count) : encoding;
+
+    size_t fullBlocks = count / BLOCK_SIZE;
+    m_blocks.reserve(fullBlocks);
+    for (size_t i = 0; i < fullBlocks; ++i) {
+        std::shared_ptr<Block> block = std::make_shared<Block>();
+        encodeBlock(data + i * BLOCK_SIZE, BLOCK_SIZE, m_encoding, *block);
+        m_blocks.push_back(block);
+    }
+
+    m_tail.assign(data + fullBlocks * BLOCK_SIZE, data + count);
+    m_size = count;
+}
+
+void EncodedColumn::append(double value) {
+    m_tail.push_back(value);
+    m_size++;
+
+    // 尾部写满一块后编码
+    if (m_tail.size() == BLOCK_SIZE) {
+        if (m_encoding == Encoding::Auto) {
+            m_encoding = chooseEncoding(m_tail.data(), m_tail.size());
+        }
+        std::shared_ptr<Block> block = std::make_shared<Block>();
+        encodeBlock(m_tail.data(), m_tail.size(), m_encoding, *block);
+        m_blocks.push_back(block);
+        m_tail.clear();
+    }
+}
+
+void EncodedColumn::dropFront(size_t count) {
+    count = std::min(count, m_size);
+    m_size -= count;
+    m_offset += count;
+
+    // 整块丢弃的块直接释放
+    size_t dropped = std::min(m_offset / BLOCK_SIZE, m_blocks.size());
+    m_blocks.erase(m_blocks.begin(), m_blocks.begin() + dropped);
+    m_offset -= dropped * BLOCK_SIZE;
+
+    // 已编码块全部丢弃后偏移落在未编码的尾部，尾部不足一块，直接移除
+    if (m_blocks.empty() && m_offset > 0) {
+        m_tail.erase(m_tail.begin(), m_tail.begin() + m_offset);
+        m_offset = 0;
+    }
+}
+
+void EncodedColumn::clear() {
+    m_blocks.clear();
+    m_tail.clear();
+    m_encoding = Encoding::Auto;
+    m_size = 0;
+    m_offset = 0;
+}
+
+size_t EncodedColumn::blockCount() const {
+    return m_blocks.size() + (m_tail.empty() ? 0 : 1);
+}
+
+size_t EncodedColumn::decodeBlock(size_t block, double* output) const {
+    if (block < m_blocks.size()) {
+        decodeBlockData(*m_blocks[block], output);
+        size_t count = m_blocks[block]->count;
+        if (block == 0 && m_offset > 0) {
+            // 首块前部已丢弃
+            std::memmove(output, output + m_offset, (count - m_offset) * sizeof(double));
+            count -= m_offset;
+        }
+        return count;
+    }
+    if (block == m_blocks.size() && !m_tail.empty()) {
+        std::copy(m_tail.begin(), m_tail.end(), output);
+        return m_tail.size();
+    }
+    return 0;
+}
+
+void EncodedColumn::decodeAll(std::vector<double>& output) const {
+    output.resize(m_size);
+
+    size_t offset = 0;
+    size_t first = 0;
+    if (m_offset > 0) {
+        // 首块只剩后半部分，先解码到临时缓冲
+        std::vector<double> buffer(BLOCK_SIZE);
+        offset = decodeBlock(0, buffer.data());
+        std::copy(buffer.begin(), buffer.begin() + offset, output.begin());
+        first = 1;
+    }
+    for (size_t i = first; i < m_blocks.size(); ++i) {
+        decodeBlockData(*m_blocks[i], output.data() + offset);
+        offset += m_blocks[i]->count;
+    }
+    std::copy(m_tail.begin(), m_tail.end(), output.begin() + offset);
+}
+
+double EncodedColumn::valueAt(size_t index) const {
+    if (index >= m_size) {
+        return 0.0;
+    }
+
+    index += m_offset;
+    size_t block = index / BLOCK_SIZE;
+    if (block >= m_blocks.size()) {
+        return m_tail[index - m_blocks.size() * BLOCK_SIZE];
+    }
+
+    std::vector<double> buffer(BLOCK_SIZE);
+    decodeBlockData(*m_blocks[block], buffer.data());
+    return buffer[index % BLOCK_SIZE];
+}
+
+size_t EncodedColumn::memoryBytes() const {
+    // 共享的块按全量计
+    size_t bytes = sizeof(*this) + m_blocks.capacity() * sizeof(std::shared_ptr<const Block>) +
+                   m_tail.capacity() * sizeof(double);
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        bytes += sizeof(Block) + m_blocks[i]->words.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+EncodedColumn::Encoding EncodedColumn::chooseEncoding(const double* data, size_t count) {
+    // 只检查第一块，代表整列特征
+    size_t sampleCount = std::min(count, BLOCK_SIZE);
+    if (sampleCount == 0) {
+        return Encoding::GorillaXor;
+    }
+
+    bool allIntegral = true;
+    bool monotonic = true;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        double value = data[i];
+        if (!std::isfinite(value) || std::trunc(value) != value || std::fabs(value) > 9007199254740992.0) {
+            allIntegral = false;
+        }
+        if (!std::isfinite(value) || value < 0.0 || (i > 0 && value < data[i - 1])) {
+            monotonic = false;
+        }
+    }
+
+    if (allIntegral) {
+        return Encoding::FrameOfReference;
+    }
+    if (monotonic) {
+        return Encoding::DeltaOfDelta;
+    }
+    return Encoding::GorillaXor;
+}
+
+void EncodedColumn::encodeBlock(const double* data, size_t count, Encoding encoding, Block& block) {
+    block = Block();
+    block.count = static_cast<uint32_t>(count);
+
+    bool encoded = false;
+    switch (encoding) {
+    case Encoding::DeltaOfDelta:
+        encoded = encodeDeltaOfDelta(data, count, block);
+        break;
+    case Encoding::GorillaXor:
+        encoded = encodeGorilla(data, count, block);
+        break;
+    case Encoding::FrameOfReference:
+        encoded = encodeFrameOfReference(data, count, block);
+        break;
+    default:
+        break;
+    }
+
+    // 不适用或没有变小时保存原始值
+    if (!encoded || block.words.size() >= count) {
+        encodeRaw(data, count, block);
+    }
+}
+
+bool EncodedColumn::encodeDeltaOfDelta(const double* data, size_t count, Block& block) {
+    block.encoding = Encoding::DeltaOfDelta;
+    block.firstBits = toBits(data[0]);
+    if (count < 2) {
+        return true;
+    }
+
+    // 位模式按无符号回绕运算，任意值都可无损还原
+    block.firstDelta = toBits(data[1]) - toBits(data[0]);
+
+    std::vector<uint64_t> residuals(count - 2);
+    int64_t minimum = 0;
+    uint64_t previousDelta = block.firstDelta;
+    for (size_t i = 2; i < count; ++i) {
+        uint64_t delta = toBits(data[i]) - toBits(data[i - 1]);
+        int64_t deltaOfDelta = static_cast<int64_t>(delta - previousDelta);
+        residuals[i - 2] = static_cast<uint64_t>(deltaOfDelta);
+        minimum = (i == 2) ? deltaOfDelta : std::min(minimum, deltaOfDelta);
+        previousDelta = delta;
+    }
+
+    uint64_t maxOffset = 0;
+    for (size_t i = 0; i < residuals.size(); ++i) {
+        residuals[i] -= static_cast<uint64_t>(minimum);
+        maxOffset = std::max(maxOffset, residuals[i]);
+    }
+
+    block.reference = minimum;
+    block.bitWidth = bitsNeeded(maxOffset);
+    packBits(residuals.data(), residuals.size(), block.bitWidth, block.words);
+    return true;
+}
+
+bool EncodedColumn::encodeGorilla(const double* data, size_t count, Block& block) {
+    block.encoding = Encoding::GorillaXor;
+
+    ColumnBitWriter writer(block.words);
+    uint64_t previous = toBits(data[0]);
+    writer.write(previous, 64);
+
+    uint32_t previousLeading = 65;  // 65 表示还没有可复用的有效位窗口
+    uint32_t previousTrailing = 0;
+
+    for (size_t i = 1; i < count; ++i) {
+        uint64_t current = toBits(data[i]);
+        uint64_t xorValue = current ^ previous;
+        previous = current;
+
+        if (xorValue == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+
+        uint32_t leading = std::min<uint32_t>(static_cast<uint32_t>(__builtin_clzll(xorValue)), 31);
+        uint32_t trailing = static_cast<uint32_t>(__builtin_ctzll(xorValue));
+
+        writer.write(1, 1);
+        if (previousLeading <= 64 && leading >= previousLeading && trailing >= previousTrailing) {
+            // 有效位落在上一个窗口内，复用窗口
+            writer.write(0, 1);
+            uint32_t length = 64 - previousLeading - previousTrailing;
+            writer.write(xorValue >> previousTrailing, length);
+        } else {
+            writer.write(1, 1);
+            uint32_t length = 64 - leading - trailing;
+            writer.write(leading, 5);
+            writer.write(length - 1, 6);
+            writer.write(xorValue >> trailing, length);
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+
+    writer.finish();
+    return true;
+}
+
+bool EncodedColumn::encodeFrameOfReference(const double* data, size_t count, Block& block) {
+    block.encoding = Encoding::FrameOfReference;
+
+    std::vector<uint64_t> offsets(count);
+    int64_t minimum = 0;
+    int64_t maximum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        double value = data[i];
+        // 只接受可精确表示的整数；-0.0 无法还原符号，同样排除
+        if (!std::isfinite(value) || std::trunc(value) != value ||
+            std::fabs(value) > 9007199254740992.0 || (value == 0.0 && std::signbit(value))) {
+            return false;
+        }
+        int64_t integer = static_cast<int64_t>(value);
+        offsets[i] = static_cast<uint64_t>(integer);
+        minimum = (i == 0) ? integer : std::min(minimum, integer);
+        maximum = (i == 0) ? integer : std::max(maximum, integer);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        offsets[i] -= static_cast<uint64_t>(minimum);
+    }
+
+    block.reference = minimum;
+    block.bitWidth = bitsNeeded(static_cast<uint64_t>(maximum) - static_cast<uint64_t>(minimum));
+    packBits(offsets.data(), count, block.bitWidth, block.words);
+    return true;
+}
+
+void EncodedColumn::encodeRaw(const double* data, size_t count, Block& block) {
+    block.encoding = Encoding::Raw;
+    block.bitWidth = 64;
+    block.words.resize(count);
+    std::memcpy(block.words.data(), data, count * sizeof(double));
+}
+
+void EncodedColumn::decodeBlockData(const Block& block, double* output) {
+    size_t count = block.count;
+
+    switch (block.encoding) {
+    case Encoding::Raw:
+        std::memcpy(output, block.words.data(), count * sizeof(double));
+        break;
+
+    case Encoding::DeltaOfDelta: {
+        output[0] = fromBits(block.firstBits);
+        if (count < 2) {
+            break;
+        }
+
+        uint64_t residuals[BLOCK_SIZE];
+        unpackBits(block.words.data(), count - 2, block.bitWidth, residuals);
+
+        uint64_t value = block.firstBits + block.firstDelta;
+        uint64_t delta = block.firstDelta;
+        uint64_t reference = static_cast<uint64_t>(block.reference);
+        output[1] = fromBits(value);
+        for (size_t i = 2; i < count; ++i) {
+            delta += reference + residuals[i - 2];
+            value += delta;
+            output[i] = fromBits(value);
+        }
+        break;
+    }
+
+    case Encoding::GorillaXor: {
+        ColumnBitReader reader(block.words);
+        uint64_t previous = reader.read(64);
+        output[0] = fromBits(previous);
+
+        uint32_t leading = 0;
+        uint32_t trailing = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (reader.read(1) != 0) {
+                if (reader.read(1) != 0) {
+                    leading = static_cast<uint32_t>(reader.read(5));
+                    uint32_t length = static_cast<uint32_t>(reader.read(6)) + 1;
+                    trailing = 64 - leading - length;
+                }
+                uint32_t length = 64 - leading - trailing;
+                previous ^= reader.read(length) << trailing;
+            }
+            output[i] = fromBits(previous);
+        }
+        break;
+    }
+
+    case Encoding::FrameOfReference: {
+        uint64_t offsets[BLOCK_SIZE];
+        unpackBits(block.words.data(), count, block.bitWidth, offsets);
+        for (size_t i = 0; i < count; ++i) {
+            output[i] = static_cast<double>(block.reference + static_cast<int64_t>(offsets[i]));
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,129 @@
+#include "LineBlockReader.h"
+#include "utils/ThreadPool.h"
+#include "utils/Tracer.h"
+#include <algorithm>
+#include <cstring>
+
+const size_t LineBlockReader::BLOCK_BYTES;
+
+LineBlockReader::LineBlockReader() : m_parallel(true) {}
+
+bool LineBlockReader::read(std::istream& stream, const LineParser& parser, const BlockConsumer& consumer) {
+    ThreadPool& pool = ThreadPool::getInstance();
+    size_t blocksPerRound = m_parallel ? std::max<size_t>(1, pool.getThreadCount() * 2) : 1;
+    size_t roundBytes = blocksPerRound * BLOCK_BYTES;
+
+    size_t used = 0;            // 缓冲中未处理的字节数（上一轮末尾不完整的行）
+    size_t bytesRead = 0;
+    bool endOfStream = false;
+    while (true) {
+        if (!endOfStream) {
+            if (m_buffer.size() < used + roundBytes) {
+                m_buffer.resize(used + roundBytes);
+            }
+            stream.read(m_buffer.data() + used, static_cast<std::streamsize>(roundBytes));
+            size_t count = static_cast<size_t>(stream.gcount());
+            used += count;
+            endOfStream = count < roundBytes;
+        }
+        if (used == 0) {
+            break;
+        }
+
+        // 本轮只处理到最后一个完整行，剩余部分留到下一轮；流结束时最后一行可以没有换行符
+        const char* begin = m_buffer.data();
+        const char* limit = begin + used;
+        if (!endOfStream) {
+            const char* lastNewline = nullptr;
+            for (const char* p = limit; p > begin; --p) {
+                if (p[-1] == '\n') {
+                    lastNewline = p - 1;
+                    break;
+                }
+            }
+            if (!lastNewline) {
+                // 单行超过一轮的大小，继续读入
+                continue;
+            }
+            limit = lastNewline + 1;
+        }
+
+        size_t blockCount = splitBlocks(begin, limit);
+        {
+            TRACE_SCOPE("data", "LineBlockReader::parseRound");
+            if (m_parallel && blockCount > 1) {
+                pool.parallelFor(0, blockCount, 1, [&](size_t first, size_t last) {
+                    for (size_t b = first; b < last; ++b) {
+                        parseBlock(m_boundaries[b], m_boundaries[b + 1], parser, *m_blocks[b]);
+                    }
+                });
+            } else {
+                for (size_t b = 0; b < blockCount; ++b) {
+                    parseBlock(m_boundaries[b], m_boundaries[b + 1], parser, *m_blocks[b]);
+                }
+            }
+        }
+
+        for (size_t b = 0; b < blockCount; ++b) {
+            bytesRead += static_cast<size_t>(m_boundaries[b + 1] - m_boundaries[b]);
+            if (!consumer(*m_blocks[b], bytesRead)) {
+                return false;
+            }
+        }
+
+        size_t consumed = static_cast<size_t>(limit - begin);
+        std::memmove(m_buffer.data(), m_buffer.data() + consumed, used - consumed);
+        used -= consumed;
+        if (endOfStream && used == 0) {
+            break;
+        }
+    }
+
+    return !stream.bad();
+}
+
+size_t LineBlockReader::splitBlocks(const char* begin, const char* end) {
+    m_boundaries.clear();
+    m_boundaries.push_back(begin);
+    const char* start = begin;
+    while (start < end) {
+        const char* blockEnd = end;
+        if (static_cast<size_t>(end - start) > BLOCK_BYTES) {
+            // 块末尾延伸到下一个换行符之后
+            const char* newline = static_cast<const char*>(
+                std::memchr(start + BLOCK_BYTES - 1, '\n', static_cast<size_t>(end - (start + BLOCK_BYTES - 1))));
+            blockEnd = newline ? newline + 1 : end;
+        }
+        m_boundaries.push_back(blockEnd);
+        start = blockEnd;
+    }
+
+    size_t blockCount = m_boundaries.size() - 1;
+    while (m_blocks.size() < blockCount) {
+        m_blocks.push_back(std::unique_ptr<Block>(new Block()));
+    }
+    return blockCount;
+}
+
+void LineBlockReader::parseBlock(const char* begin, const char* end, const LineParser& parser, Block& block) {
+    block.arena.reset();
+    block.rows.clear();
+    block.lines = 0;
+    block.skippedLines = 0;
+
+    const char* lineBegin = begin;
+    while (lineBegin < end) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(lineBegin, '\n', static_cast<size_t>(end - lineBegin)));
+        const char* lineEnd = newline ? newline : end;
+
+        Row row;
+        block.lines++;
+        if (parser(lineBegin, lineEnd, block.arena, row)) {
+            block.rows.push_back(row);
+        } else {
+            block.skippedLines++;
+        }
+        lineBegin = newline ? newline + 1 : end;
+    }
+}
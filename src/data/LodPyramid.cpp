@@ -0,0 +1,227 @@
+#include "LodPyramid.h"
+#include "DataModel.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const size_t LodPyramid::BASE_BUCKET;
+const size_t LodPyramid::PREFIX_SAMPLES;
+
+LodPyramid::LodPyramid() : m_sourceSize(0), m_origin(0) {
+    std::fill(m_prefixRows, m_prefixRows + PREFIX_SAMPLES, 0);
+    std::fill(m_prefixSamples, m_prefixSamples + PREFIX_SAMPLES, 0.0);
+}
+
+void LodPyramid::build(const ColumnBuffer& data) {
+    clear();
+    extend(data);
+}
+
+void LodPyramid::extend(const ColumnBuffer& data) {
+    size_t size = data.size();
+    if (size < m_sourceSize || !prefixMatches(data)) {
+        // 数据被截断或替换，只能重建
+        build(data);
+        return;
+    }
+
+    if (m_levels.empty()) {
+        m_levels.push_back(Level());
+    }
+
+    // 每层只构建完全位于现存数据内的桶；开头部分被丢弃的桶跳过，跳过后该层从新位置重新开始
+    size_t totalRows = m_origin + size;
+
+    // 第1层：每 BASE_BUCKET 个原始点一个节点，按存储的连续片段读取，桶可以跨片段
+    Level& base = m_levels[0];
+    size_t baseStart = std::max(base.endNode(), (m_origin + BASE_BUCKET - 1) / BASE_BUCKET);
+    if (baseStart > base.endNode()) {
+        base.nodes.clear();
+        base.firstNode = baseStart;
+    }
+    size_t baseEnd = totalRows / BASE_BUCKET;
+    if (baseEnd > baseStart) {
+        base.nodes.reserve(base.nodes.size() + baseEnd - baseStart);
+        Node pending;
+        data.forEachSpan(baseStart * BASE_BUCKET - m_origin, baseEnd * BASE_BUCKET - m_origin,
+            [&](size_t spanStart, const double* values, size_t count) {
+                for (size_t i = 0; i < count; ) {
+                    size_t row = m_origin + spanStart + i;
+                    size_t run = std::min(count - i, BASE_BUCKET - row % BASE_BUCKET);
+                    accumulate(pending, values + i, run);
+                    i += run;
+                    if ((row + run) % BASE_BUCKET == 0) {
+                        base.nodes.push_back(pending);
+                        pending = Node();
+                    }
+                }
+            });
+    }
+
+    // 更高层：由下一层两两合并，只计算新增部分
+    for (size_t level = 1; ; ++level) {
+        size_t bucket = bucketSize(level + 1);
+        size_t start = (m_origin + bucket - 1) / bucket;
+        if (m_levels[level - 1].endNode() / 2 < start + 1) {
+            break;  // 下一层不足两个可合并的节点
+        }
+        if (level >= m_levels.size()) {
+            m_levels.push_back(Level());
+        }
+
+        const Level& lower = m_levels[level - 1];
+        Level& current = m_levels[level];
+        start = std::max(current.endNode(), start);
+        if (start > current.endNode()) {
+            current.nodes.clear();
+            current.firstNode = start;
+        }
+        size_t end = lower.endNode() / 2;
+        current.nodes.reserve(current.nodes.size() + (end > start ? end - start : 0));
+        for (size_t i = start; i < end; ++i) {
+            Node node = lower.nodes[i * 2 - lower.firstNode];
+            mergeNode(node, lower.nodes[i * 2 + 1 - lower.firstNode]);
+            current.nodes.push_back(node);
+        }
+    }
+
+    m_sourceSize = size;
+    recordPrefix(data);
+}
+
+void LodPyramid::dropFront(size_t count) {
+    // 丢弃的行可能包括尚未汇总的部分
+    m_origin += count;
+    m_sourceSize = count < m_sourceSize ? m_sourceSize - count : 0;
+
+    // 完全丢弃的节点攒到该层一半以上时才移除，移除的开销均摊到丢弃的行上
+    for (size_t level = 1; level <= m_levels.size(); ++level) {
+        Level& current = m_levels[level - 1];
+        size_t dropped = std::min(m_origin / bucketSize(level), current.endNode());
+        if (dropped > current.firstNode && (dropped - current.firstNode) * 2 > current.nodes.size()) {
+            current.nodes.erase(current.nodes.begin(), current.nodes.begin() + (dropped - current.firstNode));
+            current.firstNode = dropped;
+        }
+    }
+}
+
+void LodPyramid::clear() {
+    m_levels.clear();
+    m_sourceSize = 0;
+    m_origin = 0;
+}
+
+size_t LodPyramid::nodesInRange(size_t level, size_t startIndex, size_t endIndex,
+                                const Node*& nodes, size_t& firstRow) const {
+    nodes = nullptr;
+    firstRow = startIndex;
+    if (level == 0 || level > m_levels.size() || startIndex >= endIndex) {
+        return 0;
+    }
+
+    // 按丢弃前的行号取完整的桶；startIndex >= 0 保证不会取到部分被丢弃的桶
+    const Level& current = m_levels[level - 1];
+    size_t bucket = bucketSize(level);
+    size_t first = std::max((m_origin + startIndex + bucket - 1) / bucket, current.firstNode);
+    size_t last = std::min((m_origin + endIndex) / bucket, current.endNode());
+    if (last <= first) {
+        return 0;
+    }
+    nodes = current.nodes.data() + (first - current.firstNode);
+    firstRow = first * bucket - m_origin;
+    return last - first;
+}
+
+size_t LodPyramid::selectLevel(size_t visibleRows, size_t minNodes) const {
+    size_t selected = 0;
+    for (size_t level = 1; level <= m_levels.size(); ++level) {
+        if (visibleRows / bucketSize(level) < minNodes) {
+            break;
+        }
+        selected = level;
+    }
+    return selected;
+}
+
+std::map<std::string, std::shared_ptr<LodPyramid> >
+LodPyramid::buildForFields(const DataModel& model, const std::vector<std::string>& fieldNames) {
+    std::vector<std::shared_ptr<LodPyramid> > pyramids(fieldNames.size());
+    for (size_t i = 0; i < pyramids.size(); ++i) {
+        pyramids[i] = std::make_shared<LodPyramid>();
+    }
+
+    // 每列独立，每列一个任务在共享线程池中并行构建
+    ThreadPool::getInstance().parallelFor(0, fieldNames.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            ColumnBuffer series = model.getColumnBuffer(fieldNames[i]);
+            pyramids[i]->build(series);
+        }
+    });
+
+    std::map<std::string, std::shared_ptr<LodPyramid> > result;
+    for (size_t i = 0; i < fieldNames.size(); ++i) {
+        result[fieldNames[i]] = pyramids[i];
+    }
+    return result;
+}
+
+void LodPyramid::recordPrefix(const ColumnBuffer& data) {
+    if (m_sourceSize == 0) {
+        return;
+    }
+    for (size_t i = 0; i < PREFIX_SAMPLES; ++i) {
+        size_t index = i * (m_sourceSize - 1) / (PREFIX_SAMPLES - 1);
+        m_prefixRows[i] = m_origin + index;
+        m_prefixSamples[i] = data[index];
+    }
+}
+
+bool LodPyramid::prefixMatches(const ColumnBuffer& data) const {
+    if (m_sourceSize == 0) {
+        return true;
+    }
+    // 按位比较，NaN 与自身相等
+    for (size_t i = 0; i < PREFIX_SAMPLES; ++i) {
+        if (m_prefixRows[i] < m_origin) {
+            continue;
+        }
+        double value = data[m_prefixRows[i] - m_origin];
+        if (std::memcmp(&value, &m_prefixSamples[i], sizeof(double)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LodPyramid::accumulate(Node& node, const double* values, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        double value = values[i];
+        if (std::isnan(value)) {
+            continue;
+        }
+        if (node.count == 0) {
+            node.minValue = value;
+            node.maxValue = value;
+        } else {
+            node.minValue = std::min(node.minValue, value);
+            node.maxValue = std::max(node.maxValue, value);
+        }
+        node.sum += value;
+        node.count++;
+    }
+}
+
+void LodPyramid::mergeNode(Node& target, const Node& source) {
+    if (source.count == 0) {
+        return;
+    }
+    if (target.count == 0) {
+        target = source;
+        return;
+    }
+    target.minValue = std::min(target.minValue, source.minValue);
+    target.maxValue = std::max(target.maxValue, source.maxValue);
+    target.sum += source.sum;
+    target.count += source.count;
+}
@@ -0,0 +1,103 @@
+#include "ParseArena.h"
+#include <cstring>
+#include <algorithm>
+
+const size_t ParseArena::DEFAULT_BLOCK_SIZE;
+
+ParseArena::ParseArena(size_t blockSize)
+    : m_current(0), m_offset(0), m_blockSize(std::max<size_t>(blockSize, 64)), m_blockAllocations(0) {}
+
+ParseArena::~ParseArena() {
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        delete[] m_blocks[i].data;
+    }
+}
+
+ParseArena& ParseArena::forThread() {
+    static thread_local ParseArena arena;
+    return arena;
+}
+
+void ParseArena::addBlock(size_t size) {
+    Block block;
+    block.data = new char[size];
+    block.size = size;
+    m_blocks.push_back(block);
+    m_blockAllocations++;
+}
+
+void* ParseArena::allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) {
+        bytes = 1;
+    }
+
+    // 从当前块开始找能放下的块，后面的块在回退或 reset() 之后会被重新使用
+    while (m_current < m_blocks.size()) {
+        Block& block = m_blocks[m_current];
+        size_t address = reinterpret_cast<size_t>(block.data) + m_offset;
+        size_t padding = (alignment - address % alignment) % alignment;
+        if (m_offset + padding + bytes <= block.size) {
+            void* result = block.data + m_offset + padding;
+            m_offset += padding + bytes;
+            return result;
+        }
+        m_current++;
+        m_offset = 0;
+    }
+
+    // new 返回的内存满足基本类型的对齐
+    addBlock(std::max(m_blockSize, bytes));
+    m_current = m_blocks.size() - 1;
+    m_offset = bytes;
+    return m_blocks[m_current].data;
+}
+
+char* ParseArena::copyString(const char* begin, const char* end) {
+    size_t length = static_cast<size_t>(end - begin);
+    char* result = static_cast<char*>(allocate(length + 1, 1));
+    std::memcpy(result, begin, length);
+    result[length] = '\0';
+    return result;
+}
+
+ParseArena::Mark ParseArena::mark() const {
+    Mark position;
+    position.block = m_current;
+    position.offset = m_offset;
+    return position;
+}
+
+void ParseArena::rewind(const Mark& position) {
+    m_current = position.block;
+    m_offset = position.offset;
+}
+
+void ParseArena::reset() {
+    // 上一批用了多个块：合并为一个块，下一批同样大小的分配不再跨块或申请新块
+    if (m_blocks.size() > 1) {
+        size_t total = capacity();
+        for (size_t i = 0; i < m_blocks.size(); ++i) {
+            delete[] m_blocks[i].data;
+        }
+        m_blocks.clear();
+        addBlock(total);
+    }
+    m_current = 0;
+    m_offset = 0;
+}
+
+size_t ParseArena::bytesUsed() const {
+    size_t used = 0;
+    for (size_t i = 0; i < m_current && i < m_blocks.size(); ++i) {
+        used += m_blocks[i].size;
+    }
+    return used + m_offset;
+}
+
+size_t ParseArena::capacity() const {
+    size_t total = 0;
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        total += m_blocks[i].size;
+    }
+    return total;
+}
@@ -0,0 +1,199 @@
+#include "ParseCache.h"
+#include "DataSnapshot.h"
+#include "utils/FileUtils.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <iostream>
+
+// 参与内容哈希的首尾块大小
+static const size_t HASH_BLOCK_SIZE = 64 * 1024;
+// 缓存文件格式变化时递增，使旧缓存全部失效
+static const char* CACHE_FORMAT_TAG = "parse-cache-v1";
+static const char* CACHE_EXTENSION = ".snap";
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+ParseCache& ParseCache::getInstance() {
+    static ParseCache instance;
+    return instance;
+}
+
+ParseCache::ParseCache()
+    : m_enabled(true)
+    , m_directory(FileUtils::joinPath(FileUtils::getTempDirectory(), "DataAnalysisTool_cache"))
+    , m_maxBytes(2ULL * 1024 * 1024 * 1024) {}
+
+void ParseCache::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = enabled;
+}
+
+bool ParseCache::isEnabled() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_enabled;
+}
+
+void ParseCache::setCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = directory;
+}
+
+std::string ParseCache::getCacheDirectory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_directory;
+}
+
+void ParseCache::setMaxBytes(uint64_t maxBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = maxBytes;
+}
+
+uint64_t ParseCache::getMaxBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxBytes;
+}
+
+uint64_t ParseCache::hashBytes(const char* data, size_t size, uint64_t seed) {
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::string ParseCache::makeKey(const std::string& filename, const std::string& parseSettings) {
+    FileUtils::FileInfo info;
+    if (!FileUtils::getFileInfo(filename, info)) {
+        return std::string();
+    }
+    
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        return std::string();
+    }
+    
+    // 文件身份：路径、大小、修改时间
+    std::ostringstream identity;
+    identity << CACHE_FORMAT_TAG << '\n' << filename << '\n' << info.size << '\n'
+             << info.modifiedTime << '\n' << parseSettings;
+    std::string identityText = identity.str();
+    uint64_t hash = hashBytes(identityText.data(), identityText.size(), FNV_OFFSET_BASIS);
+    
+    // 内容：首尾两个数据块
+    std::vector<char> buffer(HASH_BLOCK_SIZE);
+    file.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+    hash = hashBytes(&buffer[0], static_cast<size_t>(file.gcount()), hash);
+    
+    if (info.size > HASH_BLOCK_SIZE) {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(info.size - HASH_BLOCK_SIZE), std::ios::beg);
+        file.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+        hash = hashBytes(&buffer[0], static_cast<size_t>(file.gcount()), hash);
+    }
+    
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+std::string ParseCache::pathForKey(const std::string& key) const {
+    return FileUtils::joinPath(m_directory, key + CACHE_EXTENSION);
+}
+
+std::shared_ptr<DataModel> ParseCache::lookup(const std::string& key) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_enabled || key.empty()) {
+            return nullptr;
+        }
+        path = pathForKey(key);
+    }
+    
+    DataSnapshot snapshot;
+    if (!FileUtils::exists(path) || !snapshot.open(path)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.misses++;
+        return nullptr;
+    }
+    
+    // 列直接引用映射内存，命中时不复制数据。缓存文件只会经临时文件改名整体替换或被删除，
+    // 已映射的内容在模型释放前保持不变
+    std::shared_ptr<DataModel> model = snapshot.toDataModel(true);
+    
+    // 更新修改时间作为最近使用时间，供LRU淘汰使用
+    FileUtils::touch(path);
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.hits++;
+    return model;
+}
+
+bool ParseCache::store(const std::string& key, const DataModel& model) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_enabled || key.empty()) {
+            return false;
+        }
+        if (!FileUtils::createDirectories(m_directory)) {
+            std::cerr << "无法创建缓存目录: " << m_directory << std::endl;
+            return false;
+        }
+        path = pathForKey(key);
+    }
+    
+    std::string errorMessage;
+    if (!DataSnapshot::write(model, path, true, errorMessage)) {
+        std::cerr << "写入解析缓存失败: " << errorMessage << std::endl;
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.stores++;
+    evictIfNeeded();
+    return true;
+}
+
+void ParseCache::evictIfNeeded() {
+    std::vector<FileUtils::FileInfo> files = FileUtils::listFiles(m_directory, CACHE_EXTENSION);
+    
+    uint64_t totalBytes = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        totalBytes += files[i].size;
+    }
+    if (totalBytes <= m_maxBytes) {
+        return;
+    }
+    
+    // 最久未使用的在前
+    std::sort(files.begin(), files.end(),
+              [](const FileUtils::FileInfo& a, const FileUtils::FileInfo& b) {
+                  return a.modifiedTime < b.modifiedTime;
+              });
+    
+    for (size_t i = 0; i < files.size() && totalBytes > m_maxBytes; ++i) {
+        if (FileUtils::removeFile(files[i].path)) {
+            totalBytes -= files[i].size;
+            m_stats.evictions++;
+        }
+    }
+}
+
+void ParseCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<FileUtils::FileInfo> files = FileUtils::listFiles(m_directory, CACHE_EXTENSION);
+    for (size_t i = 0; i < files.size(); ++i) {
+        FileUtils::removeFile(files[i].path);
+    }
+}
+
+ParseCache::Stats ParseCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -1,9 +1,11 @@
 #include "RealTimeDataSource.h"
+#include "RecordingLog.h"
 #include <iostream>
 #include <chrono>
 #include <cmath>
 #include <thread>
 #include <sstream>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -11,14 +13,18 @@
 #include <unistd.h>
 #endif
 
+const int RealTimeDataSource::PUBLISH_INTERVAL_MS;
+
 RealTimeDataSource::RealTimeDataSource() 
     : m_state(State::Stopped), m_hasNewData(false), m_isPaused(false),
       m_currentValue(0.0), m_startTime(0.0), m_sampleCount(0),
-      m_minValue(0.0), m_maxValue(0.0), m_valueSum(0.0),
+      m_minValue(0.0), m_maxValue(0.0), m_valueSum(0.0), m_droppedSamples(0),
       m_threadRunning(false), m_dataModel(std::make_shared<DataModel>()) {
     
     // 初始化互斥锁和条件变量
     pthread_mutex_init(&m_statsMutex, NULL);
+    pthread_mutex_init(&m_pendingMutex, NULL);
+    pthread_mutex_init(&m_sampleSinkMutex, NULL);
     pthread_mutex_init(&m_threadMutex, NULL);
     pthread_cond_init(&m_threadCond, NULL);
     
@@ -36,6 +42,8 @@ RealTimeDataSource::~RealTimeDataSource() {
     stop();
     
     pthread_mutex_destroy(&m_statsMutex);
+    pthread_mutex_destroy(&m_pendingMutex);
+    pthread_mutex_destroy(&m_sampleSinkMutex);
     pthread_mutex_destroy(&m_threadMutex);
     pthread_cond_destroy(&m_threadCond);
 }
@@ -56,6 +64,7 @@ bool RealTimeDataSource::start() {
     m_dataModel->clear();
     m_dataModel->addField("time");
     m_dataModel->addField("value");
+    m_dataModel->publish();
     
     // 重置统计信息
     pthread_mutex_lock(&m_statsMutex);
@@ -65,6 +74,12 @@ bool RealTimeDataSource::start() {
     m_valueSum = 0.0;
     pthread_mutex_unlock(&m_statsMutex);
     
+    pthread_mutex_lock(&m_pendingMutex);
+    m_pendingTimes.clear();
+    m_pendingValues.clear();
+    m_droppedSamples = 0;
+    pthread_mutex_unlock(&m_pendingMutex);
+    
     // 设置开始时间
     auto now = std::chrono::steady_clock::now();
     m_startTime = std::chrono::duration<double>(now.time_since_epoch()).count();
@@ -102,6 +117,13 @@ void RealTimeDataSource::stop() {
         std::cerr << "等待线程结束失败" << std::endl;
     }
     
+    // 采集已停止，写出未满的批次并落盘
+    pthread_mutex_lock(&m_sampleSinkMutex);
+    if (m_recordingLog) {
+        m_recordingLog->flush(true);
+    }
+    pthread_mutex_unlock(&m_sampleSinkMutex);
+    
     m_state = State::Stopped;
     m_hasNewData = false;
     
@@ -172,10 +194,16 @@ void RealTimeDataSource::dataGenerationThread() {
     std::cout << "数据生成线程启动" << std::endl;
     
     auto lastUpdateTime = std::chrono::steady_clock::now();
+    auto lastPublishTime = lastUpdateTime;
     double accumulatedTime = 0.0;
+    bool unpublished = false;
     
     while (m_threadRunning) {
         if (m_isPaused) {
+            if (unpublished) {
+                m_dataModel->publish();
+                unpublished = false;
+            }
             // 暂停状态，等待恢复
             pthread_mutex_lock(&m_threadMutex);
             pthread_cond_wait(&m_threadCond, &m_threadMutex);
@@ -195,6 +223,14 @@ void RealTimeDataSource::dataGenerationThread() {
             // 生成新数据点
             updateData();
             accumulatedTime = 0.0;
+            unpublished = true;
+        }
+        
+        // 发布会复制模型的列表结构，按显示帧的节奏发布，不必每个样本一次
+        if (unpublished && currentTime - lastPublishTime >= std::chrono::milliseconds(PUBLISH_INTERVAL_MS)) {
+            m_dataModel->publish();
+            lastPublishTime = currentTime;
+            unpublished = false;
         }
         
         // 休眠以避免过度占用CPU
@@ -208,6 +244,9 @@ void RealTimeDataSource::dataGenerationThread() {
         }
     }
     
+    if (unpublished) {
+        m_dataModel->publish();
+    }
     std::cout << "数据生成线程结束" << std::endl;
 }
 
@@ -254,23 +293,111 @@ void RealTimeDataSource::updateData() {
 void RealTimeDataSource::addDataPoint(double value) {
     double currentTime = getElapsedTime();
     
+    // 先交给预写日志再更新模型。日志按批写出：样本最多在写入端缓冲 flushIntervalMs
+    // （或攒满 batchRows 行）后才进入文件，之后按同步策略落盘，因此崩溃时界面上最近显示的样本
+    // 可能不在日志中，丢失窗口见 RecordingLogWriter
+    std::string logError;
+    pthread_mutex_lock(&m_sampleSinkMutex);
+    if (m_recordingLog) {
+        double row[2] = {currentTime, value};
+        if (!m_recordingLog->appendRow(row)) {
+            logError = m_recordingLog->getLastError();
+            m_recordingLog.reset();
+        }
+    }
+    pthread_mutex_unlock(&m_sampleSinkMutex);
+    if (!logError.empty() && m_errorCallback) {
+        m_errorCallback("录制日志写入失败，已停止记录: " + logError);
+    }
+    
     std::map<std::string, double> point;
     point["time"] = currentTime;
     point["value"] = value;
     
     m_dataModel->addDataPoint(point);
+    appendPendingSample(currentTime, value);
     
-    // 限制缓冲区大小
-    if (m_dataModel->size() > m_config.bufferSize) {
-        // 移除旧数据，保留最新的bufferSize个点
-        auto subset = m_dataModel->getSubset(1, m_dataModel->size());
-        m_dataModel->clear();
-        
-        auto fieldNames = subset->getFieldNames();
-        for (const auto& field : fieldNames) {
-            m_dataModel->addDataSeries(field, subset->getDataSeries(field));
-        }
+    pthread_mutex_lock(&m_sampleSinkMutex);
+    if (m_sampleCallback) {
+        m_sampleCallback(currentTime, value);
+    }
+    pthread_mutex_unlock(&m_sampleSinkMutex);
+    
+    // 限制缓冲区大小：移除旧数据，保留最新的bufferSize个点（只移动列视图起点，不复制）
+    size_t bufferSize = static_cast<size_t>(std::max(m_config.bufferSize, 0));
+    if (m_dataModel->size() > bufferSize) {
+        m_dataModel->removeFront(m_dataModel->size() - bufferSize);
+    }
+    // 采集线程独占写入模型，其他线程只读取发布的版本；由 dataGenerationThread 按帧发布
+}
+
+void RealTimeDataSource::appendPendingSample(double time, double value) {
+    pthread_mutex_lock(&m_pendingMutex);
+    
+    // 消费端跟不上时一次丢弃较旧的一半，避免缓冲无限增长
+    size_t capacity = std::max<size_t>(static_cast<size_t>(std::max(m_config.bufferSize, 1)),
+                                       static_cast<size_t>(m_config.sampleRate));
+    if (m_pendingTimes.size() >= capacity) {
+        size_t dropCount = m_pendingTimes.size() / 2;
+        m_pendingTimes.erase(m_pendingTimes.begin(), m_pendingTimes.begin() + dropCount);
+        m_pendingValues.erase(m_pendingValues.begin(), m_pendingValues.begin() + dropCount);
+        m_droppedSamples += dropCount;
     }
+    
+    m_pendingTimes.push_back(time);
+    m_pendingValues.push_back(value);
+    
+    pthread_mutex_unlock(&m_pendingMutex);
+}
+
+size_t RealTimeDataSource::takePendingSamples(std::vector<double>& times, std::vector<double>& values) {
+    times.clear();
+    values.clear();
+    
+    pthread_mutex_lock(&m_pendingMutex);
+    times.swap(m_pendingTimes);
+    values.swap(m_pendingValues);
+    pthread_mutex_unlock(&m_pendingMutex);
+    
+    return times.size();
+}
+
+std::vector<std::string> RealTimeDataSource::getFieldNames() const {
+    std::vector<std::string> fieldNames;
+    fieldNames.push_back("time");
+    fieldNames.push_back("value");
+    return fieldNames;
+}
+
+size_t RealTimeDataSource::takePendingRows(std::vector<std::vector<double> >& columns) {
+    columns.resize(2);
+    return takePendingSamples(columns[0], columns[1]);
+}
+
+void RealTimeDataSource::setSampleCallback(SampleCallback callback) {
+    pthread_mutex_lock(&m_sampleSinkMutex);
+    m_sampleCallback = callback;
+    pthread_mutex_unlock(&m_sampleSinkMutex);
+}
+
+void RealTimeDataSource::setRecordingLog(std::shared_ptr<RecordingLogWriter> log) {
+    pthread_mutex_lock(&m_sampleSinkMutex);
+    m_recordingLog = log;
+    pthread_mutex_unlock(&m_sampleSinkMutex);
+}
+
+std::shared_ptr<RecordingLogWriter> RealTimeDataSource::getRecordingLog() const {
+    pthread_mutex_lock(&m_sampleSinkMutex);
+    std::shared_ptr<RecordingLogWriter> log = m_recordingLog;
+    pthread_mutex_unlock(&m_sampleSinkMutex);
+    return log;
+}
+
+size_t RealTimeDataSource::getDroppedSampleCount() const {
+    pthread_mutex_lock(&m_pendingMutex);
+    size_t dropped = m_droppedSamples;
+    pthread_mutex_unlock(&m_pendingMutex);
+    return dropped;
 }
 
 void RealTimeDataSource::updateStatistics(double value) {
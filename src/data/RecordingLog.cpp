@@ -0,0 +1,590 @@
+#include "RecordingLog.h"
+#include "utils/Crc32.h"
+#include "utils/FileUtils.h"
+#include "utils/Tracer.h"
+#include <fstream>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const char RecordingLogWriter::MAGIC[8] = { 'D', 'A', 'W', 'A', 'L', '0', '0', '1' };
+const uint32_t RecordingLogWriter::VERSION;
+
+static const uint32_t FRAME_MARKER = 0x4D415246u;   // "FRAM"
+static const size_t FRAME_HEADER_SIZE = 32;
+// 帧头中参与帧头 CRC 的部分：标记、行数、序号、载荷长度、载荷 CRC
+static const size_t FRAME_HEADER_CHECKED = 24;
+// 单帧载荷上限，读取时用于排除损坏的长度字段
+static const uint64_t MAX_FRAME_PAYLOAD = static_cast<uint64_t>(1) << 31;
+
+// ==================== 小端序列化工具 ====================
+
+static bool isLittleEndianHost() {
+    uint16_t value = 1;
+    return *reinterpret_cast<const uint8_t*>(&value) == 1;
+}
+
+static void putU32(std::string& buffer, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void putU64(std::string& buffer, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static uint32_t getU32(const char* data) {
+    uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint64_t getU64(const char* data) {
+    uint64_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 文件头：魔数、版本、字段表，补齐到8字节后是 CRC 和保留字
+static std::string buildFileHeader(const std::vector<std::string>& fieldNames) {
+    std::string header(RecordingLogWriter::MAGIC, sizeof(RecordingLogWriter::MAGIC));
+    putU32(header, RecordingLogWriter::VERSION);
+    putU32(header, static_cast<uint32_t>(fieldNames.size()));
+    for (const std::string& name : fieldNames) {
+        putU32(header, static_cast<uint32_t>(name.size()));
+        header.append(name);
+    }
+    header.resize(alignUp(header.size(), 8), '\0');
+    putU32(header, Crc32::compute(header.data(), header.size()));
+    putU32(header, 0);
+    return header;
+}
+
+// ==================== 文件操作 ====================
+
+static bool startsWithMagic(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    char magic[sizeof(RecordingLogWriter::MAGIC)];
+    file.read(magic, sizeof(magic));
+    return file.gcount() > 0 &&
+           std::memcmp(magic, RecordingLogWriter::MAGIC, static_cast<size_t>(file.gcount())) == 0;
+}
+
+#ifdef _WIN32
+
+static int openLogFile(const std::string& path) {
+    return _open(path.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+static bool seekToEnd(int fd, uint64_t position) {
+    return _chsize_s(fd, static_cast<__int64>(position)) == 0 &&
+           _lseeki64(fd, static_cast<__int64>(position), SEEK_SET) >= 0;
+}
+
+static long long writeSome(int fd, const char* data, size_t size) {
+    return _write(fd, data, static_cast<unsigned int>(std::min<size_t>(size, 1u << 30)));
+}
+
+static bool syncFile(int fd) {
+    return _commit(fd) == 0;
+}
+
+static void syncParentDirectory(const std::string&) {
+}
+
+static void closeLogFile(int fd) {
+    _close(fd);
+}
+
+#else
+
+static int openLogFile(const std::string& path) {
+    return ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+}
+
+static bool seekToEnd(int fd, uint64_t position) {
+    return ftruncate(fd, static_cast<off_t>(position)) == 0 &&
+           lseek(fd, static_cast<off_t>(position), SEEK_SET) >= 0;
+}
+
+static long long writeSome(int fd, const char* data, size_t size) {
+    return ::write(fd, data, size);
+}
+
+static bool syncFile(int fd) {
+#if defined(__APPLE__)
+    return fsync(fd) == 0;
+#else
+    return fdatasync(fd) == 0;
+#endif
+}
+
+// 新建的文件要同步所在目录，目录项才会在断电后保留
+static void syncParentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+
+static void closeLogFile(int fd) {
+    ::close(fd);
+}
+
+#endif
+
+// ==================== RecordingLogWriter ====================
+
+RecordingLogWriter::RecordingLogWriter()
+    : m_fd(-1), m_fieldCount(0), m_pendingRows(0), m_sequence(0), m_unsyncedBytes(0),
+      m_writeFailed(false), m_stopFlush(false), m_syncRequested(false) {
+}
+
+RecordingLogWriter::~RecordingLogWriter() {
+    close();
+}
+
+bool RecordingLogWriter::open(const std::string& path, const std::vector<std::string>& fieldNames,
+                              const Options& options, std::string& errorMessage) {
+    close();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isLittleEndianHost()) {
+        errorMessage = "录制日志要求小端平台";
+        return false;
+    }
+    if (fieldNames.empty()) {
+        errorMessage = "录制日志没有字段";
+        return false;
+    }
+
+    // 已有日志：校验字段后从最后一个有效帧之后继续追加
+    uint64_t appendAt = 0;
+    uint64_t sequence = 0;
+    uint64_t recovered = 0;
+    FileUtils::FileInfo info;
+    if (FileUtils::getFileInfo(path, info) && info.size > 0) {
+        RecordingLogReader reader;
+        if (reader.open(path)) {
+            if (reader.getFieldNames() != fieldNames) {
+                errorMessage = "已有录制日志的字段不一致: " + path;
+                return false;
+            }
+            appendAt = reader.getValidBytes();
+            sequence = reader.getFrameCount();
+            recovered = reader.getDiscardedBytes();
+        } else if (!startsWithMagic(path)) {
+            errorMessage = reader.getLastError();
+            return false;
+        }
+        // 有魔数但文件头不完整：创建途中中断留下的，按新文件重写
+    }
+
+    int fd = openLogFile(path);
+    if (fd < 0) {
+        errorMessage = "无法打开录制日志: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    if (!seekToEnd(fd, appendAt)) {
+        errorMessage = "无法截断录制日志: " + path;
+        closeLogFile(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_path = path;
+    m_options = options;
+    m_options.batchRows = std::min<size_t>(std::max<size_t>(1, m_options.batchRows), 1 << 20);
+    m_fieldCount = fieldNames.size();
+    m_pending.assign(m_fieldCount, std::vector<double>());
+    for (std::vector<double>& column : m_pending) {
+        column.reserve(m_options.batchRows);
+    }
+    m_pendingRows = 0;
+    m_sequence = sequence;
+    m_unsyncedBytes = 0;
+    m_lastSync = Clock::now();
+    m_stats = Stats();
+    m_stats.recoveredBytes = recovered;
+    m_lastError.clear();
+    m_writeFailed = false;
+    m_syncRequested = false;
+
+    if (appendAt == 0) {
+        if (!writeAllLocked(buildFileHeader(fieldNames)) || !syncLocked()) {
+            errorMessage = m_lastError;
+            closeLogFile(m_fd);
+            m_fd = -1;
+            return false;
+        }
+        syncParentDirectory(path);
+    }
+
+    // 批次超时与组提交同步超时中较短的一个作为后台检查周期
+    int periodMs = std::max(1, m_options.flushIntervalMs);
+    if (m_options.syncPolicy == SyncPolicy::GroupCommit) {
+        periodMs = std::min(periodMs, std::max(1, m_options.syncIntervalMs));
+    }
+    m_stopFlush = false;
+    m_flushThread = std::thread(&RecordingLogWriter::flushThread, this, std::chrono::milliseconds(periodMs));
+    return true;
+}
+
+bool RecordingLogWriter::close() {
+    stopFlushThread();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd < 0) {
+        return true;
+    }
+
+    bool success = (m_pendingRows == 0 || writeFrameLocked()) && syncLocked();
+    closeLogFile(m_fd);
+    m_fd = -1;
+    return success;
+}
+
+bool RecordingLogWriter::isOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fd >= 0;
+}
+
+bool RecordingLogWriter::appendRow(const double* values) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd < 0 || m_writeFailed) {
+        return false;
+    }
+
+    if (m_pendingRows == 0) {
+        m_pendingSince = Clock::now();
+    }
+    for (size_t j = 0; j < m_fieldCount; ++j) {
+        m_pending[j].push_back(values[j]);
+    }
+    m_pendingRows++;
+    m_stats.rowsAppended++;
+
+    if (m_pendingRows >= m_options.batchRows ||
+        Clock::now() - m_pendingSince >= std::chrono::milliseconds(m_options.flushIntervalMs)) {
+        return writeFrameLocked();
+    }
+    return true;
+}
+
+bool RecordingLogWriter::flush(bool sync) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fd < 0) {
+        return false;
+    }
+    if (m_pendingRows > 0 && !writeFrameLocked()) {
+        return false;
+    }
+    return !sync || syncLocked();
+}
+
+void RecordingLogWriter::flushThread(std::chrono::milliseconds period) {
+    Tracer::getInstance().setThreadName("wal-flush");
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopFlush) {
+        m_flushCondition.wait_for(lock, period, [this] { return m_stopFlush || m_syncRequested; });
+        if (m_stopFlush) {
+            break;
+        }
+        if (m_writeFailed) {
+            m_syncRequested = false;
+            continue;
+        }
+        if (!flushDueLocked() || !syncIfDue(lock)) {
+            m_writeFailed = true;
+        }
+    }
+}
+
+bool RecordingLogWriter::flushDueLocked() {
+    if (m_fd < 0) {
+        return true;
+    }
+
+    if (m_pendingRows > 0 &&
+        Clock::now() - m_pendingSince >= std::chrono::milliseconds(m_options.flushIntervalMs)) {
+        return writeFrameLocked();
+    }
+    return true;
+}
+
+bool RecordingLogWriter::syncIfDue(std::unique_lock<std::mutex>& lock) {
+    bool requested = m_syncRequested;
+    m_syncRequested = false;
+    if (m_fd < 0 || m_unsyncedBytes == 0) {
+        return true;
+    }
+    bool due = requested ||
+               (m_options.syncPolicy == SyncPolicy::GroupCommit &&
+                Clock::now() - m_lastSync >= std::chrono::milliseconds(m_options.syncIntervalMs));
+    if (!due) {
+        return true;
+    }
+
+    // 同步期间不持锁，采集线程可以继续追加和写帧；同步中写入的字节留到下一次
+    int fd = m_fd;
+    uint64_t bytes = m_unsyncedBytes;
+    lock.unlock();
+    Clock::time_point start = Clock::now();
+    bool synced;
+    int error;
+    {
+        TRACE_SCOPE("data", "RecordingLogWriter::sync");
+        synced = syncFile(fd);
+        error = errno;
+    }
+    Clock::time_point end = Clock::now();
+    lock.lock();
+
+    if (!synced) {
+        m_lastError = "同步录制日志失败: " + m_path + " (" + std::strerror(error) + ")";
+        return false;
+    }
+    m_unsyncedBytes -= std::min(bytes, m_unsyncedBytes);
+    recordSyncLocked(start, end);
+    return true;
+}
+
+void RecordingLogWriter::stopFlushThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlush = true;
+    }
+    m_flushCondition.notify_all();
+    if (m_flushThread.joinable()) {
+        m_flushThread.join();
+    }
+}
+
+bool RecordingLogWriter::writeFrameLocked() {
+    TRACE_SCOPE("data", "RecordingLogWriter::writeFrame");
+
+    uint32_t rows = static_cast<uint32_t>(m_pendingRows);
+    size_t payloadSize = m_fieldCount * m_pendingRows * sizeof(double);
+
+    m_frame.clear();
+    m_frame.reserve(FRAME_HEADER_SIZE + payloadSize);
+    m_frame.resize(FRAME_HEADER_SIZE);
+    for (size_t j = 0; j < m_fieldCount; ++j) {
+        m_frame.append(reinterpret_cast<const char*>(m_pending[j].data()), m_pendingRows * sizeof(double));
+        m_pending[j].clear();
+    }
+    m_pendingRows = 0;
+
+    std::string header;
+    putU32(header, FRAME_MARKER);
+    putU32(header, rows);
+    putU64(header, m_sequence);
+    putU32(header, static_cast<uint32_t>(payloadSize));
+    putU32(header, Crc32::compute(m_frame.data() + FRAME_HEADER_SIZE, payloadSize));
+    putU32(header, Crc32::compute(header.data(), FRAME_HEADER_CHECKED));
+    putU32(header, 0);
+    m_frame.replace(0, FRAME_HEADER_SIZE, header);
+
+    if (!writeAllLocked(m_frame)) {
+        return false;
+    }
+    m_sequence++;
+    m_stats.framesWritten++;
+
+    // 写帧的线程（通常是采集线程）不做同步，按同步策略通知后台线程
+    bool syncNeeded = false;
+    switch (m_options.syncPolicy) {
+    case SyncPolicy::EveryBatch:
+        syncNeeded = true;
+        break;
+    case SyncPolicy::GroupCommit:
+        syncNeeded = m_unsyncedBytes >= m_options.syncBytes ||
+                     Clock::now() - m_lastSync >= std::chrono::milliseconds(m_options.syncIntervalMs);
+        break;
+    default:
+        break;
+    }
+    if (syncNeeded && !m_syncRequested) {
+        m_syncRequested = true;
+        m_flushCondition.notify_one();
+    }
+    return true;
+}
+
+bool RecordingLogWriter::writeAllLocked(const std::string& data) {
+    const char* cursor = data.data();
+    size_t remaining = data.size();
+    while (remaining > 0) {
+        long long written = writeSome(m_fd, cursor, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            m_lastError = "写入录制日志失败: " + m_path + " (" + std::strerror(errno) + ")";
+            return false;
+        }
+        cursor += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    m_unsyncedBytes += data.size();
+    m_stats.bytesWritten += data.size();
+    return true;
+}
+
+bool RecordingLogWriter::syncLocked() {
+    if (m_unsyncedBytes == 0) {
+        return true;
+    }
+
+    TRACE_SCOPE("data", "RecordingLogWriter::sync");
+    Clock::time_point start = Clock::now();
+    if (!syncFile(m_fd)) {
+        m_lastError = "同步录制日志失败: " + m_path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    m_unsyncedBytes = 0;
+    recordSyncLocked(start, Clock::now());
+    return true;
+}
+
+void RecordingLogWriter::recordSyncLocked(Clock::time_point start, Clock::time_point end) {
+    m_lastSync = end;
+    double elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    m_stats.syncCount++;
+    m_stats.totalSyncMs += elapsedMs;
+    m_stats.maxSyncMs = std::max(m_stats.maxSyncMs, elapsedMs);
+}
+
+RecordingLogWriter::Stats RecordingLogWriter::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+std::string RecordingLogWriter::getLastError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
+
+// ==================== RecordingLogReader ====================
+
+RecordingLogReader::RecordingLogReader()
+    : m_rowCount(0), m_validBytes(0) {
+}
+
+RecordingLogReader::~RecordingLogReader() {
+    close();
+}
+
+bool RecordingLogReader::open(const std::string& path) {
+    close();
+    if (!isLittleEndianHost()) {
+        m_lastError = "录制日志要求小端平台";
+        return false;
+    }
+    if (!m_file.open(path)) {
+        m_lastError = m_file.getLastError();
+        return false;
+    }
+
+    const char* data = m_file.data();
+    size_t size = m_file.size();
+    const size_t prefixSize = sizeof(RecordingLogWriter::MAGIC) + 8;
+    if (size < prefixSize || std::memcmp(data, RecordingLogWriter::MAGIC, sizeof(RecordingLogWriter::MAGIC)) != 0) {
+        m_lastError = "不是录制日志文件: " + path;
+        close();
+        return false;
+    }
+    if (getU32(data + 8) != RecordingLogWriter::VERSION) {
+        m_lastError = "不支持的录制日志版本: " + path;
+        close();
+        return false;
+    }
+
+    // 字段表
+    uint32_t fieldCount = getU32(data + 12);
+    size_t position = prefixSize;
+    for (uint32_t j = 0; j < fieldCount; ++j) {
+        if (position + 4 > size || getU32(data + position) > size - position - 4) {
+            m_lastError = "录制日志文件头不完整: " + path;
+            close();
+            return false;
+        }
+        uint32_t length = getU32(data + position);
+        m_fieldNames.push_back(std::string(data + position + 4, length));
+        position += 4 + length;
+    }
+    position = alignUp(position, 8);
+    if (fieldCount == 0 || position + 8 > size ||
+        getU32(data + position) != Crc32::compute(data, position)) {
+        m_lastError = "录制日志文件头损坏: " + path;
+        close();
+        return false;
+    }
+    position += 8;
+    m_validBytes = position;
+
+    // 逐帧校验，在第一个无效帧处停止
+    while (position + FRAME_HEADER_SIZE <= size) {
+        const char* header = data + position;
+        uint32_t rows = getU32(header + 4);
+        uint64_t payloadSize = getU32(header + 16);
+        if (getU32(header) != FRAME_MARKER ||
+            getU32(header + 24) != Crc32::compute(header, FRAME_HEADER_CHECKED) ||
+            getU64(header + 8) != m_frames.size() ||
+            payloadSize > MAX_FRAME_PAYLOAD ||
+            payloadSize != static_cast<uint64_t>(rows) * fieldCount * sizeof(double) ||
+            payloadSize > size - position - FRAME_HEADER_SIZE) {
+            break;
+        }
+        const char* payload = header + FRAME_HEADER_SIZE;
+        if (getU32(header + 20) != Crc32::compute(payload, static_cast<size_t>(payloadSize))) {
+            break;
+        }
+
+        Frame frame;
+        frame.payloadOffset = position + FRAME_HEADER_SIZE;
+        frame.rows = rows;
+        m_frames.push_back(frame);
+        m_rowCount += rows;
+        position += FRAME_HEADER_SIZE + static_cast<size_t>(payloadSize);
+        m_validBytes = position;
+    }
+
+    m_lastError.clear();
+    return true;
+}
+
+void RecordingLogReader::close() {
+    m_file.close();
+    m_fieldNames.clear();
+    m_frames.clear();
+    m_rowCount = 0;
+    m_validBytes = 0;
+}
+
+const double* RecordingLogReader::getColumn(size_t frame, size_t field) const {
+    const Frame& info = m_frames[frame];
+    // 文件头和帧头都按8字节对齐，映射起点按页对齐，载荷可以直接按 double 读取
+    return reinterpret_cast<const double*>(m_file.data() + info.payloadOffset) +
+           static_cast<size_t>(info.rows) * field;
+}
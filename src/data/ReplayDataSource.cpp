@@ -0,0 +1,242 @@
+#include "ReplayDataSource.h"
+#include "utils/Tracer.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+// 待取缓冲的最大行数，消费端长时间不取时丢弃较旧的一半
+static const size_t MAX_PENDING_ROWS = static_cast<size_t>(1) << 20;
+
+ReplayDataSource::ReplayDataSource()
+    : m_dataModel(std::make_shared<DataModel>()), m_state(State::Stopped), m_hasNewData(false),
+      m_stopRequested(false), m_totalRows(0), m_discardedBytes(0), m_rowsReplayed(0),
+      m_framesReplayed(0), m_droppedRows(0), m_finished(false) {
+}
+
+ReplayDataSource::~ReplayDataSource() {
+    stop();
+}
+
+bool ReplayDataSource::initialize(const std::string& config) {
+    m_filename = config;
+    m_state = State::Stopped;
+    m_cancelRequested.store(false);
+    return true;
+}
+
+bool ReplayDataSource::start() {
+    TRACE_SCOPE("data", "ReplayDataSource::start");
+    stop();
+
+    if (m_filename.empty()) {
+        if (m_errorCallback) {
+            m_errorCallback("文件名不能为空");
+        }
+        return false;
+    }
+    if (!m_reader.open(m_filename)) {
+        m_state = State::Error;
+        if (m_errorCallback) {
+            m_errorCallback("无法打开录制日志: " + m_reader.getLastError());
+        }
+        return false;
+    }
+
+    m_fieldNames = m_reader.getFieldNames();
+    m_dataModel = std::make_shared<DataModel>();
+    for (const std::string& field : m_fieldNames) {
+        m_dataModel->addField(field);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingColumns.assign(m_fieldNames.size(), std::vector<double>());
+        m_lastRow.clear();
+        m_totalRows = m_reader.getRowCount();
+        m_discardedBytes = m_reader.getDiscardedBytes();
+        m_rowsReplayed = 0;
+        m_framesReplayed = 0;
+        m_droppedRows = 0;
+        m_finished = false;
+        m_startTime = Clock::now();
+    }
+    m_stopRequested = false;
+    m_hasNewData = false;
+    m_state = State::Running;
+    m_thread = std::thread(&ReplayDataSource::replayThread, this);
+
+    std::cout << "开始回放录制日志: " << m_reader.getRowCount() << " 行, "
+              << m_reader.getFrameCount() << " 帧";
+    if (m_reader.getDiscardedBytes() > 0) {
+        std::cout << ", 末尾忽略 " << m_reader.getDiscardedBytes() << " 字节损坏数据";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+void ReplayDataSource::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_threadMutex);
+        m_stopRequested = true;
+    }
+    m_threadCond.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_reader.close();
+    m_state = State::Stopped;
+}
+
+bool ReplayDataSource::waitUntil(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_threadMutex);
+    m_threadCond.wait_until(lock, deadline, [this]() { return m_stopRequested; });
+    return !m_stopRequested;
+}
+
+void ReplayDataSource::replayThread() {
+    Tracer::getInstance().setThreadName("replay");
+
+    double speed = m_config.speed > 0.0 ? m_config.speed : 0.0;
+    Clock::time_point wallStart = Clock::now();
+    double firstTime = 0.0;
+    bool haveFirstTime = false;
+
+    for (size_t frame = 0; frame < m_reader.getFrameCount(); ++frame) {
+        size_t rows = m_reader.getFrameRows(frame);
+        const double* times = m_reader.getColumn(frame, 0);
+
+        size_t row = 0;
+        while (row < rows) {
+            size_t end = rows;
+            if (speed > 0.0) {
+                // 追加所有已到回放时刻的行；下一行未到时等待
+                if (!haveFirstTime && std::isfinite(times[row])) {
+                    firstTime = times[row];
+                    haveFirstTime = true;
+                }
+                Clock::time_point now = Clock::now();
+                Clock::time_point due = now;
+                end = row;
+                while (end < rows) {
+                    double offset = std::isfinite(times[end]) ? (times[end] - firstTime) / speed : 0.0;
+                    due = wallStart + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(std::max(0.0, offset)));
+                    if (due > now) {
+                        break;
+                    }
+                    ++end;
+                }
+                if (end == row) {
+                    if (!waitUntil(due)) {
+                        return;
+                    }
+                    continue;
+                }
+            } else {
+                std::lock_guard<std::mutex> lock(m_threadMutex);
+                if (m_stopRequested) {
+                    return;
+                }
+            }
+
+            appendRows(frame, row, end);
+            row = end;
+        }
+
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_framesReplayed++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_finished = true;
+        m_endTime = Clock::now();
+    }
+    m_state = State::Stopped;
+    if (m_dataReadyCallback) {
+        m_dataReadyCallback();
+    }
+    std::cout << "录制日志回放结束" << std::endl;
+}
+
+void ReplayDataSource::appendRows(size_t frame, size_t first, size_t last) {
+    TRACE_SCOPE("data", "ReplayDataSource::appendRows");
+
+    size_t fieldCount = m_fieldNames.size();
+    std::vector<const double*> columns(fieldCount);
+    for (size_t j = 0; j < fieldCount; ++j) {
+        columns[j] = m_reader.getColumn(frame, j);
+    }
+
+    std::vector<double> row(fieldCount);
+    for (size_t i = first; i < last; ++i) {
+        for (size_t j = 0; j < fieldCount; ++j) {
+            row[j] = columns[j][i];
+        }
+        m_dataModel->addDataPoint(m_fieldNames.data(), row.data(), nullptr, fieldCount);
+    }
+
+    // 限制缓冲区大小：只移动列视图起点，不复制
+    if (m_config.bufferSize > 0 && m_dataModel->size() > m_config.bufferSize) {
+        m_dataModel->removeFront(m_dataModel->size() - m_config.bufferSize);
+    }
+    m_dataModel->publish();
+
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        size_t count = last - first;
+        if (!m_pendingColumns.empty() && m_pendingColumns[0].size() + count > MAX_PENDING_ROWS) {
+            size_t dropCount = m_pendingColumns[0].size() / 2;
+            for (std::vector<double>& pending : m_pendingColumns) {
+                pending.erase(pending.begin(), pending.begin() + dropCount);
+            }
+            m_droppedRows += dropCount;
+        }
+        for (size_t j = 0; j < fieldCount; ++j) {
+            m_pendingColumns[j].insert(m_pendingColumns[j].end(), columns[j] + first, columns[j] + last);
+        }
+        m_lastRow = row;
+        m_rowsReplayed += count;
+    }
+
+    m_hasNewData = true;
+    if (m_dataReadyCallback) {
+        m_dataReadyCallback();
+    }
+}
+
+std::vector<double> ReplayDataSource::getData() {
+    m_hasNewData = false;
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    return m_lastRow;
+}
+
+size_t ReplayDataSource::takePendingRows(std::vector<std::vector<double> >& columns) {
+    for (std::vector<double>& column : columns) {
+        column.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    columns.resize(m_pendingColumns.size());
+    for (size_t j = 0; j < m_pendingColumns.size(); ++j) {
+        columns[j].swap(m_pendingColumns[j]);
+    }
+    return columns.empty() ? 0 : columns[0].size();
+}
+
+ReplayDataSource::ReplayStats ReplayDataSource::getStatistics() const {
+    ReplayStats stats;
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    stats.totalRows = m_totalRows;
+    stats.discardedBytes = m_discardedBytes;
+    stats.rowsReplayed = m_rowsReplayed;
+    stats.framesReplayed = m_framesReplayed;
+    stats.droppedRows = m_droppedRows;
+    stats.finished = m_finished;
+    stats.elapsedSeconds = std::chrono::duration<double>(
+        (m_finished ? m_endTime : Clock::now()) - m_startTime).count();
+    if (stats.elapsedSeconds > 0.0) {
+        stats.rowsPerSecond = m_rowsReplayed / stats.elapsedSeconds;
+    }
+    return stats;
+}
@@ -0,0 +1,893 @@
+#include "SocketDataSource.h"
+#include "utils/Tracer.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+const uint32_t SocketDataSource::FRAME_MAGIC;
+const size_t SocketDataSource::FRAME_HEADER_SIZE;
+const size_t SocketDataSource::MAX_FRAME_PAYLOAD;
+
+// 最大数据报长度（UDP 载荷上限）
+static const size_t MAX_DATAGRAM = 65536;
+// 流式连接每次读取的字节数
+static const size_t STREAM_READ_SIZE = 256 * 1024;
+// 待取缓冲的最大行数，消费端长时间不取时丢弃较旧的一半
+static const size_t MAX_PENDING_ROWS = static_cast<size_t>(1) << 20;
+// 序号落后超过这么多时视为发送端重启，重新开始跟踪
+static const int32_t SEQUENCE_RESTART_GAP = 1 << 16;
+// 一轮最多连续读取的次数，避免持续高负载时迟迟不发布
+static const int MAX_READS_PER_ROUND = 16;
+
+// ==================== 小端序列化工具 ====================
+
+static bool isLittleEndianHost() {
+    uint16_t value = 1;
+    return *reinterpret_cast<const uint8_t*>(&value) == 1;
+}
+
+static uint16_t loadU16(const char* data) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t loadU32(const char* data) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+static void putU16(std::string& buffer, uint16_t value) {
+    buffer.push_back(static_cast<char>(value & 0xFF));
+    buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+static void putU32(std::string& buffer, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+// 按小端读取 count 个 double
+static void loadDoubles(const char* data, double* values, size_t count) {
+    std::memcpy(values, data, count * sizeof(double));
+    if (!isLittleEndianHost()) {
+        for (size_t i = 0; i < count; ++i) {
+            char* bytes = reinterpret_cast<char*>(&values[i]);
+            std::reverse(bytes, bytes + sizeof(double));
+        }
+    }
+}
+
+static uint64_t hashBytes(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::vector<std::string> splitString(const std::string& text, char delimiter) {
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, delimiter)) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+// ==================== SocketDataSource ====================
+
+SocketDataSource::SocketDataSource()
+    : m_dataModel(std::make_shared<DataModel>()), m_state(State::Stopped), m_hasNewData(false),
+      m_boundPort(0), m_unlinkPath(false), m_stopRequested(false), m_socketFd(-1), m_pollFd(-1),
+      m_batchRows(0) {
+    m_wakePipe[0] = -1;
+    m_wakePipe[1] = -1;
+}
+
+SocketDataSource::~SocketDataSource() {
+    stop();
+}
+
+bool SocketDataSource::parseConfig(const std::string& text, SocketConfig& config, std::string& errorMessage) {
+    std::vector<std::string> items = splitString(text, ';');
+    for (size_t i = 0; i < items.size(); ++i) {
+        size_t separator = items[i].find('=');
+        if (separator == std::string::npos) {
+            errorMessage = "无效的配置项: " + items[i];
+            return false;
+        }
+        std::string key = items[i].substr(0, separator);
+        std::string value = items[i].substr(separator + 1);
+        char* end = nullptr;
+        long number = std::strtol(value.c_str(), &end, 10);
+        bool isNumber = !value.empty() && *end == '\0' && number >= 0;
+
+        if (key == "transport") {
+            if (value == "udp") {
+                config.transport = Transport::Udp;
+            } else if (value == "tcp") {
+                config.transport = Transport::Tcp;
+            } else if (value == "unix") {
+                config.transport = Transport::Unix;
+            } else if (value == "unixgram") {
+                config.transport = Transport::UnixDatagram;
+            } else {
+                errorMessage = "不支持的传输方式: " + value;
+                return false;
+            }
+        } else if (key == "address") {
+            config.address = value;
+        } else if (key == "format") {
+            if (value == "binary") {
+                config.format = Format::Binary;
+            } else if (value == "text") {
+                config.format = Format::Text;
+            } else {
+                errorMessage = "不支持的数据格式: " + value;
+                return false;
+            }
+        } else if (key == "fields") {
+            config.fieldNames = splitString(value, ',');
+        } else if (key == "port" && isNumber && number <= 65535) {
+            config.port = static_cast<int>(number);
+        } else if (key == "buffer" && isNumber) {
+            config.bufferSize = static_cast<size_t>(number);
+        } else if (key == "batch" && isNumber && number > 0) {
+            config.batchSize = std::min(static_cast<size_t>(number), static_cast<size_t>(1024));
+        } else if (key == "rcvbuf" && isNumber) {
+            config.receiveBufferBytes = static_cast<int>(std::min(number, 1L << 30));
+        } else {
+            errorMessage = "无效的配置项: " + items[i];
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SocketDataSource::initialize(const std::string& config) {
+    SocketConfig parsed;
+    std::string errorMessage;
+    if (!parseConfig(config, parsed, errorMessage)) {
+        if (m_errorCallback) {
+            m_errorCallback(errorMessage);
+        }
+        return false;
+    }
+    m_config = parsed;
+    m_state = State::Stopped;
+    m_cancelRequested.store(false);
+    return true;
+}
+
+void SocketDataSource::encodeFrame(uint32_t sequence, const double* values, size_t rowCount, size_t fieldCount,
+                                   std::string& out) {
+    putU32(out, FRAME_MAGIC);
+    putU32(out, sequence);
+    putU16(out, static_cast<uint16_t>(fieldCount));
+    putU16(out, static_cast<uint16_t>(rowCount));
+    putU32(out, 0);
+    size_t offset = out.size();
+    size_t count = rowCount * fieldCount;
+    out.resize(offset + count * sizeof(double));
+    std::memcpy(&out[offset], values, count * sizeof(double));
+    if (!isLittleEndianHost()) {
+        for (size_t i = 0; i < count; ++i) {
+            char* bytes = &out[offset + i * sizeof(double)];
+            std::reverse(bytes, bytes + sizeof(double));
+        }
+    }
+}
+
+#ifdef _WIN32
+
+bool SocketDataSource::openSocket(std::string& errorMessage) {
+    errorMessage = "当前平台不支持套接字数据源";
+    return false;
+}
+
+void SocketDataSource::closeSockets() {
+}
+
+void SocketDataSource::receiveThread() {
+}
+
+void SocketDataSource::acceptConnections() {
+}
+
+void SocketDataSource::receiveDatagrams() {
+}
+
+bool SocketDataSource::receiveStream(Connection&) {
+    return false;
+}
+
+#else
+
+static bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// 把 fd 加入等待集合；Linux 上为 epoll，其他平台在每轮 poll 前重新收集
+static bool watchDescriptor(int pollFd, int fd) {
+#ifdef __linux__
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    return epoll_ctl(pollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+#else
+    (void)pollFd;
+    (void)fd;
+    return true;
+#endif
+}
+
+bool SocketDataSource::openSocket(std::string& errorMessage) {
+    bool isUnix = m_config.transport == Transport::Unix || m_config.transport == Transport::UnixDatagram;
+    bool isStream = m_config.transport == Transport::Tcp || m_config.transport == Transport::Unix;
+    int socketType = isStream ? SOCK_STREAM : SOCK_DGRAM;
+
+    if (isUnix) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (m_config.address.empty() || m_config.address.size() >= sizeof(address.sun_path)) {
+            errorMessage = "无效的 Unix 套接字路径: " + m_config.address;
+            return false;
+        }
+        std::memcpy(address.sun_path, m_config.address.c_str(), m_config.address.size());
+
+        // 上次运行遗留的套接字文件会让 bind 失败；只删除套接字，不删除普通文件
+        struct stat info;
+        if (lstat(m_config.address.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+            unlink(m_config.address.c_str());
+        }
+
+        m_socketFd = socket(AF_UNIX, socketType, 0);
+        if (m_socketFd < 0 || bind(m_socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            errorMessage = "无法绑定 Unix 套接字 " + m_config.address + ": " + std::strerror(errno);
+            return false;
+        }
+        m_unlinkPath = true;
+    } else {
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = socketType;
+        hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+        addrinfo* result = nullptr;
+        std::string port = std::to_string(m_config.port);
+        int status = getaddrinfo(m_config.address.empty() ? nullptr : m_config.address.c_str(), port.c_str(),
+                                 &hints, &result);
+        if (status != 0 || !result) {
+            errorMessage = "无法解析地址 " + m_config.address + ": " + gai_strerror(status);
+            return false;
+        }
+
+        m_socketFd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        int reuse = 1;
+        if (m_socketFd >= 0 && isStream) {
+            setsockopt(m_socketFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        }
+        bool bound = m_socketFd >= 0 && bind(m_socketFd, result->ai_addr, result->ai_addrlen) == 0;
+        int bindError = errno;
+        freeaddrinfo(result);
+        if (!bound) {
+            errorMessage = "无法绑定 " + m_config.address + ":" + port + ": " + std::strerror(bindError);
+            return false;
+        }
+
+        sockaddr_storage local;
+        socklen_t localLength = sizeof(local);
+        if (getsockname(m_socketFd, reinterpret_cast<sockaddr*>(&local), &localLength) == 0) {
+            if (local.ss_family == AF_INET) {
+                m_boundPort = ntohs(reinterpret_cast<sockaddr_in*>(&local)->sin_port);
+            } else if (local.ss_family == AF_INET6) {
+                m_boundPort = ntohs(reinterpret_cast<sockaddr_in6*>(&local)->sin6_port);
+            }
+        }
+    }
+
+    if (!isStream && m_config.receiveBufferBytes > 0) {
+        // 接收缓冲决定了接收线程短暂停顿时能吸收多少数据报
+        setsockopt(m_socketFd, SOL_SOCKET, SO_RCVBUF, &m_config.receiveBufferBytes,
+                   sizeof(m_config.receiveBufferBytes));
+    }
+    if (isStream && listen(m_socketFd, 16) != 0) {
+        errorMessage = std::string("无法监听: ") + std::strerror(errno);
+        return false;
+    }
+    if (!setNonBlocking(m_socketFd) || pipe(m_wakePipe) != 0) {
+        errorMessage = std::string("无法初始化套接字: ") + std::strerror(errno);
+        return false;
+    }
+
+#ifdef __linux__
+    m_pollFd = epoll_create1(0);
+    if (m_pollFd < 0) {
+        errorMessage = std::string("无法创建 epoll: ") + std::strerror(errno);
+        return false;
+    }
+#endif
+    if (!watchDescriptor(m_pollFd, m_wakePipe[0]) || !watchDescriptor(m_pollFd, m_socketFd)) {
+        errorMessage = std::string("无法等待套接字事件: ") + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+void SocketDataSource::closeSockets() {
+    for (std::map<int, std::unique_ptr<Connection> >::iterator it = m_connections.begin();
+         it != m_connections.end(); ++it) {
+        close(it->first);
+    }
+    m_connections.clear();
+
+    int* descriptors[] = { &m_socketFd, &m_pollFd, &m_wakePipe[0], &m_wakePipe[1] };
+    for (int* fd : descriptors) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    if (m_unlinkPath) {
+        unlink(m_config.address.c_str());
+        m_unlinkPath = false;
+    }
+}
+
+void SocketDataSource::receiveThread() {
+    Tracer::getInstance().setThreadName("socket-ingest");
+    bool isStream = m_config.transport == Transport::Tcp || m_config.transport == Transport::Unix;
+
+    std::vector<int> ready;
+#ifdef __linux__
+    std::vector<epoll_event> events(64);
+#else
+    std::vector<pollfd> descriptors;
+#endif
+
+    while (!m_stopRequested.load()) {
+        ready.clear();
+#ifdef __linux__
+        int count = epoll_wait(m_pollFd, events.data(), static_cast<int>(events.size()), -1);
+        for (int i = 0; i < count; ++i) {
+            ready.push_back(events[i].data.fd);
+        }
+#else
+        descriptors.clear();
+        pollfd entry;
+        entry.events = POLLIN;
+        entry.revents = 0;
+        entry.fd = m_wakePipe[0];
+        descriptors.push_back(entry);
+        entry.fd = m_socketFd;
+        descriptors.push_back(entry);
+        for (std::map<int, std::unique_ptr<Connection> >::iterator it = m_connections.begin();
+             it != m_connections.end(); ++it) {
+            entry.fd = it->first;
+            descriptors.push_back(entry);
+        }
+        int count = poll(descriptors.data(), descriptors.size(), -1);
+        for (size_t i = 0; count > 0 && i < descriptors.size(); ++i) {
+            if (descriptors[i].revents != 0) {
+                ready.push_back(descriptors[i].fd);
+            }
+        }
+#endif
+        if (count < 0 && errno != EINTR) {
+            m_state = State::Error;
+            if (m_errorCallback) {
+                m_errorCallback(std::string("等待套接字事件失败: ") + std::strerror(errno));
+            }
+            break;
+        }
+
+        TRACE_SCOPE("data", "SocketDataSource::receive");
+        for (size_t i = 0; i < ready.size(); ++i) {
+            int fd = ready[i];
+            if (fd == m_wakePipe[0]) {
+                continue;
+            }
+            if (fd == m_socketFd) {
+                if (isStream) {
+                    acceptConnections();
+                } else {
+                    receiveDatagrams();
+                }
+                continue;
+            }
+            std::map<int, std::unique_ptr<Connection> >::iterator it = m_connections.find(fd);
+            if (it != m_connections.end() && !receiveStream(*it->second)) {
+                close(fd);
+                m_connections.erase(it);
+            }
+        }
+        m_threadStats.activeConnections = m_connections.size();
+        finishBatch();
+    }
+}
+
+void SocketDataSource::acceptConnections() {
+    while (true) {
+        int fd = accept(m_socketFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        if (!setNonBlocking(fd) || !watchDescriptor(m_pollFd, fd)) {
+            close(fd);
+            continue;
+        }
+        std::unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        connection->buffer.resize(STREAM_READ_SIZE);
+        m_connections[fd] = std::move(connection);
+        m_threadStats.connectionsAccepted++;
+    }
+}
+
+void SocketDataSource::receiveDatagrams() {
+    size_t batchSize = std::max(m_config.batchSize, static_cast<size_t>(1));
+    // 每个数据报多留一个字节，文本格式在末尾写入 '\0'
+    size_t slotSize = MAX_DATAGRAM + 1;
+    if (m_datagramBuffer.size() < batchSize * slotSize) {
+        m_datagramBuffer.resize(batchSize * slotSize);
+    }
+
+#ifdef __linux__
+    std::vector<mmsghdr> messages(batchSize);
+    std::vector<iovec> vectors(batchSize);
+    std::vector<sockaddr_storage> senders(batchSize);
+    for (int round = 0; round < MAX_READS_PER_ROUND; ++round) {
+        for (size_t i = 0; i < batchSize; ++i) {
+            vectors[i].iov_base = &m_datagramBuffer[i * slotSize];
+            vectors[i].iov_len = MAX_DATAGRAM;
+            std::memset(&messages[i].msg_hdr, 0, sizeof(messages[i].msg_hdr));
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_name = &senders[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+        }
+        int count = recvmmsg(m_socketFd, messages.data(), static_cast<unsigned int>(batchSize), MSG_DONTWAIT, nullptr);
+        if (count <= 0) {
+            return;
+        }
+        m_threadStats.receiveCalls++;
+        for (int i = 0; i < count; ++i) {
+            size_t size = messages[i].msg_len;
+            m_threadStats.packetsReceived++;
+            m_threadStats.bytesReceived += size;
+            if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                m_threadStats.malformedFrames++;
+                continue;
+            }
+            uint64_t sender = hashBytes(&senders[i], messages[i].msg_hdr.msg_namelen);
+            decodeDatagram(&m_datagramBuffer[i * slotSize], size, m_datagramSenders[sender]);
+        }
+        if (static_cast<size_t>(count) < batchSize) {
+            return;
+        }
+    }
+#else
+    for (int round = 0; round < MAX_READS_PER_ROUND * static_cast<int>(batchSize); ++round) {
+        sockaddr_storage sender;
+        socklen_t senderLength = sizeof(sender);
+        ssize_t size = recvfrom(m_socketFd, &m_datagramBuffer[0], MAX_DATAGRAM, 0,
+                                reinterpret_cast<sockaddr*>(&sender), &senderLength);
+        if (size < 0) {
+            return;
+        }
+        m_threadStats.receiveCalls++;
+        m_threadStats.packetsReceived++;
+        m_threadStats.bytesReceived += static_cast<uint64_t>(size);
+        decodeDatagram(&m_datagramBuffer[0], static_cast<size_t>(size),
+                       m_datagramSenders[hashBytes(&sender, senderLength)]);
+    }
+#endif
+}
+
+bool SocketDataSource::receiveStream(Connection& connection) {
+    for (int round = 0; round < MAX_READS_PER_ROUND; ++round) {
+        // 保证有一整块可读空间，并为文本格式的结尾 '\0' 多留一个字节
+        if (connection.buffer.size() - connection.used < STREAM_READ_SIZE + 1) {
+            connection.buffer.resize(connection.used + STREAM_READ_SIZE + 1);
+        }
+        ssize_t size = recv(connection.fd, &connection.buffer[connection.used], STREAM_READ_SIZE, 0);
+        if (size == 0) {
+            return false;
+        }
+        if (size < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        m_threadStats.receiveCalls++;
+        m_threadStats.packetsReceived++;
+        m_threadStats.bytesReceived += static_cast<uint64_t>(size);
+        connection.used += static_cast<size_t>(size);
+
+        long consumed = decodeStream(&connection.buffer[0], connection.used, connection.sequence);
+        if (consumed < 0) {
+            // 二进制流失去帧边界后无法重新同步，断开由发送端重连
+            return false;
+        }
+        if (consumed > 0) {
+            std::memmove(&connection.buffer[0], &connection.buffer[consumed], connection.used - consumed);
+            connection.used -= static_cast<size_t>(consumed);
+        } else if (connection.used > FRAME_HEADER_SIZE + MAX_FRAME_PAYLOAD) {
+            // 超长且没有换行的文本行
+            m_threadStats.malformedFrames++;
+            return false;
+        }
+        if (static_cast<size_t>(size) < STREAM_READ_SIZE) {
+            return true;
+        }
+    }
+    return true;
+}
+
+#endif // _WIN32
+
+bool SocketDataSource::start() {
+    TRACE_SCOPE("data", "SocketDataSource::start");
+    stop();
+
+    m_dataModel = std::make_shared<DataModel>();
+    m_modelFields.clear();
+    m_datagramSenders.clear();
+    m_batchColumns.clear();
+    m_batchRows = 0;
+    m_threadStats = SocketStats();
+    m_boundPort = m_config.port;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_fieldNames.clear();
+        m_pendingColumns.clear();
+        m_lastRow.clear();
+        m_stats = SocketStats();
+        m_startTime = Clock::now();
+    }
+    if (!m_config.fieldNames.empty()) {
+        ensureFields(m_config.fieldNames.size());
+    }
+    m_dataModel->publish();
+
+    std::string errorMessage;
+    if (!openSocket(errorMessage)) {
+        closeSockets();
+        m_state = State::Error;
+        if (m_errorCallback) {
+            m_errorCallback(errorMessage);
+        }
+        return false;
+    }
+
+    m_stopRequested = false;
+    m_hasNewData = false;
+    m_state = State::Running;
+    m_thread = std::thread(&SocketDataSource::receiveThread, this);
+
+    std::cout << "套接字数据源已启动: " << m_config.address;
+    if (m_boundPort.load() > 0) {
+        std::cout << ":" << m_boundPort.load();
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+void SocketDataSource::stop() {
+    m_stopRequested = true;
+    if (m_thread.joinable()) {
+#ifndef _WIN32
+        char wake = 0;
+        ssize_t written = write(m_wakePipe[1], &wake, 1);
+        (void)written;
+#endif
+        m_thread.join();
+    }
+    closeSockets();
+    if (m_state.load() == State::Running) {
+        m_state = State::Stopped;
+    }
+}
+
+void SocketDataSource::decodeDatagram(char* data, size_t size, SequenceState& sequence) {
+    if (m_config.format == Format::Text) {
+        // 数据报末尾的行可以没有换行符
+        data[size] = '\n';
+        long consumed = decodeStream(data, size + 1, sequence);
+        (void)consumed;
+        return;
+    }
+
+    size_t offset = 0;
+    while (offset < size) {
+        long frameSize = decodeFrame(data + offset, size - offset, sequence);
+        if (frameSize <= 0) {
+            // 数据报中不完整或损坏的帧：丢弃本数据报剩余部分
+            m_threadStats.malformedFrames++;
+            return;
+        }
+        offset += static_cast<size_t>(frameSize);
+    }
+}
+
+long SocketDataSource::decodeStream(char* data, size_t size, SequenceState& sequence) {
+    size_t offset = 0;
+    if (m_config.format == Format::Text) {
+        while (offset < size) {
+            char* begin = data + offset;
+            char* end = static_cast<char*>(std::memchr(begin, '\n', size - offset));
+            if (!end) {
+                break;
+            }
+            decodeLine(begin, end);
+            offset = static_cast<size_t>(end - data) + 1;
+        }
+        return static_cast<long>(offset);
+    }
+
+    while (offset < size) {
+        long frameSize = decodeFrame(data + offset, size - offset, sequence);
+        if (frameSize < 0) {
+            m_threadStats.malformedFrames++;
+            return -1;
+        }
+        if (frameSize == 0) {
+            break;
+        }
+        offset += static_cast<size_t>(frameSize);
+    }
+    return static_cast<long>(offset);
+}
+
+long SocketDataSource::decodeFrame(const char* data, size_t size, SequenceState& sequence) {
+    if (size < FRAME_HEADER_SIZE) {
+        return 0;
+    }
+    if (loadU32(data) != FRAME_MAGIC) {
+        return -1;
+    }
+    uint32_t frameSequence = loadU32(data + 4);
+    size_t fieldCount = loadU16(data + 8);
+    size_t rowCount = loadU16(data + 10);
+    size_t payloadSize = fieldCount * rowCount * sizeof(double);
+    if (fieldCount == 0 || payloadSize > MAX_FRAME_PAYLOAD) {
+        return -1;
+    }
+    if (size < FRAME_HEADER_SIZE + payloadSize) {
+        return 0;
+    }
+    long frameSize = static_cast<long>(FRAME_HEADER_SIZE + payloadSize);
+
+    if (!ensureFields(fieldCount)) {
+        m_threadStats.malformedFrames++;
+        return frameSize;
+    }
+    if (!acceptSequence(frameSequence, sequence)) {
+        return frameSize;
+    }
+
+    m_threadStats.framesDecoded++;
+    const char* payload = data + FRAME_HEADER_SIZE;
+    m_row.resize(fieldCount);
+    for (size_t row = 0; row < rowCount; ++row) {
+        loadDoubles(payload + row * fieldCount * sizeof(double), m_row.data(), fieldCount);
+        appendRow(m_row.data());
+    }
+    return frameSize;
+}
+
+void SocketDataSource::decodeLine(char* begin, char* end) {
+    if (end > begin && end[-1] == '\r') {
+        --end;
+    }
+    // strtod 需要以 '\0' 结尾，直接写在接收缓冲中原来的换行符位置
+    *end = '\0';
+
+    m_row.clear();
+    char* cursor = begin;
+    while (cursor < end) {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == ',' || *cursor == ';')) {
+            ++cursor;
+        }
+        if (cursor >= end) {
+            break;
+        }
+        char* parsedEnd = nullptr;
+        double value = std::strtod(cursor, &parsedEnd);
+        if (parsedEnd == cursor || (parsedEnd < end && *parsedEnd != ' ' && *parsedEnd != '\t' &&
+                                    *parsedEnd != ',' && *parsedEnd != ';')) {
+            m_threadStats.malformedFrames++;
+            return;
+        }
+        m_row.push_back(value);
+        cursor = parsedEnd;
+    }
+    if (m_row.empty()) {
+        return;
+    }
+    if (!ensureFields(m_row.size())) {
+        m_threadStats.malformedFrames++;
+        return;
+    }
+    m_threadStats.framesDecoded++;
+    appendRow(m_row.data());
+}
+
+bool SocketDataSource::acceptSequence(uint32_t sequence, SequenceState& state) {
+    if (!state.started) {
+        state.started = true;
+        state.next = sequence + 1;
+        state.seen = 1;
+        return true;
+    }
+
+    int32_t delta = static_cast<int32_t>(sequence - state.next);
+    if (delta >= 0) {
+        // 按序到达或跳过了 delta 个帧
+        m_threadStats.framesLost += static_cast<uint64_t>(delta);
+        // delta 最大为 INT32_MAX，先按无符号比较再移位，避免 delta + 1 溢出
+        uint32_t shift = static_cast<uint32_t>(delta) + 1;
+        state.seen = shift >= 64 ? 1 : ((state.seen << shift) | 1);
+        state.next = sequence + 1;
+        return true;
+    }
+    if (delta < -SEQUENCE_RESTART_GAP) {
+        // 发送端重启后序号从头开始
+        state = SequenceState();
+        return acceptSequence(sequence, state);
+    }
+
+    // 迟到的帧：在最近 64 个序号的窗口内可以区分乱序与重复，窗口外的只计乱序
+    uint32_t back = static_cast<uint32_t>(-delta - 1);
+    if (back < 64) {
+        uint64_t bit = static_cast<uint64_t>(1) << back;
+        if (state.seen & bit) {
+            m_threadStats.framesDuplicate++;
+            return false;
+        }
+        state.seen |= bit;
+        if (m_threadStats.framesLost > 0) {
+            m_threadStats.framesLost--;
+        }
+    }
+    m_threadStats.framesOutOfOrder++;
+    return true;
+}
+
+bool SocketDataSource::ensureFields(size_t fieldCount) {
+    if (!m_modelFields.empty()) {
+        return m_modelFields.size() == fieldCount;
+    }
+
+    std::vector<std::string> names = m_config.fieldNames;
+    if (names.empty()) {
+        names.push_back("time");
+        for (size_t i = 1; i < fieldCount; ++i) {
+            names.push_back(fieldCount == 2 ? std::string("value") : "value" + std::to_string(i));
+        }
+    }
+    if (names.size() != fieldCount) {
+        return false;
+    }
+
+    m_modelFields = names;
+    for (const std::string& name : m_modelFields) {
+        m_dataModel->addField(name);
+    }
+    m_batchColumns.assign(fieldCount, std::vector<double>());
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_fieldNames = m_modelFields;
+    m_pendingColumns.assign(fieldCount, std::vector<double>());
+    return true;
+}
+
+void SocketDataSource::appendRow(const double* values) {
+    size_t fieldCount = m_modelFields.size();
+    m_dataModel->addDataPoint(m_modelFields.data(), values, nullptr, fieldCount);
+    for (size_t j = 0; j < fieldCount; ++j) {
+        m_batchColumns[j].push_back(values[j]);
+    }
+    m_batchRows++;
+    m_threadStats.rowsDecoded++;
+}
+
+void SocketDataSource::finishBatch() {
+    size_t count = m_batchRows;
+    if (count > 0) {
+        // 限制模型大小：只移动列视图起点，不复制
+        if (m_config.bufferSize > 0 && m_dataModel->size() > m_config.bufferSize) {
+            m_dataModel->removeFront(m_dataModel->size() - m_config.bufferSize);
+        }
+        m_dataModel->publish();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        if (count > 0) {
+            size_t fieldCount = m_batchColumns.size();
+            if (m_pendingColumns[0].size() + count > MAX_PENDING_ROWS) {
+                size_t dropCount = m_pendingColumns[0].size() / 2;
+                for (std::vector<double>& pending : m_pendingColumns) {
+                    pending.erase(pending.begin(), pending.begin() + dropCount);
+                }
+                m_threadStats.droppedRows += dropCount;
+            }
+            m_lastRow.resize(fieldCount);
+            for (size_t j = 0; j < fieldCount; ++j) {
+                m_pendingColumns[j].insert(m_pendingColumns[j].end(), m_batchColumns[j].begin(),
+                                           m_batchColumns[j].end());
+                m_lastRow[j] = m_batchColumns[j].back();
+                m_batchColumns[j].clear();
+            }
+        }
+        m_stats = m_threadStats;
+    }
+    m_batchRows = 0;
+
+    if (count > 0) {
+        m_hasNewData = true;
+        if (m_dataReadyCallback) {
+            m_dataReadyCallback();
+        }
+    }
+}
+
+std::vector<double> SocketDataSource::getData() {
+    m_hasNewData = false;
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    return m_lastRow;
+}
+
+std::vector<std::string> SocketDataSource::getFieldNames() const {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    return m_fieldNames;
+}
+
+size_t SocketDataSource::takePendingRows(std::vector<std::vector<double> >& columns) {
+    for (std::vector<double>& column : columns) {
+        column.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    columns.resize(m_pendingColumns.size());
+    for (size_t j = 0; j < m_pendingColumns.size(); ++j) {
+        columns[j].swap(m_pendingColumns[j]);
+    }
+    return columns.empty() ? 0 : columns[0].size();
+}
+
+SocketDataSource::SocketStats SocketDataSource::getStatistics() const {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    SocketStats stats = m_stats;
+    stats.elapsedSeconds = std::chrono::duration<double>(Clock::now() - m_startTime).count();
+    if (stats.elapsedSeconds > 0.0) {
+        stats.packetsPerSecond = stats.packetsReceived / stats.elapsedSeconds;
+        stats.rowsPerSecond = stats.rowsDecoded / stats.elapsedSeconds;
+    }
+    return stats;
+}
@@ -0,0 +1,397 @@
+#include "TypedColumn.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstring>
+
+static const double MAX_EXACT_INTEGER = 9007199254740992.0;  // 2^53
+
+// ==================== 按类型实例化的批量循环 ====================
+
+template <typename T>
+static void convertRange(const T* source, size_t count, double* output) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = static_cast<double>(source[i]);
+    }
+}
+
+template <typename T>
+static void storeRange(const double* source, size_t count, T* output) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = static_cast<T>(source[i]);
+    }
+}
+
+template <typename T>
+static void integralRange(const T* source, size_t count,
+                          double& minValue, double& maxValue, double& sum, size_t& valid) {
+    if (count == 0) {
+        return;
+    }
+    T localMin = source[0];
+    T localMax = source[0];
+    double localSum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        localMin = std::min(localMin, source[i]);
+        localMax = std::max(localMax, source[i]);
+        localSum += static_cast<double>(source[i]);
+    }
+
+    if (valid == 0) {
+        minValue = static_cast<double>(localMin);
+        maxValue = static_cast<double>(localMax);
+    } else {
+        minValue = std::min(minValue, static_cast<double>(localMin));
+        maxValue = std::max(maxValue, static_cast<double>(localMax));
+    }
+    sum += localSum;
+    valid += count;
+}
+
+template <typename T>
+static void floatingRange(const T* source, size_t count,
+                          double& minValue, double& maxValue, double& sum, size_t& valid) {
+    for (size_t i = 0; i < count; ++i) {
+        double value = static_cast<double>(source[i]);
+        if (std::isnan(value)) {
+            continue;
+        }
+        if (valid == 0) {
+            minValue = value;
+            maxValue = value;
+        } else {
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+        sum += value;
+        valid++;
+    }
+}
+
+template <typename T>
+static bool fitsInteger(double value) {
+    return std::isfinite(value) && std::trunc(value) == value &&
+           !(value == 0.0 && std::signbit(value)) &&
+           std::fabs(value) <= MAX_EXACT_INTEGER &&
+           value >= static_cast<double>(std::numeric_limits<T>::min()) &&
+           value <= static_cast<double>(std::numeric_limits<T>::max());
+}
+
+// ==================== TypedColumn ====================
+
+TypedColumn::TypedColumn(ColumnType type)
+    : m_storage(std::make_shared<std::vector<uint64_t> >()), m_type(type), m_size(0), m_offset(0) {}
+
+void TypedColumn::clear() {
+    m_storage = std::make_shared<std::vector<uint64_t> >();
+    m_size = 0;
+    m_offset = 0;
+}
+
+void TypedColumn::reserve(size_t count) {
+    mutableStorage().reserve(((m_offset + count) * elementBits(m_type) + 63) / 64);
+}
+
+bool TypedColumn::assign(const double* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!canRepresent(m_type, data[i])) {
+            return false;
+        }
+    }
+
+    // 新建存储，不影响共享旧存储的其他列
+    m_storage = std::make_shared<std::vector<uint64_t> >((count * elementBits(m_type) + 63) / 64, 0);
+    m_size = count;
+    m_offset = 0;
+
+    switch (m_type) {
+    case ColumnType::Bool:
+        for (size_t i = 0; i < count; ++i) {
+            (*m_storage)[i >> 6] |= static_cast<uint64_t>(data[i] != 0.0) << (i & 63);
+        }
+        break;
+    case ColumnType::Int8:    storeRange(data, count, typedData<int8_t>()); break;
+    case ColumnType::UInt8:   storeRange(data, count, typedData<uint8_t>()); break;
+    case ColumnType::Int16:   storeRange(data, count, typedData<int16_t>()); break;
+    case ColumnType::UInt16:  storeRange(data, count, typedData<uint16_t>()); break;
+    case ColumnType::Int32:   storeRange(data, count, typedData<int32_t>()); break;
+    case ColumnType::UInt32:  storeRange(data, count, typedData<uint32_t>()); break;
+    case ColumnType::Int64:   storeRange(data, count, typedData<int64_t>()); break;
+    case ColumnType::UInt64:  storeRange(data, count, typedData<uint64_t>()); break;
+    case ColumnType::Float32: storeRange(data, count, typedData<float>()); break;
+    case ColumnType::Float64: storeRange(data, count, typedData<double>()); break;
+    }
+    return true;
+}
+
+bool TypedColumn::append(double value) {
+    if (!canRepresent(m_type, value)) {
+        return false;
+    }
+    ensureCapacity(m_offset + m_size + 1);
+    storeValue(m_offset + m_size, value);
+    m_size++;
+    return true;
+}
+
+void TypedColumn::dropFront(size_t count) {
+    count = std::min(count, m_size);
+    m_size -= count;
+    m_offset += count;
+    if (m_offset < m_size || m_offset < 64) {
+        return;
+    }
+
+    // 丢弃部分超过剩余数据时把剩余数据整理到新存储（不修改可能被共享的旧存储），
+    // 每次整理复制的数据不超过此前丢弃的数据，逐个丢弃为均摊 O(1)
+    size_t bits = elementBits(m_type);
+    std::shared_ptr<std::vector<uint64_t> > storage =
+        std::make_shared<std::vector<uint64_t> >((m_size * bits + 63) / 64, 0);
+    if (m_type == ColumnType::Bool) {
+        for (size_t i = 0; i < m_size; ++i) {
+            size_t bit = m_offset + i;
+            (*storage)[i >> 6] |= (((*m_storage)[bit >> 6] >> (bit & 63)) & 1) << (i & 63);
+        }
+    } else if (m_size > 0) {
+        const unsigned char* source = reinterpret_cast<const unsigned char*>(m_storage->data());
+        std::memcpy(storage->data(), source + m_offset * bits / 8, m_size * bits / 8);
+    }
+    m_storage = storage;
+    m_offset = 0;
+}
+
+double TypedColumn::valueAt(size_t index) const {
+    if (index >= m_size) {
+        return 0.0;
+    }
+    double value = 0.0;
+    toDoubles(index, 1, &value);
+    return value;
+}
+
+void TypedColumn::toDoubles(size_t startIndex, size_t count, double* output) const {
+    if (startIndex >= m_size) {
+        return;
+    }
+    count = std::min(count, m_size - startIndex);
+    startIndex += m_offset;
+
+    switch (m_type) {
+    case ColumnType::Bool:
+        for (size_t i = 0; i < count; ++i) {
+            size_t bit = startIndex + i;
+            output[i] = static_cast<double>(((*m_storage)[bit >> 6] >> (bit & 63)) & 1);
+        }
+        break;
+    case ColumnType::Int8:    convertRange(typedData<int8_t>() + startIndex, count, output); break;
+    case ColumnType::UInt8:   convertRange(typedData<uint8_t>() + startIndex, count, output); break;
+    case ColumnType::Int16:   convertRange(typedData<int16_t>() + startIndex, count, output); break;
+    case ColumnType::UInt16:  convertRange(typedData<uint16_t>() + startIndex, count, output); break;
+    case ColumnType::Int32:   convertRange(typedData<int32_t>() + startIndex, count, output); break;
+    case ColumnType::UInt32:  convertRange(typedData<uint32_t>() + startIndex, count, output); break;
+    case ColumnType::Int64:   convertRange(typedData<int64_t>() + startIndex, count, output); break;
+    case ColumnType::UInt64:  convertRange(typedData<uint64_t>() + startIndex, count, output); break;
+    case ColumnType::Float32: convertRange(typedData<float>() + startIndex, count, output); break;
+    case ColumnType::Float64: convertRange(typedData<double>() + startIndex, count, output); break;
+    }
+}
+
+void TypedColumn::computeRange(size_t startIndex, size_t endIndex,
+                               double& minValue, double& maxValue, double& sum, size_t& count) const {
+    endIndex = std::min(endIndex, m_size);
+    if (startIndex >= endIndex) {
+        return;
+    }
+    size_t n = endIndex - startIndex;
+    startIndex += m_offset;
+    endIndex += m_offset;
+
+    switch (m_type) {
+    case ColumnType::Bool: {
+        size_t ones = 0;
+        for (size_t i = startIndex; i < endIndex; ++i) {
+            ones += ((*m_storage)[i >> 6] >> (i & 63)) & 1;
+        }
+        double localMin = ones == n ? 1.0 : 0.0;
+        double localMax = ones > 0 ? 1.0 : 0.0;
+        minValue = count == 0 ? localMin : std::min(minValue, localMin);
+        maxValue = count == 0 ? localMax : std::max(maxValue, localMax);
+        sum += static_cast<double>(ones);
+        count += n;
+        break;
+    }
+    case ColumnType::Int8:    integralRange(typedData<int8_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::UInt8:   integralRange(typedData<uint8_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::Int16:   integralRange(typedData<int16_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::UInt16:  integralRange(typedData<uint16_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::Int32:   integralRange(typedData<int32_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::UInt32:  integralRange(typedData<uint32_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::Int64:   integralRange(typedData<int64_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::UInt64:  integralRange(typedData<uint64_t>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::Float32: floatingRange(typedData<float>() + startIndex, n, minValue, maxValue, sum, count); break;
+    case ColumnType::Float64: floatingRange(typedData<double>() + startIndex, n, minValue, maxValue, sum, count); break;
+    }
+}
+
+size_t TypedColumn::memoryBytes() const {
+    return sizeof(*this) + m_storage->capacity() * sizeof(uint64_t);
+}
+
+std::vector<uint64_t>& TypedColumn::mutableStorage() {
+    if (m_storage.use_count() > 1) {
+        m_storage = std::make_shared<std::vector<uint64_t> >(*m_storage);
+    }
+    return *m_storage;
+}
+
+void TypedColumn::ensureCapacity(size_t count) {
+    size_t words = (count * elementBits(m_type) + 63) / 64;
+    std::vector<uint64_t>& storage = mutableStorage();
+    if (words > storage.size()) {
+        // resize 按几何倍数扩容，逐个追加为均摊 O(1)
+        storage.resize(words, 0);
+    }
+}
+
+void TypedColumn::storeValue(size_t index, double value) {
+    switch (m_type) {
+    case ColumnType::Bool: {
+        uint64_t mask = uint64_t(1) << (index & 63);
+        std::vector<uint64_t>& storage = mutableStorage();
+        if (value != 0.0) {
+            storage[index >> 6] |= mask;
+        } else {
+            storage[index >> 6] &= ~mask;
+        }
+        break;
+    }
+    case ColumnType::Int8:    typedData<int8_t>()[index] = static_cast<int8_t>(value); break;
+    case ColumnType::UInt8:   typedData<uint8_t>()[index] = static_cast<uint8_t>(value); break;
+    case ColumnType::Int16:   typedData<int16_t>()[index] = static_cast<int16_t>(value); break;
+    case ColumnType::UInt16:  typedData<uint16_t>()[index] = static_cast<uint16_t>(value); break;
+    case ColumnType::Int32:   typedData<int32_t>()[index] = static_cast<int32_t>(value); break;
+    case ColumnType::UInt32:  typedData<uint32_t>()[index] = static_cast<uint32_t>(value); break;
+    case ColumnType::Int64:   typedData<int64_t>()[index] = static_cast<int64_t>(value); break;
+    case ColumnType::UInt64:  typedData<uint64_t>()[index] = static_cast<uint64_t>(value); break;
+    case ColumnType::Float32: typedData<float>()[index] = static_cast<float>(value); break;
+    case ColumnType::Float64: typedData<double>()[index] = value; break;
+    }
+}
+
+size_t TypedColumn::elementBits(ColumnType type) {
+    switch (type) {
+    case ColumnType::Bool:    return 1;
+    case ColumnType::Int8:
+    case ColumnType::UInt8:   return 8;
+    case ColumnType::Int16:
+    case ColumnType::UInt16:  return 16;
+    case ColumnType::Int32:
+    case ColumnType::UInt32:
+    case ColumnType::Float32: return 32;
+    default:                  return 64;
+    }
+}
+
+bool TypedColumn::isIntegral(ColumnType type) {
+    return type != ColumnType::Float32 && type != ColumnType::Float64;
+}
+
+const char* TypedColumn::typeName(ColumnType type) {
+    switch (type) {
+    case ColumnType::Bool:    return "bool";
+    case ColumnType::Int8:    return "int8";
+    case ColumnType::UInt8:   return "uint8";
+    case ColumnType::Int16:   return "int16";
+    case ColumnType::UInt16:  return "uint16";
+    case ColumnType::Int32:   return "int32";
+    case ColumnType::UInt32:  return "uint32";
+    case ColumnType::Int64:   return "int64";
+    case ColumnType::UInt64:  return "uint64";
+    case ColumnType::Float32: return "float32";
+    default:                  return "float64";
+    }
+}
+
+bool TypedColumn::typeFromName(const std::string& name, ColumnType& type) {
+    static const ColumnType allTypes[] = {
+        ColumnType::Bool, ColumnType::Int8, ColumnType::UInt8, ColumnType::Int16,
+        ColumnType::UInt16, ColumnType::Int32, ColumnType::UInt32, ColumnType::Int64,
+        ColumnType::UInt64, ColumnType::Float32, ColumnType::Float64
+    };
+    for (size_t i = 0; i < sizeof(allTypes) / sizeof(allTypes[0]); ++i) {
+        if (name == typeName(allTypes[i])) {
+            type = allTypes[i];
+            return true;
+        }
+    }
+    if (name == "double") {
+        type = ColumnType::Float64;
+        return true;
+    }
+    if (name == "float") {
+        type = ColumnType::Float32;
+        return true;
+    }
+    return false;
+}
+
+bool TypedColumn::canRepresent(ColumnType type, double value) {
+    switch (type) {
+    case ColumnType::Bool:    return value == 1.0 || (value == 0.0 && !std::signbit(value));
+    case ColumnType::Int8:    return fitsInteger<int8_t>(value);
+    case ColumnType::UInt8:   return fitsInteger<uint8_t>(value);
+    case ColumnType::Int16:   return fitsInteger<int16_t>(value);
+    case ColumnType::UInt16:  return fitsInteger<uint16_t>(value);
+    case ColumnType::Int32:   return fitsInteger<int32_t>(value);
+    case ColumnType::UInt32:  return fitsInteger<uint32_t>(value);
+    case ColumnType::Int64:   return fitsInteger<int64_t>(value);
+    case ColumnType::UInt64:  return fitsInteger<uint64_t>(value);
+    case ColumnType::Float32:
+        return std::isnan(value) || static_cast<double>(static_cast<float>(value)) == value;
+    default:
+        return true;
+    }
+}
+
+ColumnType TypedColumn::inferType(const double* data, size_t count) {
+    if (count == 0) {
+        return ColumnType::Float64;
+    }
+
+    bool integral = true;
+    bool float32Exact = true;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double value = data[i];
+        if (integral && !fitsInteger<int64_t>(value)) {
+            integral = false;
+        }
+        if (float32Exact && !canRepresent(ColumnType::Float32, value)) {
+            float32Exact = false;
+        }
+        if (!integral && !float32Exact) {
+            return ColumnType::Float64;
+        }
+        if (integral) {
+            minValue = (i == 0) ? value : std::min(minValue, value);
+            maxValue = (i == 0) ? value : std::max(maxValue, value);
+        }
+    }
+
+    if (!integral) {
+        return ColumnType::Float32;
+    }
+
+    if (minValue >= 0.0) {
+        if (maxValue <= 1.0) return ColumnType::Bool;
+        if (maxValue <= 255.0) return ColumnType::UInt8;
+        if (maxValue <= 65535.0) return ColumnType::UInt16;
+        if (maxValue <= 4294967295.0) return ColumnType::UInt32;
+        return ColumnType::UInt64;
+    }
+    if (minValue >= -128.0 && maxValue <= 127.0) return ColumnType::Int8;
+    if (minValue >= -32768.0 && maxValue <= 32767.0) return ColumnType::Int16;
+    if (minValue >= -2147483648.0 && maxValue <= 2147483647.0) return ColumnType::Int32;
+    return ColumnType::Int64;
+}
@@ -0,0 +1,1184 @@
+#include "BinaryExportPlugin.h"
+#include "DataModel.h"
+#include "utils/Tracer.h"
+#include "utils/Crc32.h"
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+
+// 转换写出时每批的元素数
+static const size_t STAGING_ELEMENTS = 8192;
+// Arrow 消息体中每个缓冲的对齐（规范要求8字节，建议64字节）
+static const size_t ARROW_BUFFER_ALIGNMENT = 64;
+
+// ==================== 小端序列化工具 ====================
+
+static bool isLittleEndianHost() {
+    uint16_t value = 1;
+    return *reinterpret_cast<const uint8_t*>(&value) == 1;
+}
+
+static void putU16(std::string& buffer, uint16_t value) {
+    buffer.push_back(static_cast<char>(value & 0xFF));
+    buffer.push_back(static_cast<char>(value >> 8));
+}
+
+static void putU32(std::string& buffer, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void putU64(std::string& buffer, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief 顺序写二进制文件并记录当前位置，可在写入的同时累计 CRC-32
+ */
+class BinaryFileWriter {
+public:
+    BinaryFileWriter() : m_position(0), m_crc(0), m_crcActive(false) {}
+
+    bool open(const std::string& path) {
+        m_file.open(path.c_str(), std::ios::binary | std::ios::trunc);
+        m_position = 0;
+        return m_file.is_open();
+    }
+
+    void write(const void* data, size_t size) {
+        if (m_crcActive) {
+            m_crc = Crc32::update(m_crc, data, size);
+        }
+        m_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        m_position += size;
+    }
+
+    void write(const std::string& data) {
+        write(data.data(), data.size());
+    }
+
+    void writeZeros(size_t count) {
+        static const char zeros[64] = {0};
+        while (count > 0) {
+            size_t n = std::min(count, sizeof(zeros));
+            write(zeros, n);
+            count -= n;
+        }
+    }
+
+    uint64_t position() const { return m_position; }
+
+    void beginCrc() {
+        m_crc = 0;
+        m_crcActive = true;
+    }
+
+    uint32_t endCrc() {
+        m_crcActive = false;
+        return m_crc;
+    }
+
+    // 回到已写过的位置覆盖写入（不计入 CRC），再回到末尾继续
+    void overwrite(uint64_t position, const std::string& data) {
+        m_file.seekp(static_cast<std::streamoff>(position));
+        m_file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        m_file.seekp(static_cast<std::streamoff>(m_position));
+    }
+
+    bool close() {
+        m_file.close();
+        return !m_file.fail();
+    }
+
+private:
+    std::ofstream m_file;
+    uint64_t m_position;
+    uint32_t m_crc;
+    bool m_crcActive;
+};
+
+// ==================== 列数据写出 ====================
+
+// 导出时按列读取所需的信息，在写出开始前一次性取出
+struct BinaryColumn {
+    std::string name;
+    ColumnBuffer values;
+    const std::vector<uint64_t>* validity;
+    ColumnType type;
+};
+
+static std::vector<BinaryColumn> collectColumns(const DataModel& data) {
+    std::vector<std::string> fieldNames = data.getFieldNames();
+    std::vector<BinaryColumn> columns(fieldNames.size());
+    for (size_t j = 0; j < fieldNames.size(); ++j) {
+        columns[j].name = fieldNames[j];
+        columns[j].values = data.getColumnBuffer(fieldNames[j]);
+        columns[j].validity = data.getValidityBitmap(fieldNames[j]);
+        columns[j].type = data.getFieldType(fieldNames[j]);
+    }
+    return columns;
+}
+
+// 空值或超出该列长度的行
+static bool isNullRow(const BinaryColumn& column, size_t row) {
+    if (row >= column.values.size()) {
+        return true;
+    }
+    const std::vector<uint64_t>* validity = column.validity;
+    return validity && (row >> 6) < validity->size() && (((*validity)[row >> 6] >> (row & 63)) & 1) == 0;
+}
+
+static size_t countNulls(const BinaryColumn& column, size_t first, size_t last) {
+    size_t columnSize = column.values.size();
+    size_t nulls = last > columnSize ? last - std::max(first, columnSize) : 0;
+    if (column.validity) {
+        for (size_t row = first; row < std::min(last, columnSize); ++row) {
+            if (isNullRow(column, row)) {
+                nulls++;
+            }
+        }
+    }
+    return nulls;
+}
+
+/**
+ * @brief 把 [first, last) 行按元素类型 T 写出，空值写为 nullValue
+ *
+ * 无空值的 double 列直接写出列存储的连续片段，其余类型经小批量缓冲转换后写出。
+ */
+template <typename T>
+static void writeValues(BinaryFileWriter& out, const BinaryColumn& column, size_t first, size_t last, T nullValue) {
+    size_t end = std::min(last, column.values.size());
+    bool direct = std::is_same<T, double>::value && !column.validity;
+    std::vector<T> staging;
+
+    if (first < end) {
+        column.values.forEachSpan(first, end, [&](size_t startIndex, const double* values, size_t count) {
+            if (direct) {
+                out.write(values, count * sizeof(double));
+                return;
+            }
+            for (size_t offset = 0; offset < count; offset += STAGING_ELEMENTS) {
+                size_t n = std::min(STAGING_ELEMENTS, count - offset);
+                staging.resize(n);
+                for (size_t i = 0; i < n; ++i) {
+                    staging[i] = isNullRow(column, startIndex + offset + i)
+                        ? nullValue : static_cast<T>(values[offset + i]);
+                }
+                out.write(staging.data(), n * sizeof(T));
+            }
+        });
+    }
+
+    // 超出列长度的部分
+    for (size_t row = std::max(first, end); row < last; row += STAGING_ELEMENTS) {
+        size_t n = std::min(STAGING_ELEMENTS, last - row);
+        staging.assign(n, nullValue);
+        out.write(staging.data(), n * sizeof(T));
+    }
+}
+
+static void writeTypedValues(BinaryFileWriter& out, const BinaryColumn& column, ColumnType type,
+                             size_t first, size_t last) {
+    switch (type) {
+    case ColumnType::Bool:    writeValues<uint8_t>(out, column, first, last, 0); break;
+    case ColumnType::Int8:    writeValues<int8_t>(out, column, first, last, 0); break;
+    case ColumnType::UInt8:   writeValues<uint8_t>(out, column, first, last, 0); break;
+    case ColumnType::Int16:   writeValues<int16_t>(out, column, first, last, 0); break;
+    case ColumnType::UInt16:  writeValues<uint16_t>(out, column, first, last, 0); break;
+    case ColumnType::Int32:   writeValues<int32_t>(out, column, first, last, 0); break;
+    case ColumnType::UInt32:  writeValues<uint32_t>(out, column, first, last, 0); break;
+    case ColumnType::Int64:   writeValues<int64_t>(out, column, first, last, 0); break;
+    case ColumnType::UInt64:  writeValues<uint64_t>(out, column, first, last, 0); break;
+    case ColumnType::Float32:
+        writeValues<float>(out, column, first, last, std::numeric_limits<float>::quiet_NaN());
+        break;
+    default:
+        writeValues<double>(out, column, first, last, std::numeric_limits<double>::quiet_NaN());
+        break;
+    }
+}
+
+// 按 Arrow 位图布局（低位在前）写出 [first, last) 行的有效位或布尔值
+static void writeBits(BinaryFileWriter& out, const BinaryColumn& column, size_t first, size_t last, bool validityBits) {
+    std::vector<uint8_t> bits((last - first + 7) / 8, 0);
+    for (size_t row = first; row < last; ++row) {
+        bool bit = !isNullRow(column, row);
+        if (bit && !validityBits) {
+            bit = column.values[row] != 0.0;
+        }
+        if (bit) {
+            bits[(row - first) >> 3] |= static_cast<uint8_t>(1u << ((row - first) & 7));
+        }
+    }
+    out.write(bits.data(), bits.size());
+}
+
+// ==================== NumPy 格式 ====================
+
+static const char* npyDescr(ColumnType type) {
+    switch (type) {
+    case ColumnType::Bool:    return "|b1";
+    case ColumnType::Int8:    return "|i1";
+    case ColumnType::UInt8:   return "|u1";
+    case ColumnType::Int16:   return "<i2";
+    case ColumnType::UInt16:  return "<u2";
+    case ColumnType::Int32:   return "<i4";
+    case ColumnType::UInt32:  return "<u4";
+    case ColumnType::Int64:   return "<i8";
+    case ColumnType::UInt64:  return "<u8";
+    case ColumnType::Float32: return "<f4";
+    default:                  return "<f8";
+    }
+}
+
+static size_t npyItemSize(ColumnType type) {
+    return type == ColumnType::Bool ? 1 : TypedColumn::elementBits(type) / 8;
+}
+
+// .npy 没有空值表示：整数和布尔列含空值时改用 float64，空值写为 NaN
+static ColumnType npyExportType(const BinaryColumn& column, size_t rows) {
+    if (TypedColumn::isIntegral(column.type) && countNulls(column, 0, rows) > 0) {
+        return ColumnType::Float64;
+    }
+    return column.type;
+}
+
+// 版本 1.0 的 .npy 头部；用空格补齐到64字节整数倍，数组数据从对齐位置开始
+static std::string npyHeader(ColumnType type, size_t rows) {
+    std::string dictionary = std::string("{'descr': '") + npyDescr(type) +
+        "', 'fortran_order': False, 'shape': (" + std::to_string(rows) + ",), }";
+    size_t total = 10 + dictionary.size() + 1;     // 魔数6 + 版本2 + 头长度2 + 结尾换行
+    dictionary.append((64 - total % 64) % 64, ' ');
+    dictionary += '\n';
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    putU16(header, static_cast<uint16_t>(dictionary.size()));
+    return header + dictionary;
+}
+
+// 字段名用作文件名或 ZIP 条目名时替换路径分隔符等特殊字符
+static std::string safeEntryName(const std::string& name) {
+    std::string safe = name.empty() ? std::string("field") : name;
+    for (size_t i = 0; i < safe.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(safe[i]);
+        if (c < 0x20 || std::string("/\\:*?\"<>|").find(static_cast<char>(c)) != std::string::npos) {
+            safe[i] = '_';
+        }
+    }
+    return safe;
+}
+
+static bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// ==================== Arrow IPC 元数据 ====================
+
+/**
+ * @brief 最小的 FlatBuffers 编码器，只支持 Arrow 元数据用到的表、字符串和向量
+ *
+ * 对象按父在前、子在后的顺序写入：引用字段（uoffset）总是指向后方，写完子对象后回填。
+ * 每个表的 vtable 紧挨在表之前，表起点按8字节对齐，字段按大小降序排列以保证自然对齐。
+ */
+class FlatBufferWriter {
+public:
+    struct Slot {
+        size_t size;        // 字段字节数，0 表示省略；引用字段为4
+        uint64_t value;     // 标量值，引用字段写 0 后回填
+    };
+
+    FlatBufferWriter() : m_data(4, '\0') {}
+
+    void setRoot(size_t table) { patch(0, table); }
+
+    // 写一个表，positions 返回各字段在缓冲中的位置（用于回填引用）
+    size_t table(const std::vector<Slot>& slots, std::vector<size_t>& positions) {
+        std::vector<size_t> order;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].size > 0) {
+                order.push_back(i);
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [&slots](size_t a, size_t b) {
+            return slots[a].size > slots[b].size;
+        });
+
+        std::vector<uint16_t> fieldOffsets(slots.size(), 0);
+        size_t tableSize = 4;       // 表头的 soffset
+        for (size_t k = 0; k < order.size(); ++k) {
+            size_t size = slots[order[k]].size;
+            tableSize = alignUp(tableSize, size);
+            fieldOffsets[order[k]] = static_cast<uint16_t>(tableSize);
+            tableSize += size;
+        }
+
+        align(2);
+        size_t vtable = m_data.size();
+        putU16(m_data, static_cast<uint16_t>(4 + 2 * slots.size()));
+        putU16(m_data, static_cast<uint16_t>(tableSize));
+        for (size_t i = 0; i < slots.size(); ++i) {
+            putU16(m_data, fieldOffsets[i]);
+        }
+
+        align(8);
+        size_t tableStart = m_data.size();
+        m_data.append(tableSize, '\0');
+        putScalar(tableStart, tableStart - vtable, 4);      // vtable = table - soffset
+
+        positions.assign(slots.size(), 0);
+        for (size_t k = 0; k < order.size(); ++k) {
+            size_t i = order[k];
+            positions[i] = tableStart + fieldOffsets[i];
+            putScalar(positions[i], slots[i].value, slots[i].size);
+        }
+        return tableStart;
+    }
+
+    size_t string(const std::string& text) {
+        align(4);
+        size_t position = m_data.size();
+        putU32(m_data, static_cast<uint32_t>(text.size()));
+        m_data += text;
+        m_data += '\0';
+        return position;
+    }
+
+    // 表引用向量，positions 返回各元素的位置
+    size_t offsetVector(size_t count, std::vector<size_t>& positions) {
+        align(4);
+        size_t position = m_data.size();
+        putU32(m_data, static_cast<uint32_t>(count));
+        positions.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = m_data.size();
+            putU32(m_data, 0);
+        }
+        return position;
+    }
+
+    // 8字节对齐的结构体向量：长度前缀放在8字节边界之前
+    size_t structVector(const std::string& elements, size_t count) {
+        while ((m_data.size() + 4) % 8 != 0) {
+            m_data += '\0';
+        }
+        size_t position = m_data.size();
+        putU32(m_data, static_cast<uint32_t>(count));
+        m_data += elements;
+        return position;
+    }
+
+    void patch(size_t at, size_t target) {
+        putScalar(at, target - at, 4);
+    }
+
+    std::string finish() {
+        align(8);
+        return m_data;
+    }
+
+private:
+    void align(size_t alignment) {
+        m_data.append((alignment - m_data.size() % alignment) % alignment, '\0');
+    }
+
+    void putScalar(size_t at, uint64_t value, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            m_data[at + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    std::string m_data;
+};
+
+// Arrow 格式定义（Schema.fbs / Message.fbs）中用到的枚举值
+static const uint16_t ARROW_METADATA_V5 = 4;
+static const uint8_t ARROW_TYPE_INT = 2;
+static const uint8_t ARROW_TYPE_FLOATING_POINT = 3;
+static const uint8_t ARROW_TYPE_BOOL = 6;
+static const uint8_t ARROW_HEADER_SCHEMA = 1;
+static const uint8_t ARROW_HEADER_RECORD_BATCH = 3;
+
+static uint8_t arrowTypeTag(ColumnType type) {
+    if (type == ColumnType::Bool) {
+        return ARROW_TYPE_BOOL;
+    }
+    return TypedColumn::isIntegral(type) ? ARROW_TYPE_INT : ARROW_TYPE_FLOATING_POINT;
+}
+
+static size_t writeArrowType(FlatBufferWriter& fb, ColumnType type) {
+    std::vector<size_t> at;
+    switch (arrowTypeTag(type)) {
+    case ARROW_TYPE_BOOL:
+        return fb.table(std::vector<FlatBufferWriter::Slot>(), at);
+    case ARROW_TYPE_FLOATING_POINT:
+        // FloatingPoint { precision: SINGLE=1 / DOUBLE=2 }
+        return fb.table({{2, type == ColumnType::Float32 ? 1u : 2u}}, at);
+    default: {
+        // Int { bitWidth, is_signed }
+        bool isSigned = type == ColumnType::Int8 || type == ColumnType::Int16 ||
+                        type == ColumnType::Int32 || type == ColumnType::Int64;
+        return fb.table({{4, TypedColumn::elementBits(type)}, {1, isSigned ? 1u : 0u}}, at);
+    }
+    }
+}
+
+static size_t writeArrowField(FlatBufferWriter& fb, const BinaryColumn& column) {
+    // Field { name, nullable, type_type, type, dictionary, children }
+    std::vector<size_t> at;
+    size_t field = fb.table({{4, 0}, {1, 1}, {1, arrowTypeTag(column.type)}, {4, 0}, {0, 0}, {4, 0}}, at);
+    fb.patch(at[0], fb.string(column.name));
+    fb.patch(at[3], writeArrowType(fb, column.type));
+    std::vector<size_t> children;
+    fb.patch(at[5], fb.offsetVector(0, children));
+    return field;
+}
+
+static size_t writeArrowSchema(FlatBufferWriter& fb, const std::vector<BinaryColumn>& columns) {
+    // Schema { endianness = Little, fields }
+    std::vector<size_t> at;
+    size_t schema = fb.table({{2, 0}, {4, 0}}, at);
+    std::vector<size_t> fields;
+    fb.patch(at[1], fb.offsetVector(columns.size(), fields));
+    for (size_t j = 0; j < columns.size(); ++j) {
+        fb.patch(fields[j], writeArrowField(fb, columns[j]));
+    }
+    return schema;
+}
+
+// 封装消息：0xFFFFFFFF、元数据长度、按8字节补齐的 Message
+static std::string frameArrowMessage(uint8_t headerType, uint64_t bodyLength,
+                                     const std::function<size_t(FlatBufferWriter&)>& writeHeader) {
+    // Message { version, header_type, header, bodyLength }
+    FlatBufferWriter fb;
+    std::vector<size_t> at;
+    size_t message = fb.table({{2, ARROW_METADATA_V5}, {1, headerType}, {4, 0}, {8, bodyLength}}, at);
+    fb.setRoot(message);
+    fb.patch(at[2], writeHeader(fb));
+    std::string metadata = fb.finish();
+
+    std::string framed;
+    putU32(framed, 0xFFFFFFFFu);
+    putU32(framed, static_cast<uint32_t>(metadata.size()));
+    return framed + metadata;
+}
+
+// 记录批次中一列的缓冲布局
+struct ArrowColumnLayout {
+    size_t nullCount;
+    size_t validityLength;
+    size_t valuesLength;
+};
+
+// 写出 [first, last) 行的一个记录批次，并在 blocks 中记录它的 Block { offset, metaDataLength, bodyLength }
+static void writeArrowRecordBatch(BinaryFileWriter& out, const std::vector<BinaryColumn>& columns,
+                                  size_t first, size_t last, std::string& blocks, size_t& blockCount) {
+    size_t batchLength = last - first;
+
+    // 每列两个缓冲：有效位图（无空值时长度为0）和值
+    std::vector<ArrowColumnLayout> layouts(columns.size());
+    std::string nodes;
+    std::string buffers;
+    uint64_t bodyLength = 0;
+    for (size_t j = 0; j < columns.size(); ++j) {
+        ArrowColumnLayout& layout = layouts[j];
+        layout.nullCount = countNulls(columns[j], first, last);
+        layout.validityLength = layout.nullCount > 0 ? (batchLength + 7) / 8 : 0;
+        layout.valuesLength = columns[j].type == ColumnType::Bool
+            ? (batchLength + 7) / 8 : batchLength * (TypedColumn::elementBits(columns[j].type) / 8);
+
+        putU64(nodes, batchLength);
+        putU64(nodes, layout.nullCount);
+        putU64(buffers, bodyLength);
+        putU64(buffers, layout.validityLength);
+        bodyLength += alignUp(layout.validityLength, ARROW_BUFFER_ALIGNMENT);
+        putU64(buffers, bodyLength);
+        putU64(buffers, layout.valuesLength);
+        bodyLength += alignUp(layout.valuesLength, ARROW_BUFFER_ALIGNMENT);
+    }
+
+    std::string message = frameArrowMessage(ARROW_HEADER_RECORD_BATCH, bodyLength,
+        [&](FlatBufferWriter& fb) {
+            // RecordBatch { length, nodes, buffers }
+            std::vector<size_t> at;
+            size_t batch = fb.table({{8, batchLength}, {4, 0}, {4, 0}}, at);
+            fb.patch(at[1], fb.structVector(nodes, columns.size()));
+            fb.patch(at[2], fb.structVector(buffers, columns.size() * 2));
+            return batch;
+        });
+
+    putU64(blocks, out.position());
+    putU32(blocks, static_cast<uint32_t>(message.size()));
+    putU32(blocks, 0);
+    putU64(blocks, bodyLength);
+    blockCount++;
+
+    out.write(message);
+    for (size_t j = 0; j < columns.size(); ++j) {
+        const ArrowColumnLayout& layout = layouts[j];
+        if (layout.validityLength > 0) {
+            writeBits(out, columns[j], first, last, true);
+            out.writeZeros(alignUp(layout.validityLength, ARROW_BUFFER_ALIGNMENT) - layout.validityLength);
+        }
+        if (columns[j].type == ColumnType::Bool) {
+            writeBits(out, columns[j], first, last, false);
+        } else {
+            writeTypedValues(out, columns[j], columns[j].type, first, last);
+        }
+        out.writeZeros(alignUp(layout.valuesLength, ARROW_BUFFER_ALIGNMENT) - layout.valuesLength);
+    }
+}
+
+// 写出流结束标记；文件格式再写 Footer、Footer 长度和结尾魔数
+static void writeArrowEnd(BinaryFileWriter& out, bool fileFormat, const std::vector<BinaryColumn>& columns,
+                          const std::string& blocks, size_t blockCount) {
+    // 流结束标记
+    std::string endOfStream;
+    putU32(endOfStream, 0xFFFFFFFFu);
+    putU32(endOfStream, 0);
+    out.write(endOfStream);
+
+    if (fileFormat) {
+        // Footer { version, schema, dictionaries, recordBatches }
+        FlatBufferWriter fb;
+        std::vector<size_t> at;
+        size_t footer = fb.table({{2, ARROW_METADATA_V5}, {4, 0}, {4, 0}, {4, 0}}, at);
+        fb.setRoot(footer);
+        fb.patch(at[1], writeArrowSchema(fb, columns));
+        fb.patch(at[2], fb.structVector(std::string(), 0));
+        fb.patch(at[3], fb.structVector(blocks, blockCount));
+        std::string footerBytes = fb.finish();
+
+        out.write(footerBytes);
+        std::string footerLength;
+        putU32(footerLength, static_cast<uint32_t>(footerBytes.size()));
+        out.write(footerLength);
+        out.write(std::string("ARROW1", 6));
+    }
+}
+
+// ==================== NpyExportPlugin ====================
+
+NpyExportPlugin::NpyExportPlugin()
+    : m_bundle(true), m_processingTime(0), m_processedCount(0) {
+}
+
+NpyExportPlugin::~NpyExportPlugin() {
+    shutdown();
+}
+
+std::string NpyExportPlugin::getName() const {
+    return "NpyExportPlugin";
+}
+
+std::string NpyExportPlugin::getVersion() const {
+    return "1.0.0";
+}
+
+std::string NpyExportPlugin::getDescription() const {
+    return "NumPy格式导出插件，每个字段导出为.npy数组，可打包为不压缩的.npz";
+}
+
+std::string NpyExportPlugin::getAuthor() const {
+    return "Data Parsing Tool Team";
+}
+
+std::vector<std::string> NpyExportPlugin::getDependencies() const {
+    return {};
+}
+
+bool NpyExportPlugin::initialize() {
+    m_lastError.clear();
+    return true;
+}
+
+bool NpyExportPlugin::shutdown() {
+    m_processedCount = 0;
+    m_processingTime = 0;
+    return true;
+}
+
+bool NpyExportPlugin::isInitialized() const {
+    return true;
+}
+
+bool NpyExportPlugin::processData(std::shared_ptr<DataModel> input,
+                                  std::shared_ptr<DataModel> output) {
+    TRACE_SCOPE("plugin", "NpyExportPlugin::processData");
+
+    // 导出插件不变换数据，输出一行导出统计信息
+    if (!input) {
+        m_lastError = "输入数据为空";
+        return false;
+    }
+
+    if (output) {
+        std::map<std::string, double> stats;
+        stats["total_points"] = static_cast<double>(input->size());
+        stats["field_count"] = static_cast<double>(input->getFieldNames().size());
+        stats["export_time"] = static_cast<double>(m_processingTime);
+        output->addDataPoint(stats);
+    }
+
+    m_processedCount += input->size();
+    m_lastError.clear();
+    return true;
+}
+
+bool NpyExportPlugin::exportToFile(const std::string& filename,
+                                   std::shared_ptr<DataModel> data) {
+    TRACE_SCOPE("export", "NpyExportPlugin::exportToFile");
+
+    if (!data || data->empty()) {
+        m_lastError = "没有数据可导出";
+        return false;
+    }
+    if (!isLittleEndianHost()) {
+        m_lastError = "NumPy导出要求小端平台";
+        return false;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    try {
+        bool success = m_bundle ? writeNpzFile(filename, data) : writeNpyFiles(filename, data);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        m_processingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            endTime - startTime).count();
+        m_processedCount += data->size();
+
+        if (success) {
+            m_lastError.clear();
+        }
+        return success;
+
+    } catch (const std::exception& e) {
+        m_lastError = std::string("导出失败: ") + e.what();
+        return false;
+    }
+}
+
+bool NpyExportPlugin::writeNpyFiles(const std::string& filename, std::shared_ptr<DataModel> data) {
+    std::vector<BinaryColumn> columns = collectColumns(*data);
+    if (columns.empty()) {
+        m_lastError = "没有可导出的字段";
+        return false;
+    }
+
+    std::string stem = filename;
+    if (endsWith(stem, ".npy") || endsWith(stem, ".npz")) {
+        stem.resize(stem.size() - 4);
+    }
+
+    size_t rows = data->size();
+    for (size_t j = 0; j < columns.size(); ++j) {
+        std::string path = stem + "_" + safeEntryName(columns[j].name) + ".npy";
+        BinaryFileWriter out;
+        if (!out.open(path)) {
+            m_lastError = "无法创建文件: " + path;
+            return false;
+        }
+
+        ColumnType type = npyExportType(columns[j], rows);
+        out.write(npyHeader(type, rows));
+        writeTypedValues(out, columns[j], type, 0, rows);
+        if (!out.close()) {
+            m_lastError = "写入文件失败: " + path;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool NpyExportPlugin::writeNpzFile(const std::string& filename, std::shared_ptr<DataModel> data) {
+    std::vector<BinaryColumn> columns = collectColumns(*data);
+    if (columns.empty()) {
+        m_lastError = "没有可导出的字段";
+        return false;
+    }
+
+    BinaryFileWriter out;
+    if (!out.open(filename)) {
+        m_lastError = "无法创建文件: " + filename;
+        return false;
+    }
+
+    // ZIP 条目使用 stored（不压缩），条目名按 UTF-8 标记，时间固定为 1980-01-01
+    static const uint16_t ZIP_VERSION = 20;
+    static const uint16_t ZIP_FLAG_UTF8 = 0x0800;
+    static const uint16_t ZIP_DOS_DATE = (0 << 9) | (1 << 5) | 1;
+    static const uint16_t ZIP_ALIGNMENT_EXTRA_ID = 0xD935;
+
+    struct ZipEntry {
+        std::string name;
+        uint64_t headerOffset;
+        uint64_t size;
+        uint32_t crc;
+    };
+    std::vector<ZipEntry> entries;
+
+    size_t rows = data->size();
+    for (size_t j = 0; j < columns.size(); ++j) {
+        ZipEntry entry;
+        entry.name = safeEntryName(columns[j].name) + ".npy";
+        entry.headerOffset = out.position();
+
+        ColumnType type = npyExportType(columns[j], rows);
+        std::string header = npyHeader(type, rows);
+        entry.size = header.size() + static_cast<uint64_t>(rows) * npyItemSize(type);
+
+        // 本地文件头的扩展字段用作填充，使数组数据（.npy 头部长度为64的整数倍）从64字节边界开始
+        size_t extraLength = (64 - (entry.headerOffset + 30 + entry.name.size()) % 64) % 64;
+        if (extraLength > 0 && extraLength < 4) {
+            extraLength += 64;
+        }
+        if (entry.headerOffset + 30 + entry.name.size() + extraLength + entry.size > 0xFFFFFFFFull ||
+            entries.size() >= 0xFFFF) {
+            m_lastError = "NPZ文件超过ZIP格式限制（4GB或65535个条目），请改为导出单独的.npy文件";
+            out.close();
+            return false;
+        }
+
+        std::string local;
+        putU32(local, 0x04034b50u);
+        putU16(local, ZIP_VERSION);
+        putU16(local, ZIP_FLAG_UTF8);
+        putU16(local, 0);                   // stored
+        putU16(local, 0);                   // 修改时间
+        putU16(local, ZIP_DOS_DATE);
+        putU32(local, 0);                   // CRC-32，写完数据后回填
+        putU32(local, static_cast<uint32_t>(entry.size));
+        putU32(local, static_cast<uint32_t>(entry.size));
+        putU16(local, static_cast<uint16_t>(entry.name.size()));
+        putU16(local, static_cast<uint16_t>(extraLength));
+        local += entry.name;
+        if (extraLength > 0) {
+            putU16(local, ZIP_ALIGNMENT_EXTRA_ID);
+            putU16(local, static_cast<uint16_t>(extraLength - 4));
+            local.append(extraLength - 4, '\0');
+        }
+        out.write(local);
+
+        out.beginCrc();
+        out.write(header);
+        writeTypedValues(out, columns[j], type, 0, rows);
+        entry.crc = out.endCrc();
+
+        std::string crc;
+        putU32(crc, entry.crc);
+        out.overwrite(entry.headerOffset + 14, crc);
+        entries.push_back(entry);
+    }
+
+    // 中央目录和目录结束记录
+    uint64_t directoryOffset = out.position();
+    std::string directory;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const ZipEntry& entry = entries[i];
+        putU32(directory, 0x02014b50u);
+        putU16(directory, ZIP_VERSION);     // 创建版本
+        putU16(directory, ZIP_VERSION);     // 解压所需版本
+        putU16(directory, ZIP_FLAG_UTF8);
+        putU16(directory, 0);
+        putU16(directory, 0);
+        putU16(directory, ZIP_DOS_DATE);
+        putU32(directory, entry.crc);
+        putU32(directory, static_cast<uint32_t>(entry.size));
+        putU32(directory, static_cast<uint32_t>(entry.size));
+        putU16(directory, static_cast<uint16_t>(entry.name.size()));
+        putU16(directory, 0);               // 扩展字段长度
+        putU16(directory, 0);               // 注释长度
+        putU16(directory, 0);               // 起始磁盘号
+        putU16(directory, 0);               // 内部属性
+        putU32(directory, 0);               // 外部属性
+        putU32(directory, static_cast<uint32_t>(entry.headerOffset));
+        directory += entry.name;
+    }
+    if (directoryOffset + directory.size() > 0xFFFFFFFFull) {
+        m_lastError = "NPZ文件超过ZIP格式限制（4GB或65535个条目），请改为导出单独的.npy文件";
+        out.close();
+        return false;
+    }
+
+    uint32_t directorySize = static_cast<uint32_t>(directory.size());
+    putU32(directory, 0x06054b50u);
+    putU16(directory, 0);
+    putU16(directory, 0);
+    putU16(directory, static_cast<uint16_t>(entries.size()));
+    putU16(directory, static_cast<uint16_t>(entries.size()));
+    putU32(directory, directorySize);
+    putU32(directory, static_cast<uint32_t>(directoryOffset));
+    putU16(directory, 0);
+    out.write(directory);
+
+    if (!out.close()) {
+        m_lastError = "写入文件失败: " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool NpyExportPlugin::setParameter(const std::string& key, const QVariant& value) {
+    if (key == "bundle") {
+        m_bundle = value.toBool();
+        return true;
+    }
+
+    m_lastError = "无效参数: " + key;
+    return false;
+}
+
+QVariant NpyExportPlugin::getParameter(const std::string& key) const {
+    if (key == "bundle") {
+        return m_bundle;
+    }
+    return QVariant();
+}
+
+std::map<std::string, QVariant> NpyExportPlugin::getDefaultParameters() const {
+    return {
+        {"bundle", true}
+    };
+}
+
+bool NpyExportPlugin::validateParameters() const {
+    return true;
+}
+
+std::string NpyExportPlugin::getLastError() const {
+    return m_lastError;
+}
+
+int NpyExportPlugin::getProcessingTime() const {
+    return m_processingTime;
+}
+
+size_t NpyExportPlugin::getProcessedCount() const {
+    return m_processedCount;
+}
+
+std::vector<std::string> NpyExportPlugin::getSupportedFormats() const {
+    return {"npz", "npy"};
+}
+
+// ==================== ArrowExportPlugin ====================
+
+struct ArrowExportPlugin::StreamState {
+    BinaryFileWriter out;
+    std::string filename;
+    std::vector<BinaryColumn> schema;   // 只用 name 和 type
+    bool schemaWritten = false;
+    std::string blocks;
+    size_t blockCount = 0;
+};
+
+ArrowExportPlugin::ArrowExportPlugin()
+    : m_fileFormat(true), m_batchRows(1 << 20), m_processingTime(0), m_processedCount(0) {
+}
+
+ArrowExportPlugin::~ArrowExportPlugin() {
+    endStream();
+    shutdown();
+}
+
+std::string ArrowExportPlugin::getName() const {
+    return "ArrowExportPlugin";
+}
+
+std::string ArrowExportPlugin::getVersion() const {
+    return "1.0.0";
+}
+
+std::string ArrowExportPlugin::getDescription() const {
+    return "Apache Arrow IPC导出插件，支持文件格式和流格式";
+}
+
+std::string ArrowExportPlugin::getAuthor() const {
+    return "Data Parsing Tool Team";
+}
+
+std::vector<std::string> ArrowExportPlugin::getDependencies() const {
+    return {};
+}
+
+bool ArrowExportPlugin::initialize() {
+    m_lastError.clear();
+    return true;
+}
+
+bool ArrowExportPlugin::shutdown() {
+    m_processedCount = 0;
+    m_processingTime = 0;
+    return true;
+}
+
+bool ArrowExportPlugin::isInitialized() const {
+    return true;
+}
+
+bool ArrowExportPlugin::processData(std::shared_ptr<DataModel> input,
+                                    std::shared_ptr<DataModel> output) {
+    TRACE_SCOPE("plugin", "ArrowExportPlugin::processData");
+
+    // 导出插件不变换数据，输出一行导出统计信息
+    if (!input) {
+        m_lastError = "输入数据为空";
+        return false;
+    }
+
+    if (output) {
+        std::map<std::string, double> stats;
+        stats["total_points"] = static_cast<double>(input->size());
+        stats["field_count"] = static_cast<double>(input->getFieldNames().size());
+        stats["export_time"] = static_cast<double>(m_processingTime);
+        output->addDataPoint(stats);
+    }
+
+    m_processedCount += input->size();
+    m_lastError.clear();
+    return true;
+}
+
+bool ArrowExportPlugin::exportToFile(const std::string& filename,
+                                     std::shared_ptr<DataModel> data) {
+    TRACE_SCOPE("export", "ArrowExportPlugin::exportToFile");
+
+    if (!data || data->empty()) {
+        m_lastError = "没有数据可导出";
+        return false;
+    }
+    if (!isLittleEndianHost()) {
+        m_lastError = "Arrow导出要求小端平台";
+        return false;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    try {
+        bool success = writeArrowFile(filename, data);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        m_processingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            endTime - startTime).count();
+        m_processedCount += data->size();
+
+        if (success) {
+            m_lastError.clear();
+        }
+        return success;
+
+    } catch (const std::exception& e) {
+        m_lastError = std::string("导出失败: ") + e.what();
+        return false;
+    }
+}
+
+bool ArrowExportPlugin::writeArrowFile(const std::string& filename, std::shared_ptr<DataModel> data) {
+    std::vector<BinaryColumn> columns = collectColumns(*data);
+    if (columns.empty()) {
+        m_lastError = "没有可导出的字段";
+        return false;
+    }
+
+    BinaryFileWriter out;
+    if (!out.open(filename)) {
+        m_lastError = "无法创建文件: " + filename;
+        return false;
+    }
+
+    // 文件格式：魔数 + 流格式内容 + Footer + Footer 长度 + 魔数
+    if (m_fileFormat) {
+        out.write(std::string("ARROW1\0\0", 8));
+    }
+
+    out.write(frameArrowMessage(ARROW_HEADER_SCHEMA, 0, [&columns](FlatBufferWriter& fb) {
+        return writeArrowSchema(fb, columns);
+    }));
+
+    std::string blocks;
+    size_t blockCount = 0;
+
+    size_t rows = data->size();
+    size_t batchRows = m_batchRows > 0 ? m_batchRows : rows;
+    for (size_t first = 0; first < rows; first += batchRows) {
+        writeArrowRecordBatch(out, columns, first, std::min(rows, first + batchRows), blocks, blockCount);
+    }
+
+    writeArrowEnd(out, m_fileFormat, columns, blocks, blockCount);
+
+    if (!out.close()) {
+        m_lastError = "写入文件失败: " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool ArrowExportPlugin::beginStream(const std::string& filename, const std::vector<std::string>& fieldNames) {
+    endStream();
+    if (fieldNames.empty()) {
+        m_lastError = "没有可导出的字段";
+        return false;
+    }
+    if (!isLittleEndianHost()) {
+        m_lastError = "Arrow导出要求小端平台";
+        return false;
+    }
+
+    std::unique_ptr<StreamState> stream(new StreamState());
+    if (!stream->out.open(filename)) {
+        m_lastError = "无法创建文件: " + filename;
+        return false;
+    }
+    stream->filename = filename;
+    stream->schema.resize(fieldNames.size());
+    for (size_t j = 0; j < fieldNames.size(); ++j) {
+        stream->schema[j].name = fieldNames[j];
+        stream->schema[j].validity = nullptr;
+        stream->schema[j].type = ColumnType::Float64;
+    }
+    if (m_fileFormat) {
+        stream->out.write(std::string("ARROW1\0\0", 8));
+    }
+
+    m_stream = std::move(stream);
+    m_lastError.clear();
+    return true;
+}
+
+bool ArrowExportPlugin::appendBatch(const DataModel& batch) {
+    if (!m_stream) {
+        m_lastError = "增量导出尚未开始";
+        return false;
+    }
+    StreamState& stream = *m_stream;
+
+    // Schema 在首个批次到达时按其字段类型写出，批次中缺少的字段保持 float64
+    if (!stream.schemaWritten) {
+        for (BinaryColumn& field : stream.schema) {
+            if (batch.hasField(field.name)) {
+                field.type = batch.getFieldType(field.name);
+            }
+        }
+        stream.out.write(frameArrowMessage(ARROW_HEADER_SCHEMA, 0, [&stream](FlatBufferWriter& fb) {
+            return writeArrowSchema(fb, stream.schema);
+        }));
+        stream.schemaWritten = true;
+    }
+
+    size_t rows = batch.size();
+    if (rows == 0) {
+        return true;
+    }
+
+    // 值按 Schema 中的类型写出；缺少的字段整列为空值
+    std::vector<BinaryColumn> columns(stream.schema.size());
+    for (size_t j = 0; j < columns.size(); ++j) {
+        columns[j].name = stream.schema[j].name;
+        columns[j].type = stream.schema[j].type;
+        columns[j].validity = nullptr;
+        if (batch.hasField(columns[j].name)) {
+            columns[j].values = batch.getColumnBuffer(columns[j].name);
+            columns[j].validity = batch.getValidityBitmap(columns[j].name);
+        }
+    }
+
+    size_t batchRows = m_batchRows > 0 ? m_batchRows : rows;
+    for (size_t first = 0; first < rows; first += batchRows) {
+        writeArrowRecordBatch(stream.out, columns, first, std::min(rows, first + batchRows),
+                              stream.blocks, stream.blockCount);
+    }
+    m_processedCount += rows;
+    return true;
+}
+
+bool ArrowExportPlugin::endStream() {
+    if (!m_stream) {
+        return false;
+    }
+    std::unique_ptr<StreamState> stream = std::move(m_stream);
+
+    if (!stream->schemaWritten) {
+        stream->out.write(frameArrowMessage(ARROW_HEADER_SCHEMA, 0, [&stream](FlatBufferWriter& fb) {
+            return writeArrowSchema(fb, stream->schema);
+        }));
+    }
+    writeArrowEnd(stream->out, m_fileFormat, stream->schema, stream->blocks, stream->blockCount);
+
+    if (!stream->out.close()) {
+        m_lastError = "写入文件失败: " + stream->filename;
+        return false;
+    }
+    return true;
+}
+
+uint64_t ArrowExportPlugin::getStreamBytes() const {
+    return m_stream ? m_stream->out.position() : 0;
+}
+
+bool ArrowExportPlugin::setParameter(const std::string& key, const QVariant& value) {
+    if (key == "format") {
+        std::string format = value.toString().toStdString();
+        if (format == "file" || format == "stream") {
+            m_fileFormat = format == "file";
+            return true;
+        }
+    } else if (key == "batch_rows") {
+        bool ok;
+        int batchRows = value.toInt(&ok);
+        if (ok && batchRows > 0) {
+            m_batchRows = static_cast<size_t>(batchRows);
+            return true;
+        }
+    }
+
+    m_lastError = "无效参数: " + key;
+    return false;
+}
+
+QVariant ArrowExportPlugin::getParameter(const std::string& key) const {
+    if (key == "format") {
+        return QString(m_fileFormat ? "file" : "stream");
+    } else if (key == "batch_rows") {
+        return static_cast<int>(m_batchRows);
+    }
+    return QVariant();
+}
+
+std::map<std::string, QVariant> ArrowExportPlugin::getDefaultParameters() const {
+    return {
+        {"format", "file"},
+        {"batch_rows", 1 << 20}
+    };
+}
+
+bool ArrowExportPlugin::validateParameters() const {
+    return m_batchRows > 0;
+}
+
+std::string ArrowExportPlugin::getLastError() const {
+    return m_lastError;
+}
+
+int ArrowExportPlugin::getProcessingTime() const {
+    return m_processingTime;
+}
+
+size_t ArrowExportPlugin::getProcessedCount() const {
+    return m_processedCount;
+}
+
+std::vector<std::string> ArrowExportPlugin::getSupportedFormats() const {
+    return {"arrow", "arrows", "feather"};
+}
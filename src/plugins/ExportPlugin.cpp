@@ -1,18 +1,130 @@
 #include "ExportPlugin.h"
 #include "DataModel.h"
+#include "utils/Tracer.h"
+#include "utils/ThreadPool.h"
 #include <fstream>
-#include <iomanip>
-#include <sstream>
+#include <charconv>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 
+// 每次并行格式化的行数；每块生成一段连续文本，用一次写调用输出
+static const size_t EXPORT_BLOCK_ROWS = 16384;
+
+// 导出时按列读取所需的信息，在格式化开始前一次性取出
+struct ExportColumn {
+    ColumnBuffer values;
+    const std::vector<uint64_t>* validity;
+    ColumnType type;
+};
+
+static void appendChars(std::string& out, const char* first, const char* last) {
+    out.append(first, static_cast<size_t>(last - first));
+}
+
+static void appendInteger(std::string& out, long long value) {
+    char buffer[24];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    appendChars(out, buffer, result.ptr);
+}
+
+// precision < 0 时输出能无损往返的最短表示，否则输出固定小数位数
+template <typename T>
+static void appendFloating(std::string& out, T value, int precision) {
+    char buffer[384];   // 固定格式下 double 最大值展开为 309 位整数部分
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::to_chars_result result = precision < 0
+        ? std::to_chars(buffer, buffer + sizeof(buffer), value)
+        : std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+    appendChars(out, buffer, result.ptr);
+#else
+    // 标准库不支持浮点 to_chars 时的退路：最大有效位数保证往返，但不一定最短
+    int length = precision < 0
+        ? std::snprintf(buffer, sizeof(buffer), "%.*g", sizeof(T) == sizeof(float) ? 9 : 17,
+                        static_cast<double>(value))
+        : std::snprintf(buffer, sizeof(buffer), "%.*f", precision, static_cast<double>(value));
+    if (length > 0) {
+        out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+#endif
+}
+
+// 把 [firstRow, lastRow) 行格式化为 CSV 文本，追加到 out
+static void formatRowBlock(const std::vector<ExportColumn>& columns, size_t firstRow, size_t lastRow,
+                           const std::string& delimiter, int precision, std::string& out) {
+    size_t rowCount = lastRow - firstRow;
+    // 每列先把本块的值复制到连续数组，之后逐行读取时不再经过分块存储的索引
+    std::vector<std::vector<double> > blockValues(columns.size());
+    std::vector<size_t> available(columns.size(), 0);
+    for (size_t j = 0; j < columns.size(); ++j) {
+        size_t columnSize = columns[j].values.size();
+        if (columnSize > firstRow) {
+            available[j] = std::min(lastRow, columnSize) - firstRow;
+            blockValues[j].resize(available[j]);
+            columns[j].values.copyTo(firstRow, available[j], blockValues[j].data());
+        }
+    }
+    
+    out.reserve(out.size() + rowCount * columns.size() * 12);
+    for (size_t r = 0; r < rowCount; ++r) {
+        size_t row = firstRow + r;
+        for (size_t j = 0; j < columns.size(); ++j) {
+            if (j > 0) {
+                out += delimiter;
+            }
+            // 空值和超出该列长度的位置输出为空字段
+            if (r >= available[j]) {
+                continue;
+            }
+            const std::vector<uint64_t>* validity = columns[j].validity;
+            if (validity && (row >> 6) < validity->size() && (((*validity)[row >> 6] >> (row & 63)) & 1) == 0) {
+                continue;
+            }
+            
+            double value = blockValues[j][r];
+            if (TypedColumn::isIntegral(columns[j].type)) {
+                appendInteger(out, static_cast<long long>(value));
+            } else if (columns[j].type == ColumnType::Float32) {
+                // float32 列按 float 格式化，避免输出展宽后的 double 尾数
+                appendFloating(out, static_cast<float>(value), precision);
+            } else {
+                appendFloating(out, value, precision);
+            }
+        }
+        out += '\n';
+    }
+}
+
+// ==================== ExportPlugin ====================
+
+ExportPlugin::ExportPlugin() {
+}
+
+bool ExportPlugin::beginStream(const std::string& filename, const std::vector<std::string>& fieldNames) {
+    (void)filename;
+    (void)fieldNames;
+    return false;
+}
+
+bool ExportPlugin::appendBatch(const DataModel& batch) {
+    (void)batch;
+    return false;
+}
+
+bool ExportPlugin::endStream() {
+    return false;
+}
+
 // ==================== CSVExportPlugin ====================
 
 CSVExportPlugin::CSVExportPlugin() 
-    : m_delimiter(","), m_includeHeader(true), m_encoding("UTF-8"),
-      m_processingTime(0), m_processedCount(0) {
+    : m_delimiter(","), m_includeHeader(true), m_encoding("UTF-8"), m_precision(-1),
+      m_processingTime(0), m_processedCount(0), m_streamBytes(0) {
 }
 
 CSVExportPlugin::~CSVExportPlugin() {
+    endStream();
     shutdown();
 }
 
@@ -53,6 +165,8 @@ bool CSVExportPlugin::isInitialized() const {
 
 bool CSVExportPlugin::processData(std::shared_ptr<DataModel> input, 
                                  std::shared_ptr<DataModel> output) {
+    TRACE_SCOPE("plugin", "CSVExportPlugin::processData");
+    
     // 导出插件通常不需要处理数据，而是直接导出到文件
     // 这里可以创建一个包含导出信息的DataModel
     if (!input) {
@@ -68,10 +182,8 @@ bool CSVExportPlugin::processData(std::shared_ptr<DataModel> input,
             stats["field_count"] = static_cast<double>(input->getFieldNames().size());
             stats["export_time"] = static_cast<double>(m_processingTime);
             
-            // 将统计信息添加到输出
-            for (const auto& stat : stats) {
-                output->addDataPoint({{stat.first, stat.second}});
-            }
+            // 将统计信息作为一行添加到输出（逐字段添加会让其余字段补空值）
+            output->addDataPoint(stats);
         }
         
         m_processedCount += input->size();
@@ -86,6 +198,8 @@ bool CSVExportPlugin::processData(std::shared_ptr<DataModel> input,
 
 bool CSVExportPlugin::exportToFile(const std::string& filename, 
                                   std::shared_ptr<DataModel> data) {
+    TRACE_SCOPE("export", "CSVExportPlugin::exportToFile");
+    
     if (!data || data->empty()) {
         m_lastError = "没有数据可导出";
         return false;
@@ -130,33 +244,45 @@ bool CSVExportPlugin::writeCSVFile(const std::string& filename,
         
         // 写入表头
         if (m_includeHeader) {
-            for (size_t i = 0; i < fieldNames.size(); ++i) {
-                if (i > 0) file << m_delimiter;
-                file << escapeCSVField(fieldNames[i]);
-            }
-            file << std::endl;
+            std::string header = buildHeader(fieldNames);
+            file.write(header.data(), static_cast<std::streamsize>(header.size()));
         }
         
-        // 写入数据
+        // 按列取出数据视图、空值位图和类型（编码列在这里解码一次），格式化时直接按列读取
+        std::vector<ExportColumn> columns(fieldNames.size());
+        for (size_t j = 0; j < fieldNames.size(); ++j) {
+            columns[j].values = data->getColumnBuffer(fieldNames[j]);
+            columns[j].validity = data->getValidityBitmap(fieldNames[j]);
+            columns[j].type = data->getFieldType(fieldNames[j]);
+        }
+        
+        // 每轮在共享线程池中并行格式化若干行块，再按顺序写出；每轮的块数限制了缓冲占用的内存
         size_t dataSize = data->size();
-        for (size_t i = 0; i < dataSize; ++i) {
-            std::map<std::string, double> dataPoint;
-            if (data->getDataPoint(i, dataPoint)) {
-                for (size_t j = 0; j < fieldNames.size(); ++j) {
-                    if (j > 0) file << m_delimiter;
-                    
-                    auto it = dataPoint.find(fieldNames[j]);
-                    if (it != dataPoint.end()) {
-                        file << formatCSVValue(it->second);
-                    } else {
-                        file << ""; // 空值
-                    }
+        size_t blockCount = (dataSize + EXPORT_BLOCK_ROWS - 1) / EXPORT_BLOCK_ROWS;
+        size_t blocksPerRound = std::max<size_t>(1, ThreadPool::getInstance().getThreadCount() * 2);
+        std::vector<std::string> blocks(std::min(blockCount, blocksPerRound));
+        
+        for (size_t roundBegin = 0; roundBegin < blockCount && file.good(); roundBegin += blocksPerRound) {
+            size_t roundEnd = std::min(blockCount, roundBegin + blocksPerRound);
+            ThreadPool::getInstance().parallelFor(roundBegin, roundEnd, 1, [&](size_t first, size_t last) {
+                for (size_t b = first; b < last; ++b) {
+                    std::string& block = blocks[b - roundBegin];
+                    block.clear();
+                    formatRowBlock(columns, b * EXPORT_BLOCK_ROWS, std::min(dataSize, (b + 1) * EXPORT_BLOCK_ROWS),
+                                   m_delimiter, m_precision, block);
                 }
-                file << std::endl;
+            });
+            for (size_t b = roundBegin; b < roundEnd; ++b) {
+                const std::string& block = blocks[b - roundBegin];
+                file.write(block.data(), static_cast<std::streamsize>(block.size()));
             }
         }
         
         file.close();
+        if (file.fail()) {
+            m_lastError = "写入文件失败: " + filename;
+            return false;
+        }
         return true;
         
     } catch (const std::exception& e) {
@@ -168,6 +294,86 @@ bool CSVExportPlugin::writeCSVFile(const std::string& filename,
     }
 }
 
+bool CSVExportPlugin::beginStream(const std::string& filename, const std::vector<std::string>& fieldNames) {
+    endStream();
+    if (fieldNames.empty()) {
+        m_lastError = "没有可导出的字段";
+        return false;
+    }
+    
+    m_streamFile.open(filename, std::ios::out | std::ios::trunc);
+    if (!m_streamFile.is_open()) {
+        m_lastError = "无法创建文件: " + filename;
+        return false;
+    }
+    m_streamFields = fieldNames;
+    m_streamBytes = 0;
+    
+    if (m_includeHeader) {
+        std::string header = buildHeader(fieldNames);
+        m_streamFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+        m_streamBytes += header.size();
+    }
+    m_lastError.clear();
+    return m_streamFile.good();
+}
+
+bool CSVExportPlugin::appendBatch(const DataModel& batch) {
+    if (!m_streamFile.is_open()) {
+        m_lastError = "增量导出尚未开始";
+        return false;
+    }
+    
+    // 批次不含的字段按空值输出，保证各行列数与表头一致
+    std::vector<ExportColumn> columns(m_streamFields.size());
+    for (size_t j = 0; j < m_streamFields.size(); ++j) {
+        if (batch.hasField(m_streamFields[j])) {
+            columns[j].values = batch.getColumnBuffer(m_streamFields[j]);
+            columns[j].validity = batch.getValidityBitmap(m_streamFields[j]);
+            columns[j].type = batch.getFieldType(m_streamFields[j]);
+        } else {
+            columns[j].validity = nullptr;
+            columns[j].type = ColumnType::Float64;
+        }
+    }
+    
+    std::string text;
+    formatRowBlock(columns, 0, batch.size(), m_delimiter, m_precision, text);
+    m_streamFile.write(text.data(), static_cast<std::streamsize>(text.size()));
+    m_streamFile.flush();
+    if (m_streamFile.fail()) {
+        m_lastError = "写入文件失败";
+        return false;
+    }
+    m_streamBytes += text.size();
+    m_processedCount += batch.size();
+    return true;
+}
+
+bool CSVExportPlugin::endStream() {
+    if (!m_streamFile.is_open()) {
+        return false;
+    }
+    m_streamFile.close();
+    m_streamFields.clear();
+    if (m_streamFile.fail()) {
+        m_streamFile.clear();
+        m_lastError = "写入文件失败";
+        return false;
+    }
+    return true;
+}
+
+std::string CSVExportPlugin::buildHeader(const std::vector<std::string>& fieldNames) {
+    std::string header;
+    for (size_t i = 0; i < fieldNames.size(); ++i) {
+        if (i > 0) header += m_delimiter;
+        header += escapeCSVField(fieldNames[i]);
+    }
+    header += '\n';
+    return header;
+}
+
 std::string CSVExportPlugin::escapeCSVField(const std::string& field) {
     // 检查是否需要引号
     bool needsQuotes = field.find(m_delimiter) != std::string::npos ||
@@ -196,27 +402,6 @@ std::string CSVExportPlugin::escapeCSVField(const std::string& field) {
     return escaped;
 }
 
-std::string CSVExportPlugin::formatCSVValue(double value) {
-    std::ostringstream ss;
-    ss << std::setprecision(15) << value; // 高精度输出
-    
-    std::string str = ss.str();
-    
-    // 检查是否需要科学计数法转换
-    if (str.find('e') != std::string::npos || str.find('E') != std::string::npos) {
-        // 已经是科学计数法，直接返回
-        return str;
-    }
-    
-    // 检查是否为整数
-    if (value == static_cast<long long>(value)) {
-        // 整数格式，去掉小数点
-        return std::to_string(static_cast<long long>(value));
-    }
-    
-    return str;
-}
-
 bool CSVExportPlugin::setParameter(const std::string& key, const QVariant& value) {
     if (key == "delimiter") {
         QString delim = value.toString();
@@ -236,8 +421,8 @@ bool CSVExportPlugin::setParameter(const std::string& key, const QVariant& value
     } else if (key == "precision") {
         bool ok;
         int precision = value.toInt(&ok);
-        if (ok && precision >= 0 && precision <= 15) {
-            // 精度设置会在formatCSVValue中使用
+        if (ok && precision >= -1 && precision <= 15) {
+            m_precision = precision;
             return true;
         }
     }
@@ -253,6 +438,8 @@ QVariant CSVExportPlugin::getParameter(const std::string& key) const {
         return m_includeHeader;
     } else if (key == "encoding") {
         return QString::fromStdString(m_encoding);
+    } else if (key == "precision") {
+        return m_precision;
     }
     return QVariant();
 }
@@ -262,7 +449,7 @@ std::map<std::string, QVariant> CSVExportPlugin::getDefaultParameters() const {
         {"delimiter", ","},
         {"include_header", true},
         {"encoding", "UTF-8"},
-        {"precision", 6}
+        {"precision", -1}
     };
 }
 
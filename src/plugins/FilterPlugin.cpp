@@ -1,15 +1,30 @@
 #include "FilterPlugin.h"
 #include "DataModel.h"
+#include "utils/Tracer.h"
+#include "utils/ThreadPool.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <stdexcept>
+#include <limits>
+
+// 有效位图中 index 位是否为1（有效）
+static bool isValidBit(const std::vector<uint64_t>& validity, size_t index) {
+    size_t word = index / 64;
+    return word < validity.size() && ((validity[word] >> (index % 64)) & 1) != 0;
+}
+
+// ==================== FilterPlugin ====================
+
+FilterPlugin::FilterPlugin() 
+    : m_cutoffFrequency(0.0), m_filterOrder(1), m_initialized(false) {
+}
 
 // ==================== MovingAverageFilter ====================
 
 MovingAverageFilter::MovingAverageFilter() 
     : m_windowSize(5), m_currentIndex(0), m_sum(0.0), 
-      m_initialized(false), m_processingTime(0), m_processedCount(0) {
+      m_processingTime(0), m_processedCount(0) {
     m_cutoffFrequency = 0.5;
     m_filterOrder = 1;
 }
@@ -68,6 +83,8 @@ bool MovingAverageFilter::isInitialized() const {
 
 bool MovingAverageFilter::processData(std::shared_ptr<DataModel> input, 
                                      std::shared_ptr<DataModel> output) {
+    TRACE_SCOPE("plugin", "MovingAverageFilter::processData");
+    
     if (!m_initialized || !input || !output) {
         m_lastError = "插件未初始化或输入输出为空";
         return false;
@@ -85,22 +102,29 @@ bool MovingAverageFilter::processData(std::shared_ptr<DataModel> input,
         
         // 处理每个字段
         for (const auto& fieldName : fieldNames) {
-            const auto& inputData = input->getDataSeries(fieldName);
-            if (inputData.empty()) {
-                continue;
-            }
-            
             std::vector<double> outputData;
-            outputData.reserve(inputData.size());
+            outputData.reserve(input->size());
             
-            // 对每个数据点应用移动平均
-            for (size_t i = 0; i < inputData.size(); ++i) {
-                double filteredValue = processSample(inputData[i]);
-                outputData.push_back(filteredValue);
+            // 按块读取输入，类型化/编码字段无需先展开整列；空值不进入滑动窗口，输出仍为空值
+            const std::vector<uint64_t>* validity = input->getValidityBitmap(fieldName);
+            input->scanField(fieldName, [&](size_t startIndex, const double* values, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    if (validity && !isValidBit(*validity, startIndex + i)) {
+                        outputData.push_back(std::numeric_limits<double>::quiet_NaN());
+                        continue;
+                    }
+                    outputData.push_back(processSample(values[i]));
+                }
+            });
+            if (outputData.empty()) {
+                continue;
             }
             
             // 将结果保存到输出
             output->addDataSeries(fieldName, outputData);
+            if (validity) {
+                output->setValidityBitmap(fieldName, *validity);
+            }
         }
         
         auto endTime = std::chrono::high_resolution_clock::now();
@@ -238,7 +262,9 @@ void MovingAverageFilter::initializeBuffer() {
 // ==================== LowPassFilter ====================
 
 LowPassFilter::LowPassFilter() 
-    : m_cutoffFrequency(0.1), m_filterOrder(2), m_processingTime(0), m_processedCount(0) {
+    : m_processingTime(0), m_processedCount(0) {
+    m_cutoffFrequency = 0.1;
+    m_filterOrder = 2;
     calculateCoefficients();
 }
 
@@ -295,6 +321,8 @@ bool LowPassFilter::isInitialized() const {
 
 bool LowPassFilter::processData(std::shared_ptr<DataModel> input, 
                                std::shared_ptr<DataModel> output) {
+    TRACE_SCOPE("plugin", "LowPassFilter::processData");
+    
     if (!input || !output) {
         m_lastError = "输入输出数据为空";
         return false;
@@ -309,37 +337,59 @@ bool LowPassFilter::processData(std::shared_ptr<DataModel> input,
             return false;
         }
         
-        for (const auto& fieldName : fieldNames) {
-            const auto& inputData = input->getDataSeries(fieldName);
-            if (inputData.empty()) {
+        // 各字段的滤波器状态互相独立，在共享线程池中按字段并行计算，再按原顺序写入输出
+        std::vector<std::vector<double> > results(fieldNames.size());
+        ThreadPool::getInstance().parallelFor(0, fieldNames.size(), 1, [&](size_t first, size_t last) {
+            for (size_t f = first; f < last; ++f) {
+                const std::string& fieldName = fieldNames[f];
+                std::vector<double>& outputData = results[f];
+                outputData.reserve(input->size());
+
+                // 最近 b.size() 个输入，history[j] = x[n-j]，序列开始前视为0
+                std::vector<double> history(m_coefficientsB.size(), 0.0);
+
+                // 应用低通滤波，按块读取输入；空值位置沿用上一个输出值保持滤波器状态连续，最终仍标记为空值
+                const std::vector<uint64_t>* validity = input->getValidityBitmap(fieldName);
+                input->scanField(fieldName, [&](size_t startIndex, const double* values, size_t count) {
+                    for (size_t k = 0; k < count; ++k) {
+                        size_t i = outputData.size();
+                        if (validity && !isValidBit(*validity, startIndex + k)) {
+                            outputData.push_back(i > 0 ? outputData[i - 1] : 0.0);
+                            continue;
+                        }
+                        if (!history.empty()) {
+                            std::copy_backward(history.begin(), history.end() - 1, history.end());
+                            history[0] = values[k];
+                        }
+                        double outputValue = 0.0;
+
+                        // IIR滤波器实现: y[n] = sum(b[i]*x[n-i]) - sum(a[i]*y[n-i])
+                        for (size_t j = 0; j < m_coefficientsB.size(); ++j) {
+                            outputValue += m_coefficientsB[j] * history[j];
+                        }
+
+                        for (size_t j = 1; j < m_coefficientsA.size(); ++j) {
+                            if (i >= j) {
+                                outputValue -= m_coefficientsA[j] * outputData[i - j];
+                            }
+                        }
+
+                        outputData.push_back(outputValue);
+                    }
+                });
+            }
+        });
+        
+        for (size_t f = 0; f < fieldNames.size(); ++f) {
+            if (results[f].empty()) {
                 continue;
             }
             
-            std::vector<double> outputData;
-            outputData.reserve(inputData.size());
-            
-            // 应用低通滤波
-            for (size_t i = 0; i < inputData.size(); ++i) {
-                double inputValue = inputData[i];
-                double outputValue = 0.0;
-                
-                // IIR滤波器实现: y[n] = sum(b[i]*x[n-i]) - sum(a[i]*y[n-i])
-                for (size_t j = 0; j < m_coefficientsB.size(); ++j) {
-                    if (i >= j) {
-                        outputValue += m_coefficientsB[j] * inputData[i - j];
-                    }
-                }
-                
-                for (size_t j = 1; j < m_coefficientsA.size(); ++j) {
-                    if (i >= j) {
-                        outputValue -= m_coefficientsA[j] * outputData[i - j];
-                    }
-                }
-                
-                outputData.push_back(outputValue);
+            output->addDataSeries(fieldNames[f], results[f]);
+            const std::vector<uint64_t>* validity = input->getValidityBitmap(fieldNames[f]);
+            if (validity) {
+                output->setValidityBitmap(fieldNames[f], *validity);
             }
-            
-            output->addDataSeries(fieldName, outputData);
         }
         
         auto endTime = std::chrono::high_resolution_clock::now();
@@ -1,9 +1,17 @@
 #include "InterpolationPlugin.h"
 #include "DataModel.h"
+#include "utils/Tracer.h"
+#include "utils/ThreadPool.h"
 #include <algorithm>
 #include <cmath>
+#include <chrono>
 #include <stdexcept>
 
+// ==================== InterpolationPlugin ====================
+
+InterpolationPlugin::InterpolationPlugin() {
+}
+
 // ==================== LinearInterpolationPlugin ====================
 
 LinearInterpolationPlugin::LinearInterpolationPlugin() 
@@ -51,6 +59,8 @@ bool LinearInterpolationPlugin::isInitialized() const {
 
 bool LinearInterpolationPlugin::processData(std::shared_ptr<DataModel> input, 
                                            std::shared_ptr<DataModel> output) {
+    TRACE_SCOPE("plugin", "LinearInterpolationPlugin::processData");
+    
     if (!input || !output) {
         m_lastError = "输入输出数据为空";
         return false;
@@ -74,13 +84,14 @@ bool LinearInterpolationPlugin::processData(std::shared_ptr<DataModel> input,
             }
         }
         
-        if (hasTimeField) {
-            // 有时时间字段的插值
-            return processWithTimeField(input, output, fieldNames);
-        } else {
-            // 无时间字段的插值（基于索引）
-            return processWithoutTimeField(input, output, fieldNames);
-        }
+        bool success = hasTimeField
+            ? processWithTimeField(input, output, fieldNames)       // 有时间字段的插值
+            : processWithoutTimeField(input, output, fieldNames);   // 无时间字段的插值（基于索引）
+        
+        auto endTime = std::chrono::high_resolution_clock::now();
+        m_processingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            endTime - startTime).count();
+        return success;
         
     } catch (const std::exception& e) {
         m_lastError = std::string("插值处理失败: ") + e.what();
@@ -92,47 +103,55 @@ bool LinearInterpolationPlugin::processWithTimeField(std::shared_ptr<DataModel>
                                                    std::shared_ptr<DataModel> output,
                                                    const std::vector<std::string>& fieldNames) {
     // 获取时间数据
-    const auto& timeData = input->getDataSeries("time");
+    ColumnBuffer timeData = input->getColumnBuffer("time");
     if (timeData.empty()) {
         m_lastError = "时间字段数据为空";
         return false;
     }
     
     // 生成新的时间序列
-    double startTime = timeData.front();
-    double endTime = timeData.back();
+    double firstTime = timeData[0];
+    double lastTime = timeData[timeData.size() - 1];
     std::vector<double> newTime;
     
-    for (double t = startTime; t <= endTime; t += m_stepSize) {
+    for (double t = firstTime; t <= lastTime; t += m_stepSize) {
         newTime.push_back(t);
     }
     
-    // 为每个字段进行插值
-    for (const auto& fieldName : fieldNames) {
-        if (fieldName == "time") {
-            output->addDataSeries("time", newTime);
+    // 先按顺序取出并校验各字段，再在共享线程池中并行插值；校验通过后插值不会失败
+    // 列视图与模型共享存储，不复制为连续数组
+    std::vector<ColumnBuffer> yData(fieldNames.size());
+    std::vector<bool> hasY(fieldNames.size(), false);
+    for (size_t f = 0; f < fieldNames.size(); ++f) {
+        if (fieldNames[f] == "time") {
             continue;
         }
         
-        const auto& yData = input->getDataSeries(fieldName);
-        if (yData.size() != timeData.size()) {
+        yData[f] = input->getColumnBuffer(fieldNames[f]);
+        hasY[f] = true;
+        if (yData[f].size() != timeData.size()) {
             m_lastError = "时间序列和数据序列长度不匹配";
             return false;
         }
-        
-        std::vector<double> newYData;
-        newYData.reserve(newTime.size());
-        
-        if (!linearInterpolate(timeData, yData, newTime, newYData)) {
+        if (timeData.size() < 2) {
+            m_lastError = "输入数据无效";
             return false;
         }
-        
-        output->addDataSeries(fieldName, newYData);
     }
     
-    auto endTime = std::chrono::high_resolution_clock::now();
-    m_processingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-        endTime - startTime).count();
+    std::vector<std::vector<double> > newYData(fieldNames.size());
+    ThreadPool::getInstance().parallelFor(0, fieldNames.size(), 1, [&](size_t first, size_t last) {
+        for (size_t f = first; f < last; ++f) {
+            if (hasY[f]) {
+                linearInterpolate(timeData, yData[f], newTime, newYData[f]);
+            }
+        }
+    });
+    
+    for (size_t f = 0; f < fieldNames.size(); ++f) {
+        output->addDataSeries(fieldNames[f], hasY[f] ? newYData[f] : newTime);
+    }
+    
     m_processedCount += newTime.size();
     
     m_lastError.clear();
@@ -156,20 +175,21 @@ bool LinearInterpolationPlugin::processWithoutTimeField(std::shared_ptr<DataMode
         newX[i] = static_cast<double>(i) * m_stepSize;
     }
     
+    // 生成原始索引
+    ColumnBuffer::Storage indices(originalSize);
+    for (size_t i = 0; i < originalSize; ++i) {
+        indices[i] = static_cast<double>(i);
+    }
+    ColumnBuffer originalX(std::move(indices));
+    
     // 为每个字段进行插值
     for (const auto& fieldName : fieldNames) {
-        const auto& yData = input->getDataSeries(fieldName);
+        ColumnBuffer yData = input->getColumnBuffer(fieldName);
         if (yData.size() != originalSize) {
             m_lastError = "数据字段长度不一致";
             return false;
         }
         
-        // 生成原始索引
-        std::vector<double> originalX(originalSize);
-        for (size_t i = 0; i < originalSize; ++i) {
-            originalX[i] = static_cast<double>(i);
-        }
-        
         std::vector<double> newYData;
         if (!linearInterpolate(originalX, yData, newX, newYData)) {
             return false;
@@ -178,17 +198,14 @@ bool LinearInterpolationPlugin::processWithoutTimeField(std::shared_ptr<DataMode
         output->addDataSeries(fieldName, newYData);
     }
     
-    auto endTime = std::chrono::high_resolution_clock::now();
-    m_processingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-        endTime - startTime).count();
     m_processedCount += newSize;
     
     m_lastError.clear();
     return true;
 }
 
-bool LinearInterpolationPlugin::linearInterpolate(const std::vector<double>& x, 
-                                                 const std::vector<double>& y,
+bool LinearInterpolationPlugin::linearInterpolate(const ColumnBuffer& x, 
+                                                 const ColumnBuffer& y,
                                                  std::vector<double>& newX, 
                                                  std::vector<double>& newY) {
     if (x.size() != y.size() || x.size() < 2) {
@@ -211,13 +228,13 @@ bool LinearInterpolationPlugin::linearInterpolate(const std::vector<double>& x,
         
         if (j >= x.size() - 1) {
             // 超出范围，使用最后一个值
-            newY.push_back(y.back());
+            newY.push_back(y[y.size() - 1]);
             continue;
         }
         
-        if (targetX < x.front()) {
+        if (targetX < x[0]) {
             // 小于最小值，使用第一个值
-            newY.push_back(y.front());
+            newY.push_back(y[0]);
             continue;
         }
         
@@ -2,6 +2,9 @@
 #include "FilterPlugin.h"
 #include "InterpolationPlugin.h"
 #include "ExportPlugin.h"
+#include "BinaryExportPlugin.h"
+#include "DataModel.h"
+#include "utils/Tracer.h"
 #include <algorithm>
 #include <chrono>
 
@@ -10,6 +13,28 @@ PluginManager& PluginManager::getInstance() {
     return instance;
 }
 
+PluginManager::PluginManager() {
+    // 内置插件按类名注册
+    registerFactory("MovingAverageFilter", []() -> std::shared_ptr<PluginInterface> {
+        return std::make_shared<MovingAverageFilter>();
+    });
+    registerFactory("LowPassFilter", []() -> std::shared_ptr<PluginInterface> {
+        return std::make_shared<LowPassFilter>();
+    });
+    registerFactory("LinearInterpolationPlugin", []() -> std::shared_ptr<PluginInterface> {
+        return std::make_shared<LinearInterpolationPlugin>();
+    });
+    registerFactory("CSVExportPlugin", []() -> std::shared_ptr<PluginInterface> {
+        return std::make_shared<CSVExportPlugin>();
+    });
+    registerFactory("NpyExportPlugin", []() -> std::shared_ptr<PluginInterface> {
+        return std::make_shared<NpyExportPlugin>();
+    });
+    registerFactory("ArrowExportPlugin", []() -> std::shared_ptr<PluginInterface> {
+        return std::make_shared<ArrowExportPlugin>();
+    });
+}
+
 PluginManager::~PluginManager() {
     // 关闭所有插件
     for (auto& pair : m_plugins) {
@@ -80,6 +105,47 @@ bool PluginManager::reloadPlugin(const std::string& name) {
     return false;
 }
 
+void PluginManager::registerFactory(const std::string& name, PluginFactory factory) {
+    if (!factory) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_factoryMutex);
+    m_factories[name] = factory;
+}
+
+bool PluginManager::hasFactory(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(m_factoryMutex);
+    return m_factories.find(name) != m_factories.end();
+}
+
+std::vector<std::string> PluginManager::getFactoryNames() const {
+    std::lock_guard<std::mutex> lock(m_factoryMutex);
+    std::vector<std::string> names;
+    for (const auto& pair : m_factories) {
+        names.push_back(pair.first);
+    }
+    return names;
+}
+
+std::shared_ptr<PluginInterface> PluginManager::createPlugin(const std::string& name) const {
+    PluginFactory factory;
+    {
+        std::lock_guard<std::mutex> lock(m_factoryMutex);
+        auto it = m_factories.find(name);
+        if (it == m_factories.end()) {
+            return nullptr;
+        }
+        factory = it->second;
+    }
+    
+    // 在锁外创建，插件构造和初始化可以并行
+    std::shared_ptr<PluginInterface> plugin = factory();
+    if (!plugin || !plugin->initialize()) {
+        return nullptr;
+    }
+    return plugin;
+}
+
 std::shared_ptr<PluginInterface> PluginManager::getPlugin(const std::string& name) const {
     auto it = m_plugins.find(name);
     if (it != m_plugins.end() && it->second.isInitialized) {
@@ -121,6 +187,8 @@ bool PluginManager::processData(const std::string& pluginName,
         return false;
     }
     
+    // 区间以插件名命名，链中各插件在跟踪视图里可直接区分
+    TRACE_SCOPE("plugin", pluginName);
     auto startTime = std::chrono::high_resolution_clock::now();
     
     bool success = plugin->processData(input, output);
@@ -165,6 +233,7 @@ bool PluginManager::processWithChain(const std::vector<std::string>& pluginChain
         return false;
     }
     
+    TRACE_SCOPE("plugin", "PluginManager::processWithChain");
     std::shared_ptr<DataModel> currentInput = input;
     std::shared_ptr<DataModel> tempOutput;
     
@@ -0,0 +1,378 @@
+#include "StreamingExporter.h"
+#include "DataModel.h"
+#include "utils/FileUtils.h"
+#include "utils/Tracer.h"
+#include <ctime>
+#include <cstdio>
+#include <algorithm>
+
+StreamingExporter::StreamingExporter(std::shared_ptr<ExportPlugin> plugin, const Config& config)
+    : m_plugin(plugin), m_config(config), m_pendingRows(0), m_queuedRows(0),
+      m_running(false), m_stopping(false), m_failed(false),
+      m_peakQueuedBatches(0), m_rowsWritten(0), m_bytesWritten(0), m_droppedRows(0),
+      m_filesCompleted(0), m_fileBytes(0), m_fileSequence(0) {
+    if (m_config.batchRows == 0) {
+        m_config.batchRows = 1;
+    }
+    if (m_config.queueCapacity == 0) {
+        m_config.queueCapacity = 1;
+    }
+    if (m_config.flushIntervalMs <= 0) {
+        m_config.flushIntervalMs = 500;
+    }
+}
+
+StreamingExporter::~StreamingExporter() {
+    stop();
+}
+
+bool StreamingExporter::start(const std::vector<std::string>& fieldNames, std::string* errorMessage) {
+    std::string error;
+    if (isRunning()) {
+        error = "流式导出已在运行";
+    } else if (!m_plugin || !m_plugin->supportsStreaming()) {
+        error = "导出插件不支持增量导出";
+    } else if (fieldNames.empty()) {
+        error = "没有可导出的字段";
+    } else if (!m_config.directory.empty() && !FileUtils::createDirectories(m_config.directory)) {
+        error = "无法创建目录: " + m_config.directory;
+    }
+
+    if (error.empty()) {
+        m_fieldNames = fieldNames;
+        m_pendingColumns.assign(fieldNames.size(), std::vector<double>());
+        m_pendingValidity.assign(fieldNames.size(), std::vector<uint64_t>());
+        m_pendingRows = 0;
+        m_queuedRows = 0;
+        m_queue.clear();
+        m_stopping = false;
+        m_failed = false;
+        m_peakQueuedBatches = 0;
+        m_rowsWritten = 0;
+        m_bytesWritten = 0;
+        m_droppedRows = 0;
+        m_filesCompleted = 0;
+        m_fileSequence = 0;
+        m_startTime = Clock::now();
+        openNextFile(error);
+    }
+
+    if (!error.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastError = error;
+        if (errorMessage) {
+            *errorMessage = error;
+        }
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = true;
+        m_lastError.clear();
+    }
+    m_writer = std::thread(&StreamingExporter::writerLoop, this);
+    return true;
+}
+
+void StreamingExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_stopping = true;
+    }
+    m_notEmpty.notify_all();
+    m_notFull.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    m_stopTime = Clock::now();
+}
+
+bool StreamingExporter::isRunning() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+void StreamingExporter::appendRow(const double* values, size_t count) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running || m_stopping) {
+        return;
+    }
+
+    size_t row = m_pendingRows;
+    if (row == 0) {
+        m_pendingSince = Clock::now();
+    }
+    for (size_t j = 0; j < m_pendingColumns.size(); ++j) {
+        bool valid = j < count;
+        m_pendingColumns[j].push_back(valid ? values[j] : 0.0);
+
+        // 列中出现第一个空值时才建立有效位图，之前的行都有效
+        std::vector<uint64_t>& validity = m_pendingValidity[j];
+        if (!valid && validity.empty()) {
+            validity.assign(m_config.batchRows / 64 + 1, ~0ULL);
+        }
+        if (!validity.empty()) {
+            if ((row >> 6) >= validity.size()) {
+                validity.resize((row >> 6) + 1, ~0ULL);
+            }
+            if (!valid) {
+                validity[row >> 6] &= ~(1ULL << (row & 63));
+            }
+        }
+    }
+    m_pendingRows++;
+
+    if (m_pendingRows >= m_config.batchRows) {
+        size_t rows = 0;
+        std::shared_ptr<const DataModel> batch = takePendingLocked(rows);
+        enqueueLocked(lock, batch, rows);
+    }
+}
+
+void StreamingExporter::appendBatch(std::shared_ptr<const DataModel> batch) {
+    if (!batch || batch->size() == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running || m_stopping) {
+        return;
+    }
+    // 先写出已积累的行，保持提交顺序
+    if (m_pendingRows > 0) {
+        size_t rows = 0;
+        std::shared_ptr<const DataModel> pending = takePendingLocked(rows);
+        enqueueLocked(lock, pending, rows);
+    }
+    enqueueLocked(lock, batch, batch->size());
+}
+
+std::shared_ptr<const DataModel> StreamingExporter::takePendingLocked(size_t& rows) {
+    rows = m_pendingRows;
+    std::shared_ptr<DataModel> batch = std::make_shared<DataModel>();
+    for (size_t j = 0; j < m_fieldNames.size(); ++j) {
+        batch->addDataSeries(m_fieldNames[j], ColumnBuffer(std::move(m_pendingColumns[j])));
+        if (!m_pendingValidity[j].empty()) {
+            batch->setValidityBitmap(m_fieldNames[j], m_pendingValidity[j]);
+        }
+        m_pendingColumns[j] = std::vector<double>();
+        m_pendingColumns[j].reserve(std::min<size_t>(m_config.batchRows, 65536));
+        m_pendingValidity[j].clear();
+    }
+    m_pendingRows = 0;
+    return batch;
+}
+
+void StreamingExporter::enqueueLocked(std::unique_lock<std::mutex>& lock,
+                                      std::shared_ptr<const DataModel> batch, size_t rows) {
+    if (!m_config.dropWhenFull) {
+        m_notFull.wait(lock, [this]() {
+            return m_queue.size() < m_config.queueCapacity || m_failed || m_stopping;
+        });
+    }
+    // 停止时写线程会写完队列，不再受容量限制
+    if (m_failed || (m_queue.size() >= m_config.queueCapacity && !m_stopping)) {
+        m_droppedRows += rows;
+        return;
+    }
+
+    m_queue.push_back(batch);
+    m_queuedRows += rows;
+    m_peakQueuedBatches = std::max(m_peakQueuedBatches, m_queue.size());
+    lock.unlock();
+    m_notEmpty.notify_one();
+    lock.lock();
+}
+
+void StreamingExporter::writerLoop() {
+    Tracer::getInstance().setThreadName("stream-export");
+    const std::chrono::milliseconds flushInterval(m_config.flushIntervalMs);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        if (m_queue.empty()) {
+            // 停止时或积累的行等待过久时，由写线程直接封装未满的批次
+            bool flushDue = m_pendingRows > 0 && Clock::now() - m_pendingSince >= flushInterval;
+            if (m_pendingRows > 0 && (m_stopping || flushDue)) {
+                size_t rows = 0;
+                std::shared_ptr<const DataModel> batch = takePendingLocked(rows);
+                m_queue.push_back(batch);
+                m_queuedRows += rows;
+                continue;
+            }
+            if (m_stopping) {
+                break;
+            }
+            Clock::time_point deadline = m_pendingRows > 0
+                ? m_pendingSince + flushInterval : Clock::now() + flushInterval;
+            m_notEmpty.wait_until(lock, deadline);
+            continue;
+        }
+
+        std::shared_ptr<const DataModel> batch = m_queue.front();
+        m_queue.pop_front();
+        size_t rows = batch->size();
+        m_queuedRows -= std::min(m_queuedRows, rows);
+        bool failed = m_failed;
+        lock.unlock();
+        m_notFull.notify_all();
+
+        std::string error;
+        if (!failed) {
+            TRACE_SCOPE("export", "StreamingExporter::writeBatch");
+            if (shouldRotate() && finishFile(error)) {
+                openNextFile(error);
+            }
+            if (error.empty() && !m_plugin->appendBatch(*batch)) {
+                error = "写入失败: " + m_plugin->getLastError();
+            }
+        }
+        uint64_t fileBytes = m_plugin->getStreamBytes();
+
+        lock.lock();
+        if (failed || !error.empty()) {
+            m_droppedRows += rows;
+        } else {
+            m_rowsWritten += rows;
+            m_fileBytes = fileBytes;
+        }
+        if (!error.empty()) {
+            m_failed = true;
+            m_lastError = error;
+            lock.unlock();
+            m_notFull.notify_all();
+            reportError(error);
+            lock.lock();
+        }
+    }
+
+    bool failed = m_failed;
+    lock.unlock();
+
+    std::string error;
+    if (!failed && !finishFile(error)) {
+        lock.lock();
+        m_failed = true;
+        m_lastError = error;
+        lock.unlock();
+        reportError(error);
+    }
+}
+
+bool StreamingExporter::openNextFile(std::string& errorMessage) {
+    std::string filename = nextFileName();
+    if (!m_plugin->beginStream(filename, m_fieldNames)) {
+        errorMessage = "无法开始导出: " + filename + " (" + m_plugin->getLastError() + ")";
+        return false;
+    }
+    m_fileOpened = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_currentFile = filename;
+    m_fileBytes = m_plugin->getStreamBytes();
+    return true;
+}
+
+bool StreamingExporter::finishFile(std::string& errorMessage) {
+    std::string filename;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        filename = m_currentFile;
+    }
+    if (filename.empty()) {
+        return true;
+    }
+
+    bool closed = m_plugin->endStream();
+    // 结束时写出的 Footer 等内容不经过 appendBatch，按关闭后的文件大小统计
+    FileUtils::FileInfo info;
+    bool sized = FileUtils::getFileInfo(filename, info);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bytesWritten += sized ? info.size : m_fileBytes;
+    m_fileBytes = 0;
+    m_filesCompleted++;
+    m_currentFile.clear();
+    if (!closed) {
+        errorMessage = "关闭文件失败: " + filename + " (" + m_plugin->getLastError() + ")";
+        return false;
+    }
+    return true;
+}
+
+bool StreamingExporter::shouldRotate() const {
+    if (m_config.rotateBytes > 0 && m_plugin->getStreamBytes() >= m_config.rotateBytes) {
+        return true;
+    }
+    if (m_config.rotateSeconds > 0.0) {
+        std::chrono::duration<double> open = Clock::now() - m_fileOpened;
+        return open.count() >= m_config.rotateSeconds;
+    }
+    return false;
+}
+
+std::string StreamingExporter::nextFileName() {
+    std::time_t now = std::time(nullptr);
+    std::tm local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+    char sequence[16];
+    std::snprintf(sequence, sizeof(sequence), "%04zu", m_fileSequence++);
+
+    std::string name = m_config.baseName + "_" + stamp + "_" + sequence + m_config.extension;
+    return m_config.directory.empty() ? name : FileUtils::joinPath(m_config.directory, name);
+}
+
+void StreamingExporter::reportError(const std::string& message) {
+    ErrorCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        callback = m_errorCallback;
+    }
+    if (callback) {
+        callback(message);
+    }
+}
+
+StreamingExporter::Metrics StreamingExporter::getMetrics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Metrics metrics;
+    metrics.queuedBatches = m_queue.size() + (m_pendingRows > 0 ? 1 : 0);
+    metrics.queuedRows = m_queuedRows + m_pendingRows;
+    metrics.peakQueuedBatches = m_peakQueuedBatches;
+    metrics.rowsWritten = m_rowsWritten;
+    metrics.bytesWritten = m_bytesWritten + m_fileBytes;
+    metrics.droppedRows = m_droppedRows;
+    metrics.filesCompleted = m_filesCompleted;
+    metrics.currentFile = m_currentFile;
+    if (m_running || m_fileSequence > 0) {
+        std::chrono::duration<double> elapsed = (m_running ? Clock::now() : m_stopTime) - m_startTime;
+        metrics.elapsedSeconds = elapsed.count();
+    }
+    if (metrics.elapsedSeconds > 0.0) {
+        metrics.megabytesPerSecond = metrics.bytesWritten / (1024.0 * 1024.0) / metrics.elapsedSeconds;
+        metrics.rowsPerSecond = metrics.rowsWritten / metrics.elapsedSeconds;
+    }
+    return metrics;
+}
+
+std::string StreamingExporter::getLastError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
+
+void StreamingExporter::setErrorCallback(ErrorCallback callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_errorCallback = callback;
+}
@@ -0,0 +1,48 @@
+#include "Crc32.h"
+
+namespace {
+
+struct Crc32Table {
+    uint32_t entries[8][256];
+
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            entries[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int k = 1; k < 8; ++k) {
+                entries[k][i] = (entries[k - 1][i] >> 8) ^ entries[0][entries[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+// 按小端顺序组合4个字节，与平台字节序无关（编译器会合并为一次读取）
+inline uint32_t loadLittleEndian32(const uint8_t* bytes) {
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+} // namespace
+
+uint32_t Crc32::update(uint32_t crc, const void* data, size_t size) {
+    static const Crc32Table table;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (; size >= 8; size -= 8, bytes += 8) {
+        uint32_t low = loadLittleEndian32(bytes) ^ crc;
+        uint32_t high = loadLittleEndian32(bytes + 4);
+        crc = table.entries[7][low & 0xFF] ^ table.entries[6][(low >> 8) & 0xFF] ^
+              table.entries[5][(low >> 16) & 0xFF] ^ table.entries[4][low >> 24] ^
+              table.entries[3][high & 0xFF] ^ table.entries[2][(high >> 8) & 0xFF] ^
+              table.entries[1][(high >> 16) & 0xFF] ^ table.entries[0][high >> 24];
+    }
+    for (; size > 0; --size, ++bytes) {
+        crc = table.entries[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
@@ -0,0 +1,143 @@
+#include "FileUtils.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#include <unistd.h>
+#endif
+
+bool FileUtils::getFileInfo(const std::string& path, FileInfo& info) {
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0) {
+        return false;
+    }
+    
+    info.path = path;
+    info.size = static_cast<uint64_t>(fileStat.st_size);
+    info.modifiedTime = static_cast<int64_t>(fileStat.st_mtime);
+    return true;
+}
+
+bool FileUtils::exists(const std::string& path) {
+    struct stat fileStat;
+    return stat(path.c_str(), &fileStat) == 0;
+}
+
+bool FileUtils::isDirectory(const std::string& path) {
+    struct stat fileStat;
+    return stat(path.c_str(), &fileStat) == 0 && S_ISDIR(fileStat.st_mode);
+}
+
+bool FileUtils::createDirectories(const std::string& path) {
+    if (path.empty()) {
+        return false;
+    }
+    
+    // 从前往后逐级创建
+    for (size_t pos = 1; pos <= path.size(); ++pos) {
+        if (pos != path.size() && path[pos] != '/' && path[pos] != '\\') {
+            continue;
+        }
+        
+        std::string current = path.substr(0, pos);
+        if (current.empty() || exists(current)) {
+            continue;
+        }
+        
+#ifdef _WIN32
+        int result = _mkdir(current.c_str());
+#else
+        int result = mkdir(current.c_str(), 0755);
+#endif
+        if (result != 0 && errno != EEXIST) {
+            return false;
+        }
+    }
+    
+    return exists(path);
+}
+
+std::vector<FileUtils::FileInfo> FileUtils::listFiles(const std::string& directory,
+                                                      const std::string& extension) {
+    std::vector<FileInfo> files;
+    
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return files;
+    }
+    
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        if (!extension.empty() &&
+            (name.size() < extension.size() ||
+             name.compare(name.size() - extension.size(), extension.size(), extension) != 0)) {
+            continue;
+        }
+        
+        FileInfo info;
+        std::string fullPath = joinPath(directory, name);
+        struct stat fileStat;
+        if (stat(fullPath.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+            continue;
+        }
+        
+        info.path = fullPath;
+        info.size = static_cast<uint64_t>(fileStat.st_size);
+        info.modifiedTime = static_cast<int64_t>(fileStat.st_mtime);
+        files.push_back(info);
+    }
+    
+    closedir(dir);
+    return files;
+}
+
+bool FileUtils::touch(const std::string& path) {
+    // 传入空指针时使用当前时间
+    return utime(path.c_str(), NULL) == 0;
+}
+
+bool FileUtils::removeFile(const std::string& path) {
+    return std::remove(path.c_str()) == 0;
+}
+
+std::string FileUtils::joinPath(const std::string& directory, const std::string& name) {
+    if (directory.empty()) {
+        return name;
+    }
+    char last = directory[directory.size() - 1];
+    if (last == '/' || last == '\\') {
+        return directory + name;
+    }
+    return directory + "/" + name;
+}
+
+std::string FileUtils::getTempDirectory() {
+#ifdef _WIN32
+    const char* names[] = { "TEMP", "TMP" };
+    for (size_t i = 0; i < 2; ++i) {
+        const char* value = std::getenv(names[i]);
+        if (value && *value) {
+            return value;
+        }
+    }
+    return ".";
+#else
+    const char* value = std::getenv("TMPDIR");
+    if (value && *value) {
+        return value;
+    }
+    return "/tmp";
+#endif
+}
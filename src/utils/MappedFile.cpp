@@ -0,0 +1,142 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+MappedFile::MappedFile()
+    : m_data(nullptr), m_size(0), m_isOpen(false)
+#ifdef _WIN32
+    , m_fileHandle(nullptr), m_mappingHandle(nullptr)
+#endif
+{}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        m_lastError = "无法打开文件: " + path;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        m_lastError = "无法获取文件大小: " + path;
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    m_isOpen = true;
+
+    // 空文件无法映射，视为打开成功但没有数据
+    if (m_size == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        close();
+        m_lastError = "创建文件映射失败: " + path;
+        return false;
+    }
+    m_mappingHandle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        close();
+        m_lastError = "映射文件视图失败: " + path;
+        return false;
+    }
+
+    m_data = static_cast<const char*>(view);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_fileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_isOpen = false;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_lastError = "无法打开文件: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        m_lastError = "无法获取文件大小: " + path;
+        ::close(fd);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileStat.st_size);
+    m_isOpen = true;
+
+    // 空文件无法映射，视为打开成功但没有数据
+    if (m_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void* mapped = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后文件描述符即可关闭
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        m_size = 0;
+        m_isOpen = false;
+        m_lastError = "映射文件失败: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+
+    m_data = static_cast<const char*>(mapped);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_isOpen = false;
+}
+
+#endif
@@ -0,0 +1,285 @@
+#include "ThreadPool.h"
+#include "Tracer.h"
+#include <chrono>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// 当前线程在所属线程池中的下标，非工作线程为 -1
+static thread_local const ThreadPool* t_pool = nullptr;
+static thread_local int t_workerIndex = -1;
+
+static void pinCurrentThread(size_t index) {
+    size_t cpuCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t cpu = index % cpuCount;
+#ifdef _WIN32
+    if (cpu < sizeof(DWORD_PTR) * 8) {
+        SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+ThreadPool::ThreadPool()
+    : m_pendingTasks(0), m_stopping(false), m_threadCount(0), m_pinThreads(false), m_executed(0), m_stolen(0) {
+    start(0);
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance;
+    return instance;
+}
+
+void ThreadPool::configure(size_t threadCount, bool pinThreads) {
+    std::lock_guard<std::mutex> lock(m_configureMutex);
+    size_t resolved = threadCount > 0 ? threadCount : std::max<size_t>(1, std::thread::hardware_concurrency());
+    if (resolved == m_workers.size() && pinThreads == m_pinThreads) {
+        return;
+    }
+
+    stop();
+    m_pinThreads = pinThreads;
+    start(resolved);
+}
+
+void ThreadPool::start(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    m_stopping = false;
+    m_workers.clear();
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    // 先建好全部队列再启动线程，窃取时遍历的列表不再变化
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+    m_threadCount.store(threadCount);
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        if (m_workers[i]->thread.joinable()) {
+            m_workers[i]->thread.join();
+        }
+    }
+
+    // 工作线程退出前会取完队列，这里只处理停止期间新提交的任务
+    Task task;
+    while (takeTask(-1, true, task)) {
+        execute(task);
+    }
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return t_pool == this && t_workerIndex >= 0;
+}
+
+void ThreadPool::submit(Task task) {
+    // 先增加计数再入队，计数总不小于队列中的任务数；在睡眠锁内增加，
+    // 避免工作线程检查计数后、进入等待前错过唤醒
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_pendingTasks.fetch_add(1);
+    }
+
+    if (isWorkerThread()) {
+        Worker& worker = *m_workers[static_cast<size_t>(t_workerIndex)];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        m_sharedTasks.push_back(std::move(task));
+    }
+    m_wakeCondition.notify_one();
+}
+
+bool ThreadPool::takeTask(int workerIndex, bool fromShared, Task& task) {
+    if (m_pendingTasks.load() == 0) {
+        return false;
+    }
+
+    // 自己的队列：从队尾取最近提交的任务
+    if (workerIndex >= 0) {
+        Worker& own = *m_workers[static_cast<size_t>(workerIndex)];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            m_pendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    if (fromShared) {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        if (!m_sharedTasks.empty()) {
+            task = std::move(m_sharedTasks.front());
+            m_sharedTasks.pop_front();
+            m_pendingTasks.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // 从其他工作线程的队头窃取最早提交的任务（通常是更大的一段工作）
+    size_t count = m_workers.size();
+    size_t startIndex = workerIndex >= 0 ? static_cast<size_t>(workerIndex) + 1 : 0;
+    for (size_t k = 0; k < count; ++k) {
+        size_t victim = (startIndex + k) % count;
+        if (static_cast<int>(victim) == workerIndex) {
+            continue;
+        }
+        Worker& other = *m_workers[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            m_pendingTasks.fetch_sub(1);
+            m_stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(Task& task) {
+    task();
+    task = Task();
+    m_executed.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ThreadPool::runPendingTask() {
+    // 工作线程等待时只取自己和其他工作线程队列中的任务：它等待的子任务都在这些队列里，
+    // 公共队列中的通常是外部提交的大任务，取来执行会推迟当前等待的完成
+    int workerIndex = isWorkerThread() ? t_workerIndex : -1;
+    Task task;
+    if (!takeTask(workerIndex, workerIndex < 0, task)) {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    t_pool = this;
+    t_workerIndex = static_cast<int>(index);
+    if (m_pinThreads) {
+        pinCurrentThread(index);
+    }
+    if (Tracer::isEnabled()) {
+        Tracer::getInstance().setThreadName("pool-worker-" + std::to_string(index));
+    }
+
+    Task task;
+    while (true) {
+        if (takeTask(t_workerIndex, true, task)) {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        if (m_stopping && m_pendingTasks.load() == 0) {
+            break;
+        }
+        m_wakeCondition.wait(lock, [this]() { return m_stopping || m_pendingTasks.load() > 0; });
+    }
+
+    t_pool = nullptr;
+    t_workerIndex = -1;
+}
+
+size_t ThreadPool::chunkSize(size_t count, size_t grain) const {
+    // 自动粒度：每个线程约4段，负载不均时可以互相窃取
+    if (grain == 0) {
+        size_t target = std::max<size_t>(1, m_threadCount.load() * 4);
+        grain = std::max<size_t>(1, (count + target - 1) / target);
+    }
+    return grain;
+}
+
+ThreadPool::Stats ThreadPool::getStats() const {
+    Stats stats;
+    stats.executed = m_executed.load(std::memory_order_relaxed);
+    stats.stolen = m_stolen.load(std::memory_order_relaxed);
+    return stats;
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : m_pool(pool), m_pending(0), m_cancelled(false) {}
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+        // 析构时不再抛出，异常应通过显式 wait() 获取
+    }
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    m_pending.fetch_add(1);
+    m_pool.submit([this, task]() {
+        if (!m_cancelled.load()) {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+                m_cancelled.store(true);
+            }
+        }
+        finishTask();
+    });
+}
+
+void TaskGroup::finishTask() {
+    // 在锁内递减，等待线程检查计数和进入等待之间不会错过通知
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending.fetch_sub(1) == 1) {
+        m_doneCondition.notify_all();
+    }
+}
+
+void TaskGroup::wait() {
+    while (m_pending.load() > 0) {
+        if (m_pool.runPendingTask()) {
+            continue;
+        }
+        // 剩下的任务都在其他线程上执行；它们可能再提交子任务，所以只短暂等待后重新检查
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait_for(lock, std::chrono::milliseconds(1), [this]() { return m_pending.load() == 0; });
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        error = m_error;
+        m_error = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,237 @@
+#include "Tracer.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+const size_t Tracer::EVENTS_PER_CHUNK;
+const size_t Tracer::MAX_CHUNKS_PER_THREAD;
+
+static int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out << '\\' << static_cast<char>(c);
+        } else if (c < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out << buffer;
+        } else {
+            out << static_cast<char>(c);
+        }
+    }
+    out << '"';
+}
+
+// 线程退出时标记缓冲已退役，clear() 时从线程列表中移除
+class Tracer::ThreadHandle {
+public:
+    explicit ThreadHandle(Tracer& tracer) {
+        std::lock_guard<std::mutex> lock(tracer.m_mutex);
+        buffer = std::make_shared<ThreadBuffer>(tracer.m_nextThreadId.fetch_add(1),
+                                                tracer.m_generation.load());
+        tracer.m_buffers.push_back(buffer);
+    }
+
+    ~ThreadHandle() {
+        buffer->retired.store(true);
+    }
+
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+
+Tracer::ThreadBuffer::ThreadBuffer(uint32_t id, uint64_t currentGeneration)
+    : threadId(id), threadName(nullptr), generation(currentGeneration), dropped(0), retired(false),
+      head(new Chunk()), tail(head), chunkCount(1) {}
+
+Tracer::ThreadBuffer::~ThreadBuffer() {
+    Chunk* chunk = head;
+    while (chunk) {
+        Chunk* next = chunk->next.load();
+        delete chunk;
+        chunk = next;
+    }
+}
+
+Tracer::Tracer() : m_originNs(steadyNowNs()), m_generation(0), m_nextThreadId(1) {}
+
+Tracer& Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::setEnabled(bool enabled) {
+    s_enabled.store(enabled);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generation.fetch_add(1);
+
+    // 已退出线程的缓冲不会再被写入，可以释放
+    std::vector<std::shared_ptr<ThreadBuffer> > active;
+    for (size_t i = 0; i < m_buffers.size(); ++i) {
+        if (!m_buffers[i]->retired.load()) {
+            active.push_back(m_buffers[i]);
+        }
+    }
+    m_buffers.swap(active);
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    static thread_local ThreadHandle handle(*this);
+    return *handle.buffer;
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    localBuffer().threadName.store(intern(name));
+}
+
+const char* Tracer::intern(const std::string& text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_strings.insert(text).first->c_str();
+}
+
+int64_t Tracer::nowNs() const {
+    return steadyNowNs() - m_originNs;
+}
+
+void Tracer::resetBuffer(ThreadBuffer& buffer, uint64_t generation) {
+    // 块不释放（导出线程可能正在遍历），只清空计数后重用
+    for (Chunk* chunk = buffer.head; chunk; chunk = chunk->next.load(std::memory_order_relaxed)) {
+        chunk->count.store(0, std::memory_order_relaxed);
+    }
+    buffer.tail = buffer.head;
+    buffer.dropped.store(0, std::memory_order_relaxed);
+    buffer.generation.store(generation, std::memory_order_release);
+}
+
+void Tracer::record(const char* category, const char* name, int64_t startNs, int64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+
+    uint64_t generation = m_generation.load(std::memory_order_relaxed);
+    if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+        resetBuffer(buffer, generation);
+    }
+
+    Chunk* chunk = buffer.tail;
+    size_t index = chunk->count.load(std::memory_order_relaxed);
+    if (index == EVENTS_PER_CHUNK) {
+        Chunk* next = chunk->next.load(std::memory_order_relaxed);
+        if (!next) {
+            if (buffer.chunkCount >= MAX_CHUNKS_PER_THREAD) {
+                buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            next = new Chunk();
+            buffer.chunkCount++;
+            chunk->next.store(next, std::memory_order_release);
+        }
+        buffer.tail = next;
+        chunk = next;
+        index = 0;
+    }
+
+    Event& event = chunk->events[index];
+    event.category = category;
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+    // 先写内容再发布计数，导出线程只读取已发布的部分
+    chunk->count.store(index + 1, std::memory_order_release);
+}
+
+size_t Tracer::eventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t generation = m_generation.load();
+    size_t total = 0;
+    for (size_t i = 0; i < m_buffers.size(); ++i) {
+        if (m_buffers[i]->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+        for (Chunk* chunk = m_buffers[i]->head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            total += chunk->count.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+uint64_t Tracer::droppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t generation = m_generation.load();
+    uint64_t total = 0;
+    for (size_t i = 0; i < m_buffers.size(); ++i) {
+        if (m_buffers[i]->generation.load(std::memory_order_acquire) == generation) {
+            total += m_buffers[i]->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+void Tracer::writeChromeTrace(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t generation = m_generation.load();
+    uint64_t dropped = 0;
+    bool first = true;
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (size_t i = 0; i < m_buffers.size(); ++i) {
+        const ThreadBuffer& buffer = *m_buffers[i];
+
+        const char* threadName = buffer.threadName.load();
+        if (threadName) {
+            out << (first ? "\n" : ",\n");
+            out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer.threadId
+                << ", \"args\": {\"name\": ";
+            writeJsonString(out, threadName);
+            out << "}}";
+            first = false;
+        }
+
+        if (buffer.generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+        dropped += buffer.dropped.load(std::memory_order_relaxed);
+
+        for (const Chunk* chunk = buffer.head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t count = chunk->count.load(std::memory_order_acquire);
+            for (size_t j = 0; j < count; ++j) {
+                const Event& event = chunk->events[j];
+                out << (first ? "\n" : ",\n");
+                out << "{\"name\": ";
+                writeJsonString(out, event.name);
+                out << ", \"cat\": ";
+                writeJsonString(out, event.category);
+                // trace-event 的时间单位为微秒
+                out << ", \"ph\": \"X\", \"ts\": " << event.startNs / 1000.0
+                    << ", \"dur\": " << event.durationNs / 1000.0
+                    << ", \"pid\": 1, \"tid\": " << buffer.threadId << "}";
+                first = false;
+            }
+        }
+    }
+    out << (first ? "" : "\n") << "], \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+}
+
+bool Tracer::writeChromeTrace(const std::string& filename, std::string& errorMessage) const {
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        errorMessage = "无法创建跟踪文件: " + filename;
+        return false;
+    }
+    writeChromeTrace(file);
+    if (!file.good()) {
+        errorMessage = "写入跟踪文件失败: " + filename;
+        return false;
+    }
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "ChartManager.h"
+#include "PlotDataBridge.h"
 #include <QCustomPlot>
 #include <QCPGraph>
 #include <QCPLegend>
@@ -111,13 +112,34 @@ QCPGraph* ChartManager::addGraph(const QString& name, const QColor& color) {
 
 void ChartManager::updateGraphData(const QString& name, 
                                  const QVector<double>& xData, 
-                                 const QVector<double>& yData) {
+                                 const QVector<double>& yData,
+                                 bool alreadySorted) {
     if (!m_graphs.contains(name)) {
         return;
     }
     
     QCPGraph* graph = m_graphs[name];
-    graph->setData(xData, yData);
+    graph->setData(xData, yData, alreadySorted);
+    emit graphUpdated(name);
+}
+
+void ChartManager::setGraphData(const QString& name, const double* xData, const double* yData,
+                                size_t count) {
+    if (!m_graphs.contains(name)) {
+        return;
+    }
+    
+    PlotDataBridge::setGraphData(m_graphs[name], xData, yData, count);
+    emit graphUpdated(name);
+}
+
+void ChartManager::setGraphData(const QString& name, const ColumnBuffer& xData,
+                                const ColumnBuffer& yData) {
+    if (!m_graphs.contains(name)) {
+        return;
+    }
+    
+    PlotDataBridge::setGraphData(m_graphs[name], xData, yData);
     emit graphUpdated(name);
 }
 
@@ -126,15 +148,21 @@ void ChartManager::fitToData() {
     
     m_plotWidget->rescaleAxes();
     
-    // 添加一些边距
     auto xRange = m_plotWidget->xAxis->range();
     auto yRange = m_plotWidget->yAxis->range();
     
-    double xMargin = (xRange.upper - xRange.lower) * 0.05;
-    double yMargin = (yRange.upper - yRange.lower) * 0.05;
+    fitToRange(xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+}
+
+void ChartManager::fitToRange(double xMin, double xMax, double yMin, double yMax) {
+    if (!m_plotWidget) return;
+    
+    // 添加一些边距
+    double xMargin = (xMax - xMin) * 0.05;
+    double yMargin = (yMax - yMin) * 0.05;
     
-    m_plotWidget->xAxis->setRange(xRange.lower - xMargin, xRange.upper + xMargin);
-    m_plotWidget->yAxis->setRange(yRange.lower - yMargin, yRange.upper + yMargin);
+    m_plotWidget->xAxis->setRange(xMin - xMargin, xMax + xMargin);
+    m_plotWidget->yAxis->setRange(yMin - yMargin, yMax + yMargin);
     
     m_plotWidget->replot();
 }
@@ -0,0 +1,98 @@
+#include "DecimationWorker.h"
+#include "data/DataModel.h"
+#include "data/LodPyramid.h"
+#include <algorithm>
+
+DecimationWorker::DecimationWorker(QObject* parent)
+    : QObject(parent)
+    , m_latestGeneration(0)
+    , m_pyramidModelId(0)
+    , m_pyramidRevision(0)
+    , m_pyramidRemovedRows(0) {
+}
+
+void DecimationWorker::setLatestGeneration(quint64 generation) {
+    m_latestGeneration.store(generation);
+}
+
+void DecimationWorker::prepare(const QSharedPointer<DataModel>& dataModel, const QString& xField) {
+    if (!dataModel) {
+        return;
+    }
+    rebuildPyramids(*dataModel, xField.toStdString());
+}
+
+void DecimationWorker::process(const DecimationRequest& request) {
+    // 已有更新的请求排队，跳过本次计算
+    if (request.generation < m_latestGeneration.load() || !request.dataModel) {
+        return;
+    }
+
+    // 持有列视图，计算期间模型被修改也不影响本次读取
+    ColumnBuffer xSeries = request.dataModel->getColumnBuffer(request.xField);
+    ColumnBuffer ySeries = request.dataModel->getColumnBuffer(request.yField);
+    size_t count = std::min(xSeries.size(), ySeries.size());
+    if (count == 0) {
+        return;
+    }
+
+    preparePyramids(request);
+
+    size_t startIndex = 0;
+    size_t endIndex = count;
+    DataDecimator::visibleRange(xSeries.slice(0, count), request.xMin, request.xMax,
+                                startIndex, endIndex);
+
+    std::vector<double> outX, outY;
+    DataDecimator::decimateLod(xSeries, ySeries, startIndex, endIndex,
+                               DataDecimator::pointsForPixels(request.pixelWidth), request.mode,
+                               *m_pyramids[request.yField], outX, outY);
+
+    QVector<double> xData(static_cast<int>(outX.size()));
+    QVector<double> yData(static_cast<int>(outY.size()));
+    std::copy(outX.begin(), outX.end(), xData.begin());
+    std::copy(outY.begin(), outY.end(), yData.begin());
+
+    emit decimated(request.generation, request.seriesName, xData, yData);
+}
+
+void DecimationWorker::preparePyramids(const DecimationRequest& request) {
+    const DataModel* model = request.dataModel.data();
+    
+    // 新模型或数据被替换：并行重建所有列
+    if (model->getInstanceId() != m_pyramidModelId || model->getRevision() != m_pyramidRevision) {
+        rebuildPyramids(*model, request.xField);
+    }
+    
+    // 开头的行被丢弃（实时缓冲区写满后）：各列金字塔同步丢弃，不重建
+    size_t removedRows = model->getRemovedRowCount();
+    if (removedRows != m_pyramidRemovedRows) {
+        for (auto& entry : m_pyramids) {
+            entry.second->dropFront(removedRows - m_pyramidRemovedRows);
+        }
+        m_pyramidRemovedRows = removedRows;
+    }
+    
+    // 纯追加：只扩展新增部分（extend 会先核对已汇总部分的抽样值）；x 列不需要金字塔
+    std::shared_ptr<LodPyramid>& pyramid = m_pyramids[request.yField];
+    if (!pyramid) {
+        pyramid = std::make_shared<LodPyramid>();
+    }
+    
+    ColumnBuffer series = model->getColumnBuffer(request.yField);
+    if (series.size() != pyramid->sourceSize()) {
+        pyramid->extend(series);
+    }
+}
+
+void DecimationWorker::rebuildPyramids(const DataModel& model, const std::string& xField) {
+    if (model.getInstanceId() == m_pyramidModelId && model.getRevision() == m_pyramidRevision) {
+        return;
+    }
+    std::vector<std::string> yFields = model.getFieldNames();
+    yFields.erase(std::remove(yFields.begin(), yFields.end(), xField), yFields.end());
+    m_pyramids = LodPyramid::buildForFields(model, yFields);
+    m_pyramidModelId = model.getInstanceId();
+    m_pyramidRevision = model.getRevision();
+    m_pyramidRemovedRows = model.getRemovedRowCount();
+}
@@ -0,0 +1,72 @@
+#include "FrameScheduler.h"
+#include <algorithm>
+
+FrameScheduler::FrameScheduler(QObject* parent)
+    : QObject(parent)
+    , m_refreshRate(30)
+    , m_pending(false)
+    , m_framesSinceClock(0) {
+    
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(1000 / m_refreshRate);
+    connect(&m_timer, &QTimer::timeout, this, &FrameScheduler::onTimeout);
+}
+
+void FrameScheduler::setRefreshRate(int framesPerSecond) {
+    m_refreshRate = std::max(1, std::min(framesPerSecond, 240));
+    m_timer.setInterval(1000 / m_refreshRate);
+}
+
+void FrameScheduler::resetStats() {
+    m_stats = FrameStats();
+    m_framesSinceClock = 0;
+    m_fpsClock.invalidate();
+}
+
+void FrameScheduler::requestFrame() {
+    m_stats.requestCount++;
+    
+    if (m_pending) {
+        m_stats.coalescedCount++;
+        return;
+    }
+    
+    m_pending = true;
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void FrameScheduler::onTimeout() {
+    if (!m_pending) {
+        // 一整帧没有新请求，停止定时器直到下次请求
+        m_timer.stop();
+        return;
+    }
+    
+    // 先清除标志，绘制期间产生的请求留到下一帧
+    m_pending = false;
+    
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+    emit frameRequested();
+    double frameMs = frameTimer.nsecsElapsed() / 1.0e6;
+    
+    m_stats.frameCount++;
+    m_stats.lastFrameMs = frameMs;
+    m_stats.maxFrameMs = std::max(m_stats.maxFrameMs, frameMs);
+    m_stats.averageFrameMs += (frameMs - m_stats.averageFrameMs) / m_stats.frameCount;
+    
+    // 每秒更新一次实际帧率
+    if (!m_fpsClock.isValid()) {
+        m_fpsClock.start();
+        m_framesSinceClock = 0;
+    }
+    m_framesSinceClock++;
+    qint64 elapsedMs = m_fpsClock.elapsed();
+    if (elapsedMs >= 1000) {
+        m_stats.actualFps = m_framesSinceClock * 1000.0 / elapsedMs;
+        m_framesSinceClock = 0;
+        m_fpsClock.restart();
+    }
+}
@@ -0,0 +1,71 @@
+#include "PlotDataBridge.h"
+#include <algorithm>
+
+QSharedPointer<QCPGraphDataContainer> PlotDataBridge::toGraphData(const double* x, const double* y,
+                                                                  size_t count) {
+    QSharedPointer<QCPGraphDataContainer> container(new QCPGraphDataContainer);
+    if (!x || !y || count == 0) {
+        return container;
+    }
+    
+    // 一次遍历完成填充和有序性检查
+    QVector<QCPGraphData> data(static_cast<int>(count));
+    bool sorted = true;
+    for (size_t i = 0; i < count; ++i) {
+        data[static_cast<int>(i)].key = x[i];
+        data[static_cast<int>(i)].value = y[i];
+        if (i > 0 && x[i] < x[i - 1]) {
+            sorted = false;
+        }
+    }
+    
+    // set() 与 data 隐式共享同一块内存，未排序时原地排序一次
+    container->set(data, sorted);
+    return container;
+}
+
+QSharedPointer<QCPGraphDataContainer> PlotDataBridge::toGraphData(const ColumnBuffer& x,
+                                                                  const ColumnBuffer& y) {
+    QSharedPointer<QCPGraphDataContainer> container(new QCPGraphDataContainer);
+    size_t count = std::min(x.size(), y.size());
+    if (count == 0) {
+        return container;
+    }
+    
+    // x、y 各按自己的片段遍历一次，直接写入曲线数据，有序性检查与填充 x 同时完成
+    QVector<QCPGraphData> data(static_cast<int>(count));
+    QCPGraphData* points = data.data();
+    bool sorted = true;
+    double previous = 0.0;
+    x.forEachSpan(0, count, [&](size_t startIndex, const double* values, size_t spanCount) {
+        for (size_t i = 0; i < spanCount; ++i) {
+            if (startIndex + i > 0 && values[i] < previous) {
+                sorted = false;
+            }
+            previous = values[i];
+            points[startIndex + i].key = values[i];
+        }
+    });
+    y.forEachSpan(0, count, [&](size_t startIndex, const double* values, size_t spanCount) {
+        for (size_t i = 0; i < spanCount; ++i) {
+            points[startIndex + i].value = values[i];
+        }
+    });
+    
+    container->set(data, sorted);
+    return container;
+}
+
+void PlotDataBridge::setGraphData(QCPGraph* graph, const double* x, const double* y, size_t count) {
+    if (!graph) {
+        return;
+    }
+    graph->setData(toGraphData(x, y, count));
+}
+
+void PlotDataBridge::setGraphData(QCPGraph* graph, const ColumnBuffer& x, const ColumnBuffer& y) {
+    if (!graph) {
+        return;
+    }
+    graph->setData(toGraphData(x, y));
+}
@@ -1,7 +1,9 @@
 #include "PlotWidget.h"
 #include "ChartManager.h"
 #include "InteractionHandler.h"
+#include "DecimationWorker.h"
 #include "data/DataModel.h"
+#include <QThread>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QMouseEvent>
@@ -16,15 +18,45 @@ PlotWidget::PlotWidget(QWidget* parent)
     : QWidget(parent)
     , m_autoScale(true)
     , m_showTooltips(true)
-    , m_isRealTime(false) {
+    , m_isRealTime(false)
+    , m_decimationThread(nullptr)
+    , m_decimationWorker(nullptr)
+    , m_decimationMode(DataDecimator::Mode::MinMax)
+    , m_decimationGeneration(0)
+    , m_frameScheduler(new FrameScheduler(this)) {
     
     setupUI();
     setupPlot();
     setupInteractions();
+    setupDecimation();
+    
+    connect(m_frameScheduler, &FrameScheduler::frameRequested, this, &PlotWidget::onFrame);
 }
 
 PlotWidget::~PlotWidget() {
     // 清理资源
+    if (m_decimationThread) {
+        m_decimationThread->quit();
+        m_decimationThread->wait();
+    }
+}
+
+void PlotWidget::setupDecimation() {
+    qRegisterMetaType<DecimationRequest>("DecimationRequest");
+    qRegisterMetaType<QSharedPointer<DataModel> >("QSharedPointer<DataModel>");
+    
+    m_decimationThread = new QThread(this);
+    m_decimationWorker = new DecimationWorker();
+    m_decimationWorker->moveToThread(m_decimationThread);
+    
+    connect(m_decimationThread, &QThread::finished, m_decimationWorker, &QObject::deleteLater);
+    connect(m_decimationWorker, &DecimationWorker::decimated, this, &PlotWidget::onDecimated);
+    
+    // 缩放/平移后按新的可见范围重新降采样
+    connect(m_customPlot->xAxis, QOverload<const QCPRange&>::of(&QCPAxis::rangeChanged),
+            this, &PlotWidget::onXAxisRangeChanged);
+    
+    m_decimationThread->start();
 }
 
 void PlotWidget::setupUI() {
@@ -91,6 +123,15 @@ void PlotWidget::setDataModel(QSharedPointer<DataModel> dataModel) {
         return;
     }
     
+    // 加载完成即在工作线程中为各 y 列并行构建LOD金字塔，先于随后的降采样请求执行；
+    // 与 updatePlot 一致，第一个字段作为x轴
+    std::vector<std::string> fieldNames = m_dataModel->getFieldNames();
+    if (m_decimationMode != DataDecimator::Mode::None && !fieldNames.empty()) {
+        QMetaObject::invokeMethod(m_decimationWorker, "prepare", Qt::QueuedConnection,
+                                  Q_ARG(QSharedPointer<DataModel>, m_dataModel),
+                                  Q_ARG(QString, QString::fromStdString(fieldNames[0])));
+    }
+    
     // 从数据模型加载数据
     updatePlot();
 }
@@ -103,23 +144,53 @@ void PlotWidget::addDataSeries(const QString& name, const QVector<double>& xData
     }
     
     try {
-        QCPGraph* graph = m_chartManager->addGraph(name, generateColor(m_graphs.size()));
-        m_chartManager->updateGraphData(name, xData, yData);
-        m_graphs[name] = graph;
+        setSeriesData(name, xData, yData);
         
         if (m_autoScale) {
             m_chartManager->fitToData();
         }
         
         m_customPlot->replot();
-        emit seriesAdded(name);
         
     } catch (const std::exception& e) {
         emit errorOccurred(QString("添加数据系列失败: %1").arg(e.what()));
     }
 }
 
+void PlotWidget::setSeriesData(const QString& name, const QVector<double>& xData, 
+                               const QVector<double>& yData) {
+    bool isNew = !m_graphs.contains(name);
+    QCPGraph* graph = m_chartManager->addGraph(name, generateColor(m_graphs.size()));
+    m_chartManager->updateGraphData(name, xData, yData);
+    m_graphs[name] = graph;
+    
+    if (isNew) {
+        emit seriesAdded(name);
+    }
+}
+
+void PlotWidget::setSeriesData(const QString& name, const ColumnBuffer& xData,
+                               const ColumnBuffer& yData) {
+    bool isNew = !m_graphs.contains(name);
+    QCPGraph* graph = m_chartManager->addGraph(name, generateColor(m_graphs.size()));
+    m_chartManager->setGraphData(name, xData, yData);
+    m_graphs[name] = graph;
+    
+    if (isNew) {
+        emit seriesAdded(name);
+    }
+}
+
 void PlotWidget::addRealTimeData(const QString& seriesName, double x, double y) {
+    addRealTimeBatch(seriesName, QVector<double>(1, x), QVector<double>(1, y));
+}
+
+void PlotWidget::addRealTimeBatch(const QString& seriesName, const QVector<double>& xData,
+                                  const QVector<double>& yData) {
+    if (xData.isEmpty() || xData.size() != yData.size()) {
+        return;
+    }
+    
     if (!m_graphs.contains(seriesName)) {
         // 创建新曲线
         QCPGraph* graph = m_chartManager->addGraph(seriesName, generateColor(m_graphs.size()));
@@ -127,21 +198,77 @@ void PlotWidget::addRealTimeData(const QString& seriesName, double x, double y)
         emit seriesAdded(seriesName);
     }
     
-    m_chartManager->addDataPoint(seriesName, x, y);
+    // 只缓存，由下一帧统一追加和重绘
+    PendingSamples& pending = m_pendingSamples[seriesName];
+    if (pending.xData.isEmpty()) {
+        // 共享批次缓冲（隐式共享，不复制）
+        pending.xData = xData;
+        pending.yData = yData;
+    } else {
+        pending.xData += xData;
+        pending.yData += yData;
+    }
     m_isRealTime = true;
     
-    // 实时模式下自动滚动
-    if (m_autoScale && m_isRealTime) {
-        auto range = m_chartManager->getDataRange();
-        m_chartManager->setXAxisRange(range.left(), range.left() + 100); // 显示最近100个点
+    m_frameScheduler->requestFrame();
+}
+
+void PlotWidget::onFrame() {
+    double latestX = 0.0;
+    bool hasNewData = false;
+    
+    for (auto it = m_pendingSamples.begin(); it != m_pendingSamples.end(); ++it) {
+        PendingSamples& pending = it.value();
+        if (pending.xData.isEmpty() || !m_graphs.contains(it.key())) {
+            continue;
+        }
+        
+        // 实时数据按时间顺序到达，批量追加无需排序
+        m_graphs[it.key()]->addData(pending.xData, pending.yData, true);
+        latestX = hasNewData ? std::max(latestX, pending.xData.last()) : pending.xData.last();
+        hasNewData = true;
+        
+        pending.xData.clear();
+        pending.yData.clear();
+    }
+    
+    // 实时模式下自动滚动：保持当前可见宽度，最新点贴右边缘
+    if (hasNewData && m_autoScale && m_isRealTime) {
+        double width = m_customPlot->xAxis->range().size();
+        m_customPlot->xAxis->setRange(latestX - width, latestX);
     }
     
     m_customPlot->replot();
 }
 
+void PlotWidget::onRealTimeDataAdded(const QString& seriesName, double x, double y) {
+    addRealTimeData(seriesName, x, y);
+}
+
+void PlotWidget::onRealTimeBatchReady(const QString& xField, const QVector<double>& xData,
+                                      const QMap<QString, QVector<double>>& seriesData) {
+    Q_UNUSED(xField);
+    for (auto it = seriesData.constBegin(); it != seriesData.constEnd(); ++it) {
+        addRealTimeBatch(it.key(), xData, it.value());
+    }
+}
+
+void PlotWidget::onReplotRequested() {
+    m_frameScheduler->requestFrame();
+}
+
+void PlotWidget::setRefreshRate(int framesPerSecond) {
+    m_frameScheduler->setRefreshRate(framesPerSecond);
+}
+
+FrameScheduler::FrameStats PlotWidget::getFrameStats() const {
+    return m_frameScheduler->getStats();
+}
+
 void PlotWidget::clearData() {
     m_chartManager->clearGraphData();
     m_graphs.clear();
+    m_pendingSamples.clear();
     m_customPlot->replot();
     m_isRealTime = false;
 }
@@ -155,6 +282,7 @@ void PlotWidget::clearSeries(const QString& seriesName) {
     if (m_graphs.contains(seriesName)) {
         m_chartManager->removeGraph(seriesName);
         m_graphs.remove(seriesName);
+        m_pendingSamples.remove(seriesName);
         m_customPlot->replot();
         emit seriesRemoved(seriesName);
     }
@@ -176,8 +304,48 @@ void PlotWidget::setAxisLabels(const QString& xLabel, const QString& yLabel) {
 void PlotWidget::setAutoScale(bool autoScale) {
     m_autoScale = autoScale;
     if (m_autoScale) {
+        autoScaleAxes();
+    }
+}
+
+void PlotWidget::autoScaleAxes() {
+    if (!m_dataModel || m_dataModel->empty()) {
         m_chartManager->fitToData();
+        return;
     }
+    
+    // 坐标范围直接取自DataModel的分块摘要，不再遍历曲线数据
+    auto fieldNames = m_dataModel->getFieldNames();
+    double xMin = 0.0, xMax = 0.0;
+    if (fieldNames.size() < 2 || !m_dataModel->getFieldRange(fieldNames[0], xMin, xMax)) {
+        m_chartManager->fitToData();
+        return;
+    }
+    
+    bool hasYRange = false;
+    double yMin = 0.0, yMax = 0.0;
+    for (size_t i = 1; i < fieldNames.size(); ++i) {
+        QString fieldName = QString::fromStdString(fieldNames[i]);
+        if (!m_graphs.contains(fieldName) || !m_graphs[fieldName]->visible()) {
+            continue;
+        }
+        
+        double fieldMin = 0.0, fieldMax = 0.0;
+        if (!m_dataModel->getFieldRange(fieldNames[i], fieldMin, fieldMax)) {
+            continue;
+        }
+        
+        yMin = hasYRange ? std::min(yMin, fieldMin) : fieldMin;
+        yMax = hasYRange ? std::max(yMax, fieldMax) : fieldMax;
+        hasYRange = true;
+    }
+    
+    if (!hasYRange) {
+        m_chartManager->fitToData();
+        return;
+    }
+    
+    m_chartManager->fitToRange(xMin, xMax, yMin, yMax);
 }
 
 void PlotWidget::updatePlot() {
@@ -194,25 +362,42 @@ void PlotWidget::updatePlot() {
         
         // 假设第一个字段是x轴数据
         QString xFieldName = QString::fromStdString(fieldNames[0]);
-        auto xData = m_dataModel->getDataSeries(xFieldName.toStdString());
+        m_xFieldName = xFieldName;
+        
+        if (m_decimationMode != DataDecimator::Mode::None) {
+            // 只创建曲线，数据由降采样线程按可见范围填充
+            for (size_t i = 1; i < fieldNames.size(); ++i) {
+                QString fieldName = QString::fromStdString(fieldNames[i]);
+                if (!m_graphs.contains(fieldName)) {
+                    m_graphs[fieldName] = m_chartManager->addGraph(fieldName, generateColor(m_graphs.size()));
+                    emit seriesAdded(fieldName);
+                }
+            }
+            
+            if (m_autoScale) {
+                autoScaleAxes();
+            }
+            
+            requestDecimation();
+            return;
+        }
+        
+        // 直接引用模型中的列内存，由桥接一次填充曲线数据
+        ColumnBuffer xData = m_dataModel->getColumnBuffer(fieldNames[0]);
         
         // 为其他字段创建曲线
         for (size_t i = 1; i < fieldNames.size(); ++i) {
             QString fieldName = QString::fromStdString(fieldNames[i]);
-            auto yData = m_dataModel->getDataSeries(fieldName.toStdString());
+            ColumnBuffer yData = m_dataModel->getColumnBuffer(fieldNames[i]);
             
             if (xData.size() == yData.size()) {
-                QVector<double> xVec, yVec;
-                for (size_t j = 0; j < xData.size(); ++j) {
-                    xVec.append(xData[j]);
-                    yVec.append(yData[j]);
-                }
-                addDataSeries(fieldName, xVec, yVec);
+                // 按列的连续片段直接写入曲线数据，分块的列不再拼成临时连续数组
+                setSeriesData(fieldName, xData, yData);
             }
         }
         
         if (m_autoScale) {
-            m_chartManager->fitToData();
+            autoScaleAxes();
         }
         
         m_customPlot->replot();
@@ -232,4 +417,59 @@ bool PlotWidget::savePlot(const QString& filename, int width, int height) {
     }
 }
 
+void PlotWidget::setDecimationMode(DataDecimator::Mode mode) {
+    if (m_decimationMode == mode) {
+        return;
+    }
+    
+    m_decimationMode = mode;
+    updatePlot();
+}
+
+void PlotWidget::requestDecimation() {
+    if (!m_dataModel || m_xFieldName.isEmpty() || m_isRealTime ||
+        m_decimationMode == DataDecimator::Mode::None) {
+        return;
+    }
+    
+    // 新一代请求，之前排队的请求在工作线程中直接跳过
+    quint64 generation = ++m_decimationGeneration;
+    m_decimationWorker->setLatestGeneration(generation);
+    
+    QCPRange range = m_customPlot->xAxis->range();
+    int pixelWidth = m_customPlot->axisRect()->width();
+    
+    for (auto it = m_graphs.constBegin(); it != m_graphs.constEnd(); ++it) {
+        DecimationRequest request;
+        request.generation = generation;
+        request.seriesName = it.key();
+        request.dataModel = m_dataModel;
+        request.xField = m_xFieldName.toStdString();
+        request.yField = it.key().toStdString();
+        request.xMin = range.lower;
+        request.xMax = range.upper;
+        request.pixelWidth = pixelWidth;
+        request.mode = m_decimationMode;
+        
+        QMetaObject::invokeMethod(m_decimationWorker, "process", Qt::QueuedConnection,
+                                  Q_ARG(DecimationRequest, request));
+    }
+}
+
+void PlotWidget::onXAxisRangeChanged(const QCPRange& newRange) {
+    Q_UNUSED(newRange);
+    requestDecimation();
+}
+
+void PlotWidget::onDecimated(quint64 generation, const QString& seriesName,
+                             const QVector<double>& xData, const QVector<double>& yData) {
+    // 丢弃过期结果
+    if (generation != m_decimationGeneration || !m_graphs.contains(seriesName)) {
+        return;
+    }
+    
+    m_chartManager->updateGraphData(seriesName, xData, yData, true);
+    m_customPlot->replot(QCustomPlot::rpQueuedReplot);
+}
+
 // 其他方法实现...
\ No newline at end of file